@@ -14,8 +14,10 @@ if (BUILD_EXAMPLES AND BUILD_SKYLICHT_LIGHMAPPER)
 	
 	if (BUILD_SKYLICHT_COLLISION)
 	subdirs(Samples/Collision)
+	subdirs(Samples/CollisionBenchmark)
 	endif()
 	
+	subdirs(Samples/CullingBenchmark)
 	subdirs(Samples/DrawPrimitives)
 
 	if (BUILD_SKYLICHT_UI)
@@ -24,6 +26,7 @@ if (BUILD_EXAMPLES AND BUILD_SKYLICHT_LIGHMAPPER)
 	
 	subdirs(Samples/HelloWorld)
 	subdirs(Samples/Instancing)
+	subdirs(Samples/LoadingBenchmark)
 	
 	if (BUILD_SKYLICHT_AUDIO)
 	subdirs(Samples/LuckyDraw)
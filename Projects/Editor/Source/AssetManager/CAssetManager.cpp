@@ -81,6 +81,9 @@ namespace Skylicht
 			m_files.clear();
 			m_pathToFile.clear();
 
+			// the files on disk may be changed outside the engine
+			getIrrlichtDevice()->getFileSystem()->clearPathCache();
+
 			if (m_haveAssetFolder)
 			{
 				for (const auto& file : fs::directory_iterator(m_assetFolder))
@@ -1 +1 @@
-#define PROJECT_PATH "/Users/phamhongduc/skylicht-engine/Assets"
\ No newline at end of file
+#define PROJECT_PATH "/root/repo/Assets"
\ No newline at end of file
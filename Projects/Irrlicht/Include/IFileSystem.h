@@ -318,6 +318,19 @@ public:
 	\return True if file exists, and false if it does not exist or an error occured. */
 	virtual bool existFile(const path& filename) const =0;
 
+	//! Clears the cache of resolved file names.
+	/** existFile() and createAndOpenFile() remember where a file name was
+	found (archive, disk or nowhere). The cache is cleared when archives are
+	added, removed or moved and when a file is written through this file
+	system. Call this when files are created or deleted by other means. */
+	virtual void clearPathCache() =0;
+
+	//! Get the number of file name lookups answered by the cache.
+	virtual u32 getPathCacheHit() const =0;
+
+	//! Get the number of file name lookups that had to search archives and disk.
+	virtual u32 getPathCacheMiss() const =0;
+
 	//! Creates a XML Reader from a file which returns all parsed strings as wide characters (wchar_t*).
 	/** Use createXMLReaderUTF8() if you prefer char* instead of wchar_t*. See IIrrXMLReader for
 	more information on how to use the parser.
@@ -64,7 +64,8 @@ namespace io
 {
 
 //! constructor
-CFileSystem::CFileSystem()
+CFileSystem::CFileSystem() :
+	PathCacheHit(0), PathCacheMiss(0)
 {
 	#ifdef _DEBUG
 	setDebugName("CFileSystem");
@@ -122,21 +123,30 @@ CFileSystem::~CFileSystem()
 IReadFile* CFileSystem::createAndOpenFile(const io::path& filename)
 {
 	IReadFile* file = 0;
-	u32 i;
 
 	if (filename.size() == 0)
 		return NULL;	// fix for Linux System filename == ""
 
-	for (i=0; i< FileArchives.size(); ++i)
+	const SResolvedPath resolved = resolvePath(filename);
+	if (resolved.Archive == ERP_NOT_FOUND)
+		return NULL;
+
+	if (resolved.Archive >= 0)
 	{
-		file = FileArchives[i]->createAndOpenFile(filename);
+		file = FileArchives[resolved.Archive]->createAndOpenFile((u32)resolved.Index);
 		if (file)
 			return file;
 	}
 
 	// Create the file using an absolute path so that it matches
 	// the scheme used by CNullDriver::getTexture().
-	return CReadFile::createReadFile(getAbsolutePath(filename));
+	file = CReadFile::createReadFile(getAbsolutePath(filename));
+
+	// the file was removed since it was resolved
+	if (!file)
+		invalidatePath(filename);
+
+	return file;
 }
 
 
@@ -176,6 +186,9 @@ IWriteFile* CFileSystem::createMemoryWriteFile(void* memory, s32 len,
 //! Opens a file for write access.
 IWriteFile* CFileSystem::createAndWriteFile(const io::path& filename, bool append)
 {
+	// the file may be cached as not found, and the name can be spelled
+	// in many ways (relative, absolute), so drop the whole cache
+	clearPathCache();
 	return CWriteFile::createWriteFile(filename, append);
 }
 
@@ -224,6 +237,9 @@ bool CFileSystem::moveFileArchive(u32 sourceIndex, s32 relative)
 		FileArchives[s] = t;
 		r = true;
 	}
+
+	if (r)
+		clearPathCache();
 	return r;
 }
 
@@ -323,6 +339,7 @@ bool CFileSystem::addFileArchive(const io::path& filename, bool ignoreCase,
 	if (archive)
 	{
 		FileArchives.push_back(archive);
+		clearPathCache();
 		if (password.size())
 			archive->Password=password;
 		if (retArchive)
@@ -429,6 +446,7 @@ bool CFileSystem::addFileArchive(IReadFile* file, bool ignoreCase,
 		if (archive)
 		{
 			FileArchives.push_back(archive);
+			clearPathCache();
 			if (password.size())
 				archive->Password=password;
 			if (retArchive)
@@ -457,6 +475,7 @@ bool CFileSystem::addFileArchive(IFileArchive* archive)
 		}
 	}
 	FileArchives.push_back(archive);
+	clearPathCache();
 	return true;
 }
 
@@ -469,6 +488,7 @@ bool CFileSystem::removeFileArchive(u32 index)
 	{
 		FileArchives[index]->drop();
 		FileArchives.erase(index);
+		clearPathCache();
 		ret = true;
 	}
 	_IRR_IMPLEMENT_MANAGED_MARSHALLING_BUGFIX;
@@ -594,6 +614,9 @@ bool CFileSystem::changeWorkingDirectoryTo(const io::path& newDirectory)
 {
 	bool success=false;
 
+	// relative file names now point to other files
+	clearPathCache();
+
 	if (FileSystemType != FILESYSTEM_NATIVE)
 	{
 		WorkingDirectory[FILESYSTEM_VIRTUAL] = newDirectory;
@@ -971,10 +994,83 @@ IFileList* CFileSystem::createEmptyFileList(const io::path& path, bool ignoreCas
 //! determines if a file exists and would be able to be opened.
 bool CFileSystem::existFile(const io::path& filename) const
 {
+	return resolvePath(filename).Archive != ERP_NOT_FOUND;
+}
+
+
+//! Clears the cache of resolved file names.
+void CFileSystem::clearPathCache()
+{
+	std::lock_guard<std::mutex> lock(ResolvedPathLock);
+	ResolvedPaths.clear();
+}
+
+
+//! Get the number of file name lookups answered by the cache.
+u32 CFileSystem::getPathCacheHit() const
+{
+	return PathCacheHit;
+}
+
+
+//! Get the number of file name lookups that had to search archives and disk.
+u32 CFileSystem::getPathCacheMiss() const
+{
+	return PathCacheMiss;
+}
+
+
+//! find the file in the archives and on disk, the result is cached
+CFileSystem::SResolvedPath CFileSystem::resolvePath(const io::path& filename) const
+{
+	const std::basic_string<fschar_t> key(filename.c_str(), filename.size());
+
+	{
+		std::lock_guard<std::mutex> lock(ResolvedPathLock);
+		auto it = ResolvedPaths.find(key);
+		if (it != ResolvedPaths.end())
+		{
+			++PathCacheHit;
+			return it->second;
+		}
+	}
+
+	SResolvedPath resolved;
+	resolved.Archive = ERP_NOT_FOUND;
+	resolved.Index = -1;
+
 	for (u32 i=0; i < FileArchives.size(); ++i)
-		if (FileArchives[i]->getFileList()->findFile(filename)!=-1)
-			return true;
+	{
+		const s32 index = FileArchives[i]->getFileList()->findFile(filename);
+		if (index != -1)
+		{
+			resolved.Archive = (s32)i;
+			resolved.Index = index;
+			break;
+		}
+	}
+
+	if (resolved.Archive == ERP_NOT_FOUND && existDiskFile(filename))
+		resolved.Archive = ERP_DISK;
+
+	std::lock_guard<std::mutex> lock(ResolvedPathLock);
+	++PathCacheMiss;
+	ResolvedPaths[key] = resolved;
+	return resolved;
+}
+
 
+//! forget a cached file name
+void CFileSystem::invalidatePath(const io::path& filename) const
+{
+	std::lock_guard<std::mutex> lock(ResolvedPathLock);
+	ResolvedPaths.erase(std::basic_string<fschar_t>(filename.c_str(), filename.size()));
+}
+
+
+//! check the file on disk without the archives
+bool CFileSystem::existDiskFile(const io::path& filename) const
+{
 #if defined(_IRR_WINDOW_UNIVERSAL_PLATFORM_) || defined(_IRR_WEBASM_PLATFORM_)
 	FILE *file = fopen(filename.c_str(), "rb");
 	if (file == NULL)
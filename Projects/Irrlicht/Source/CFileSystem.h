@@ -8,6 +8,10 @@
 #include "IFileSystem.h"
 #include "irrArray.h"
 
+#include <string>
+#include <unordered_map>
+#include <mutex>
+
 namespace irr
 {
 namespace io
@@ -127,6 +131,15 @@ public:
 	//! determines if a file exists and would be able to be opened.
 	virtual bool existFile(const io::path& filename) const _IRR_OVERRIDE_;
 
+	//! Clears the cache of resolved file names.
+	virtual void clearPathCache() _IRR_OVERRIDE_;
+
+	//! Get the number of file name lookups answered by the cache.
+	virtual u32 getPathCacheHit() const _IRR_OVERRIDE_;
+
+	//! Get the number of file name lookups that had to search archives and disk.
+	virtual u32 getPathCacheMiss() const _IRR_OVERRIDE_;
+
 	//! Creates a XML Reader from a file.
 	virtual IXMLReader* createXMLReader(const io::path& filename) _IRR_OVERRIDE_;
 
@@ -150,6 +163,29 @@ public:
 
 private:
 
+	enum E_RESOLVED_PATH
+	{
+		ERP_NOT_FOUND = -2,
+		ERP_DISK = -1
+	};
+
+	//! Where a file name was found: an archive index with the file index in it,
+	//! ERP_DISK or ERP_NOT_FOUND
+	struct SResolvedPath
+	{
+		s32 Archive;
+		s32 Index;
+	};
+
+	//! find the file in the archives and on disk, the result is cached
+	SResolvedPath resolvePath(const io::path& filename) const;
+
+	//! forget a cached file name
+	void invalidatePath(const io::path& filename) const;
+
+	//! check the file on disk without the archives
+	bool existDiskFile(const io::path& filename) const;
+
 	// don't expose, needs refactoring
 	bool changeArchivePassword(const path& filename,
 			const core::stringc& password,
@@ -163,6 +199,12 @@ private:
 	core::array<IArchiveLoader*> ArchiveLoader;
 	//! currently attached Archives
 	core::array<IFileArchive*> FileArchives;
+
+	//! resolved file names, keyed by the name as it is requested
+	mutable std::unordered_map<std::basic_string<fschar_t>, SResolvedPath> ResolvedPaths;
+	mutable std::mutex ResolvedPathLock;
+	mutable u32 PathCacheHit;
+	mutable u32 PathCacheMiss;
 };
 
 
@@ -0,0 +1,739 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+#include "pch.h"
+#include "CBVHBuilder.h"
+
+#include "Thread/CJobSystem.h"
+#include "Utils/CSIMDUtils.h"
+#include "Debug/CSceneDebug.h"
+
+#include <algorithm>
+
+#define BVH_NUM_BINS 16
+#define BVH_MAX_LEAF_POLYS 8
+#define BVH_MAX_DEPTH 60
+#define BVH_STACK_SIZE 128
+#define BVH_PARALLEL_BUILD_POLYS 16384
+#define BVH_DEBUG_DEPTH 8
+
+namespace Skylicht
+{
+	struct SBVHBin
+	{
+		f32 Min[3];
+		f32 Max[3];
+		u32 Count;
+	};
+
+	inline void resetBVHBin(SBVHBin& bin)
+	{
+		for (int a = 0; a < 3; a++)
+		{
+			bin.Min[a] = FLT_MAX;
+			bin.Max[a] = -FLT_MAX;
+		}
+		bin.Count = 0;
+	}
+
+	// min_/max_ instead of aabbox3df::addInternalBox, that have no branch
+	inline void addBVHBin(SBVHBin& bin, const f32* min, const f32* max)
+	{
+		for (int a = 0; a < 3; a++)
+		{
+			bin.Min[a] = core::min_(bin.Min[a], min[a]);
+			bin.Max[a] = core::max_(bin.Max[a], max[a]);
+		}
+	}
+
+	inline f32 getBVHBinArea(const SBVHBin& bin)
+	{
+		f32 x = bin.Max[0] - bin.Min[0];
+		f32 y = bin.Max[1] - bin.Min[1];
+		f32 z = bin.Max[2] - bin.Min[2];
+		return x * y + y * z + z * x;
+	}
+
+	inline f32 getBVHCenter(const SBVHBuildRef& ref, int axis)
+	{
+		return ((&ref.Box.MinEdge.X)[axis] + (&ref.Box.MaxEdge.X)[axis]) * 0.5f;
+	}
+
+	inline int getBVHBin(const SBVHBuildRef& ref, int axis, f32 minCenter, f32 scale)
+	{
+		int bin = (int)((getBVHCenter(ref, axis) - minCenter) * scale);
+		return core::clamp(bin, 0, BVH_NUM_BINS - 1);
+	}
+
+	inline void getBVHInvDir(const core::vector3df& dir, f32* invDir)
+	{
+		// avoid inf * 0 = nan on the slab test
+		invDir[0] = dir.X != 0.0f ? 1.0f / dir.X : 1e30f;
+		invDir[1] = dir.Y != 0.0f ? 1.0f / dir.Y : 1e30f;
+		invDir[2] = dir.Z != 0.0f ? 1.0f / dir.Z : 1e30f;
+	}
+
+	inline bool intersectBVHBox(const core::aabbox3df& box, const core::vector3df& origin, const f32* invDir, f32 maxT, f32& tNear)
+	{
+		f32 tMin = 0.0f;
+		f32 tMax = maxT;
+
+		for (int a = 0; a < 3; a++)
+		{
+			f32 t1 = ((&box.MinEdge.X)[a] - (&origin.X)[a]) * invDir[a];
+			f32 t2 = ((&box.MaxEdge.X)[a] - (&origin.X)[a]) * invDir[a];
+
+			tMin = core::max_(tMin, core::min_(t1, t2));
+			tMax = core::min_(tMax, core::max_(t1, t2));
+		}
+
+		tNear = tMin;
+		return tMin <= tMax;
+	}
+
+	CBVHBuilder::CBVHBuilder() :
+		m_numPoly(0),
+		m_buildNodeCount(0)
+	{
+
+	}
+
+	CBVHBuilder::~CBVHBuilder()
+	{
+		clear();
+	}
+
+	void CBVHBuilder::clear()
+	{
+		m_bvhNodes.clear();
+		m_bvhTriangles.clear();
+
+		for (int i = 0; i < 9; i++)
+			m_triangleData[i].clear();
+
+		m_numPoly = 0;
+
+		CCollisionBuilder::clear();
+	}
+
+	void CBVHBuilder::build()
+	{
+		const u32 start = os::Timer::getRealTime();
+
+		CCollisionNode** nodes = m_nodes.pointer();
+
+		// step 1: update transform and triangles
+		System::CJobSystem::getInstance()->parallelFor((int)m_nodes.size(), 1, [nodes](int begin, int end)
+			{
+				for (int i = begin; i < end; i++)
+					nodes[i]->updateTransform();
+			});
+
+		buildBVH();
+
+		c8 tmp[256];
+		sprintf(tmp, "Needed %ums to CBVHBuilder::build (%u polys, %u nodes)", os::Timer::getRealTime() - start, m_numPoly, m_bvhNodes.size());
+		os::Printer::log(tmp, ELL_INFORMATION);
+	}
+
+	void CBVHBuilder::buildBVH()
+	{
+		System::CJobSystem* jobSystem = System::CJobSystem::getInstance();
+
+		u32 numNode = m_nodes.size();
+		CCollisionNode** nodes = m_nodes.pointer();
+
+		core::array<u32> offset;
+		offset.set_used(numNode);
+
+		m_numPoly = 0;
+		for (u32 i = 0; i < numNode; i++)
+		{
+			offset[i] = m_numPoly;
+			m_numPoly += nodes[i]->Triangles.size();
+		}
+
+		m_bvhNodes.set_used(0);
+		m_bvhTriangles.set_used(0);
+		for (int i = 0; i < 9; i++)
+			m_triangleData[i].set_used(0);
+
+		if (m_numPoly > 0)
+		{
+			// step 1: bbox & center of triangles
+			core::array<SBVHTriangle> triangles;
+			triangles.set_used(m_numPoly);
+
+			m_buildRefs.set_used(m_numPoly);
+
+			SBVHTriangle* tris = triangles.pointer();
+			SBVHBuildRef* refs = m_buildRefs.pointer();
+			u32* offsets = offset.pointer();
+
+			jobSystem->parallelFor((int)numNode, 1, [nodes, offsets, tris, refs](int begin, int end)
+				{
+					for (int i = begin; i < end; i++)
+					{
+						CCollisionNode* node = nodes[i];
+						core::triangle3df* triangle = node->Triangles.pointer();
+
+						for (u32 j = 0, n = node->Triangles.size(); j < n; j++)
+						{
+							u32 id = offsets[i] + j;
+
+							refs[id].Box.reset(triangle[j].pointA);
+							refs[id].Box.addInternalPoint(triangle[j].pointB);
+							refs[id].Box.addInternalPoint(triangle[j].pointC);
+							refs[id].ID = id;
+
+							tris[id].Node = node;
+							tris[id].ID = j;
+						}
+					}
+				});
+
+			// step 2: build the nodes (a binary tree with N leafs has 2N - 1 nodes)
+			m_bvhNodes.set_used(m_numPoly * 2 - 1);
+			m_buildNodeCount = 1;
+
+			buildNode(0, 0, m_numPoly, 0);
+
+			m_bvhNodes.set_used(m_buildNodeCount);
+
+			// step 3: sort triangles in the leaf order
+			m_bvhTriangles.set_used(m_numPoly);
+			for (int i = 0; i < 9; i++)
+				m_triangleData[i].set_used(m_numPoly);
+
+			SBVHTriangle* leafTris = m_bvhTriangles.pointer();
+
+			f32* data[9];
+			for (int i = 0; i < 9; i++)
+				data[i] = m_triangleData[i].pointer();
+
+			jobSystem->parallelFor((int)m_numPoly, 4096, [tris, leafTris, refs, &data](int begin, int end)
+				{
+					for (int i = begin; i < end; i++)
+					{
+						const SBVHTriangle& t = tris[refs[i].ID];
+						const core::triangle3df& triangle = t.Node->Triangles[t.ID];
+
+						leafTris[i] = t;
+
+						core::vector3df e1 = triangle.pointB - triangle.pointA;
+						core::vector3df e2 = triangle.pointC - triangle.pointA;
+
+						data[0][i] = triangle.pointA.X;
+						data[1][i] = triangle.pointA.Y;
+						data[2][i] = triangle.pointA.Z;
+						data[3][i] = e1.X;
+						data[4][i] = e1.Y;
+						data[5][i] = e1.Z;
+						data[6][i] = e2.X;
+						data[7][i] = e2.Y;
+						data[8][i] = e2.Z;
+					}
+				});
+
+			m_buildRefs.clear();
+		}
+	}
+
+	void CBVHBuilder::buildNode(u32 nodeId, u32 begin, u32 end, u32 depth)
+	{
+		SBVHNode& node = m_bvhNodes[nodeId];
+
+		SBVHBuildRef* refs = m_buildRefs.pointer();
+
+		// bounds of the triangles and their centers
+		SBVHBin bounds, centerBounds;
+		resetBVHBin(bounds);
+		resetBVHBin(centerBounds);
+
+		f32 center[3];
+
+		for (u32 i = begin; i < end; i++)
+		{
+			const SBVHBuildRef& ref = refs[i];
+			addBVHBin(bounds, &ref.Box.MinEdge.X, &ref.Box.MaxEdge.X);
+
+			for (int a = 0; a < 3; a++)
+				center[a] = getBVHCenter(ref, a);
+			addBVHBin(centerBounds, center, center);
+		}
+
+		node.Box.MinEdge.set(bounds.Min[0], bounds.Min[1], bounds.Min[2]);
+		node.Box.MaxEdge.set(bounds.Max[0], bounds.Max[1], bounds.Max[2]);
+
+		u32 count = end - begin;
+		if (count <= BVH_MAX_LEAF_POLYS)
+		{
+			node.First = begin;
+			node.Count = count;
+			return;
+		}
+
+		u32 mid = begin;
+		if (depth < BVH_MAX_DEPTH)
+			mid = splitSAH(begin, end, centerBounds.Min, centerBounds.Max);
+
+		// the centers are in the same bin or the tree is too deep
+		if (mid == begin || mid == end)
+			mid = splitMedian(begin, end, centerBounds.Min, centerBounds.Max);
+
+		u32 child = m_buildNodeCount.fetch_add(2);
+		node.First = child;
+		node.Count = 0;
+
+		if (count > BVH_PARALLEL_BUILD_POLYS)
+		{
+			System::CJobSystem* jobSystem = System::CJobSystem::getInstance();
+			System::CJobGroup group;
+
+			jobSystem->run([this, child, begin, mid, depth]()
+				{
+					buildNode(child, begin, mid, depth + 1);
+				}, &group);
+
+			buildNode(child + 1, mid, end, depth + 1);
+
+			jobSystem->wait(&group);
+		}
+		else
+		{
+			buildNode(child, begin, mid, depth + 1);
+			buildNode(child + 1, mid, end, depth + 1);
+		}
+	}
+
+	u32 CBVHBuilder::splitSAH(u32 begin, u32 end, const f32* centerMin, const f32* centerMax)
+	{
+		SBVHBuildRef* refs = m_buildRefs.pointer();
+
+		// bin on the longest axis of centers only, that is 3 times faster than 3 axis and the tree is nearly the same
+		int axis = 0;
+		for (int a = 1; a < 3; a++)
+		{
+			if (centerMax[a] - centerMin[a] > centerMax[axis] - centerMin[axis])
+				axis = a;
+		}
+
+		f32 extent = centerMax[axis] - centerMin[axis];
+		if (extent <= 1e-6f)
+			return begin;
+
+		f32 minCenter = centerMin[axis];
+		f32 scale = BVH_NUM_BINS / extent;
+
+		SBVHBin bins[BVH_NUM_BINS];
+		for (int b = 0; b < BVH_NUM_BINS; b++)
+			resetBVHBin(bins[b]);
+
+		for (u32 i = begin; i < end; i++)
+		{
+			const SBVHBuildRef& ref = refs[i];
+
+			SBVHBin& bin = bins[getBVHBin(ref, axis, minCenter, scale)];
+			addBVHBin(bin, &ref.Box.MinEdge.X, &ref.Box.MaxEdge.X);
+			bin.Count++;
+		}
+
+		// sweep from the right
+		f32 rightArea[BVH_NUM_BINS];
+		u32 rightCount[BVH_NUM_BINS];
+
+		SBVHBin sweep;
+		resetBVHBin(sweep);
+
+		for (int b = BVH_NUM_BINS - 1; b > 0; b--)
+		{
+			addBVHBin(sweep, bins[b].Min, bins[b].Max);
+			sweep.Count += bins[b].Count;
+
+			rightArea[b] = sweep.Count > 0 ? getBVHBinArea(sweep) : 0.0f;
+			rightCount[b] = sweep.Count;
+		}
+
+		// sweep from the left and find the lowest cost
+		f32 bestCost = 0.0f;
+		int bestBin = -1;
+
+		resetBVHBin(sweep);
+
+		for (int b = 0; b < BVH_NUM_BINS - 1; b++)
+		{
+			addBVHBin(sweep, bins[b].Min, bins[b].Max);
+			sweep.Count += bins[b].Count;
+
+			if (sweep.Count == 0 || rightCount[b + 1] == 0)
+				continue;
+
+			f32 cost = getBVHBinArea(sweep) * sweep.Count + rightArea[b + 1] * rightCount[b + 1];
+			if (bestBin < 0 || cost < bestCost)
+			{
+				bestCost = cost;
+				bestBin = b + 1;
+			}
+		}
+
+		if (bestBin < 0)
+			return begin;
+
+		// split plane of the best bin, compare min + max to skip the * 0.5
+		f32 split = (minCenter + bestBin / scale) * 2.0f;
+
+		SBVHBuildRef* mid = std::partition(refs + begin, refs + end, [axis, split](const SBVHBuildRef& ref)
+			{
+				return (&ref.Box.MinEdge.X)[axis] + (&ref.Box.MaxEdge.X)[axis] < split;
+			});
+
+		return (u32)(mid - refs);
+	}
+
+	u32 CBVHBuilder::splitMedian(u32 begin, u32 end, const f32* centerMin, const f32* centerMax)
+	{
+		SBVHBuildRef* refs = m_buildRefs.pointer();
+
+		// the longest axis of centers
+		int axis = 0;
+		for (int a = 1; a < 3; a++)
+		{
+			if (centerMax[a] - centerMin[a] > centerMax[axis] - centerMin[axis])
+				axis = a;
+		}
+
+		u32 mid = begin + (end - begin) / 2;
+
+		std::nth_element(refs + begin, refs + mid, refs + end, [axis](const SBVHBuildRef& a, const SBVHBuildRef& b)
+			{
+				return getBVHCenter(a, axis) < getBVHCenter(b, axis);
+			});
+
+		return mid;
+	}
+
+	void CBVHBuilder::drawDebug()
+	{
+		if (m_bvhNodes.size() == 0)
+			return;
+
+		CSceneDebug* debug = CSceneDebug::getInstance();
+
+		u32 stack[BVH_STACK_SIZE];
+		u32 level[BVH_STACK_SIZE];
+		int top = 0;
+
+		stack[top] = 0;
+		level[top] = 0;
+		top++;
+
+		while (top > 0)
+		{
+			top--;
+
+			const SBVHNode& node = m_bvhNodes[stack[top]];
+			u32 nodeLevel = level[top];
+
+			debug->addBoudingBox(node.Box, SColor(255, 255, 0, 0));
+
+			if (node.Count == 0 && nodeLevel < BVH_DEBUG_DEPTH)
+			{
+				stack[top] = node.First;
+				level[top] = nodeLevel + 1;
+				top++;
+
+				stack[top] = node.First + 1;
+				level[top] = nodeLevel + 1;
+				top++;
+			}
+		}
+	}
+
+	bool CBVHBuilder::getCollisionPoint(
+		const core::line3d<f32>& ray,
+		f32& outBestDistanceSquared,
+		core::vector3df& outIntersection,
+		core::triangle3df& outTriangle,
+		CCollisionNode*& outNode)
+	{
+		outNode = NULL;
+
+		if (m_bvhNodes.size() == 0)
+			return false;
+
+		// t in [0, 1] from ray.start to ray.end
+		core::vector3df dir = ray.end - ray.start;
+
+		f32 length = dir.getLength();
+		if (length <= 0.0f)
+			return false;
+
+		f32 t = core::min_(1.0f, sqrtf(outBestDistanceSquared) / length);
+
+		f32 invDir[3];
+		getBVHInvDir(dir, invDir);
+
+		const SBVHNode* nodes = m_bvhNodes.const_pointer();
+
+		const f32* triangle[9];
+		u32 stack[BVH_STACK_SIZE];
+		int top = 0;
+		int best = -1;
+
+		f32 tNear, tNear1;
+		if (!intersectBVHBox(nodes[0].Box, ray.start, invDir, t, tNear))
+			return false;
+
+		stack[top++] = 0;
+
+		while (top > 0)
+		{
+			const SBVHNode& node = nodes[stack[--top]];
+
+			if (node.Count > 0)
+			{
+				for (int i = 0; i < 9; i++)
+					triangle[i] = m_triangleData[i].const_pointer() + node.First;
+
+				int id = CSIMDUtils::intersectRayTriangles(ray.start, dir, triangle, (int)node.Count, t);
+				if (id >= 0)
+					best = (int)node.First + id;
+			}
+			else
+			{
+				bool hit = intersectBVHBox(nodes[node.First].Box, ray.start, invDir, t, tNear);
+				bool hit1 = intersectBVHBox(nodes[node.First + 1].Box, ray.start, invDir, t, tNear1);
+
+				// push the far child first, so the near child is tested first
+				if (hit && hit1)
+				{
+					if (tNear < tNear1)
+					{
+						stack[top++] = node.First + 1;
+						stack[top++] = node.First;
+					}
+					else
+					{
+						stack[top++] = node.First;
+						stack[top++] = node.First + 1;
+					}
+				}
+				else if (hit)
+					stack[top++] = node.First;
+				else if (hit1)
+					stack[top++] = node.First + 1;
+			}
+		}
+
+		if (best < 0)
+			return false;
+
+		const SBVHTriangle& result = m_bvhTriangles[best];
+
+		outIntersection = ray.start + dir * t;
+		outBestDistanceSquared = outIntersection.getDistanceFromSQ(ray.start);
+		outTriangle = result.Node->Triangles[result.ID];
+		outNode = result.Node;
+		return true;
+	}
+
+	void CBVHBuilder::getCollisionPoints(const core::line3df* rays, int count, SCollisionHit* hits)
+	{
+		// the packet is 4 rays, that is the SSE/NEON width
+		int numPacket = (count + 3) / 4;
+
+		System::CJobSystem::getInstance()->parallelFor(numPacket, 16, [this, rays, count, hits](int begin, int end)
+			{
+				for (int i = begin; i < end; i++)
+				{
+					int first = i * 4;
+					getCollisionPacket(rays + first, core::min_(4, count - first), hits + first);
+				}
+			});
+	}
+
+	void CBVHBuilder::getCollisionPacket(const core::line3df* rays, int count, SCollisionHit* hits)
+	{
+		f32 origin[3][4];
+		f32 dir[3][4];
+		f32 invDir[3][4];
+		f32 maxT[4];
+		int best[4];
+
+		for (int r = 0; r < 4; r++)
+		{
+			core::vector3df o, d;
+			maxT[r] = -1.0f;
+			best[r] = -1;
+
+			if (r < count)
+			{
+				o = rays[r].start;
+				d = rays[r].end - rays[r].start;
+
+				// the ray that has no length never hits
+				if (d.getLengthSQ() > 0.0f)
+					maxT[r] = 1.0f;
+			}
+
+			f32 inv[3];
+			getBVHInvDir(d, inv);
+
+			for (int a = 0; a < 3; a++)
+			{
+				origin[a][r] = (&o.X)[a];
+				dir[a][r] = (&d.X)[a];
+				invDir[a][r] = inv[a];
+			}
+		}
+
+		if (m_bvhNodes.size() > 0)
+		{
+			const f32* o[3] = { origin[0], origin[1], origin[2] };
+			const f32* d[3] = { dir[0], dir[1], dir[2] };
+			const f32* inv[3] = { invDir[0], invDir[1], invDir[2] };
+			const f32* triangle[9];
+
+			for (int i = 0; i < 9; i++)
+				triangle[i] = m_triangleData[i].const_pointer();
+
+			const SBVHNode* nodes = m_bvhNodes.const_pointer();
+			core::vector3df order(dir[0][0], dir[1][0], dir[2][0]);
+
+			u32 stack[BVH_STACK_SIZE];
+			int top = 0;
+
+			stack[top++] = 0;
+
+			while (top > 0)
+			{
+				const SBVHNode& node = nodes[stack[--top]];
+
+				if (CSIMDUtils::intersectRayPacketBox(o, inv, maxT, node.Box) == 0)
+					continue;
+
+				if (node.Count > 0)
+				{
+					for (u32 i = node.First, n = node.First + node.Count; i < n; i++)
+					{
+						int mask = CSIMDUtils::intersectRayPacketTriangle(o, d, triangle, (int)i, maxT);
+						if (mask == 0)
+							continue;
+
+						for (int r = 0; r < 4; r++)
+						{
+							if (mask & (1 << r))
+								best[r] = (int)i;
+						}
+					}
+				}
+				else
+				{
+					// the near child of the first ray is tested first
+					core::vector3df v = nodes[node.First + 1].Box.getCenter() - nodes[node.First].Box.getCenter();
+					if (v.dotProduct(order) > 0.0f)
+					{
+						stack[top++] = node.First + 1;
+						stack[top++] = node.First;
+					}
+					else
+					{
+						stack[top++] = node.First;
+						stack[top++] = node.First + 1;
+					}
+				}
+			}
+		}
+
+		for (int r = 0; r < count; r++)
+		{
+			SCollisionHit& hit = hits[r];
+
+			if (best[r] >= 0)
+			{
+				const SBVHTriangle& result = m_bvhTriangles[best[r]];
+
+				hit.Hit = true;
+				hit.Intersection = rays[r].start + (rays[r].end - rays[r].start) * maxT[r];
+				hit.DistanceSquared = hit.Intersection.getDistanceFromSQ(rays[r].start);
+				hit.Triangle = result.Node->Triangles[result.ID];
+				hit.Node = result.Node;
+			}
+			else
+			{
+				hit.Hit = false;
+				hit.DistanceSquared = rays[r].getLengthSQ();
+				hit.Node = NULL;
+			}
+		}
+	}
+
+	void CBVHBuilder::getTriangles(const core::aabbox3df& box,
+		core::array<core::triangle3df*>& result,
+		core::array<CCollisionNode*>& nodes)
+	{
+		if (m_bvhNodes.size() == 0)
+			return;
+
+		const SBVHNode* bvhNodes = m_bvhNodes.const_pointer();
+
+		const f32* triangle[9];
+		bool overlap[BVH_MAX_LEAF_POLYS];
+
+		u32 stack[BVH_STACK_SIZE];
+		int top = 0;
+
+		stack[top++] = 0;
+
+		while (top > 0)
+		{
+			const SBVHNode& node = bvhNodes[stack[--top]];
+
+			if (!node.Box.intersectsWithBox(box))
+				continue;
+
+			if (node.Count > 0)
+			{
+				for (int i = 0; i < 9; i++)
+					triangle[i] = m_triangleData[i].const_pointer() + node.First;
+
+				CSIMDUtils::overlapBoxTriangles(box, triangle, (int)node.Count, overlap);
+
+				for (u32 i = 0; i < node.Count; i++)
+				{
+					if (overlap[i])
+					{
+						const SBVHTriangle& t = m_bvhTriangles[node.First + i];
+						result.push_back(&t.Node->Triangles[t.ID]);
+						nodes.push_back(t.Node);
+					}
+				}
+			}
+			else
+			{
+				stack[top++] = node.First;
+				stack[top++] = node.First + 1;
+			}
+		}
+	}
+}
\ No newline at end of file
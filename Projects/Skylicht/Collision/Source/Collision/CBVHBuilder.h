@@ -0,0 +1,123 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+#pragma once
+
+#include "CCollisionBuilder.h"
+
+#include <atomic>
+
+namespace Skylicht
+{
+	/// @brief Node of the flattened BVH. A leaf has Count > 0 and owns the triangles [First, First + Count),
+	/// an inner node has Count = 0 and its children are First and First + 1
+	struct SBVHNode
+	{
+		core::aabbox3df Box;
+		u32 First;
+		u32 Count;
+	};
+
+	/// @brief The triangle in the leaf order of the BVH
+	struct SBVHTriangle
+	{
+		CCollisionNode* Node;
+		u32 ID;
+	};
+
+	/// @brief The triangle bbox that is sorted while build the BVH
+	struct SBVHBuildRef
+	{
+		core::aabbox3df Box;
+		u32 ID;
+	};
+
+	/// @brief Collision builder that uses a binned SAH bounding volume hierarchy.
+	/// The build runs on the job system and the queries test 4 triangles (or 4 rays) at once with CSIMDUtils.
+	/// The queries are thread-safe, they can be called on many threads after build()
+	class CBVHBuilder : public CCollisionBuilder
+	{
+	protected:
+		core::array<SBVHNode> m_bvhNodes;
+
+		core::array<SBVHTriangle> m_bvhTriangles;
+
+		// SoA of triangles in leaf order: v0 xyz, e1 xyz, e2 xyz
+		core::array<f32> m_triangleData[9];
+
+		u32 m_numPoly;
+
+		// temp data for build
+		core::array<SBVHBuildRef> m_buildRefs;
+		std::atomic<u32> m_buildNodeCount;
+
+	public:
+		CBVHBuilder();
+
+		virtual ~CBVHBuilder();
+
+		virtual void build();
+
+		/// @brief Build the BVH with the current triangles of the nodes, without updateTransform
+		void buildBVH();
+
+		virtual void clear();
+
+		virtual void drawDebug();
+
+		inline u32 getNodeCount()
+		{
+			return m_bvhNodes.size();
+		}
+
+		inline u32 getPolyCount()
+		{
+			return m_numPoly;
+		}
+
+	public:
+
+		virtual bool getCollisionPoint(
+			const core::line3d<f32>& ray,
+			f32& outBestDistanceSquared,
+			core::vector3df& outIntersection,
+			core::triangle3df& outTriangle,
+			CCollisionNode*& outNode);
+
+		virtual void getCollisionPoints(const core::line3df* rays, int count, SCollisionHit* hits);
+
+		virtual void getTriangles(const core::aabbox3df& box,
+			core::array<core::triangle3df*>& result,
+			core::array<CCollisionNode*>& nodes);
+
+	protected:
+
+		void buildNode(u32 nodeId, u32 begin, u32 end, u32 depth);
+
+		u32 splitSAH(u32 begin, u32 end, const f32* centerMin, const f32* centerMax);
+
+		u32 splitMedian(u32 begin, u32 end, const f32* centerMin, const f32* centerMax);
+
+		void getCollisionPacket(const core::line3df* rays, int count, SCollisionHit* hits);
+	};
+}
\ No newline at end of file
@@ -39,6 +39,11 @@ namespace Skylicht
 
 	}
 
+	void CCollisionBuilder::addCollision(CCollisionNode* node)
+	{
+		m_nodes.push_back(node);
+	}
+
 	void CCollisionBuilder::removeCollision(CGameObject* object)
 	{
 		for (u32 i = 0, n = m_nodes.size(); i < n; i++)
@@ -51,12 +56,14 @@ namespace Skylicht
 					CCollisionNode* t = m_nodes[n - 1];
 					m_nodes[n - 1] = m_nodes[i];
 					m_nodes[i] = t;
+					onRemoveNode(m_nodes[n - 1]);
 					delete m_nodes[n - 1];
 					m_nodes.erase(n - 1);
 					return;
 				}
 				else
 				{
+					onRemoveNode(m_nodes[i]);
 					delete m_nodes[i];
 					m_nodes.erase(i);
 					return;
@@ -80,12 +87,14 @@ namespace Skylicht
 					CCollisionNode* t = m_nodes[n - 1];
 					m_nodes[n - 1] = m_nodes[i];
 					m_nodes[i] = t;
+					onRemoveNode(m_nodes[n - 1]);
 					delete m_nodes[n - 1];
 					m_nodes.erase(n - 1);
 					return;
 				}
 				else
 				{
+					onRemoveNode(m_nodes[i]);
 					delete m_nodes[i];
 					m_nodes.erase(i);
 					return;
@@ -142,4 +151,15 @@ namespace Skylicht
 		float outBestDistanceSquared = ray.getLengthSQ();
 		return getCollisionPoint(ray, outBestDistanceSquared, outIntersection, outTriangle, outNode);
 	}
+
+	void CCollisionBuilder::getCollisionPoints(const core::line3df* rays, int count, SCollisionHit* hits)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			SCollisionHit& hit = hits[i];
+			hit.DistanceSquared = rays[i].getLengthSQ();
+			hit.Node = NULL;
+			hit.Hit = getCollisionPoint(rays[i], hit.DistanceSquared, hit.Intersection, hit.Triangle, hit.Node);
+		}
+	}
 }
\ No newline at end of file
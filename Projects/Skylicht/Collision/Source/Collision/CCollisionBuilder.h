@@ -28,16 +28,32 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
+	/// @brief Result of a ray in CCollisionBuilder::getCollisionPoints
+	struct SCollisionHit
+	{
+		bool Hit;
+		f32 DistanceSquared;
+		core::vector3df Intersection;
+		core::triangle3df Triangle;
+		CCollisionNode* Node;
+	};
+
 	class CCollisionBuilder
 	{
 	protected:
 		core::array<CCollisionNode*> m_nodes;
 
+		// the node will be deleted by removeCollision
+		virtual void onRemoveNode(CCollisionNode* node) {}
+
 	public:
 		CCollisionBuilder();
 
 		virtual ~CCollisionBuilder();
 
+		// remember build() after the add
+		void addCollision(CCollisionNode* node);
+
 		// remember build() after the remove
 		void removeCollision(CGameObject* object);
 
@@ -73,6 +89,9 @@ namespace Skylicht
 			core::triangle3df& outTriangle,
 			CCollisionNode*& outNode) = 0;
 
+		/// @brief Find the nearest hit of many rays (from ray.start to ray.end), hits[i] is the result of rays[i]
+		virtual void getCollisionPoints(const core::line3df* rays, int count, SCollisionHit* hits);
+
 		virtual void getTriangles(const core::aabbox3df& box,
 			core::array<core::triangle3df*>& result,
 			core::array<CCollisionNode*>& nodes) = 0;
@@ -43,42 +43,121 @@ namespace Skylicht
 	}
 
 	bool CCollisionManager::addMeshCollision(CGameObject* gameObject)
+	{
+		return addCollision(gameObject, false, this);
+	}
+
+	bool CCollisionManager::addBBoxCollision(CGameObject* gameObject)
+	{
+		return addCollision(gameObject, true, this);
+	}
+
+	bool CCollisionManager::addDynamicMeshCollision(CGameObject* gameObject)
+	{
+		return addCollision(gameObject, false, &m_dynamicCollision);
+	}
+
+	bool CCollisionManager::addDynamicBBoxCollision(CGameObject* gameObject)
+	{
+		return addCollision(gameObject, true, &m_dynamicCollision);
+	}
+
+	bool CCollisionManager::addCollision(CGameObject* gameObject, bool bbox, CCollisionBuilder* builder)
 	{
 		CRenderMesh* renderMesh = gameObject->getComponent<CRenderMesh>();
 		if (renderMesh == NULL)
 			return false;
 
-		CEntityManager* entityMgr = gameObject->getEntityManager();
-
 		std::vector<CRenderMeshData*>& renderers = renderMesh->getRenderers();
 		for (CRenderMeshData* renderMesh : renderers)
 		{
 			CEntity* entity = renderMesh->Entity;
-			m_nodes.push_back(
-				new CCollisionNode(gameObject, entity, new CMeshTriangleSelector(entity))
-			);
+
+			CTriangleSelector* selector = NULL;
+			if (bbox)
+				selector = new CBBTriangleSelector(entity);
+			else
+				selector = new CMeshTriangleSelector(entity);
+
+			builder->addCollision(new CCollisionNode(gameObject, entity, selector));
 		}
 
 		return renderers.size() > 0;
 	}
 
-	bool CCollisionManager::addBBoxCollision(CGameObject* gameObject)
+	void CCollisionManager::removeDynamicCollision(CGameObject* gameObject)
 	{
-		CRenderMesh* renderMesh = gameObject->getComponent<CRenderMesh>();
-		if (renderMesh == NULL)
-			return false;
+		m_dynamicCollision.removeCollision(gameObject);
+	}
 
-		CEntityManager* entityMgr = gameObject->getEntityManager();
+	u32 CCollisionManager::updateDynamicCollision()
+	{
+		return m_dynamicCollision.update();
+	}
 
-		std::vector<CRenderMeshData*>& renderers = renderMesh->getRenderers();
-		for (CRenderMeshData* renderMesh : renderers)
+	void CCollisionManager::build()
+	{
+		CBVHBuilder::build();
+		m_dynamicCollision.build();
+	}
+
+	void CCollisionManager::clear()
+	{
+		m_dynamicCollision.clear();
+		CBVHBuilder::clear();
+	}
+
+	void CCollisionManager::drawDebug()
+	{
+		CBVHBuilder::drawDebug();
+		m_dynamicCollision.drawDebug();
+	}
+
+	bool CCollisionManager::getCollisionPoint(
+		const core::line3d<f32>& ray,
+		f32& outBestDistanceSquared,
+		core::vector3df& outIntersection,
+		core::triangle3df& outTriangle,
+		CCollisionNode*& outNode)
+	{
+		bool found = CBVHBuilder::getCollisionPoint(ray, outBestDistanceSquared, outIntersection, outTriangle, outNode);
+
+		// the dynamic objects that are nearer
+		CCollisionNode* dynamicNode = NULL;
+		if (m_dynamicCollision.getCollisionPoint(ray, outBestDistanceSquared, outIntersection, outTriangle, dynamicNode))
 		{
-			CEntity* entity = renderMesh->Entity;
-			m_nodes.push_back(
-				new CCollisionNode(gameObject, entity, new CBBTriangleSelector(entity))
-			);
+			outNode = dynamicNode;
+			found = true;
 		}
 
-		return renderers.size() > 0;
+		return found;
+	}
+
+	void CCollisionManager::getCollisionPoints(const core::line3df* rays, int count, SCollisionHit* hits)
+	{
+		CBVHBuilder::getCollisionPoints(rays, count, hits);
+
+		if (m_dynamicCollision.getDynamicCount() == 0)
+			return;
+
+		for (int i = 0; i < count; i++)
+		{
+			SCollisionHit& hit = hits[i];
+
+			CCollisionNode* dynamicNode = NULL;
+			if (m_dynamicCollision.getCollisionPoint(rays[i], hit.DistanceSquared, hit.Intersection, hit.Triangle, dynamicNode))
+			{
+				hit.Node = dynamicNode;
+				hit.Hit = true;
+			}
+		}
+	}
+
+	void CCollisionManager::getTriangles(const core::aabbox3df& box,
+		core::array<core::triangle3df*>& result,
+		core::array<CCollisionNode*>& nodes)
+	{
+		CBVHBuilder::getTriangles(box, result, nodes);
+		m_dynamicCollision.getTriangles(box, result, nodes);
 	}
 }
\ No newline at end of file
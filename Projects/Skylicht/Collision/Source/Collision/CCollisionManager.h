@@ -27,11 +27,16 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CCollisionNode.h"
 #include "COctreeNode.h"
 #include "COctreeBuilder.h"
+#include "CBVHBuilder.h"
+#include "CDynamicBVHBuilder.h"
 
 namespace Skylicht
 {
-	class CCollisionManager : public COctreeBuilder
+	class CCollisionManager : public CBVHBuilder
 	{
+	protected:
+		CDynamicBVHBuilder m_dynamicCollision;
+
 	public:
 		CCollisionManager();
 
@@ -40,5 +45,44 @@ namespace Skylicht
 		bool addMeshCollision(CGameObject* gameObject);
 
 		bool addBBoxCollision(CGameObject* gameObject);
+
+		/// @brief Add the moving object, call updateDynamicCollision() after it moves instead of build()
+		bool addDynamicMeshCollision(CGameObject* gameObject);
+
+		bool addDynamicBBoxCollision(CGameObject* gameObject);
+
+		// remember build() after the remove
+		void removeDynamicCollision(CGameObject* gameObject);
+
+		/// @brief Refit the dynamic objects that have moved, return the number of refitted objects
+		u32 updateDynamicCollision();
+
+		inline CDynamicBVHBuilder* getDynamicCollision()
+		{
+			return &m_dynamicCollision;
+		}
+
+		virtual void build();
+
+		virtual void clear();
+
+		virtual void drawDebug();
+
+		virtual bool getCollisionPoint(
+			const core::line3d<f32>& ray,
+			f32& outBestDistanceSquared,
+			core::vector3df& outIntersection,
+			core::triangle3df& outTriangle,
+			CCollisionNode*& outNode);
+
+		virtual void getCollisionPoints(const core::line3df* rays, int count, SCollisionHit* hits);
+
+		virtual void getTriangles(const core::aabbox3df& box,
+			core::array<core::triangle3df*>& result,
+			core::array<CCollisionNode*>& nodes);
+
+	protected:
+
+		bool addCollision(CGameObject* gameObject, bool bbox, CCollisionBuilder* builder);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,460 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+#include "pch.h"
+#include "CDynamicBVHBuilder.h"
+
+#include "Thread/CJobSystem.h"
+#include "Transform/CWorldTransformData.h"
+#include "Debug/CSceneDebug.h"
+
+#include <algorithm>
+
+#define DYNAMIC_TREE_STACK_SIZE 64
+
+namespace Skylicht
+{
+	CDynamicBVHBuilder::CDynamicBVHBuilder() :
+		m_numRefit(0)
+	{
+
+	}
+
+	CDynamicBVHBuilder::~CDynamicBVHBuilder()
+	{
+		clear();
+	}
+
+	void CDynamicBVHBuilder::clear()
+	{
+		for (u32 i = 0, n = m_dynamics.size(); i < n; i++)
+			releaseDynamic(m_dynamics[i]);
+
+		m_dynamics.clear();
+		m_dynamicIndex.clear();
+		m_tree.clear();
+
+		CCollisionBuilder::clear();
+	}
+
+	void CDynamicBVHBuilder::releaseDynamic(SDynamicCollision& dynamic)
+	{
+		// the local node is deleted by the local BVH
+		if (dynamic.LocalBVH != NULL)
+			delete dynamic.LocalBVH;
+
+		dynamic.LocalBVH = NULL;
+		dynamic.LocalNode = NULL;
+		dynamic.Node = NULL;
+	}
+
+	void CDynamicBVHBuilder::onRemoveNode(CCollisionNode* node)
+	{
+		std::map<CCollisionNode*, u32>::iterator i = m_dynamicIndex.find(node);
+		if (i != m_dynamicIndex.end())
+		{
+			// the tree still keeps the leaf until build(), the queries skip it
+			releaseDynamic(m_dynamics[i->second]);
+			m_dynamicIndex.erase(i);
+		}
+	}
+
+	void CDynamicBVHBuilder::build()
+	{
+		const u32 start = os::Timer::getRealTime();
+
+		// keep the local BVH of the nodes that are built
+		std::map<CCollisionNode*, SDynamicCollision> built;
+		for (u32 i = 0, n = m_dynamics.size(); i < n; i++)
+		{
+			if (m_dynamics[i].Node != NULL)
+				built[m_dynamics[i].Node] = m_dynamics[i];
+		}
+
+		m_dynamics.set_used(0);
+		m_dynamicIndex.clear();
+
+		core::array<SDynamicCollision*> newDynamics;
+		u32 numPoly = 0;
+
+		for (u32 i = 0, n = m_nodes.size(); i < n; i++)
+		{
+			CCollisionNode* node = m_nodes[i];
+
+			std::map<CCollisionNode*, SDynamicCollision>::iterator it = built.find(node);
+			if (it != built.end())
+			{
+				m_dynamics.push_back(it->second);
+				built.erase(it);
+			}
+			else
+			{
+				SDynamicCollision dynamic;
+				dynamic.Node = node;
+				dynamic.LocalBVH = new CBVHBuilder();
+				dynamic.LocalNode = new CCollisionNode(node->GameObject, node->Entity, NULL);
+				dynamic.Leaf = -1;
+
+				// the node that has no selector keeps its triangles as model space
+				if (node->Selector != NULL)
+					dynamic.LocalNode->Triangles = node->Selector->getLocalTriangles();
+				else
+					dynamic.LocalNode->Triangles = node->Triangles;
+
+				dynamic.LocalBVH->addCollision(dynamic.LocalNode);
+
+				m_dynamics.push_back(dynamic);
+			}
+
+			m_dynamicIndex[node] = i;
+			numPoly += m_dynamics[i].LocalNode->Triangles.size();
+		}
+
+		// the nodes are removed without removeCollision
+		for (std::map<CCollisionNode*, SDynamicCollision>::iterator it = built.begin(), end = built.end(); it != end; ++it)
+			releaseDynamic(it->second);
+
+		// step 1: build the local BVH of new nodes
+		for (u32 i = 0, n = m_dynamics.size(); i < n; i++)
+		{
+			if (m_dynamics[i].Leaf < 0)
+				newDynamics.push_back(&m_dynamics[i]);
+		}
+
+		SDynamicCollision** dynamics = newDynamics.pointer();
+
+		System::CJobSystem::getInstance()->parallelFor((int)newDynamics.size(), 1, [dynamics](int begin, int end)
+			{
+				for (int i = begin; i < end; i++)
+				{
+					SDynamicCollision* dynamic = dynamics[i];
+					dynamic->LocalBVH->buildBVH();
+
+					core::array<core::triangle3df>& triangles = dynamic->LocalNode->Triangles;
+
+					dynamic->LocalBox.reset(core::vector3df());
+					for (u32 j = 0, n = triangles.size(); j < n; j++)
+					{
+						if (j == 0)
+							dynamic->LocalBox.reset(triangles[j].pointA);
+						else
+							dynamic->LocalBox.addInternalPoint(triangles[j].pointA);
+
+						dynamic->LocalBox.addInternalPoint(triangles[j].pointB);
+						dynamic->LocalBox.addInternalPoint(triangles[j].pointC);
+					}
+				}
+			});
+
+		for (u32 i = 0, n = newDynamics.size(); i < n; i++)
+		{
+			SDynamicCollision* dynamic = newDynamics[i];
+
+			core::matrix4 world;
+			if (dynamic->Node->Entity != NULL)
+			{
+				CWorldTransformData* transform = GET_ENTITY_DATA(dynamic->Node->Entity, CWorldTransformData);
+				if (transform != NULL)
+					world = transform->World;
+			}
+
+			updateTransform(*dynamic, world);
+		}
+
+		// step 2: build the top level tree
+		m_tree.set_used(0);
+
+		int count = (int)m_dynamics.size();
+		if (count > 0)
+		{
+			core::array<int> items;
+			items.set_used(count);
+			for (int i = 0; i < count; i++)
+				items[i] = i;
+
+			m_tree.set_used(count * 2 - 1);
+
+			int used = 1;
+			buildTree(0, items.pointer(), count, -1, used);
+		}
+
+		c8 tmp[256];
+		sprintf(tmp, "Needed %ums to CDynamicBVHBuilder::build (%u nodes, %u new nodes, %u polys)", os::Timer::getRealTime() - start, m_dynamics.size(), newDynamics.size(), numPoly);
+		os::Printer::log(tmp, ELL_INFORMATION);
+	}
+
+	void CDynamicBVHBuilder::buildTree(int nodeId, int* items, int count, int parent, int& used)
+	{
+		SDynamicTreeNode& node = m_tree[nodeId];
+		node.Parent = parent;
+
+		node.Box = m_dynamics[items[0]].Box;
+		for (int i = 1; i < count; i++)
+			node.Box.addInternalBox(m_dynamics[items[i]].Box);
+
+		if (count == 1)
+		{
+			node.Child = -1;
+			node.Item = items[0];
+			m_dynamics[items[0]].Leaf = nodeId;
+			return;
+		}
+
+		// median split on the longest axis
+		core::vector3df extent = node.Box.getExtent();
+
+		int axis = 0;
+		if (extent.Y > extent.X)
+			axis = 1;
+		if (extent.Z > (&extent.X)[axis])
+			axis = 2;
+
+		int mid = count / 2;
+
+		SDynamicCollision* dynamics = m_dynamics.pointer();
+		std::nth_element(items, items + mid, items + count, [dynamics, axis](int a, int b)
+			{
+				return (&dynamics[a].Box.MinEdge.X)[axis] + (&dynamics[a].Box.MaxEdge.X)[axis] <
+					(&dynamics[b].Box.MinEdge.X)[axis] + (&dynamics[b].Box.MaxEdge.X)[axis];
+			});
+
+		int child = used;
+		used += 2;
+
+		node.Child = child;
+		node.Item = -1;
+
+		buildTree(child, items, mid, nodeId, used);
+		buildTree(child + 1, items + mid, count - mid, nodeId, used);
+	}
+
+	void CDynamicBVHBuilder::updateTransform(SDynamicCollision& dynamic, const core::matrix4& world)
+	{
+		dynamic.Transform = world;
+		world.getInverse(dynamic.InvTransform);
+
+		dynamic.Box = dynamic.LocalBox;
+		world.transformBoxEx(dynamic.Box);
+
+		// world triangles of this node only, for the query results
+		core::array<core::triangle3df>& localTriangles = dynamic.LocalNode->Triangles;
+		core::array<core::triangle3df>& triangles = dynamic.Node->Triangles;
+
+		u32 numTris = localTriangles.size();
+		triangles.set_used(numTris);
+
+		for (u32 i = 0; i < numTris; i++)
+		{
+			world.transformVect(triangles[i].pointA, localTriangles[i].pointA);
+			world.transformVect(triangles[i].pointB, localTriangles[i].pointB);
+			world.transformVect(triangles[i].pointC, localTriangles[i].pointC);
+		}
+	}
+
+	void CDynamicBVHBuilder::refit(int leaf)
+	{
+		SDynamicTreeNode& node = m_tree[leaf];
+		node.Box = m_dynamics[node.Item].Box;
+
+		int parent = node.Parent;
+		while (parent >= 0)
+		{
+			SDynamicTreeNode& p = m_tree[parent];
+			p.Box = m_tree[p.Child].Box;
+			p.Box.addInternalBox(m_tree[p.Child + 1].Box);
+			parent = p.Parent;
+		}
+	}
+
+	u32 CDynamicBVHBuilder::update()
+	{
+		m_numRefit = 0;
+
+		for (u32 i = 0, n = m_dynamics.size(); i < n; i++)
+		{
+			SDynamicCollision& dynamic = m_dynamics[i];
+			if (dynamic.Node == NULL || dynamic.Node->Entity == NULL || dynamic.Leaf < 0)
+				continue;
+
+			CWorldTransformData* transform = GET_ENTITY_DATA(dynamic.Node->Entity, CWorldTransformData);
+			if (transform != NULL && transform->World != dynamic.Transform)
+			{
+				updateTransform(dynamic, transform->World);
+				refit(dynamic.Leaf);
+				m_numRefit++;
+			}
+		}
+
+		return m_numRefit;
+	}
+
+	bool CDynamicBVHBuilder::setTransform(CCollisionNode* node, const core::matrix4& world)
+	{
+		std::map<CCollisionNode*, u32>::iterator i = m_dynamicIndex.find(node);
+		if (i == m_dynamicIndex.end())
+			return false;
+
+		SDynamicCollision& dynamic = m_dynamics[i->second];
+		if (dynamic.Leaf < 0)
+			return false;
+
+		updateTransform(dynamic, world);
+		refit(dynamic.Leaf);
+		return true;
+	}
+
+	void CDynamicBVHBuilder::drawDebug()
+	{
+		CSceneDebug* debug = CSceneDebug::getInstance();
+
+		for (u32 i = 0, n = m_tree.size(); i < n; i++)
+		{
+			if (m_tree[i].Child < 0)
+				debug->addBoudingBox(m_tree[i].Box, SColor(255, 0, 255, 0));
+			else
+				debug->addBoudingBox(m_tree[i].Box, SColor(255, 255, 0, 0));
+		}
+	}
+
+	bool CDynamicBVHBuilder::getCollisionPoint(
+		const core::line3d<f32>& ray,
+		f32& outBestDistanceSquared,
+		core::vector3df& outIntersection,
+		core::triangle3df& outTriangle,
+		CCollisionNode*& outNode)
+	{
+		outNode = NULL;
+
+		f32 length = ray.getLength();
+		if (m_tree.size() == 0 || length <= 0.0f)
+			return false;
+
+		bool found = false;
+
+		int stack[DYNAMIC_TREE_STACK_SIZE];
+		int top = 0;
+
+		stack[top++] = 0;
+
+		while (top > 0)
+		{
+			const SDynamicTreeNode& node = m_tree[stack[--top]];
+
+			if (!node.Box.intersectsWithLine(ray))
+				continue;
+
+			if (node.Child >= 0)
+			{
+				stack[top++] = node.Child;
+				stack[top++] = node.Child + 1;
+				continue;
+			}
+
+			const SDynamicCollision& dynamic = m_dynamics[node.Item];
+			if (dynamic.LocalBVH == NULL)
+				continue;
+
+			// the ray in model space, the ratio on the ray is the same in both spaces
+			core::line3df localRay;
+			dynamic.InvTransform.transformVect(localRay.start, ray.start);
+			dynamic.InvTransform.transformVect(localRay.end, ray.end);
+
+			f32 localBest = sqrtf(outBestDistanceSquared) / length * localRay.getLength();
+			localBest = localBest * localBest;
+
+			core::vector3df intersection;
+			core::triangle3df triangle;
+			CCollisionNode* localNode = NULL;
+
+			if (dynamic.LocalBVH->getCollisionPoint(localRay, localBest, intersection, triangle, localNode))
+			{
+				dynamic.Transform.transformVect(outIntersection, intersection);
+				dynamic.Transform.transformVect(outTriangle.pointA, triangle.pointA);
+				dynamic.Transform.transformVect(outTriangle.pointB, triangle.pointB);
+				dynamic.Transform.transformVect(outTriangle.pointC, triangle.pointC);
+
+				outBestDistanceSquared = outIntersection.getDistanceFromSQ(ray.start);
+				outNode = dynamic.Node;
+				found = true;
+			}
+		}
+
+		return found;
+	}
+
+	void CDynamicBVHBuilder::getTriangles(const core::aabbox3df& box,
+		core::array<core::triangle3df*>& result,
+		core::array<CCollisionNode*>& nodes)
+	{
+		if (m_tree.size() == 0)
+			return;
+
+		core::array<core::triangle3df*> localTriangles;
+		core::array<CCollisionNode*> localNodes;
+
+		int stack[DYNAMIC_TREE_STACK_SIZE];
+		int top = 0;
+
+		stack[top++] = 0;
+
+		while (top > 0)
+		{
+			const SDynamicTreeNode& node = m_tree[stack[--top]];
+
+			if (!node.Box.intersectsWithBox(box))
+				continue;
+
+			if (node.Child >= 0)
+			{
+				stack[top++] = node.Child;
+				stack[top++] = node.Child + 1;
+				continue;
+			}
+
+			const SDynamicCollision& dynamic = m_dynamics[node.Item];
+			if (dynamic.LocalBVH == NULL)
+				continue;
+
+			core::aabbox3df localBox = box;
+			dynamic.InvTransform.transformBoxEx(localBox);
+
+			localTriangles.set_used(0);
+			localNodes.set_used(0);
+			dynamic.LocalBVH->getTriangles(localBox, localTriangles, localNodes);
+
+			// map to the world triangles of the node
+			core::triangle3df* local = dynamic.LocalNode->Triangles.pointer();
+			core::triangle3df* world = dynamic.Node->Triangles.pointer();
+
+			for (u32 i = 0, n = localTriangles.size(); i < n; i++)
+			{
+				core::triangle3df* triangle = &world[localTriangles[i] - local];
+				if (!triangle->isTotalOutsideBox(box))
+				{
+					result.push_back(triangle);
+					nodes.push_back(dynamic.Node);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+#pragma once
+
+#include "CBVHBuilder.h"
+
+namespace Skylicht
+{
+	/// @brief The moving node in CDynamicBVHBuilder
+	struct SDynamicCollision
+	{
+		CCollisionNode* Node;
+
+		// BVH of the node triangles in model space, it's built once
+		CBVHBuilder* LocalBVH;
+		CCollisionNode* LocalNode;
+
+		core::matrix4 Transform;
+		core::matrix4 InvTransform;
+
+		core::aabbox3df LocalBox;
+		core::aabbox3df Box;
+
+		// leaf of the node in the top level tree
+		int Leaf;
+	};
+
+	/// @brief Node of the top level tree, Child is -1 on the leaf, else the children are Child and Child + 1
+	struct SDynamicTreeNode
+	{
+		core::aabbox3df Box;
+		int Parent;
+		int Child;
+		int Item;
+	};
+
+	/// @brief Two level collision for the moving objects (doors, elevators, props...).
+	/// Each node has a local BVH that is built once in model space, and the top level tree over the node bounds is refitted when a node moves.
+	/// Call update() after the world transforms are updated, a full build() is only needed after add/remove collision.
+	class CDynamicBVHBuilder : public CCollisionBuilder
+	{
+	protected:
+		core::array<SDynamicCollision> m_dynamics;
+
+		core::array<SDynamicTreeNode> m_tree;
+
+		std::map<CCollisionNode*, u32> m_dynamicIndex;
+
+		u32 m_numRefit;
+
+	public:
+		CDynamicBVHBuilder();
+
+		virtual ~CDynamicBVHBuilder();
+
+		virtual void build();
+
+		virtual void clear();
+
+		virtual void drawDebug();
+
+		/// @brief Refit the nodes that have the world transform changed, return the number of refitted nodes
+		u32 update();
+
+		/// @brief Set the world transform of the node that has no entity
+		bool setTransform(CCollisionNode* node, const core::matrix4& world);
+
+		inline u32 getDynamicCount()
+		{
+			return m_dynamics.size();
+		}
+
+		inline u32 getNumRefit()
+		{
+			return m_numRefit;
+		}
+
+	public:
+
+		virtual bool getCollisionPoint(
+			const core::line3d<f32>& ray,
+			f32& outBestDistanceSquared,
+			core::vector3df& outIntersection,
+			core::triangle3df& outTriangle,
+			CCollisionNode*& outNode);
+
+		virtual void getTriangles(const core::aabbox3df& box,
+			core::array<core::triangle3df*>& result,
+			core::array<CCollisionNode*>& nodes);
+
+	protected:
+
+		virtual void onRemoveNode(CCollisionNode* node);
+
+		void releaseDynamic(SDynamicCollision& dynamic);
+
+		void updateTransform(SDynamicCollision& dynamic, const core::matrix4& world);
+
+		void refit(int leaf);
+
+		void buildTree(int nodeId, int* items, int count, int parent, int& used);
+	};
+}
\ No newline at end of file
@@ -53,6 +53,12 @@ namespace Skylicht
 			return m_triangles.size();
 		}
 
+		//! Triangles in model space
+		inline core::array<core::triangle3df>& getLocalTriangles()
+		{
+			return m_triangles;
+		}
+
 		inline CEntity* getEntity()
 		{
 			return m_entity;
@@ -28,6 +28,8 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Material/Shader/ShaderCallback/CShaderParticle.h"
 #include "Material/Shader/ShaderCallback/CShaderMaterial.h"
 
+#include "Thread/CJobSystem.h"
+
 namespace Skylicht
 {
 	namespace Particle
@@ -117,6 +119,9 @@ namespace Skylicht
 			if (m_group->getEntityCount() == 0)
 				return;
 
+			// update group before render
+			updateParticleGroups(entityManager);
+
 			CEntity** entities = m_group->getEntities();
 			int numEntity = m_group->getEntityCount();
 
@@ -128,16 +133,141 @@ namespace Skylicht
 				CCullingData* culling = GET_ENTITY_DATA(entity, CCullingData);
 				CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
 
-				// update group before render
+				// render
+				if (culling->Visible == true)
+					renderParticleGroup(data, transform->World);
+			}
+		}
+
+		void CParticleRenderer::updateParticleGroups(CEntityManager* entityManager)
+		{
+			CEntity** entities = m_group->getEntities();
+			int numEntity = m_group->getEntityCount();
+
+			if (!entityManager->isMultiThreadUpdate())
+			{
+				for (int i = 0; i < numEntity; i++)
+				{
+					CParticleBufferData* data = GET_ENTITY_DATA(entities[i], CParticleBufferData);
+					CCullingData* culling = GET_ENTITY_DATA(entities[i], CCullingData);
+
+					for (u32 j = 0, m = data->Groups.size(); j < m; j++)
+						data->Groups[j]->update(culling->Visible);
+				}
+				return;
+			}
+
+			// a sub group reads the particles of the parent group, and the parent group notifies the sub group,
+			// so they are updated in the same task, by the order of the list
+			m_updateGroups.set_used(0);
+			m_updateVisible.set_used(0);
+			m_updateTask.set_used(0);
+			m_taskBegin.set_used(0);
+
+			// clear the root table, it has at least 2 slots per group
+			u32 numGroup = 0;
+			for (int i = 0; i < numEntity; i++)
+				numGroup += GET_ENTITY_DATA(entities[i], CParticleBufferData)->Groups.size();
+
+			u32 capacity = 16;
+			while (capacity < numGroup * 2)
+				capacity <<= 1;
+
+			m_rootGroups.set_used(capacity);
+			m_rootTasks.set_used(capacity);
+			for (u32 i = 0; i < capacity; i++)
+				m_rootGroups[i] = NULL;
+
+			for (int i = 0; i < numEntity; i++)
+			{
+				CParticleBufferData* data = GET_ENTITY_DATA(entities[i], CParticleBufferData);
+				CCullingData* culling = GET_ENTITY_DATA(entities[i], CCullingData);
+
 				for (u32 j = 0, m = data->Groups.size(); j < m; j++)
 				{
-					data->Groups[j]->update(culling->Visible);
+					CGroup* group = data->Groups[j];
+
+					CGroup* root = group;
+					while (root->getParentGroup() != NULL)
+						root = root->getParentGroup();
+
+					u32 task = getRootTask(root);
+
+					m_updateGroups.push_back(group);
+					m_updateVisible.push_back(culling->Visible);
+					m_updateTask.push_back(task);
+
+					m_taskBegin[task]++;
 				}
+			}
 
-				// render
-				if (culling->Visible == true)
-					renderParticleGroup(data, transform->World);
+			numGroup = m_updateGroups.size();
+			u32 numTask = m_taskBegin.size();
+			if (numGroup == 0)
+				return;
+
+			// count to begin offset of each task
+			u32 offset = 0;
+			for (u32 i = 0; i < numTask; i++)
+			{
+				u32 count = m_taskBegin[i];
+				m_taskBegin[i] = offset;
+				offset += count;
+			}
+			m_taskBegin.push_back(offset);
+
+			// sort the groups by task, the begin offset is used as the cursor
+			m_taskGroups.set_used(numGroup);
+			m_taskVisible.set_used(numGroup);
+
+			for (u32 i = 0; i < numGroup; i++)
+			{
+				u32 position = m_taskBegin[m_updateTask[i]]++;
+				m_taskGroups[position] = m_updateGroups[i];
+				m_taskVisible[position] = m_updateVisible[i];
+			}
+
+			// the cursor is at the begin of next task, shift back
+			for (u32 i = numTask; i > 0; i--)
+				m_taskBegin[i] = m_taskBegin[i - 1];
+			m_taskBegin[0] = 0;
+
+			CGroup** taskGroups = m_taskGroups.pointer();
+			bool* taskVisible = m_taskVisible.pointer();
+			u32* taskBegin = m_taskBegin.pointer();
+
+			System::CJobSystem::getInstance()->parallelFor((int)numTask, 1,
+				[taskGroups, taskVisible, taskBegin](int begin, int end)
+				{
+					for (int t = begin; t < end; t++)
+					{
+						for (u32 i = taskBegin[t]; i < taskBegin[t + 1]; i++)
+							taskGroups[i]->update(taskVisible[i]);
+					}
+				});
+		}
+
+		u32 CParticleRenderer::getRootTask(CGroup* root)
+		{
+			u32 mask = m_rootGroups.size() - 1;
+			u32 slot = (u32)(((size_t)root >> 4) * 2654435761u) & mask;
+
+			CGroup** rootGroups = m_rootGroups.pointer();
+			while (rootGroups[slot] != NULL)
+			{
+				if (rootGroups[slot] == root)
+					return m_rootTasks[slot];
+
+				slot = (slot + 1) & mask;
 			}
+
+			// new task of this root
+			u32 task = m_taskBegin.size();
+			m_taskBegin.push_back(0);
+
+			rootGroups[slot] = root;
+			m_rootTasks[slot] = task;
+			return task;
 		}
 
 		void CParticleRenderer::renderEmission(CEntityManager* entityManager)
@@ -44,6 +44,20 @@ namespace Skylicht
 		protected:
 			CEntityGroup* m_group;
 
+			// the groups & the update task of them, a group and its sub groups are in the same task
+			core::array<Particle::CGroup*> m_updateGroups;
+			core::array<bool> m_updateVisible;
+			core::array<u32> m_updateTask;
+
+			// the groups sorted by task
+			core::array<Particle::CGroup*> m_taskGroups;
+			core::array<bool> m_taskVisible;
+			core::array<u32> m_taskBegin;
+
+			// open addressing table of the root group to its task, the capacity is kept between frames
+			core::array<Particle::CGroup*> m_rootGroups;
+			core::array<u32> m_rootTasks;
+
 		public:
 			CParticleRenderer();
 
@@ -65,6 +79,10 @@ namespace Skylicht
 
 		protected:
 
+			void updateParticleGroups(CEntityManager* entityManager);
+
+			u32 getRootTask(Particle::CGroup* root);
+
 			void renderParticleGroup(CParticleBufferData* data, const core::matrix4& world);
 
 			void renderParticleGroupEmission(CParticleBufferData* data, const core::matrix4& world);
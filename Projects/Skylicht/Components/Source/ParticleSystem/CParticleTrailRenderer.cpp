@@ -30,6 +30,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "TextureManager/CTextureManager.h"
 
+#include "Thread/CJobSystem.h"
+
 namespace Skylicht
 {
 	namespace Particle
@@ -71,16 +73,34 @@ namespace Skylicht
 			CEntity** entities = m_group->getEntities();
 			int numEntity = m_group->getEntityCount();
 
+			m_updateTrails.set_used(0);
+
 			for (int i = 0; i < numEntity; i++)
 			{
 				CParticleTrailData* trailData = GET_ENTITY_DATA(entities[i], CParticleTrailData);
 
-				// update particle trail
 				u32 m = trailData->Trails.size();
 				for (u32 j = 0; j < m; j++)
-				{
-					trailData->Trails[j]->update(camera);
-				}
+					m_updateTrails.push_back(trailData->Trails[j]);
+			}
+
+			// update particle trail, each trail builds its own mesh buffer
+			CParticleTrail** trails = m_updateTrails.pointer();
+			int numTrail = (int)m_updateTrails.size();
+
+			if (entityManager->isMultiThreadUpdate())
+			{
+				System::CJobSystem::getInstance()->parallelFor(numTrail, 1,
+					[trails, camera](int begin, int end)
+					{
+						for (int i = begin; i < end; i++)
+							trails[i]->update(camera);
+					});
+			}
+			else
+			{
+				for (int i = 0; i < numTrail; i++)
+					trails[i]->update(camera);
 			}
 		}
 
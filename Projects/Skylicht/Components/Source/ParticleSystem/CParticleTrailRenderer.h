@@ -42,6 +42,8 @@ namespace Skylicht
 		protected:
 			CEntityGroup* m_group;
 
+			core::array<CParticleTrail*> m_updateTrails;
+
 		public:
 			CParticleTrailRenderer();
 
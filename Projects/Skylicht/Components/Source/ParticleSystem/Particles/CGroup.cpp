@@ -33,6 +33,8 @@ namespace Skylicht
 	namespace Particle
 	{
 		CGroup::CGroup() :
+			m_capacity(0),
+			m_seed(random(1, 0x7fff0000)),
 			m_renderer(NULL),
 			Gravity(0.0f, 0.0f, 0.0f),
 			Friction(0.0f),
@@ -41,6 +43,8 @@ namespace Skylicht
 			OrientationNormal(1.0f, 0.0f, 0.0f),
 			OrientationUp(0.0f, 1.0f, 0.0f)
 		{
+			m_paramData = new CParticleSoA();
+
 			m_particleSystem = new CParticleSystem();
 
 			m_instancingSystem = new CParticleInstancingSystem();
@@ -63,6 +67,8 @@ namespace Skylicht
 				delete i;
 			m_interpolators.clear();
 
+			delete m_paramData;
+
 			delete m_particleSystem;
 
 			delete m_instancingSystem;
@@ -100,6 +106,10 @@ namespace Skylicht
 		{
 			float dt = getTimeStep();
 
+			// use the random sequence of this group
+			s32 seed = random_get_seed();
+			random_reset(m_seed);
+
 			updateLaunchEmitter();
 
 			CParticle* particles = m_particles.pointer();
@@ -125,27 +135,18 @@ namespace Skylicht
 			for (IParticleCallback* cb : m_callback)
 				cb->OnParticleUpdate(particles, numParticles, this, dt);
 
+			// remove die particle
+			removeDeadParticles();
+
+			particles = m_particles.pointer();
+			numParticles = m_particles.size();
+
+			// update bbox
 			if (numParticles > 0)
 				m_bbox.reset(particles[0].Position);
 
-			// remove die particle & update box
-			for (u32 i = 0; i < numParticles; i++)
-			{
-				CParticle& p = particles[i];
-
-				if (p.Life < 0)
-				{
-					// remove dead particle
-					remove(i);
-					--i;
-					--numParticles;
-				}
-				else
-				{
-					// add bbox
-					m_bbox.addInternalPoint(p.Position);
-				}
-			}
+			for (u32 i = 1; i < numParticles; i++)
+				m_bbox.addInternalPoint(particles[i].Position);
 
 			// update instancing buffer		
 			if (visible == true && m_renderer != NULL)
@@ -157,6 +158,9 @@ namespace Skylicht
 			}
 
 			bornParticle();
+
+			m_seed = random_get_seed();
+			random_reset(seed);
 		}
 
 		void CGroup::updateLaunchEmitter()
@@ -180,23 +184,48 @@ namespace Skylicht
 
 		void CGroup::bornParticle()
 		{
-			u32 emiterId = 0;
-			u32 emiterLaunch = m_launch.size();
+			u32 total = getLaunchNumber();
+			if (total == 0)
+				return;
+
+			// born all new particles at once
+			CParticle* newParticles = create(total);
+
+			for (u32 i = 0, numLaunch = m_launch.size(); i < numLaunch; i++)
+			{
+				SLaunchParticle& launch = m_launch[i];
+				for (u32 j = 0, n = launch.Number; j < n; j++)
+				{
+					CParticle& p = *newParticles;
+					launchParticle(p, launch);
+					newParticles++;
+				}
+			}
+		}
+
+		u32 CGroup::getLaunchNumber()
+		{
+			u32 total = 0;
+			u32 space = 0;
+
+			if (m_capacity > 0 && m_capacity > m_particles.size())
+				space = m_capacity - m_particles.size();
 
-			// born new particle
-			for (u32 i = emiterId; i < emiterLaunch; i++)
+			for (u32 i = 0, numLaunch = m_launch.size(); i < numLaunch; i++)
 			{
 				SLaunchParticle& launch = m_launch[i];
-				if (launch.Number > 0)
+
+				// the particles over the capacity are not emitted
+				if (m_capacity > 0)
 				{
-					CParticle* newParticles = create(launch.Number);
-					for (u32 j = 0, n = launch.Number; j < n; j++)
-					{
-						CParticle& p = newParticles[j];
-						launchParticle(p, launch);
-					}
+					launch.Number = core::min_(launch.Number, space);
+					space -= launch.Number;
 				}
+
+				total += launch.Number;
 			}
+
+			return total;
 		}
 
 		bool CGroup::launchParticle(CParticle& p, SLaunchParticle& launch)
@@ -216,19 +245,24 @@ namespace Skylicht
 
 		void CGroup::initParticleModel(CParticle& p)
 		{
+			u32 index = p.Index;
+
 			for (CModel* m : m_models)
 			{
 				EParticleParams t = m->getType();
 
+				float* startValue = m_paramData->getStart(t);
+				float* endValue = m_paramData->getEnd(t);
+
 				if (m->haveStart() == true)
-					p.StartValue[t] = m->getRandomStart();
+					startValue[index] = m->getRandomStart();
 				else
-					p.StartValue[t] = 0.0f;
+					startValue[index] = 0.0f;
 
 				if (m->haveEnd() == true)
-					p.EndValue[t] = m->getRandomEnd();
+					endValue[index] = m->getRandomEnd();
 				else
-					p.EndValue[t] = p.StartValue[t];
+					endValue[index] = startValue[index];
 
 				if (t == Particle::RotateSpeedX ||
 					t == Particle::RotateSpeedY ||
@@ -237,11 +271,11 @@ namespace Skylicht
 					p.HaveRotate = true;
 				}
 				else if (t == Particle::RotateX)
-					p.Rotation.X = p.StartValue[t];
+					p.Rotation.X = startValue[index];
 				else if (t == Particle::RotateY)
-					p.Rotation.Y = p.StartValue[t];
+					p.Rotation.Y = startValue[index];
 				else if (t == Particle::RotateZ)
-					p.Rotation.Z = p.StartValue[t];
+					p.Rotation.Z = startValue[index];
 			}
 
 			for (IParticleCallback* cb : m_callback)
@@ -250,6 +284,9 @@ namespace Skylicht
 
 		int CGroup::addParticleByEmitter(CEmitter* emitter, const core::vector3df& position, const core::vector3df& subEmitterDirection)
 		{
+			if (m_capacity > 0 && m_particles.size() >= m_capacity)
+				return -1;
+
 			CParticle* p = create(1);
 
 			initParticleLifeTime(*p);
@@ -269,6 +306,9 @@ namespace Skylicht
 
 		int CGroup::addParticleVelocityByEmitter(CEmitter* emitter, const core::vector3df& position, const core::vector3df& velocity)
 		{
+			if (m_capacity > 0 && m_particles.size() >= m_capacity)
+				return -1;
+
 			CParticle* p = create(1);
 
 			initParticleLifeTime(*p);
@@ -286,34 +326,88 @@ namespace Skylicht
 			return (int)p->Index;
 		}
 
+		void CGroup::setCapacity(u32 capacity)
+		{
+			m_capacity = capacity;
+
+			if (m_capacity > m_particles.allocated_size())
+				m_particles.reallocate(m_capacity);
+
+			m_paramData->reserve(m_capacity);
+		}
+
 		CParticle* CGroup::create(u32 num)
 		{
 			u32 total = m_particles.size();
-			for (u32 i = 0; i < num; i++)
-			{
-				m_particles.push_back(CParticle(total + i));
-			}
-			return m_particles.pointer() + total;
+			u32 newSize = total + num;
+
+			// grow the capacity x2, set_used only allocate the exact size
+			if (newSize > m_particles.allocated_size())
+				m_particles.reallocate(core::max_(newSize, m_particles.allocated_size() * 2));
+
+			m_particles.set_used(newSize);
+
+			CParticle* particles = m_particles.pointer();
+			for (u32 i = total; i < newSize; i++)
+				particles[i] = CParticle(i);
+
+			m_paramData->resize(newSize);
+			return particles + total;
 		}
 
-		void CGroup::remove(u32 index)
+		void CGroup::removeDeadParticles()
 		{
-			u32 total = m_particles.size();
-			if (index >= total)
-				return;
+			CParticle* particles = m_particles.pointer();
+			int numParticles = (int)m_particles.size();
 
-			if (index != total - 1)
+			// move the alive particles to the front, the dead particles to the back
+			int i = 0;
+			int j = numParticles - 1;
+
+			m_swaps.set_used(0);
+
+			while (true)
 			{
-				for (IParticleCallback* cb : m_callback)
-					cb->OnSwapParticleData(m_particles[index], m_particles.getLast());
+				while (i <= j && !(particles[i].Life < 0))
+					i++;
+
+				while (j > i && particles[j].Life < 0)
+					j--;
+
+				if (i >= j)
+					break;
+
+				m_swaps.push_back(SParticleSwap(i, j));
+				i++;
+				j--;
+			}
+
+			int numAlive = i;
+			if (numAlive == numParticles)
+				return;
+
+			int numSwap = (int)m_swaps.size();
+			SParticleSwap* swaps = m_swaps.pointer();
+
+			// call even if there is no swap, the callback can handle the dead particles in this pass
+			for (IParticleCallback* cb : m_callback)
+				cb->OnSwapParticleDataBatch(particles, swaps, numSwap);
 
-				m_particles[index].swap(m_particles.getLast());
+			for (int k = 0; k < numSwap; k++)
+			{
+				particles[swaps[k].Index1].swap(particles[swaps[k].Index2]);
+				m_paramData->swap(swaps[k].Index1, swaps[k].Index2);
 			}
 
+			// the callback release the last particle data, so call from the back
 			for (IParticleCallback* cb : m_callback)
-				cb->OnParticleDead(m_particles.getLast());
+			{
+				for (int k = numParticles - 1; k >= numAlive; k--)
+					cb->OnParticleDead(particles[k]);
+			}
 
-			m_particles.set_used(total - 1);
+			m_particles.set_used(numAlive);
+			m_paramData->resize(numAlive);
 		}
 
 		CModel* CGroup::createModel(EParticleParams param)
@@ -324,6 +418,8 @@ namespace Skylicht
 			{
 				m = new CModel(param);
 				m_models.push_back(m);
+
+				m_paramData->enableParam(param);
 			}
 
 			return m;
@@ -25,6 +25,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #pragma once
 
 #include "CParticle.h"
+#include "CParticleSoA.h"
 #include "Entity/CEntityPrefab.h"
 
 #include "Emitters/CEmitter.h"
@@ -59,6 +60,24 @@ namespace Skylicht
 			}
 		};
 
+		struct SParticleSwap
+		{
+			u32 Index1;
+			u32 Index2;
+
+			SParticleSwap()
+			{
+				Index1 = 0;
+				Index2 = 0;
+			}
+
+			SParticleSwap(u32 index1, u32 index2)
+			{
+				Index1 = index1;
+				Index2 = index2;
+			}
+		};
+
 		class COMPONENT_API IParticleCallback
 		{
 		public:
@@ -92,6 +111,15 @@ namespace Skylicht
 
 			}
 
+			/// @brief The swaps of a compaction, called before the data is swapped and before OnParticleDead.
+			/// It is called in each compaction that has dead particles (Life < 0), even if num is 0.
+			/// The pairs do not share any index, so they can be applied in any order.
+			virtual void OnSwapParticleDataBatch(CParticle *particles, const SParticleSwap *swaps, int num)
+			{
+				for (int i = 0; i < num; i++)
+					OnSwapParticleData(particles[swaps[i].Index1], particles[swaps[i].Index2]);
+			}
+
 			virtual void OnGroupDestroy()
 			{
 
@@ -102,7 +130,14 @@ namespace Skylicht
 		{
 		protected:
 			core::array<CParticle> m_particles;
+			CParticleSoA* m_paramData;
 			core::array<SLaunchParticle> m_launch;
+			core::array<SParticleSwap> m_swaps;
+
+			u32 m_capacity;
+
+			// the random seed of this group, the result does not depend on the update order of groups
+			s32 m_seed;
 
 			std::vector<CEmitter*> m_emitters;
 			std::vector<ISystem*> m_systems;
@@ -151,6 +186,11 @@ namespace Skylicht
 				return m_world;
 			}
 
+			virtual CGroup* getParentGroup()
+			{
+				return NULL;
+			}
+
 			virtual core::vector3df getTransformPosition(const core::vector3df& pos);
 
 			virtual core::vector3df getTransformVector(const core::vector3df& vec);
@@ -160,6 +200,26 @@ namespace Skylicht
 				return m_bbox;
 			}
 
+			/// @brief Set the fixed capacity of the group, the particle buffers are allocated once
+			/// and the particles over the capacity are not emitted. 0 is unlimited (default).
+			void setCapacity(u32 capacity);
+
+			inline u32 getCapacity()
+			{
+				return m_capacity;
+			}
+
+			/// @brief The seed of random sequence that is used by the emitters & models of this group
+			inline void setRandomSeed(s32 seed)
+			{
+				m_seed = seed;
+			}
+
+			inline s32 getRandomSeed()
+			{
+				return m_seed;
+			}
+
 			inline u32 getNumParticles()
 			{
 				return m_particles.size();
@@ -170,6 +230,11 @@ namespace Skylicht
 				return m_particles.pointer();
 			}
 
+			inline CParticleSoA* getParamData()
+			{
+				return m_paramData;
+			}
+
 			inline CEmitter* addEmitter(CEmitter *e)
 			{
 				m_emitters.push_back(e);
@@ -308,9 +373,11 @@ namespace Skylicht
 				p.HaveRotate = false;
 			}
 
+			u32 getLaunchNumber();
+
 			CParticle* create(u32 num);
 
-			void remove(u32 i);
+			void removeDeadParticles();
 		};
 	}
 }
\ No newline at end of file
@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CInterpolator.h"
+#include "Utils/CSIMDUtils.h"
 
 namespace Skylicht
 {
@@ -73,5 +74,23 @@ namespace Skylicht
 			float ratioX = (x - previousEntry.x) / (nextEntry.x - previousEntry.x);
 			return y0 + ratioX * (y1 - y0);
 		}
+
+		void CInterpolator::interpolate(const float* x, float* y, int count)
+		{
+			// flat the graph, the keys are sorted by set
+			u32 numKey = (u32)m_graph.size();
+			m_keyX.set_used(numKey);
+			m_keyY.set_used(numKey);
+
+			u32 i = 0;
+			for (const SInterpolatorEntry& entry : m_graph)
+			{
+				m_keyX[i] = entry.x;
+				m_keyY[i] = entry.y;
+				i++;
+			}
+
+			CSIMDUtils::evaluateCurve(m_keyX.const_pointer(), m_keyY.const_pointer(), (int)numKey, x, y, count);
+		}
 	}
 }
\ No newline at end of file
@@ -55,6 +55,9 @@ namespace Skylicht
 		protected:
 			std::set<SInterpolatorEntry> m_graph;
 
+			core::array<float> m_keyX;
+			core::array<float> m_keyY;
+
 		public:
 			CInterpolator();
 
@@ -62,6 +65,9 @@ namespace Skylicht
 
 			float interpolate(float x);
 
+			/// @brief y[i] = interpolate(x[i]), the graph is evaluated with SIMD
+			void interpolate(const float* x, float* y, int count);
+
 			inline std::set<SInterpolatorEntry>& getGraph()
 			{
 				return m_graph;
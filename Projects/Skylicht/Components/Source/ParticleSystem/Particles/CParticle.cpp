@@ -39,9 +39,6 @@ namespace Skylicht
 			HaveRotate(false),
 			SubEmitterDirection(0.0f, 1.0f, 0.0f)
 		{
-			memset(StartValue, 0, sizeof(float) * NumParams);
-			memset(EndValue, 0, sizeof(float) * NumParams);
-
 			Params[ColorR] = 1.0f;
 			Params[ColorG] = 1.0f;
 			Params[ColorB] = 1.0f;
@@ -73,14 +70,6 @@ namespace Skylicht
 			memcpy(Params, p.Params, size);
 			memcpy(p.Params, temp, size);
 
-			memcpy(temp, StartValue, size);
-			memcpy(StartValue, p.StartValue, size);
-			memcpy(p.StartValue, temp, size);
-
-			memcpy(temp, EndValue, size);
-			memcpy(EndValue, p.EndValue, size);
-			memcpy(p.EndValue, temp, size);
-
 			float age = Age;
 			float life = Life;
 			float lifeTime = LifeTime;
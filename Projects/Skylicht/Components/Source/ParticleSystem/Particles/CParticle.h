@@ -60,8 +60,6 @@ namespace Skylicht
 			bool Immortal;
 
 			float Params[NumParams];
-			float StartValue[NumParams];
-			float EndValue[NumParams];
 
 			float Age;
 			float Life;
@@ -80,7 +78,7 @@ namespace Skylicht
 		public:
 			CParticle(u32 index);
 
-			virtual ~CParticle();
+			~CParticle();
 
 			void swap(CParticle& p);
 		};
@@ -0,0 +1,117 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CParticleSoA.h"
+
+namespace Skylicht
+{
+	namespace Particle
+	{
+		CParticleSoA::CParticleSoA() :
+			m_count(0),
+			m_capacity(0)
+		{
+			for (int i = 0; i < NumParams; i++)
+				m_enable[i] = false;
+		}
+
+		CParticleSoA::~CParticleSoA()
+		{
+
+		}
+
+		void CParticleSoA::enableParam(EParticleParams t)
+		{
+			if (m_enable[t])
+				return;
+
+			m_enable[t] = true;
+
+			u32 capacity = core::max_(m_count, m_capacity);
+			m_start[t].reallocate(capacity);
+			m_end[t].reallocate(capacity);
+
+			m_start[t].set_used(m_count);
+			m_end[t].set_used(m_count);
+
+			if (m_count > 0)
+			{
+				memset(m_start[t].pointer(), 0, sizeof(float) * m_count);
+				memset(m_end[t].pointer(), 0, sizeof(float) * m_count);
+			}
+		}
+
+		void CParticleSoA::reserve(u32 capacity)
+		{
+			m_capacity = capacity;
+
+			for (int i = 0; i < NumParams; i++)
+			{
+				if (m_enable[i] && capacity > m_start[i].allocated_size())
+				{
+					m_start[i].reallocate(capacity);
+					m_end[i].reallocate(capacity);
+				}
+			}
+		}
+
+		void CParticleSoA::resize(u32 count)
+		{
+			for (int i = 0; i < NumParams; i++)
+			{
+				if (!m_enable[i])
+					continue;
+
+				// grow the capacity x2, set_used only allocate the exact size
+				if (count > m_start[i].allocated_size())
+				{
+					u32 capacity = core::max_(count, m_start[i].allocated_size() * 2);
+					m_start[i].reallocate(capacity);
+					m_end[i].reallocate(capacity);
+				}
+
+				m_start[i].set_used(count);
+				m_end[i].set_used(count);
+			}
+
+			m_count = count;
+		}
+
+		void CParticleSoA::swap(u32 a, u32 b)
+		{
+			for (int i = 0; i < NumParams; i++)
+			{
+				if (!m_enable[i])
+					continue;
+
+				float* start = m_start[i].pointer();
+				float* end = m_end[i].pointer();
+
+				core::swap(start[a], start[b]);
+				core::swap(end[a], end[b]);
+			}
+		}
+	}
+}
\ No newline at end of file
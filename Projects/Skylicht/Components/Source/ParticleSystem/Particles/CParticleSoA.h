@@ -0,0 +1,82 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CParticle.h"
+
+namespace Skylicht
+{
+	namespace Particle
+	{
+		/// @brief The start & end value of the particle params, in SoA layout.
+		/// The value of the particle is at the position CParticle::Index of each param array,
+		/// so the interpolate kernel read the contiguous memory of each param.
+		class COMPONENT_API CParticleSoA
+		{
+		protected:
+			core::array<float> m_start[NumParams];
+			core::array<float> m_end[NumParams];
+
+			bool m_enable[NumParams];
+
+			u32 m_count;
+			u32 m_capacity;
+
+		public:
+			CParticleSoA();
+
+			virtual ~CParticleSoA();
+
+			/// @brief Allocate the arrays of a param, only the param that have a CModel is stored
+			void enableParam(EParticleParams t);
+
+			inline bool isEnableParam(EParticleParams t)
+			{
+				return m_enable[t];
+			}
+
+			void reserve(u32 capacity);
+
+			void resize(u32 count);
+
+			void swap(u32 a, u32 b);
+
+			inline u32 getCount()
+			{
+				return m_count;
+			}
+
+			inline float* getStart(EParticleParams t)
+			{
+				return m_start[t].pointer();
+			}
+
+			inline float* getEnd(EParticleParams t)
+			{
+				return m_end[t].pointer();
+			}
+		};
+	}
+}
\ No newline at end of file
@@ -62,19 +62,11 @@ namespace Skylicht
 
 		void CSubGroup::OnParticleDead(CParticle &p)
 		{
+			// the particles of the dead parent are detached in OnSwapParticleDataBatch
 			for (CEmitter *e : m_emitters)
 			{
 				e->deleteBornData();
 			}
-
-			CParticle* particles = getParticlePointer();
-			u32 n = getNumParticles();
-
-			for (u32 i = 0; i < n; i++)
-			{
-				if (particles[i].ParentIndex == p.Index)
-					particles[i].ParentIndex = -1;
-			}
 		}
 
 		void CSubGroup::OnSwapParticleData(CParticle &p1, CParticle &p2)
@@ -96,6 +88,48 @@ namespace Skylicht
 			}
 		}
 
+		void CSubGroup::OnSwapParticleDataBatch(CParticle *parentParticles, const SParticleSwap *swaps, int num)
+		{
+			u32 numParent = m_parentGroup->getNumParticles();
+
+			// map the parent index to the swapped index
+			m_swapIndex.set_used(numParent);
+			s32* swapIndex = m_swapIndex.pointer();
+
+			for (u32 i = 0; i < numParent; i++)
+				swapIndex[i] = (s32)i;
+
+			for (int i = 0; i < num; i++)
+			{
+				u32 index1 = swaps[i].Index1;
+				u32 index2 = swaps[i].Index2;
+
+				for (CEmitter *e : m_emitters)
+					e->swapBornData(index1, index2);
+
+				swapIndex[index1] = index2;
+				swapIndex[index2] = index1;
+			}
+
+			// the parent is dead, detach its particles
+			for (u32 i = 0; i < numParent; i++)
+			{
+				if (parentParticles[i].Life < 0)
+					swapIndex[i] = -1;
+			}
+
+			// update the parent of all particles in one pass
+			CParticle* particles = getParticlePointer();
+			u32 n = getNumParticles();
+
+			for (u32 i = 0; i < n; i++)
+			{
+				s32 parentIndex = particles[i].ParentIndex;
+				if (parentIndex >= 0 && parentIndex < (s32)numParent)
+					particles[i].ParentIndex = swapIndex[parentIndex];
+			}
+		}
+
 		void CSubGroup::OnGroupDestroy()
 		{
 			m_parentGroup = NULL;
@@ -129,12 +163,16 @@ namespace Skylicht
 
 		void CSubGroup::bornParticle()
 		{
-			u32 emiterId = 0;
-			u32 emiterLaunch = m_launch.size();
+			u32 total = getLaunchNumber();
+			if (total == 0)
+				return;
 
 			CParticle* baseParticles = m_parentGroup->getParticlePointer();
 
-			for (u32 i = emiterId; i < emiterLaunch; i++)
+			// born all new particles at once
+			CParticle* newParticles = create(total);
+
+			for (u32 i = 0, numLaunch = m_launch.size(); i < numLaunch; i++)
 			{
 				SLaunchParticle &launch = m_launch[i];
 				if (launch.Number > 0)
@@ -154,13 +192,12 @@ namespace Skylicht
 					m_rotate.rotationFromTo(Transform::Oy, m_direction);
 
 					// init new particle
-					CParticle* newParticles = create(launch.Number);
-
 					for (u32 j = 0, n = launch.Number; j < n; j++)
 					{
-						CParticle &p = newParticles[j];
+						CParticle &p = *newParticles;
 						p.ParentIndex = parentIndex;
 						launchParticle(p, launch);
+						newParticles++;
 					}
 				}
 			}
@@ -46,6 +46,8 @@ namespace Skylicht
 			bool m_followParentTransform;
 			bool m_emitterWorldOrientation;
 
+			core::array<s32> m_swapIndex;
+
 		public:
 			CSubGroup(CGroup *group);
 
@@ -57,6 +59,8 @@ namespace Skylicht
 
 			virtual void OnSwapParticleData(CParticle &p1, CParticle &p2);
 
+			virtual void OnSwapParticleDataBatch(CParticle *particles, const SParticleSwap *swaps, int num);
+
 			virtual void OnGroupDestroy();
 
 			virtual void updateLaunchEmitter();
@@ -80,7 +84,7 @@ namespace Skylicht
 
 			void syncParentParams(bool life, bool color);
 
-			inline CGroup* getParentGroup()
+			virtual CGroup* getParentGroup()
 			{
 				return m_parentGroup;
 			}
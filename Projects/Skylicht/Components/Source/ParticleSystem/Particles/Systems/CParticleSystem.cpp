@@ -28,6 +28,8 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "ParticleSystem/Particles/CParticle.h"
 #include "ParticleSystem/Particles/CGroup.h"
 
+#include "Utils/CSIMDUtils.h"
+
 namespace Skylicht
 {
 	namespace Particle
@@ -73,27 +75,15 @@ namespace Skylicht
 			CParticle *p;
 			float *params;
 
-			// model
-			std::vector<CModel*>& listModel = group->getModels();
-
-			std::vector<EParticleParams> listParams;
-			std::vector<CInterpolator*> listModelInterpolators;
-
-			for (CModel *m : listModel)
-			{
-				listParams.push_back(m->getType());
-				listModelInterpolators.push_back(m->getInterpolator());
-			}
+			m_ratio.set_used(num);
+			m_value.set_used(num);
 
-			// list model and param
-			u32 numModels = (u32)listModel.size();
-			CModel** models = listModel.data();
-			EParticleParams* paramTypes = listParams.data();
-			CInterpolator** modelInterpolators = listModelInterpolators.data();
+			float* ratio = m_ratio.pointer();
+			float* value = m_value.pointer();
 
-			float f, y;
+			float f;
 
-#pragma omp parallel for private(p, params, f, y)
+#pragma omp parallel for private(p, params, f)
 			for (int i = 0; i < num; i++)
 			{
 				p = particles + i;
@@ -131,34 +121,38 @@ namespace Skylicht
 					p->Velocity *= f;
 				}
 
-				// update interpolate parameters
-				float x = core::clamp(p->Age / p->LifeTime, 0.0f, 1.0f);
+				ratio[i] = core::clamp(p->Age / p->LifeTime, 0.0f, 1.0f);
+			}
 
-				for (u32 j = 0; j < numModels; j++)
-				{
-					// linear
-					y = x;
-					EParticleParams t = paramTypes[j];
+			// update interpolate parameters, param by param on the contiguous arrays
+			CParticleSoA* paramData = group->getParamData();
 
-					if (modelInterpolators[j] != NULL)
-					{
-						// interpolate
-						y = modelInterpolators[j]->interpolate(x);
-						params[t] = y;
-					}
-					else
-					{
-						// update param value
-						params[t] = p->StartValue[t] + (p->EndValue[t] - p->StartValue[t]) * y;
-					}
+			for (CModel* m : group->getModels())
+			{
+				EParticleParams t = m->getType();
+				CInterpolator* interpolator = m->getInterpolator();
 
-					if (t == Scale)
+				if (interpolator != NULL)
+					interpolator->interpolate(ratio, value, num);
+				else
+					CSIMDUtils::lerpArray(paramData->getStart(t), paramData->getEnd(t), ratio, value, num);
+
+				if (t == Scale)
+				{
+					for (int i = 0; i < num; i++)
 					{
-						params[ScaleX] = params[Scale];
-						params[ScaleY] = params[Scale];
-						params[ScaleZ] = params[Scale];
+						params = particles[i].Params;
+						params[Scale] = value[i];
+						params[ScaleX] = value[i];
+						params[ScaleY] = value[i];
+						params[ScaleZ] = value[i];
 					}
 				}
+				else
+				{
+					for (int i = 0; i < num; i++)
+						particles[i].Params[t] = value[i];
+				}
 			}
 		}
 	}
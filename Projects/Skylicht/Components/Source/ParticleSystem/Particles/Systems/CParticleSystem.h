@@ -32,6 +32,11 @@ namespace Skylicht
 	{
 		class COMPONENT_API CParticleSystem : public ISystem
 		{
+		protected:
+			// the life ratio & interpolated value of the particles, in SoA layout
+			core::array<float> m_ratio;
+			core::array<float> m_value;
+
 		public:
 			CParticleSystem();
 
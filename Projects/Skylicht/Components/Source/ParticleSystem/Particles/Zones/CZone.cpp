@@ -29,8 +29,8 @@ namespace Skylicht
 {
 	namespace Particle
 	{
-		// use local random
-		s32 seed = 0x0f0f0f0f;
+		// use local random, each thread has its own seed so the groups can be updated in parallel
+		thread_local s32 seed = 0x0f0f0f0f;
 		const s32 m = 2147483399;	// a non-Mersenne prime
 		const s32 a = 40692;		// another spectral success story
 		const s32 q = m / a;
@@ -62,6 +62,11 @@ namespace Skylicht
 			seed = value;
 		}
 
+		s32 random_get_seed()
+		{
+			return seed;
+		}
+
 		int random(int from, int to)
 		{
 			s32 r = particle_rand() % (to - from);
@@ -37,6 +37,8 @@ namespace Skylicht
 
 		COMPONENT_API void random_reset(s32 seed);
 
+		COMPONENT_API s32 random_get_seed();
+
 		enum EZone
 		{
 			Point,
@@ -99,6 +99,13 @@ namespace Skylicht
 			return AnimNameToInfo[sceneNodeName];
 		}
 
+		/// @brief Reduce the keys and quantize the rotations of all the anim data, see CAnimationData::compress
+		void compress(f32 positionTolerance = 0.001f, f32 rotationTolerance = 0.001f, f32 scaleTolerance = 0.001f, bool quantizeRotation = true)
+		{
+			for (SEntityAnim*& i : AnimInfo)
+				i->Data.compress(positionTolerance, rotationTolerance, scaleTolerance, quantizeRotation);
+		}
+
 		float getRealTimeLength(float baseFps = 30.0f)
 		{
 			return Duration * 1000.0f / baseFps;
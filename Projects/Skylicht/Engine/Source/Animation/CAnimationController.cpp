@@ -25,19 +25,25 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "pch.h"
 #include "GameObject/CGameObject.h"
 #include "CAnimationController.h"
+#include "CAnimationSystem.h"
+#include "Entity/CEntityManager.h"
 
 #include "RenderMesh/CRenderMesh.h"
 
 namespace Skylicht
 {
 	CAnimationController::CAnimationController() :
-		m_output(NULL)
+		m_output(NULL),
+		m_animationSystem(NULL)
 	{
 
 	}
 
 	CAnimationController::~CAnimationController()
 	{
+		if (m_animationSystem)
+			m_animationSystem->removeController(this);
+
 		releaseAllSkeleton();
 	}
 
@@ -47,6 +53,23 @@ namespace Skylicht
 	}
 
 	void CAnimationController::updateComponent()
+	{
+		CEntityManager* entityManager = m_gameObject->getEntityManager();
+		if (entityManager->isMultiThreadUpdate())
+		{
+			// evaluate in parallel with the other controllers, before the transforms are updated
+			CAnimationSystem* animationSystem = entityManager->getSystem<CAnimationSystem>();
+			if (animationSystem != NULL)
+			{
+				animationSystem->addController(this);
+				return;
+			}
+		}
+
+		evaluate();
+	}
+
+	void CAnimationController::evaluate()
 	{
 		for (CSkeleton*& skeleton : m_skeletons)
 		{
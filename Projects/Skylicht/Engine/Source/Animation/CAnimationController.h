@@ -29,6 +29,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
+	class CAnimationSystem;
+
 	class SKYLICHT_API CAnimationController : public CComponentSystem
 	{
 	protected:
@@ -36,6 +38,11 @@ namespace Skylicht
 
 		CSkeleton* m_output;
 
+		// the system that queued this controller in this frame, see CAnimationSystem::addController
+		CAnimationSystem* m_animationSystem;
+
+		friend class CAnimationSystem;
+
 	public:
 		CAnimationController();
 
@@ -45,6 +52,10 @@ namespace Skylicht
 
 		virtual void updateComponent();
 
+		/// @brief Update the timeline, sample & blend the skeletons, and apply the output to joint transforms.
+		/// It is called in updateComponent, or by CAnimationSystem if the multithread update is enabled.
+		void evaluate();
+
 	public:
 
 		CSkeleton* createSkeleton();
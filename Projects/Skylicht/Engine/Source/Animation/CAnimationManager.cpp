@@ -11,7 +11,8 @@ namespace Skylicht
 {
 	IMPLEMENT_SINGLETON(CAnimationManager);
 
-	CAnimationManager::CAnimationManager()
+	CAnimationManager::CAnimationManager() :
+		m_compressClip(true)
 	{
 
 	}
@@ -81,6 +82,9 @@ namespace Skylicht
 				sprintf(log, "Load animation: %s", resource);
 				os::Printer::log(log);
 
+				if (m_compressClip)
+					output->compress();
+
 				// cached
 				m_clips[resource] = output;
 			}
@@ -42,6 +42,8 @@ namespace Skylicht
 		std::map<std::string, CAnimationClip*> m_clips;
 		std::map<std::string, CAnimation*> m_animations;
 
+		bool m_compressClip;
+
 	public:
 		CAnimationManager();
 
@@ -54,6 +56,17 @@ namespace Skylicht
 			return m_animations[animName];
 		}
 
+		/// @brief Compress the clips when they are loaded, see CAnimationClip::compress. It is enabled by default
+		inline void setCompressClip(bool b)
+		{
+			m_compressClip = b;
+		}
+
+		inline bool isCompressClip()
+		{
+			return m_compressClip;
+		}
+
 		CAnimationClip* loadAnimation(const char* resource);
 
 		CAnimationClip* loadAnimation(const char* resource, IAnimationImporter* importer);
@@ -0,0 +1,115 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CAnimationSystem.h"
+#include "CAnimationController.h"
+#include "Entity/CEntityManager.h"
+
+#include "Thread/CJobSystem.h"
+
+namespace Skylicht
+{
+	CAnimationSystem::CAnimationSystem()
+	{
+		// the controllers are evaluated in preQuery, update does nothing
+		declareNoDataAccess();
+	}
+
+	CAnimationSystem::~CAnimationSystem()
+	{
+		// the queued controllers do not keep this system
+		CAnimationController** controllers = m_controllers.pointer();
+		for (int i = 0, n = m_controllers.count(); i < n; i++)
+			controllers[i]->m_animationSystem = NULL;
+	}
+
+	void CAnimationSystem::beginQuery(CEntityManager* entityManager)
+	{
+
+	}
+
+	void CAnimationSystem::preQuery(CEntityManager* entityManager)
+	{
+		int numController = m_controllers.count();
+		if (numController == 0)
+			return;
+
+		CAnimationController** controllers = m_controllers.pointer();
+
+		// the controllers are independent, each job evaluates some controllers
+		System::CJobSystem::getInstance()->parallelFor(numController, 4,
+			[controllers](int begin, int end)
+			{
+				for (int i = begin; i < end; i++)
+					controllers[i]->evaluate();
+			});
+
+		for (int i = 0; i < numController; i++)
+			controllers[i]->m_animationSystem = NULL;
+
+		m_controllers.reset();
+	}
+
+	void CAnimationSystem::onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity)
+	{
+
+	}
+
+	void CAnimationSystem::init(CEntityManager* entityManager)
+	{
+
+	}
+
+	void CAnimationSystem::update(CEntityManager* entityManager)
+	{
+
+	}
+
+	void CAnimationSystem::addController(CAnimationController* controller)
+	{
+		if (controller->m_animationSystem == this)
+			return;
+
+		controller->m_animationSystem = this;
+		m_controllers.push(controller);
+	}
+
+	void CAnimationSystem::removeController(CAnimationController* controller)
+	{
+		CAnimationController** controllers = m_controllers.pointer();
+		int numController = m_controllers.count();
+
+		for (int i = 0; i < numController; i++)
+		{
+			if (controllers[i] == controller)
+			{
+				controller->m_animationSystem = NULL;
+				controllers[i] = controllers[numController - 1];
+				m_controllers.setCount(numController - 1);
+				return;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "Entity/IEntitySystem.h"
+#include "Entity/CArrayUtils.h"
+
+namespace Skylicht
+{
+	class CAnimationController;
+
+	/// @brief The batched evaluation of CAnimationController (skeleton sampling, blending and apply joint transform).
+	/// When the multithread update of CEntityManager is enabled, the controllers are added in updateComponent,
+	/// and they are evaluated in parallel by CJobSystem in preQuery, before the transform groups collect the changed joints.
+	class SKYLICHT_API CAnimationSystem : public IEntitySystem
+	{
+	protected:
+		CFastArray<CAnimationController*> m_controllers;
+
+	public:
+		CAnimationSystem();
+
+		virtual ~CAnimationSystem();
+
+		virtual void beginQuery(CEntityManager* entityManager);
+
+		virtual void preQuery(CEntityManager* entityManager);
+
+		virtual void onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity);
+
+		virtual void init(CEntityManager* entityManager);
+
+		virtual void update(CEntityManager* entityManager);
+
+		/// @brief Queue the controller for this frame, it is ignored if the controller is already queued.
+		void addController(CAnimationController* controller);
+
+		void removeController(CAnimationController* controller);
+
+		inline int getNumController()
+		{
+			return m_controllers.count();
+		}
+	};
+}
\ No newline at end of file
@@ -29,6 +29,9 @@ namespace Skylicht
 {
 	CAnimationTrack::CAnimationTrack() :
 		m_data(NULL),
+		m_positionCursor(0),
+		m_rotationCursor(0),
+		m_scaleCursor(0),
 		HaveAnimation(false)
 	{
 	}
@@ -64,7 +67,7 @@ namespace Skylicht
 
 		if (numPositionKey)
 		{
-			foundPositionIndex = data->Positions.getIndex(frame);
+			foundPositionIndex = data->Positions.getIndex(frame, m_positionCursor);
 			CPositionKey* pPositions = data->Positions.pointer();
 
 			// Do interpolation...
@@ -110,7 +113,7 @@ namespace Skylicht
 		u32 numScaleKey = data->Scales.size();
 		if (numScaleKey)
 		{
-			foundScaleIndex = data->Scales.getIndex(frame);
+			foundScaleIndex = data->Scales.getIndex(frame, m_scaleCursor);
 			CScaleKey* pScale = data->Scales.pointer();
 
 			// Do interpolation...
@@ -156,7 +159,7 @@ namespace Skylicht
 
 		if (numRotKey)
 		{
-			foundRotationIndex = data->Rotations.getIndex(frame);
+			foundRotationIndex = data->Rotations.getIndex(frame, m_rotationCursor);
 			CRotationKey* pRotation = data->Rotations.pointer();
 
 			// Do interpolation...
@@ -187,6 +190,36 @@ namespace Skylicht
 				quaternionSlerp(rotation, KeyA.Value, KeyB.Value, t);
 			}
 		}
+		else if (data->isQuantizedRotation())
+		{
+			numRotKey = data->QuantizedRotations.size();
+			foundRotationIndex = data->QuantizedRotations.getIndex(frame, m_rotationCursor);
+			CQuantizedRotationKey* pRotation = data->QuantizedRotations.pointer();
+
+			if (foundRotationIndex == 0)
+			{
+				pRotation[0].Value.decode(rotation);
+			}
+			else if (foundRotationIndex == -1)
+			{
+				pRotation[numRotKey - 1].Value.decode(rotation);
+			}
+			else
+			{
+				const CQuantizedRotationKey& KeyA = pRotation[foundRotationIndex];
+				const CQuantizedRotationKey& KeyB = pRotation[foundRotationIndex - 1];
+
+				const f32 fd1 = frame - KeyA.Frame;
+				const f32 fd2 = KeyB.Frame - frame;
+				const f32 t = fd1 / (fd1 + fd2);
+
+				core::quaternion a, b;
+				KeyA.Value.decode(a);
+				KeyB.Value.decode(b);
+
+				quaternionSlerp(rotation, a, b, t);
+			}
+		}
 		else
 		{
 			rotation.X = data->Rotations.Default.X;
@@ -247,4 +280,200 @@ namespace Skylicht
 		result.Z = q1.Z * scale + q2.Z * invscale;
 		result.W = q1.W * scale + q2.W * invscale;
 	}
+
+	void CQuantizedQuaternion::encode(const core::quaternion& q)
+	{
+		const f32* v = &q.X;
+
+		int largest = 0;
+		for (int i = 1; i < 4; i++)
+		{
+			if (fabsf(v[i]) > fabsf(v[largest]))
+				largest = i;
+		}
+
+		// q and -q are the same rotation, so the largest component is always positive
+		f32 sign = v[largest] < 0.0f ? -1.0f : 1.0f;
+
+		// the other components are in [-1/sqrt(2), 1/sqrt(2)]
+		const f32 scale = 32767.0f * core::squareroot(2.0f);
+
+		int n = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			if (i == largest)
+				continue;
+
+			f32 c = core::clamp(v[i] * sign * scale, -32767.0f, 32767.0f);
+			Value[n++] = (s16)core::round32(c);
+		}
+
+		Largest = (u16)largest;
+	}
+
+	void CQuantizedQuaternion::decode(core::quaternion& q) const
+	{
+		f32* v = &q.X;
+
+		const f32 scale = 1.0f / (32767.0f * core::squareroot(2.0f));
+
+		f32 sum = 0.0f;
+		int n = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			if (i == Largest)
+				continue;
+
+			v[i] = Value[n++] * scale;
+			sum += v[i] * v[i];
+		}
+
+		v[Largest] = core::squareroot(core::max_(0.0f, 1.0f - sum));
+	}
+
+	f32 getRotationAngle(core::quaternion a, core::quaternion b)
+	{
+		// the interpolated quaternion may be not normalized
+		a.normalize();
+		b.normalize();
+
+		if (a.dotProduct(b) < 0.0f)
+			b = b * -1.0f;
+
+		// |a - b| = 2 * sin(angle / 4), it is more precise than acos(dot) with the small angle
+		core::quaternion d(a.X - b.X, a.Y - b.Y, a.Z - b.Z, a.W - b.W);
+		f32 len = sqrtf(d.X * d.X + d.Y * d.Y + d.Z * d.Z + d.W * d.W);
+		return 4.0f * asinf(core::min_(len * 0.5f, 1.0f));
+	}
+
+	void sampleKeyFrame(const CPositionKey& early, const CPositionKey& late, f32 frame, core::vector3df& result)
+	{
+		f32 d = late.Frame - early.Frame;
+		f32 t = d > 0.0f ? (frame - early.Frame) / d : 0.0f;
+		result = early.Value + (late.Value - early.Value) * t;
+	}
+
+	void sampleKeyFrame(const CRotationKey& early, const CRotationKey& late, f32 frame, core::quaternion& result)
+	{
+		// same as CAnimationTrack::getFrameData
+		f32 d = late.Frame - early.Frame;
+		f32 t = d > 0.0f ? (late.Frame - frame) / d : 1.0f;
+		CAnimationTrack::quaternionSlerp(result, late.Value, early.Value, t);
+	}
+
+	f32 getKeyFrameError(const core::vector3df& a, const core::vector3df& b)
+	{
+		return a.getDistanceFrom(b);
+	}
+
+	f32 getKeyFrameError(const core::quaternion& a, const core::quaternion& b)
+	{
+		return getRotationAngle(a, b);
+	}
+
+	// the max number of keys can be removed between 2 kept keys,
+	// it limits the check of each key, so the reduction is linear
+	const u32 MaxReduceKeySpan = 32;
+
+	template<class T>
+	void reduceKeyFrames(core::array<CKeyFrameData<T>>& keys, f32 tolerance)
+	{
+		u32 numKey = keys.size();
+		if (numKey <= 2)
+			return;
+
+		core::array<CKeyFrameData<T>> result;
+		result.reallocate(numKey);
+		result.push_back(keys[0]);
+
+		u32 anchor = 0;
+		T value;
+
+		for (u32 i = 2; i < numKey; i++)
+		{
+			// check all the keys between anchor and i can be interpolated
+			bool canRemove = i - anchor <= MaxReduceKeySpan;
+			for (u32 j = anchor + 1; j < i; j++)
+			{
+				sampleKeyFrame(keys[anchor], keys[i], keys[j].Frame, value);
+				if (getKeyFrameError(value, keys[j].Value) > tolerance)
+				{
+					canRemove = false;
+					break;
+				}
+			}
+
+			if (!canRemove)
+			{
+				anchor = i - 1;
+				result.push_back(keys[anchor]);
+			}
+		}
+
+		result.push_back(keys[numKey - 1]);
+
+		keys = result;
+	}
+
+	void CAnimationData::compress(f32 positionTolerance, f32 rotationTolerance, f32 scaleTolerance, bool quantizeRotation)
+	{
+		reduceKeyFrames(Positions.Data, positionTolerance);
+		reduceKeyFrames(Scales.Data, scaleTolerance);
+
+		if (Rotations.size() == 0)
+			return;
+
+		reduceKeyFrames(Rotations.Data, rotationTolerance);
+
+		if (quantizeRotation)
+		{
+			u32 numKey = Rotations.size();
+			QuantizedRotations.Data.set_used(numKey);
+
+			for (u32 i = 0; i < numKey; i++)
+			{
+				QuantizedRotations.Data[i].Frame = Rotations.Data[i].Frame;
+				QuantizedRotations.Data[i].Value.encode(Rotations.Data[i].Value);
+			}
+
+			QuantizedRotations.Default.encode(Rotations.Default);
+
+			// free the raw keys
+			Rotations.Data.clear();
+			Rotations.clearHint();
+		}
+
+		Positions.clearHint();
+		Scales.clearHint();
+	}
+
+	u32 CAnimationData::getNumRotationKey()
+	{
+		if (isQuantizedRotation())
+			return QuantizedRotations.size();
+		return Rotations.size();
+	}
+
+	void CAnimationData::getRotationKey(u32 i, CRotationKey& key)
+	{
+		if (isQuantizedRotation())
+		{
+			const CQuantizedRotationKey& q = QuantizedRotations.Data[i];
+			key.Frame = q.Frame;
+			q.Value.decode(key.Value);
+		}
+		else
+		{
+			key = Rotations.Data[i];
+		}
+	}
+
+	f32 CAnimationData::getLastFrame()
+	{
+		f32 frame = Positions.getLastFrame();
+		frame = core::max_(frame, Rotations.getLastFrame());
+		frame = core::max_(frame, QuantizedRotations.getLastFrame());
+		frame = core::max_(frame, Scales.getLastFrame());
+		return frame;
+	}
 }
\ No newline at end of file
@@ -34,9 +34,22 @@ namespace Skylicht
 		T Value;
 	};
 
+	/// @brief The rotation that is compressed in 8 bytes (smallest three).
+	/// The largest component is dropped and rebuilt from the other three components.
+	struct SKYLICHT_API CQuantizedQuaternion
+	{
+		s16 Value[3];
+		u16 Largest;
+
+		void encode(const core::quaternion& q);
+
+		void decode(core::quaternion& q) const;
+	};
+
 	typedef CKeyFrameData<core::vector3df> CPositionKey;
 	typedef CKeyFrameData<core::quaternion> CRotationKey;
 	typedef CKeyFrameData<core::vector3df> CScaleKey;
+	typedef CKeyFrameData<CQuantizedQuaternion> CQuantizedRotationKey;
 
 	template<class T>
 	class SKYLICHT_API CArrayKeyFrame
@@ -60,6 +73,10 @@ namespace Skylicht
 
 		int getIndex(f32 frame);
 
+		/// @brief Same as getIndex, but the search starts at the cursor of the caller.
+		/// The animation is sampled with the increasing frame, so the key is usually found in a few steps.
+		int getIndex(f32 frame, int& cursor);
+
 		inline u32 size()
 		{
 			return Data.size();
@@ -119,6 +136,73 @@ namespace Skylicht
 		return foundPositionIndex;
 	}
 
+	template<class T>
+	int CArrayKeyFrame<T>::getIndex(f32 frame, int& cursor)
+	{
+		int numKey = (int)Data.size();
+		CKeyFrameData<T>* pData = Data.pointer();
+
+		if (numKey == 0 || pData[numKey - 1].Frame < frame)
+			return -1;
+
+		int i = cursor;
+		if (i < 0 || i >= numKey)
+			i = 0;
+
+		int step = 0;
+		if (pData[i].Frame >= frame)
+		{
+			// search backward
+			while (i > 0 && pData[i - 1].Frame >= frame && step < 4)
+			{
+				i--;
+				step++;
+			}
+
+			if (i > 0 && pData[i - 1].Frame >= frame)
+			{
+				// binary search in [0, i)
+				int low = 0, high = i;
+				while (low < high)
+				{
+					int mid = (low + high) >> 1;
+					if (pData[mid].Frame < frame)
+						low = mid + 1;
+					else
+						high = mid;
+				}
+				i = low;
+			}
+		}
+		else
+		{
+			// search forward, the last key is >= frame
+			while (pData[i].Frame < frame && step < 4)
+			{
+				i++;
+				step++;
+			}
+
+			if (pData[i].Frame < frame)
+			{
+				// binary search in (i, numKey)
+				int low = i + 1, high = numKey - 1;
+				while (low < high)
+				{
+					int mid = (low + high) >> 1;
+					if (pData[mid].Frame < frame)
+						low = mid + 1;
+					else
+						high = mid;
+				}
+				i = low;
+			}
+		}
+
+		cursor = i;
+		return i;
+	}
+
 	class SKYLICHT_API CAnimationData
 	{
 	public:
@@ -126,9 +210,31 @@ namespace Skylicht
 		CArrayKeyFrame<core::quaternion> Rotations;
 		CArrayKeyFrame<core::vector3df> Scales;
 
+		// the rotation keys after compress, Rotations is empty if it is used
+		CArrayKeyFrame<CQuantizedQuaternion> QuantizedRotations;
+
 		CAnimationData()
 		{
 		}
+
+		inline bool isQuantizedRotation()
+		{
+			return QuantizedRotations.size() > 0;
+		}
+
+		/// @brief Remove the keys that can be interpolated from the neighbor keys within the tolerance,
+		/// and quantize the rotation keys if quantizeRotation is true.
+		/// @param positionTolerance max distance of position
+		/// @param rotationTolerance max angle of rotation (radian)
+		/// @param scaleTolerance max distance of scale
+		void compress(f32 positionTolerance, f32 rotationTolerance, f32 scaleTolerance, bool quantizeRotation);
+
+		u32 getNumRotationKey();
+
+		/// @brief Get the rotation key, it works with both raw and quantized rotation
+		void getRotationKey(u32 i, CRotationKey& key);
+
+		f32 getLastFrame();
 	};
 
 	class SKYLICHT_API CAnimationTrack
@@ -137,6 +243,11 @@ namespace Skylicht
 
 		CAnimationData* m_data;
 
+		// the cursors of last sample keys, each track (skeleton) has its own cursors
+		int m_positionCursor;
+		int m_rotationCursor;
+		int m_scaleCursor;
+
 	public:
 		std::string Name;
 
@@ -167,6 +278,8 @@ namespace Skylicht
 
 			m_data = NULL;
 
+			resetCursor();
+
 			Name = "";
 			HaveAnimation = false;
 		}
@@ -174,6 +287,15 @@ namespace Skylicht
 		void setAnimationData(CAnimationData* data)
 		{
 			m_data = data;
+
+			resetCursor();
+		}
+
+		inline void resetCursor()
+		{
+			m_positionCursor = 0;
+			m_rotationCursor = 0;
+			m_scaleCursor = 0;
 		}
 
 		CAnimationData* getFrameData()
@@ -184,9 +184,7 @@ namespace Skylicht
 				track.setAnimationData(&anim->Data);
 
 				// get anim duration
-				float totalFrame = anim->Data.Positions.getLastFrame();
-				totalFrame = core::max_(totalFrame, anim->Data.Rotations.getLastFrame());
-				totalFrame = core::max_(totalFrame, anim->Data.Scales.getLastFrame());
+				float totalFrame = anim->Data.getLastFrame();
 
 				if (m_timeline.Duration < totalFrame)
 					m_timeline.Duration = totalFrame;
@@ -249,7 +247,8 @@ namespace Skylicht
 
 			u32 numEntities = (u32)m_entitiesData.size();
 
-			core::matrix4* worldTemp = new core::matrix4[numEntities];
+			m_worldTemp.set_used(numEntities);
+			core::matrix4* worldTemp = m_worldTemp.pointer();
 			int ret = 0;
 
 			for (u32 i = 0; i < numEntities; i++)
@@ -284,7 +283,6 @@ namespace Skylicht
 				}
 			}
 
-			delete[]worldTemp;
 			return ret;
 		}
 
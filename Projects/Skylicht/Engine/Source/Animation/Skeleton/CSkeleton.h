@@ -70,6 +70,9 @@ namespace Skylicht
 
 		EAnimationLayerType m_layerType;
 
+		// scratch buffer of simulateTransform
+		core::array<core::matrix4> m_worldTemp;
+
 	protected:
 
 		CSkeleton* m_target;
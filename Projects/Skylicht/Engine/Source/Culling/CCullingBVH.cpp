@@ -0,0 +1,511 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CCullingBVH.h"
+
+namespace Skylicht
+{
+	inline f32 getBoxArea(const core::aabbox3df& box)
+	{
+		core::vector3df e = box.MaxEdge - box.MinEdge;
+		return 2.0f * (e.X * e.Y + e.Y * e.Z + e.Z * e.X);
+	}
+
+	inline core::aabbox3df getUnionBox(const core::aabbox3df& a, const core::aabbox3df& b)
+	{
+		core::aabbox3df ret(a);
+		ret.addInternalBox(b);
+		return ret;
+	}
+
+	CCullingBVH::CCullingBVH() :
+		m_root(-1),
+		m_freeList(-1),
+		m_proxyCount(0),
+		m_margin(0.1f)
+	{
+	}
+
+	CCullingBVH::~CCullingBVH()
+	{
+	}
+
+	void CCullingBVH::clear()
+	{
+		m_nodes.set_used(0);
+		m_root = -1;
+		m_freeList = -1;
+		m_proxyCount = 0;
+	}
+
+	s32 CCullingBVH::allocateNode()
+	{
+		s32 nodeId;
+
+		if (m_freeList == -1)
+		{
+			nodeId = (s32)m_nodes.size();
+			m_nodes.push_back(SNode());
+		}
+		else
+		{
+			nodeId = m_freeList;
+			m_freeList = m_nodes[nodeId].Parent;
+		}
+
+		SNode& node = m_nodes[nodeId];
+		node.Parent = -1;
+		node.Child1 = -1;
+		node.Child2 = -1;
+		node.Height = 0;
+		node.UserData = -1;
+		return nodeId;
+	}
+
+	void CCullingBVH::freeNode(s32 nodeId)
+	{
+		SNode& node = m_nodes[nodeId];
+		node.Parent = m_freeList;
+		node.Height = -1;
+		m_freeList = nodeId;
+	}
+
+	s32 CCullingBVH::createProxy(const core::aabbox3df& box, s32 userData)
+	{
+		s32 proxyId = allocateNode();
+
+		// fat box
+		core::vector3df d = (box.MaxEdge - box.MinEdge) * 0.1f + core::vector3df(m_margin, m_margin, m_margin);
+
+		SNode& node = m_nodes[proxyId];
+		node.Box.MinEdge = box.MinEdge - d;
+		node.Box.MaxEdge = box.MaxEdge + d;
+		node.UserData = userData;
+
+		insertLeaf(proxyId);
+
+		m_proxyCount++;
+		return proxyId;
+	}
+
+	void CCullingBVH::destroyProxy(s32 proxyId)
+	{
+		removeLeaf(proxyId);
+		freeNode(proxyId);
+
+		m_proxyCount--;
+	}
+
+	bool CCullingBVH::moveProxy(s32 proxyId, const core::aabbox3df& box)
+	{
+		if (box.isFullInside(m_nodes[proxyId].Box))
+			return false;
+
+		removeLeaf(proxyId);
+
+		core::vector3df d = (box.MaxEdge - box.MinEdge) * 0.1f + core::vector3df(m_margin, m_margin, m_margin);
+
+		SNode& node = m_nodes[proxyId];
+		node.Box.MinEdge = box.MinEdge - d;
+		node.Box.MaxEdge = box.MaxEdge + d;
+
+		insertLeaf(proxyId);
+		return true;
+	}
+
+	s32 CCullingBVH::getHeight() const
+	{
+		if (m_root == -1)
+			return 0;
+		return m_nodes[m_root].Height;
+	}
+
+	void CCullingBVH::insertLeaf(s32 leaf)
+	{
+		if (m_root == -1)
+		{
+			m_root = leaf;
+			m_nodes[leaf].Parent = -1;
+			return;
+		}
+
+		// find the best sibling, that have the lowest surface area cost
+		core::aabbox3df leafBox = m_nodes[leaf].Box;
+		s32 index = m_root;
+
+		while (m_nodes[index].isLeaf() == false)
+		{
+			const SNode& node = m_nodes[index];
+			s32 child1 = node.Child1;
+			s32 child2 = node.Child2;
+
+			f32 area = getBoxArea(node.Box);
+			f32 combinedArea = getBoxArea(getUnionBox(node.Box, leafBox));
+
+			// cost of creating a new parent for this node and the new leaf
+			f32 cost = 2.0f * combinedArea;
+
+			// minimum cost of pushing the leaf further down the tree
+			f32 inheritanceCost = 2.0f * (combinedArea - area);
+
+			const SNode& node1 = m_nodes[child1];
+			f32 cost1 = getBoxArea(getUnionBox(leafBox, node1.Box)) + inheritanceCost;
+			if (node1.isLeaf() == false)
+				cost1 -= getBoxArea(node1.Box);
+
+			const SNode& node2 = m_nodes[child2];
+			f32 cost2 = getBoxArea(getUnionBox(leafBox, node2.Box)) + inheritanceCost;
+			if (node2.isLeaf() == false)
+				cost2 -= getBoxArea(node2.Box);
+
+			if (cost < cost1 && cost < cost2)
+				break;
+
+			index = cost1 < cost2 ? child1 : child2;
+		}
+
+		s32 sibling = index;
+
+		// create a new parent
+		s32 oldParent = m_nodes[sibling].Parent;
+		s32 newParent = allocateNode();
+
+		SNode& parentNode = m_nodes[newParent];
+		parentNode.Parent = oldParent;
+		parentNode.Box = getUnionBox(leafBox, m_nodes[sibling].Box);
+		parentNode.Height = m_nodes[sibling].Height + 1;
+		parentNode.Child1 = sibling;
+		parentNode.Child2 = leaf;
+
+		if (oldParent != -1)
+		{
+			if (m_nodes[oldParent].Child1 == sibling)
+				m_nodes[oldParent].Child1 = newParent;
+			else
+				m_nodes[oldParent].Child2 = newParent;
+		}
+		else
+		{
+			m_root = newParent;
+		}
+
+		m_nodes[sibling].Parent = newParent;
+		m_nodes[leaf].Parent = newParent;
+
+		// walk back up the tree fixing heights and boxes
+		fixUpward(newParent);
+	}
+
+	void CCullingBVH::removeLeaf(s32 leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = -1;
+			return;
+		}
+
+		s32 parent = m_nodes[leaf].Parent;
+		s32 grandParent = m_nodes[parent].Parent;
+		s32 sibling = m_nodes[parent].Child1 == leaf ? m_nodes[parent].Child2 : m_nodes[parent].Child1;
+
+		if (grandParent != -1)
+		{
+			// destroy parent and connect sibling to grand parent
+			if (m_nodes[grandParent].Child1 == parent)
+				m_nodes[grandParent].Child1 = sibling;
+			else
+				m_nodes[grandParent].Child2 = sibling;
+
+			m_nodes[sibling].Parent = grandParent;
+			freeNode(parent);
+
+			fixUpward(grandParent);
+		}
+		else
+		{
+			m_root = sibling;
+			m_nodes[sibling].Parent = -1;
+			freeNode(parent);
+		}
+	}
+
+	void CCullingBVH::fixUpward(s32 index)
+	{
+		while (index != -1)
+		{
+			index = balance(index);
+
+			SNode& node = m_nodes[index];
+			const SNode& node1 = m_nodes[node.Child1];
+			const SNode& node2 = m_nodes[node.Child2];
+
+			node.Height = 1 + core::max_(node1.Height, node2.Height);
+			node.Box = getUnionBox(node1.Box, node2.Box);
+
+			index = node.Parent;
+		}
+	}
+
+	s32 CCullingBVH::balance(s32 iA)
+	{
+		SNode* A = &m_nodes[iA];
+		if (A->isLeaf() || A->Height < 2)
+			return iA;
+
+		s32 iB = A->Child1;
+		s32 iC = A->Child2;
+		SNode* B = &m_nodes[iB];
+		SNode* C = &m_nodes[iC];
+
+		s32 diff = C->Height - B->Height;
+
+		// rotate C up
+		if (diff > 1)
+		{
+			s32 iF = C->Child1;
+			s32 iG = C->Child2;
+			SNode* F = &m_nodes[iF];
+			SNode* G = &m_nodes[iG];
+
+			// swap A and C
+			C->Child1 = iA;
+			C->Parent = A->Parent;
+			A->Parent = iC;
+
+			// A's old parent should point to C
+			if (C->Parent != -1)
+			{
+				if (m_nodes[C->Parent].Child1 == iA)
+					m_nodes[C->Parent].Child1 = iC;
+				else
+					m_nodes[C->Parent].Child2 = iC;
+			}
+			else
+			{
+				m_root = iC;
+			}
+
+			if (F->Height > G->Height)
+			{
+				C->Child2 = iF;
+				A->Child2 = iG;
+				G->Parent = iA;
+				A->Box = getUnionBox(B->Box, G->Box);
+				C->Box = getUnionBox(A->Box, F->Box);
+
+				A->Height = 1 + core::max_(B->Height, G->Height);
+				C->Height = 1 + core::max_(A->Height, F->Height);
+			}
+			else
+			{
+				C->Child2 = iG;
+				A->Child2 = iF;
+				F->Parent = iA;
+				A->Box = getUnionBox(B->Box, F->Box);
+				C->Box = getUnionBox(A->Box, G->Box);
+
+				A->Height = 1 + core::max_(B->Height, F->Height);
+				C->Height = 1 + core::max_(A->Height, G->Height);
+			}
+
+			return iC;
+		}
+
+		// rotate B up
+		if (diff < -1)
+		{
+			s32 iD = B->Child1;
+			s32 iE = B->Child2;
+			SNode* D = &m_nodes[iD];
+			SNode* E = &m_nodes[iE];
+
+			// swap A and B
+			B->Child1 = iA;
+			B->Parent = A->Parent;
+			A->Parent = iB;
+
+			// A's old parent should point to B
+			if (B->Parent != -1)
+			{
+				if (m_nodes[B->Parent].Child1 == iA)
+					m_nodes[B->Parent].Child1 = iB;
+				else
+					m_nodes[B->Parent].Child2 = iB;
+			}
+			else
+			{
+				m_root = iB;
+			}
+
+			if (D->Height > E->Height)
+			{
+				B->Child2 = iD;
+				A->Child1 = iE;
+				E->Parent = iA;
+				A->Box = getUnionBox(C->Box, E->Box);
+				B->Box = getUnionBox(A->Box, D->Box);
+
+				A->Height = 1 + core::max_(C->Height, E->Height);
+				B->Height = 1 + core::max_(A->Height, D->Height);
+			}
+			else
+			{
+				B->Child2 = iE;
+				A->Child1 = iD;
+				D->Parent = iA;
+				A->Box = getUnionBox(C->Box, D->Box);
+				B->Box = getUnionBox(A->Box, E->Box);
+
+				A->Height = 1 + core::max_(C->Height, D->Height);
+				B->Height = 1 + core::max_(A->Height, E->Height);
+			}
+
+			return iB;
+		}
+
+		return iA;
+	}
+
+	void CCullingBVH::pushLeaves(s32 nodeId, core::array<s32>& result)
+	{
+		u32 top = m_stack.size();
+		m_stack.push_back(nodeId);
+
+		while (m_stack.size() > top)
+		{
+			s32 id = m_stack.getLast();
+			m_stack.set_used(m_stack.size() - 1);
+
+			const SNode& node = m_nodes[id];
+			if (node.isLeaf())
+			{
+				result.push_back(node.UserData);
+			}
+			else
+			{
+				m_stack.push_back(node.Child1);
+				m_stack.push_back(node.Child2);
+			}
+		}
+	}
+
+	void CCullingBVH::queryFrustum(const scene::SViewFrustum& frustum, core::array<s32>& result)
+	{
+		if (m_root == -1)
+			return;
+
+		const u32 allPlanes = (1 << scene::SViewFrustum::VF_PLANE_COUNT) - 1;
+
+		// the stack of node id and the mask of planes that still need to test
+		m_stack.set_used(0);
+		m_stack.push_back(m_root);
+		m_stack.push_back((s32)allPlanes);
+
+		while (m_stack.size() > 0)
+		{
+			u32 mask = (u32)m_stack.getLast();
+			m_stack.set_used(m_stack.size() - 1);
+			s32 id = m_stack.getLast();
+			m_stack.set_used(m_stack.size() - 1);
+
+			const SNode& node = m_nodes[id];
+
+			core::vector3df c = node.Box.getCenter();
+			core::vector3df e = node.Box.MaxEdge - c;
+
+			bool outside = false;
+
+			for (int i = 0; i < scene::SViewFrustum::VF_PLANE_COUNT; i++)
+			{
+				u32 bit = 1 << i;
+				if ((mask & bit) == 0)
+					continue;
+
+				const core::plane3df& p = frustum.planes[i];
+				f32 d = p.Normal.dotProduct(c) + p.D;
+				f32 r = fabsf(p.Normal.X) * e.X + fabsf(p.Normal.Y) * e.Y + fabsf(p.Normal.Z) * e.Z;
+
+				if (d - r > core::ROUNDING_ERROR_f32)
+				{
+					outside = true;
+					break;
+				}
+
+				// the box is back of this plane, the children do not need test it
+				if (d + r < 0.0f)
+					mask &= ~bit;
+			}
+
+			if (outside)
+				continue;
+
+			if (node.isLeaf())
+			{
+				result.push_back(node.UserData);
+			}
+			else if (mask == 0)
+			{
+				// fully inside the frustum
+				pushLeaves(id, result);
+			}
+			else
+			{
+				m_stack.push_back(node.Child1);
+				m_stack.push_back((s32)mask);
+				m_stack.push_back(node.Child2);
+				m_stack.push_back((s32)mask);
+			}
+		}
+	}
+
+	void CCullingBVH::queryBox(const core::aabbox3df& box, core::array<s32>& result)
+	{
+		if (m_root == -1)
+			return;
+
+		m_stack.set_used(0);
+		m_stack.push_back(m_root);
+
+		while (m_stack.size() > 0)
+		{
+			s32 id = m_stack.getLast();
+			m_stack.set_used(m_stack.size() - 1);
+
+			const SNode& node = m_nodes[id];
+			if (node.Box.intersectsWithBox(box) == false)
+				continue;
+
+			if (node.isLeaf())
+			{
+				result.push_back(node.UserData);
+			}
+			else
+			{
+				m_stack.push_back(node.Child1);
+				m_stack.push_back(node.Child2);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+namespace Skylicht
+{
+	/// @brief The dynamic bounding volume hierarchy of axis aligned boxes (incremental AABB tree).
+	/// The leaf box is fattened, so the small movement of object do not need re-insert the leaf.
+	/// It is used to query the objects in the frustum without test all the objects.
+	class SKYLICHT_API CCullingBVH
+	{
+	public:
+		struct SNode
+		{
+			// fat box of leaf, or union box of children
+			core::aabbox3df Box;
+
+			s32 Parent;
+			s32 Child1;
+			s32 Child2;
+
+			// leaf = 0, free node = -1
+			s32 Height;
+
+			s32 UserData;
+
+			inline bool isLeaf() const
+			{
+				return Child1 == -1;
+			}
+		};
+
+	protected:
+		core::array<SNode> m_nodes;
+
+		s32 m_root;
+		s32 m_freeList;
+		s32 m_proxyCount;
+
+		f32 m_margin;
+
+		core::array<s32> m_stack;
+
+	public:
+		CCullingBVH();
+
+		virtual ~CCullingBVH();
+
+		/// @brief Remove all the proxies
+		void clear();
+
+		/// @brief Insert a box to tree
+		/// @return the proxy id
+		s32 createProxy(const core::aabbox3df& box, s32 userData);
+
+		/// @brief Remove the proxy from tree
+		void destroyProxy(s32 proxyId);
+
+		/// @brief Update the box of proxy, the leaf is only re-inserted when the box is out of its fat box
+		/// @return true if the leaf is re-inserted
+		bool moveProxy(s32 proxyId, const core::aabbox3df& box);
+
+		inline s32 getUserData(s32 proxyId) const
+		{
+			return m_nodes[proxyId].UserData;
+		}
+
+		inline const core::aabbox3df& getFatBox(s32 proxyId) const
+		{
+			return m_nodes[proxyId].Box;
+		}
+
+		inline s32 getProxyCount() const
+		{
+			return m_proxyCount;
+		}
+
+		/// @brief Height of tree, 0 if the tree has only one leaf
+		s32 getHeight() const;
+
+		/// @brief The box is extended by margin when it is inserted
+		inline void setMargin(f32 margin)
+		{
+			m_margin = margin;
+		}
+
+		/// @brief Push the user data of the leaves that are not outside the frustum to result
+		void queryFrustum(const scene::SViewFrustum& frustum, core::array<s32>& result);
+
+		/// @brief Push the user data of the leaves that intersect with the box to result
+		void queryBox(const core::aabbox3df& box, core::array<s32>& result);
+
+	protected:
+		s32 allocateNode();
+
+		void freeNode(s32 nodeId);
+
+		void insertLeaf(s32 leaf);
+
+		void removeLeaf(s32 leaf);
+
+		s32 balance(s32 nodeId);
+
+		void fixUpward(s32 nodeId);
+
+		void pushLeaves(s32 nodeId, core::array<s32>& result);
+	};
+}
\ No newline at end of file
@@ -28,6 +28,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Entity/CEntityManager.h"
 #include "RenderPipeline/IRenderPipeline.h"
 #include "Camera/CCamera.h"
+#include "Utils/CSIMDUtils.h"
 
 #include "RenderPipeline/CShadowMapRP.h"
 
@@ -46,7 +47,9 @@ namespace Skylicht
 	}
 
 	CCullingSystem::CCullingSystem() :
-		m_group(NULL)
+		m_group(NULL),
+		m_useBVH(false),
+		m_stamp(0)
 	{
 		m_pipelineType = IRenderPipeline::Mix;
 	}
@@ -125,14 +128,24 @@ namespace Skylicht
 
 	}
 
+	void CCullingSystem::enableBVH(bool b)
+	{
+		if (m_useBVH == b)
+			return;
+
+		m_useBVH = b;
+
+		// the proxies are rebuilt on next update
+		m_bvh.clear();
+		m_proxies.set_used(0);
+	}
+
 	void CCullingSystem::update(CEntityManager* entityManager)
 	{
 		IRenderPipeline* rp = entityManager->getRenderPipeline();
 		if (rp == NULL)
 			return;
 
-		core::matrix4 invTrans;
-
 		// camera
 		CCamera* camera = entityManager->getCamera();
 		u32 cameraCullingMask = camera->getCullingMask();
@@ -141,121 +154,283 @@ namespace Skylicht
 		int count = m_bboxAndMaterials.count();
 		SBBoxAndMaterial* bboxMats = m_bboxAndMaterials.pointer();
 
-		for (int i = 0; i < count; i++)
+		for (int i = 0; i < 3; i++)
+			m_center[i].set_used(count);
+
+		for (int i = 0; i < 9; i++)
+			m_halfAxis[i].set_used(count);
+
+		m_planeCulling.reset();
+
+		if (m_useBVH && !g_useCacheCulling)
 		{
-			SBBoxAndMaterial* bbBoxMat = &bboxMats[i];
+			updateBVH(bboxMats, count);
 
-			CEntity* entity = bbBoxMat->Entity;
-			CCullingData* culling = bbBoxMat->Culling;
+			// query the objects that near the frustum
+			m_queryResult.set_used(0);
 
-			if (g_useCacheCulling)
+			if (rp->getType() == IRenderPipeline::ShadowMap)
 			{
-				// if we have the last test result
-				if (culling->CameraCulled == true)
-					continue;
+				// query the box of cascade, the bounding box type casters are not tested with the planes
+				CShadowMapRP* shadowMapRP = (CShadowMapRP*)rp;
+				m_bvh.queryBox(shadowMapRP->getFrustumBox(), m_queryResult);
 			}
 			else
 			{
-				culling->CameraCulled = false;
+				m_bvh.queryFrustum(camera->getViewFrustum(), m_queryResult);
 			}
 
-			culling->Visible = true;
+			SCullingProxy* proxies = m_proxies.pointer();
 
-			// check camera mask culling
-			u32 test = cameraCullingMask & culling->CullingLayer;
-			if (test == 0)
+			for (u32 i = 0, n = m_queryResult.size(); i < n; i++)
 			{
-				culling->Visible = false;
-				continue;
-			}
+				SBBoxAndMaterial* bbBoxMat = &bboxMats[proxies[m_queryResult[i]].Slot];
+				CCullingData* culling = bbBoxMat->Culling;
 
-			// check material first
-			if (bbBoxMat->Materials != NULL)
-			{
-				CMaterial** materials = bbBoxMat->Materials->data();
-				int materialCount = (int)bbBoxMat->Materials->size();
+				culling->CameraCulled = false;
+				culling->Visible = true;
 
-				for (int j = 0; j < materialCount; j++)
+				if (isCulledByLayerOrMaterial(rp, cameraCullingMask, bbBoxMat))
 				{
-					CMaterial* m = materials[j];
-					if (m != NULL && rp->canRenderMaterial(m) == false)
-					{
-						culling->Visible = false;
-						break;
-					}
+					culling->Visible = false;
+					continue;
 				}
+
+				// the world bbox is updated in updateBVH
+				CWorldTransformData* transform = GET_ENTITY_DATA(bbBoxMat->Entity, CWorldTransformData);
+				testBoundingBox(rp, cameraBox, bbBoxMat, transform);
 			}
+		}
+		else
+		{
+			for (int i = 0; i < count; i++)
+			{
+				SBBoxAndMaterial* bbBoxMat = &bboxMats[i];
 
-			if (culling->Visible == false)
-				continue;
+				CEntity* entity = bbBoxMat->Entity;
+				CCullingData* culling = bbBoxMat->Culling;
 
-			if (g_useCacheCulling)
-				continue;
+				if (g_useCacheCulling)
+				{
+					// if we have the last test result
+					if (culling->CameraCulled == true)
+						continue;
+				}
+				else
+				{
+					culling->CameraCulled = false;
+				}
+
+				culling->Visible = true;
+
+				if (isCulledByLayerOrMaterial(rp, cameraCullingMask, bbBoxMat))
+				{
+					culling->Visible = false;
+					continue;
+				}
 
-			// transform world bbox
-			culling->BBox = *bbBoxMat->BBox;
+				if (g_useCacheCulling)
+					continue;
 
-			CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
-			transform->World.transformBoxEx(culling->BBox);
+				// transform world bbox
+				culling->BBox = *bbBoxMat->BBox;
 
-			// 1. Detect by bounding box
-			if (rp->getType() == IRenderPipeline::ShadowMap)
-			{
-				CShadowMapRP* shadowMapRP = (CShadowMapRP*)rp;
+				CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+				CSIMDUtils::transformBox(transform->World, culling->BBox);
 
-				const core::aabbox3df& box = shadowMapRP->getFrustumBox();
-				culling->CameraCulled = !culling->BBox.intersectsWithBox(box);
-				culling->Visible = !culling->CameraCulled;
-				continue;
+				testBoundingBox(rp, cameraBox, bbBoxMat, transform);
 			}
-			else
+		}
+
+		if (rp->getType() == IRenderPipeline::ShadowMap)
+			cullByFrustumPlanes(((CShadowMapRP*)rp)->getFrustum());
+		else
+			cullByFrustumPlanes(camera->getViewFrustum());
+	}
+
+	void CCullingSystem::updateBVH(SBBoxAndMaterial* bboxMats, int count)
+	{
+		m_stamp++;
+
+		for (int i = 0; i < count; i++)
+		{
+			SBBoxAndMaterial* bbBoxMat = &bboxMats[i];
+			CCullingData* culling = bbBoxMat->Culling;
+
+			u32 index = (u32)bbBoxMat->Entity->getIndex();
+			while (m_proxies.size() <= index)
+				m_proxies.push_back(SCullingProxy());
+
+			SCullingProxy& proxy = m_proxies[index];
+			proxy.Slot = i;
+			proxy.Stamp = m_stamp;
+
+			// the objects that are not in query result are culled
+			culling->CameraCulled = true;
+			culling->Visible = false;
+
+			// only refit the proxy of the moved object
+			CWorldTransformData* transform = GET_ENTITY_DATA(bbBoxMat->Entity, CWorldTransformData);
+			if (proxy.Proxy == -1 ||
+				transform->NeedValidate ||
+				transform->NeedValidateForLate ||
+				proxy.LocalBox != *bbBoxMat->BBox)
 			{
-				culling->CameraCulled = !culling->BBox.intersectsWithBox(cameraBox);
-				culling->Visible = !culling->CameraCulled;
+				proxy.LocalBox = *bbBoxMat->BBox;
+
+				culling->BBox = proxy.LocalBox;
+				CSIMDUtils::transformBox(transform->World, culling->BBox);
+
+				if (proxy.Proxy == -1)
+					proxy.Proxy = m_bvh.createProxy(culling->BBox, (s32)index);
+				else
+					m_bvh.moveProxy(proxy.Proxy, culling->BBox);
 			}
+		}
 
-			// 2. Detect algorithm
-			if (culling->Visible == true)
+		// remove the proxies of the objects that are removed or hidden
+		if (m_bvh.getProxyCount() > count)
+		{
+			for (u32 i = 0, n = m_proxies.size(); i < n; i++)
 			{
-				if (culling->Type == CCullingData::FrustumBox)
+				SCullingProxy& proxy = m_proxies[i];
+				if (proxy.Proxy != -1 && proxy.Stamp != m_stamp)
 				{
-					CWorldInverseTransformData* invTransform = GET_ENTITY_DATA(entity, CWorldInverseTransformData);
-					if (invTransform)
-					{
-						// transform the frustum to the node's current absolute transformation
-						invTrans = invTransform->WorldInverse;
-
-						SViewFrustum frust = camera->getViewFrustum();
-						frust.transform(invTrans);
-
-						core::vector3df edges[8];
-						bbBoxMat->BBox->getEdges(edges);
-
-						for (s32 i = 0; i < scene::SViewFrustum::VF_PLANE_COUNT; ++i)
-						{
-							bool boxInFrustum = false;
-							for (u32 j = 0; j < 8; ++j)
-							{
-								if (frust.planes[i].classifyPointRelation(edges[j]) != core::ISREL3D_FRONT)
-								{
-									boxInFrustum = true;
-									break;
-								}
-							}
-
-							if (!boxInFrustum)
-							{
-								culling->CameraCulled = true;
-								culling->Visible = false;
-								break;
-							}
-						}
-					} // if invTransform
+					m_bvh.destroyProxy(proxy.Proxy);
+					proxy.Proxy = -1;
 				}
 			}
 		}
 	}
 
+	bool CCullingSystem::isCulledByLayerOrMaterial(IRenderPipeline* rp, u32 cullingMask, SBBoxAndMaterial* bbBoxMat)
+	{
+		// check camera mask culling
+		u32 test = cullingMask & bbBoxMat->Culling->CullingLayer;
+		if (test == 0)
+			return true;
+
+		// check material
+		if (bbBoxMat->Materials != NULL)
+		{
+			CMaterial** materials = bbBoxMat->Materials->data();
+			int materialCount = (int)bbBoxMat->Materials->size();
+
+			for (int j = 0; j < materialCount; j++)
+			{
+				CMaterial* m = materials[j];
+				if (m != NULL && rp->canRenderMaterial(m) == false)
+					return true;
+			}
+		}
+
+		return false;
+	}
+
+	void CCullingSystem::testBoundingBox(IRenderPipeline* rp, const core::aabbox3df& cameraBox, SBBoxAndMaterial* bbBoxMat, CWorldTransformData* transform)
+	{
+		CCullingData* culling = bbBoxMat->Culling;
+
+		// 1. Detect by bounding box
+		if (rp->getType() == IRenderPipeline::ShadowMap)
+		{
+			CShadowMapRP* shadowMapRP = (CShadowMapRP*)rp;
+			culling->CameraCulled = !culling->BBox.intersectsWithBox(shadowMapRP->getFrustumBox());
+		}
+		else
+		{
+			culling->CameraCulled = !culling->BBox.intersectsWithBox(cameraBox);
+		}
+
+		culling->Visible = !culling->CameraCulled;
+
+		if (culling->Visible == false)
+			return;
+
+		// the bounding box type shadow casters only test the box of cascade
+		if (rp->getType() == IRenderPipeline::ShadowMap && culling->Type == CCullingData::BoundingBox)
+			return;
+
+		// 2. Collect the bounds to test with frustum planes
+		int id = m_planeCulling.count();
+		m_planeCulling.push(culling);
+
+		if (culling->Type == CCullingData::FrustumBox)
+		{
+			// oriented box: local box in world transform
+			const core::aabbox3df* box = bbBoxMat->BBox;
+			const f32* m = transform->World.pointer();
+
+			core::vector3df c = box->getCenter();
+			core::vector3df e = box->MaxEdge - c;
+			transform->World.transformVect(c);
+
+			m_center[0][id] = c.X;
+			m_center[1][id] = c.Y;
+			m_center[2][id] = c.Z;
+
+			const f32* extent = &e.X;
+			for (int j = 0; j < 3; j++)
+			{
+				m_halfAxis[j * 3][id] = m[j * 4] * extent[j];
+				m_halfAxis[j * 3 + 1][id] = m[j * 4 + 1] * extent[j];
+				m_halfAxis[j * 3 + 2][id] = m[j * 4 + 2] * extent[j];
+			}
+		}
+		else
+		{
+			// axis aligned world box
+			core::vector3df c = culling->BBox.getCenter();
+			core::vector3df e = culling->BBox.MaxEdge - c;
+
+			m_center[0][id] = c.X;
+			m_center[1][id] = c.Y;
+			m_center[2][id] = c.Z;
+
+			m_halfAxis[0][id] = e.X;
+			m_halfAxis[1][id] = 0.0f;
+			m_halfAxis[2][id] = 0.0f;
+			m_halfAxis[3][id] = 0.0f;
+			m_halfAxis[4][id] = e.Y;
+			m_halfAxis[5][id] = 0.0f;
+			m_halfAxis[6][id] = 0.0f;
+			m_halfAxis[7][id] = 0.0f;
+			m_halfAxis[8][id] = e.Z;
+		}
+	}
+
+	void CCullingSystem::cullByFrustumPlanes(const scene::SViewFrustum& frustum)
+	{
+		int numPlaneCulling = m_planeCulling.count();
+		if (numPlaneCulling == 0)
+			return;
+
+		const f32* center[3];
+		const f32* halfAxis[9];
+
+		for (int i = 0; i < 3; i++)
+			center[i] = m_center[i].const_pointer();
+
+		for (int i = 0; i < 9; i++)
+			halfAxis[i] = m_halfAxis[i].const_pointer();
+
+		// 3. Test the bounds with frustum planes in batches
+		m_outside.set_used(numPlaneCulling);
+		bool* outside = m_outside.pointer();
+
+		CSIMDUtils::cullOrientedBoxes(frustum, center, halfAxis, numPlaneCulling, outside);
+
+		CCullingData** cullings = m_planeCulling.pointer();
+		for (int i = 0; i < numPlaneCulling; i++)
+		{
+			if (outside[i])
+			{
+				cullings[i]->CameraCulled = true;
+				cullings[i]->Visible = false;
+			}
+		}
+	}
+
 	void CCullingSystem::render(CEntityManager* entityManager)
 	{
 
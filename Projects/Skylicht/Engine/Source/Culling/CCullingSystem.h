@@ -26,6 +26,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "CCullingData.h"
 #include "CVisibleData.h"
+#include "CCullingBVH.h"
 #include "Entity/CEntityGroup.h"
 #include "Entity/IRenderSystem.h"
 #include "Transform/CWorldTransformData.h"
@@ -53,6 +54,28 @@ namespace Skylicht
 		}
 	};
 
+	struct SCullingProxy
+	{
+		// proxy id in bvh
+		s32 Proxy;
+
+		// index in m_bboxAndMaterials
+		s32 Slot;
+
+		// the update that synced this proxy
+		u32 Stamp;
+
+		// local bbox that is used to compute the proxy box
+		core::aabbox3df LocalBox;
+
+		SCullingProxy()
+		{
+			Proxy = -1;
+			Slot = -1;
+			Stamp = 0;
+		}
+	};
+
 	class SKYLICHT_API CCullingSystem : public IRenderSystem
 	{
 	protected:
@@ -60,6 +83,19 @@ namespace Skylicht
 
 		CEntityGroup* m_group;
 
+		// the world bounds in SoA layout (center & half axis), that test with frustum planes
+		core::array<f32> m_center[3];
+		core::array<f32> m_halfAxis[9];
+		core::array<bool> m_outside;
+		CFastArray<CCullingData*> m_planeCulling;
+
+		// the world bounds in bvh, that query by camera frustum or shadow box
+		bool m_useBVH;
+		CCullingBVH m_bvh;
+		core::array<SCullingProxy> m_proxies;
+		core::array<s32> m_queryResult;
+		u32 m_stamp;
+
 	public:
 		CCullingSystem();
 
@@ -77,8 +113,31 @@ namespace Skylicht
 
 		virtual void postRender(CEntityManager* entityManager);
 
+		/// @brief Use the bvh of world bounds to query the objects in frustum, instead of test all the objects
+		void enableBVH(bool b);
+
+		inline bool isEnableBVH()
+		{
+			return m_useBVH;
+		}
+
+		inline CCullingBVH* getBVH()
+		{
+			return &m_bvh;
+		}
+
 		static void useCacheCulling(bool b);
 
 		static bool useCacheCulling();
+
+	protected:
+
+		void updateBVH(SBBoxAndMaterial* bboxMats, int count);
+
+		bool isCulledByLayerOrMaterial(IRenderPipeline* rp, u32 cullingMask, SBBoxAndMaterial* bbBoxMat);
+
+		void testBoundingBox(IRenderPipeline* rp, const core::aabbox3df& cameraBox, SBBoxAndMaterial* bbBoxMat, CWorldTransformData* transform);
+
+		void cullByFrustumPlanes(const scene::SViewFrustum& frustum);
 	};
 }
\ No newline at end of file
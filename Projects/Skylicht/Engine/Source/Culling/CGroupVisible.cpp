@@ -35,6 +35,7 @@ namespace Skylicht
 		CEntityGroup(NULL, 0)
 	{
 		m_dataTypes.push_back(DATA_TYPE_INDEX(CVisibleData));
+		m_incrementalQuery = true;
 	}
 
 	CGroupVisible::~CGroupVisible()
@@ -75,4 +76,31 @@ namespace Skylicht
 		m_needQuery = false;
 		m_needValidate = true;
 	}
+
+	bool CGroupVisible::isEntityInGroup(CEntityManager* entityManager, CEntity* entity)
+	{
+		if (!entity->isAlive())
+			return false;
+
+		CVisibleData* visible = GET_ENTITY_DATA(entity, CVisibleData);
+		if (visible == NULL)
+			return false;
+
+		CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+
+		visible->SelfVisible = entity->isVisible();
+		visible->Visible = visible->SelfVisible;
+		visible->Culled = false;
+
+		if (visible->Visible == true && transform != NULL && transform->ParentIndex >= 0)
+		{
+			// the parent is sorted before the child, so parent visible is updated
+			CEntity* parentEntity = entityManager->getEntity(transform->ParentIndex);
+			CVisibleData* parentVisible = GET_ENTITY_DATA(parentEntity, CVisibleData);
+			if (parentVisible)
+				visible->Visible = parentVisible->Visible;
+		}
+
+		return visible->Visible;
+	}
 }
\ No newline at end of file
@@ -35,5 +35,7 @@ namespace Skylicht
 		virtual ~CGroupVisible();
 
 		virtual void onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity);
+
+		virtual bool isEntityInGroup(CEntityManager* entityManager, CEntity* entity);
 	};
 }
\ No newline at end of file
@@ -63,6 +63,12 @@ namespace Skylicht
 			return m_count;
 		}
 
+		inline void setCount(int count)
+		{
+			if (count < m_count)
+				m_count = count;
+		}
+
 		void push(T element)
 		{
 			if (m_count + 1 >= m_alloc)
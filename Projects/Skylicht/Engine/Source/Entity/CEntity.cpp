@@ -37,6 +37,10 @@ namespace Skylicht
 	CEntity::CEntity(CEntityManager* mgr) :
 		m_alive(true),
 		m_visible(true),
+		m_changed(false),
+		m_created(false),
+		m_inAlives(false),
+		m_signature(0),
 		m_mgr(mgr)
 	{
 		m_index = mgr->getNumEntities();
@@ -48,6 +52,10 @@ namespace Skylicht
 	CEntity::CEntity(CEntityPrefab* mgr) :
 		m_alive(true),
 		m_visible(true),
+		m_changed(false),
+		m_created(false),
+		m_inAlives(false),
+		m_signature(0),
 		m_mgr(NULL)
 	{
 		m_index = mgr->getNumEntities();
@@ -61,14 +69,24 @@ namespace Skylicht
 		removeAllData();
 	}
 
+	void CEntity::setID(const char* id)
+	{
+		std::string oldID = m_id;
+		m_id = id;
+
+		if (m_mgr != NULL)
+			m_mgr->updateEntityID(this, oldID);
+	}
+
 	bool CEntity::removeData(u32 index)
 	{
 		if (Data[index])
 		{
 			notifyUpdateGroup(index);
 
-			delete Data[index];
+			releaseData(Data[index]);
 			Data[index] = NULL;
+			m_signature &= ~((u64)1 << index);
 			return true;
 		}
 
@@ -78,7 +96,17 @@ namespace Skylicht
 	IEntityData* CEntity::addDataByActivator(const char* dataType)
 	{
 		IActivatorObject* obj = CActivator::getInstance()->createInstance(dataType);
+		return addActivatorData(obj, dataType);
+	}
+
+	IEntityData* CEntity::addDataByActivatorID(int activatorID, const char* dataType)
+	{
+		IActivatorObject* obj = CActivator::getInstance()->createInstance(activatorID);
+		return addActivatorData(obj, dataType);
+	}
 
+	IEntityData* CEntity::addActivatorData(IActivatorObject* obj, const char* dataType)
+	{
 		IEntityData* data = dynamic_cast<IEntityData*>(obj);
 		if (data == NULL)
 		{
@@ -98,10 +126,11 @@ namespace Skylicht
 		int index = CEntityDataTypeManager::getDataIndex(typeid(*data));
 
 		if (Data[index])
-			delete Data[index];
+			releaseData(Data[index]);
 
 		// save at index
 		Data[index] = data;
+		m_signature |= ((u64)1 << index);
 
 		notifyUpdateGroup(index);
 
@@ -114,8 +143,9 @@ namespace Skylicht
 		{
 			if (Data[i])
 			{
-				delete Data[i];
+				releaseData(Data[i]);
 				Data[i] = NULL;
+				m_signature &= ~((u64)1 << i);
 
 				notifyUpdateGroup(i);
 			}
@@ -126,7 +156,9 @@ namespace Skylicht
 	{
 		if (m_visible != b)
 		{
-			notifyUpdateGroup(DATA_TYPE_INDEX(CVisibleData));
+			// the visible of childs is changed, so query all the group
+			if (m_mgr)
+				m_mgr->notifyUpdateGroup(DATA_TYPE_INDEX(CVisibleData));
 
 			// see: CIndirectLightingSystem, CReflectionProbeSystem
 			CWorldTransformData* transformData = GET_ENTITY_DATA(this, CWorldTransformData);
@@ -137,9 +169,24 @@ namespace Skylicht
 		}
 	}
 
+	CEntityDataStorage* CEntity::getDataStorage()
+	{
+		if (m_mgr)
+			return m_mgr->getDataStorage();
+		return NULL;
+	}
+
+	void CEntity::releaseData(IEntityData* data)
+	{
+		if (data->DataPool)
+			data->DataPool->release(data);
+		else
+			delete data;
+	}
+
 	void CEntity::notifyUpdateGroup(int type)
 	{
 		if (m_mgr)
-			m_mgr->notifyUpdateGroup(type);
+			m_mgr->notifyUpdateEntity(this, type);
 	}
 }
\ No newline at end of file
@@ -26,6 +26,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "IEntityData.h"
 #include "CEntityDataTypeManager.h"
+#include "CEntityDataStorage.h"
 
 namespace Skylicht
 {
@@ -38,8 +39,6 @@ namespace Skylicht
 
 #define GET_LIST_ENTITY_DATA2(DataType1, DataType2) { DataType1##_DataTypeIndex, DataType2##_DataTypeIndex }
 
-#define MAX_ENTITY_DATA 64
-
 	class SKYLICHT_API CEntity
 	{
 		friend class CEntityManager;
@@ -51,6 +50,14 @@ namespace Skylicht
 		int m_index;
 		std::string m_id;
 
+		// state for the incremental sort, see CEntityManager::applyChangedEntities
+		bool m_changed;
+		bool m_created;
+		bool m_inAlives;
+
+		// bit i is set when Data[i] != NULL, see CEntityGroup::onQuery
+		u64 m_signature;
+
 		CEntityManager* m_mgr;
 	public:
 
@@ -70,6 +77,9 @@ namespace Skylicht
 
 		IEntityData* addDataByActivator(const char* dataType);
 
+		/// @brief Add data by the id from CActivator::getTypeID
+		IEntityData* addDataByActivatorID(int activatorID, const char* dataType);
+
 		inline int getDataCount()
 		{
 			return MAX_ENTITY_DATA;
@@ -80,10 +90,7 @@ namespace Skylicht
 			return Data[dataIndex];
 		}
 
-		inline void setID(const char* id)
-		{
-			m_id = id;
-		}
+		void setID(const char* id);
 
 		inline std::string& getID()
 		{
@@ -100,6 +107,11 @@ namespace Skylicht
 
 		void removeAllData();
 
+		inline u64 getSignature()
+		{
+			return m_signature;
+		}
+
 		inline int getIndex()
 		{
 			return m_index;
@@ -115,12 +127,26 @@ namespace Skylicht
 			return m_visible;
 		}
 
+		inline bool isCreated()
+		{
+			return m_created;
+		}
+
 		void setVisible(bool b);
 
 		void notifyUpdateGroup(int type);
 
+		CEntityDataStorage* getDataStorage();
+
 	protected:
 
+		template<class T>
+		T* createData(u32 index);
+
+		void releaseData(IEntityData* data);
+
+		IEntityData* addActivatorData(IActivatorObject* obj, const char* dataType);
+
 		inline void setAlive(bool b)
 		{
 			m_alive = b;
@@ -128,10 +154,22 @@ namespace Skylicht
 
 	};
 
+	template<class T>
+	T* CEntity::createData(u32 index)
+	{
+		CEntityDataStorage* storage = getDataStorage();
+		if (storage)
+			return storage->createData<T>(index);
+		return new T();
+	}
+
 	template<class T>
 	T* CEntity::addData()
 	{
-		T* newData = new T();
+		// get index of type
+		u32 index = CEntityDataTypeManager::getDataIndex(typeid(T));
+
+		T* newData = createData<T>(index);
 		IEntityData* data = dynamic_cast<IEntityData*>(newData);
 		if (data == NULL)
 		{
@@ -139,22 +177,20 @@ namespace Skylicht
 			sprintf(exceptionInfo, "CEntity::addData %s must inherit IEntityData", typeid(T).name());
 			os::Printer::log(exceptionInfo);
 
-			delete newData;
+			releaseData(newData);
 			return NULL;
 		}
 
-		// get index of type
-		u32 index = CEntityDataTypeManager::getDataIndex(typeid(T));
-
 		// also save this entity index
 		data->EntityIndex = m_index;
 		data->Entity = this;
 
 		if (Data[index])
-			delete Data[index];
+			releaseData(Data[index]);
 
 		// save at index
 		Data[index] = newData;
+		m_signature |= ((u64)1 << index);
 
 		notifyUpdateGroup(index);
 
@@ -164,7 +200,7 @@ namespace Skylicht
 	template<class T>
 	T* CEntity::addData(int index)
 	{
-		T* newData = new T();
+		T* newData = createData<T>((u32)index);
 		IEntityData* data = dynamic_cast<IEntityData*>(newData);
 		if (data == NULL)
 		{
@@ -172,7 +208,7 @@ namespace Skylicht
 			sprintf(exceptionInfo, "CEntity::addData %s must inherit IEntityData", typeid(T).name());
 			os::Printer::log(exceptionInfo);
 
-			delete newData;
+			releaseData(newData);
 			return NULL;
 		}
 
@@ -181,10 +217,11 @@ namespace Skylicht
 		data->Entity = this;
 
 		if (Data[index])
-			delete Data[index];
+			releaseData(Data[index]);
 
 		// save at index
 		Data[index] = newData;
+		m_signature |= ((u64)1 << index);
 
 		notifyUpdateGroup(index);
 
@@ -217,8 +254,9 @@ namespace Skylicht
 
 		if (Data[index])
 		{
-			delete Data[index];
+			releaseData(Data[index]);
 			Data[index] = NULL;
+			m_signature &= ~((u64)1 << index);
 
 			notifyUpdateGroup(index);
 
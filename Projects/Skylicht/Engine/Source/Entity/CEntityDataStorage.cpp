@@ -0,0 +1,110 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CEntityDataStorage.h"
+
+namespace Skylicht
+{
+	CEntityDataPool::CEntityDataPool(u32 size, u32 chunkCapacity) :
+		m_chunkCapacity(chunkCapacity),
+		m_used(0)
+	{
+		// align 16 bytes for the matrix data
+		m_stride = (size + 15) & ~15;
+	}
+
+	CEntityDataPool::~CEntityDataPool()
+	{
+		for (u32 i = 0, n = m_chunks.size(); i < n; i++)
+			delete[] m_chunks[i];
+		m_chunks.clear();
+	}
+
+	void* CEntityDataPool::alloc(u32& slot)
+	{
+		if (m_free.size() > 0)
+		{
+			// reuse the released slot
+			u32 last = m_free.size() - 1;
+			slot = m_free[last];
+			m_free.erase(last);
+		}
+		else
+		{
+			slot = m_used;
+
+			// need new chunk
+			if (slot >= getAllocCount())
+			{
+				m_chunks.push_back(new u8[m_stride * m_chunkCapacity]);
+
+				u32 numMask = getAllocCount() / 32 + 1;
+				while (m_alive.size() < numMask)
+					m_alive.push_back(0);
+			}
+		}
+
+		m_used++;
+		m_alive[slot >> 5] |= (1 << (slot & 31));
+
+		u8* chunk = m_chunks[slot / m_chunkCapacity];
+		return chunk + (slot % m_chunkCapacity) * m_stride;
+	}
+
+	void CEntityDataPool::release(IEntityData* data)
+	{
+		u32 slot = data->DataSlot;
+
+		// call the virtual destructor, the memory is kept on chunk
+		data->~IEntityData();
+
+		m_alive[slot >> 5] &= ~(1 << (slot & 31));
+		m_free.push_back(slot);
+		m_used--;
+	}
+
+	CEntityDataStorage::CEntityDataStorage(u32 chunkCapacity) :
+		m_chunkCapacity(chunkCapacity)
+	{
+		for (int i = 0; i < MAX_ENTITY_DATA; i++)
+			m_pools[i] = NULL;
+	}
+
+	CEntityDataStorage::~CEntityDataStorage()
+	{
+		for (int i = 0; i < MAX_ENTITY_DATA; i++)
+		{
+			if (m_pools[i])
+				delete m_pools[i];
+		}
+	}
+
+	CEntityDataPool* CEntityDataStorage::getPool(u32 index, u32 size)
+	{
+		if (m_pools[index] == NULL)
+			m_pools[index] = new CEntityDataPool(size, m_chunkCapacity);
+		return m_pools[index];
+	}
+}
@@ -0,0 +1,149 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "IEntityData.h"
+
+namespace Skylicht
+{
+	class CEntityDataStorage;
+
+	/// @brief Chunked memory pool that stores all the entity data of one type.
+	/// The data is constructed in place (placement new), so the same data type of the entities is contiguous in memory.
+	/// The address of a data never changes while it is alive, so GET_ENTITY_DATA and the data pointers still work.
+	class SKYLICHT_API CEntityDataPool
+	{
+		friend class CEntityDataStorage;
+
+	protected:
+		u32 m_stride;
+		u32 m_chunkCapacity;
+		u32 m_used;
+
+		core::array<u8*> m_chunks;
+		core::array<u32> m_free;
+
+		// 1 bit per slot, the released slot is not alive
+		core::array<u32> m_alive;
+
+	public:
+		CEntityDataPool(u32 size, u32 chunkCapacity);
+
+		virtual ~CEntityDataPool();
+
+		void* alloc(u32& slot);
+
+		void release(IEntityData* data);
+
+		inline u32 getStride()
+		{
+			return m_stride;
+		}
+
+		inline u32 getChunkCapacity()
+		{
+			return m_chunkCapacity;
+		}
+
+		inline u32 getChunkCount()
+		{
+			return m_chunks.size();
+		}
+
+		inline u8* getChunk(u32 i)
+		{
+			return m_chunks[i];
+		}
+
+		inline u32 getUsedCount()
+		{
+			return m_used;
+		}
+
+		inline u32 getAllocCount()
+		{
+			return m_chunks.size() * m_chunkCapacity;
+		}
+
+		/// @brief The slots [0, getSlotCount()) are in the chunk memory order, check isAlive before getData.
+		inline u32 getSlotCount()
+		{
+			return m_used + m_free.size();
+		}
+
+		inline bool isAlive(u32 slot)
+		{
+			return (m_alive[slot >> 5] & (1 << (slot & 31))) != 0;
+		}
+
+		/// @brief Get the data at slot, T is the type that created the data in this pool.
+		template<class T>
+		inline T* getData(u32 slot)
+		{
+			return (T*)(m_chunks[slot / m_chunkCapacity] + (slot % m_chunkCapacity) * m_stride);
+		}
+	};
+
+	/// @brief The storage hold one CEntityDataPool for each entity data type index.
+	/// @see CEntityManager::enableDataStorage
+	class SKYLICHT_API CEntityDataStorage
+	{
+	protected:
+		CEntityDataPool* m_pools[MAX_ENTITY_DATA];
+
+		u32 m_chunkCapacity;
+
+	public:
+		CEntityDataStorage(u32 chunkCapacity = 1024);
+
+		virtual ~CEntityDataStorage();
+
+		template<class T>
+		T* createData(u32 index);
+
+		CEntityDataPool* getPool(u32 index, u32 size);
+
+		inline CEntityDataPool* getPool(u32 index)
+		{
+			return m_pools[index];
+		}
+	};
+
+	template<class T>
+	T* CEntityDataStorage::createData(u32 index)
+	{
+		CEntityDataPool* pool = getPool(index, (u32)sizeof(T));
+
+		u32 slot = 0;
+		void* mem = pool->alloc(slot);
+
+		T* newData = new (mem) T();
+
+		IEntityData* data = newData;
+		data->DataPool = pool;
+		data->DataSlot = slot;
+		return newData;
+	}
+}
@@ -38,6 +38,8 @@ namespace Skylicht
 
 #define DATA_TYPE_INDEX(type) type##_DataTypeIndex
 
+#define MAX_ENTITY_DATA 64
+
 	class SKYLICHT_API CEntityDataTypeManager
 	{
 	public:
@@ -24,24 +24,45 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CEntityGroup.h"
+#include "CEntityManager.h"
+#include "Thread/CJobSystem.h"
+
+// the entities are matched in parallel when the query has more entities than this
+#define PARALLEL_QUERY_MIN_ENTITY 4096
+#define PARALLEL_QUERY_BATCH 1024
 
 namespace Skylicht
 {
 	CEntityGroup::CEntityGroup(const u32* dataTypes, int count) :
 		m_needQuery(true),
 		m_needValidate(true),
-		m_parentGroup(NULL)
+		m_parentGroup(NULL),
+		m_incrementalQuery(false),
+		m_membershipChanged(false),
+		m_membershipValid(false),
+		m_signature(0)
 	{
 		for (int i = 0; i < count; i++)
+		{
 			m_dataTypes.push_back(dataTypes[i]);
+			m_signature |= ((u64)1 << dataTypes[i]);
+		}
 	}
 
 	CEntityGroup::CEntityGroup(const u32* dataTypes, int count, CEntityGroup* parentGroup) :
 		m_needQuery(true),
-		m_parentGroup(parentGroup)
+		m_needValidate(true),
+		m_parentGroup(parentGroup),
+		m_incrementalQuery(false),
+		m_membershipChanged(false),
+		m_membershipValid(false),
+		m_signature(0)
 	{
 		for (int i = 0; i < count; i++)
+		{
 			m_dataTypes.push_back(dataTypes[i]);
+			m_signature |= ((u64)1 << dataTypes[i]);
+		}
 	}
 
 	CEntityGroup::~CEntityGroup()
@@ -51,9 +72,6 @@ namespace Skylicht
 
 	void CEntityGroup::onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity)
 	{
-		u32* types = m_dataTypes.pointer();
-		int count = m_dataTypes.size();
-
 		m_entities.reset();
 
 		if (m_parentGroup)
@@ -62,28 +80,158 @@ namespace Skylicht
 			entities = m_parentGroup->getEntities();
 		}
 
+		System::CJobSystem* jobSystem = NULL;
+		if (numEntity >= PARALLEL_QUERY_MIN_ENTITY && entityManager->isMultiThreadUpdate())
+		{
+			jobSystem = System::CJobSystem::getInstance();
+			if (jobSystem->getNumWorker() == 0)
+				jobSystem = NULL;
+		}
+
+		if (jobSystem)
+		{
+			// match the signature in parallel batches, then collect in order
+			m_match.set_used(numEntity);
+			u8* match = m_match.pointer();
+			u64 signature = m_signature;
+
+			jobSystem->parallelFor(numEntity, PARALLEL_QUERY_BATCH,
+				[entities, match, signature](int begin, int end)
+				{
+					for (int i = begin; i < end; i++)
+						match[i] = (entities[i]->getSignature() & signature) == signature ? 1 : 0;
+				});
+
+			for (int i = 0; i < numEntity; i++)
+			{
+				if (match[i])
+					m_entities.push(entities[i]);
+			}
+		}
+		else
+		{
+			for (int i = 0; i < numEntity; i++)
+			{
+				CEntity* entity = entities[i];
+				if (isMatchSignature(entity))
+					m_entities.push(entity);
+			}
+		}
+
+		// keep the depth order of the alive entities, the transform systems
+		// need the parent before the child
+
+		m_needQuery = false;
+		m_needValidate = true;
+		m_membershipValid = false;
+	}
+
+	bool CEntityGroup::isEntityInGroup(CEntityManager* entityManager, CEntity* entity)
+	{
+		if (!entity->isAlive())
+			return false;
+
+		if (m_parentGroup && !m_parentGroup->contains(entity))
+			return false;
+
+		return isMatchSignature(entity);
+	}
+
+	void CEntityGroup::onQueryChanged(CEntityManager* entityManager, CEntity** entities, int numEntity)
+	{
+		if (numEntity == 0)
+			return;
+
+		// make sure the membership is built
+		contains(entities[0]);
+
+		bool needCompact = false;
+		u32 numEntityIndex = (u32)entityManager->getNumEntities();
+		if (m_membership.size() < numEntityIndex)
+		{
+			u32 oldSize = m_membership.size();
+			m_membership.set_used(numEntityIndex);
+			memset(m_membership.pointer() + oldSize, 0, numEntityIndex - oldSize);
+		}
+
+		u8* membership = m_membership.pointer();
+
+		// remove the entities that are not in group, or re-created
 		for (int i = 0; i < numEntity; i++)
 		{
 			CEntity* entity = entities[i];
-			bool selectEntity = true;
+			int id = entity->getIndex();
 
-			for (int j = 0; j < count; j++)
+			if (membership[id] && (entity->isCreated() || !isEntityInGroup(entityManager, entity)))
 			{
-				if (entity->Data[types[j]] == NULL)
-				{
-					selectEntity = false;
-					break;
-				}
+				membership[id] = 0;
+				needCompact = true;
 			}
+		}
+
+		if (needCompact)
+		{
+			CEntity** list = m_entities.pointer();
+			int count = m_entities.count();
+			int n = 0;
 
-			if (selectEntity)
+			for (int i = 0; i < count; i++)
 			{
+				if (membership[list[i]->getIndex()])
+					list[n++] = list[i];
+			}
+
+			m_entities.setCount(n);
+
+			m_membershipChanged = true;
+		}
+
+		// append the new entities, they are sorted by depth
+		for (int i = 0; i < numEntity; i++)
+		{
+			CEntity* entity = entities[i];
+			int id = entity->getIndex();
+
+			if (!membership[id] && isEntityInGroup(entityManager, entity))
+			{
+				membership[id] = 1;
 				m_entities.push(entity);
+				m_membershipChanged = true;
 			}
 		}
 
-		m_needQuery = false;
-		m_needValidate = true;
+		if (m_membershipChanged)
+			m_needValidate = true;
+	}
+
+	bool CEntityGroup::contains(CEntity* entity)
+	{
+		validateMembership();
+
+		u32 id = (u32)entity->getIndex();
+		return id < m_membership.size() && m_membership[id] != 0;
+	}
+
+	void CEntityGroup::validateMembership()
+	{
+		if (!m_membershipValid)
+		{
+			CEntity** entities = m_entities.pointer();
+			int count = m_entities.count();
+
+			u32 size = 0;
+			for (int i = 0; i < count; i++)
+				size = core::max_(size, (u32)entities[i]->getIndex() + 1);
+
+			m_membership.set_used(size);
+			if (size > 0)
+				memset(m_membership.pointer(), 0, size);
+
+			for (int i = 0; i < count; i++)
+				m_membership[entities[i]->getIndex()] = 1;
+
+			m_membershipValid = true;
+		}
 	}
 
 	bool CEntityGroup::haveDataType(u32 type)
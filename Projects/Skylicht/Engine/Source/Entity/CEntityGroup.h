@@ -36,6 +36,9 @@ namespace Skylicht
 	protected:
 		core::array<u32> m_dataTypes;
 
+		// the bits of m_dataTypes, the entity is matched if it has all the bits
+		u64 m_signature;
+
 		CEntityGroup* m_parentGroup;
 
 		// needQuery tell this group will query again at next frame
@@ -46,6 +49,17 @@ namespace Skylicht
 
 		CFastArray<CEntity*> m_entities;
 
+		// the group can update by the changed entities, instead of query all entities
+		bool m_incrementalQuery;
+		bool m_membershipChanged;
+
+		// membership by entity index, it's built on demand after onQuery
+		core::array<u8> m_membership;
+		bool m_membershipValid;
+
+		// the match result of onQuery, that is computed in parallel
+		core::array<u8> m_match;
+
 	public:
 		CEntityGroup(const u32* dataTypes, int count);
 
@@ -55,6 +69,35 @@ namespace Skylicht
 
 		virtual void onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity);
 
+		virtual void onQueryChanged(CEntityManager* entityManager, CEntity** entities, int numEntity);
+
+		virtual bool isEntityInGroup(CEntityManager* entityManager, CEntity* entity);
+
+		bool contains(CEntity* entity);
+
+		/// @brief Build the membership that contains uses, so contains can be called on the worker threads after it.
+		void validateMembership();
+
+		inline void enableIncrementalQuery(bool b)
+		{
+			m_incrementalQuery = b;
+		}
+
+		inline bool isIncrementalQuery()
+		{
+			return m_incrementalQuery;
+		}
+
+		inline bool isMembershipChanged()
+		{
+			return m_membershipChanged;
+		}
+
+		inline void resetMembershipChanged()
+		{
+			m_membershipChanged = false;
+		}
+
 		inline CEntity** getEntities()
 		{
 			return m_entities.pointer();
@@ -87,6 +130,16 @@ namespace Skylicht
 
 		bool haveDataType(u32 type);
 
+		inline u64 getSignature()
+		{
+			return m_signature;
+		}
+
+		inline bool isMatchSignature(CEntity* entity)
+		{
+			return (entity->getSignature() & m_signature) == m_signature;
+		}
+
 		inline CEntityGroup* getParent()
 		{
 			return m_parentGroup;
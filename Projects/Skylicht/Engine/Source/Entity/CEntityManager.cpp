@@ -26,6 +26,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CEntityManager.h"
 
 #include "Transform/CTransformComponentSystem.h"
+#include "Animation/CAnimationSystem.h"
 #include "Transform/CWorldTransformSystem.h"
 #include "Transform/CWorldInverseTransformSystem.h"
 #include "RenderMesh/CMeshRenderer.h"
@@ -44,17 +45,25 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "IndirectLighting/CIndirectLightingSystem.h"
 #include "Debug/CDebugRenderer.h"
 
+#include "Thread/CJobSystem.h"
+
 namespace Skylicht
 {
 	CEntityManager::CEntityManager() :
 		m_camera(NULL),
 		m_renderPipeline(NULL),
 		m_systemChanged(true),
-		m_needSortEntities(true)
+		m_needSortEntities(true),
+		m_dataStorage(NULL),
+		m_useDataStorage(false),
+		m_multiThreadUpdate(false),
+		m_fullSortCount(0),
+		m_incrementalSortCount(0)
 	{
 		// core engine systems
 		addSystem<CVisibleSystem>();
 		addSystem<CComponentTransformSystem>();
+		addSystem<CAnimationSystem>();
 		addSystem<CWorldTransformSystem>();
 		addSystem<CWorldInverseTransformSystem>();
 		addSystem<CJointAnimationSystem>();
@@ -82,10 +91,25 @@ namespace Skylicht
 		releaseAllEntities();
 		releaseAllSystems();
 		releaseAllGroups();
+
+		// release after all entities, that the data is destroyed
+		if (m_dataStorage)
+			delete m_dataStorage;
+	}
+
+	void CEntityManager::enableDataStorage(bool b)
+	{
+		if (b && m_dataStorage == NULL)
+			m_dataStorage = new CEntityDataStorage();
+
+		m_useDataStorage = b;
 	}
 
 	void CEntityManager::releaseAllEntities()
 	{
+		m_changedEntities.reset();
+		m_alives.set_used(0);
+
 		CEntity** entities = m_entities.pointer();
 		for (u32 i = 0, n = m_entities.size(); i < n; i++)
 		{
@@ -95,6 +119,7 @@ namespace Skylicht
 
 		m_entities.set_used(0);
 		m_unused.set_used(0);
+		m_entityByID.clear();
 
 		notifyUpdateSortEntities();
 	}
@@ -124,20 +149,22 @@ namespace Skylicht
 			int last = (int)m_unused.size() - 1;
 
 			CEntity* entity = m_unused[last];
-			initDefaultData(entity);
 			entity->setAlive(true);
+			initDefaultData(entity);
 
 			m_unused.erase(last);
 
-			notifyUpdateSortEntities();
+			entity->m_created = true;
+			notifyChangedEntity(entity);
 			return entity;
 		}
 
 		CEntity* entity = new CEntity(this);
-		initDefaultData(entity);
 		m_entities.push_back(entity);
+		initDefaultData(entity);
 
-		notifyUpdateSortEntities();
+		entity->m_created = true;
+		notifyChangedEntity(entity);
 		return entity;
 	}
 
@@ -149,13 +176,15 @@ namespace Skylicht
 		for (int i = 0; i < num; i++)
 		{
 			CEntity* entity = new CEntity(this);
+			m_entities.push_back(entity);
 			initDefaultData(entity);
 
-			m_entities.push_back(entity);
+			entity->m_created = true;
+			notifyChangedEntity(entity);
+
 			entities.push_back(entity);
 		}
 
-		notifyUpdateSortEntities();
 		return entities.pointer();
 	}
 
@@ -206,31 +235,33 @@ namespace Skylicht
 
 	CEntity* CEntityManager::getEntityByID(const char* id)
 	{
-		CEntity** e = m_entities.pointer();
-		u32 count = m_entities.size();
+		std::unordered_map<std::string, CEntity*>::iterator i = m_entityByID.find(id);
+		if (i == m_entityByID.end())
+			return NULL;
+
+		CEntity* entity = i->second;
+		if (!entity->isAlive())
+			return NULL;
+
+		return entity;
+	}
 
-		for (u32 i = 0; i < count; i++, e++)
+	void CEntityManager::updateEntityID(CEntity* entity, const std::string& oldID)
+	{
+		if (!oldID.empty())
 		{
-			CEntity* entity = (*e);
-			if (entity->isAlive() &&
-				!entity->getID().empty() &&
-				entity->getID() == id)
-			{
-				return entity;
-			}
+			std::unordered_map<std::string, CEntity*>::iterator i = m_entityByID.find(oldID);
+			if (i != m_entityByID.end() && i->second == entity)
+				m_entityByID.erase(i);
 		}
 
-		return NULL;
+		if (!entity->getID().empty())
+			m_entityByID[entity->getID()] = entity;
 	}
 
 	void CEntityManager::removeEntity(int index)
 	{
-		CEntity* entity = m_entities[index];
-		entity->setAlive(false);
-		entity->removeAllData();
-		m_unused.push_back(entity);
-
-		notifyUpdateSortEntities();
+		removeEntity(m_entities[index]);
 	}
 
 	void CEntityManager::removeEntity(CEntity* entity)
@@ -239,7 +270,11 @@ namespace Skylicht
 		entity->removeAllData();
 		m_unused.push_back(entity);
 
-		notifyUpdateSortEntities();
+		// the entity will be reused, so clear the id
+		if (!entity->getID().empty())
+			entity->setID("");
+
+		notifyChangedEntity(entity);
 	}
 
 	void CEntityManager::sortAliveEntities()
@@ -258,6 +293,8 @@ namespace Skylicht
 		{
 			CEntity* entity = entities[i];
 
+			entity->m_inAlives = entity->isAlive();
+
 			if (entity->isAlive())
 			{
 				CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
@@ -297,7 +334,139 @@ namespace Skylicht
 		}
 		m_alives.set_used(count);
 
+		// all the changed entities are sorted
+		CEntity** changed = m_changedEntities.pointer();
+		for (int i = 0, n = m_changedEntities.count(); i < n; i++)
+		{
+			changed[i]->m_changed = false;
+			changed[i]->m_created = false;
+		}
+		m_changedEntities.reset();
+
 		m_needSortEntities = false;
+		m_fullSortCount++;
+	}
+
+	int CEntityManager::computeEntityDepth(CEntity* entity)
+	{
+		int depth = 0;
+
+		CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
+		while (world != NULL && depth < MAX_ENTITY_DEPTH - 1)
+		{
+			int parentID = world->AttachParentIndex >= 0 ? world->AttachParentIndex : world->ParentIndex;
+			if (parentID < 0)
+				break;
+
+			world = GET_ENTITY_DATA(m_entities[parentID], CWorldTransformData);
+
+			depth++;
+		}
+
+		return depth;
+	}
+
+	void CEntityManager::applyChangedEntities()
+	{
+		int numChanged = m_changedEntities.count();
+
+		// too many changes, the full sort is faster
+		if ((u32)numChanged * 4 > m_alives.size())
+		{
+			notifyUpdateSortEntities();
+			sortAliveEntities();
+			return;
+		}
+
+		CEntity** changed = m_changedEntities.pointer();
+
+		// remove the dead or re-created entities from the alive list
+		bool needCompact = false;
+		for (int i = 0; i < numChanged; i++)
+		{
+			CEntity* entity = changed[i];
+			if (entity->m_inAlives && (!entity->isAlive() || entity->m_created))
+			{
+				entity->m_inAlives = false;
+				needCompact = true;
+			}
+		}
+
+		if (needCompact)
+		{
+			CEntity** alives = m_alives.pointer();
+			u32 count = 0;
+			for (u32 i = 0, n = m_alives.size(); i < n; i++)
+			{
+				if (alives[i]->m_inAlives)
+					alives[count++] = alives[i];
+			}
+			m_alives.set_used(count);
+		}
+
+		// sort the changed entities by depth, so the parent is added before the child
+		for (int i = 0; i < numChanged; i++)
+		{
+			CEntity* entity = changed[i];
+			CWorldTransformData* world = entity->isAlive() ? GET_ENTITY_DATA(entity, CWorldTransformData) : NULL;
+			if (world)
+				world->Depth = computeEntityDepth(entity);
+		}
+
+		struct {
+			bool operator()(CEntity* a, CEntity* b) const
+			{
+				CWorldTransformData* worldA = a->isAlive() ? GET_ENTITY_DATA(a, CWorldTransformData) : NULL;
+				CWorldTransformData* worldB = b->isAlive() ? GET_ENTITY_DATA(b, CWorldTransformData) : NULL;
+
+				int depthA = worldA ? worldA->Depth : 0;
+				int depthB = worldB ? worldB->Depth : 0;
+				return depthA < depthB;
+			}
+		} customLess;
+
+		std::stable_sort(changed, changed + numChanged, customLess);
+
+		for (int i = 0; i < numChanged; i++)
+		{
+			CEntity* entity = changed[i];
+			if (entity->isAlive() && !entity->m_inAlives)
+			{
+				m_alives.push_back(entity);
+				entity->m_inAlives = true;
+			}
+		}
+
+		// update the groups, the parent group is created before the child group
+		u32 numGroup = m_groups.size();
+		for (u32 i = 0; i < numGroup; i++)
+			m_groups[i]->resetMembershipChanged();
+
+		for (u32 i = 0; i < numGroup; i++)
+		{
+			CEntityGroup* g = m_groups[i];
+			CEntityGroup* parent = g->getParent();
+
+			if (parent && parent->needQuery())
+				g->notifyNeedQuery();
+
+			if (g->needQuery())
+				continue;
+
+			if (g->isIncrementalQuery())
+				g->onQueryChanged(this, changed, numChanged);
+			else if (parent == NULL || parent->isMembershipChanged())
+				g->notifyNeedQuery();
+		}
+
+		for (int i = 0; i < numChanged; i++)
+		{
+			changed[i]->m_changed = false;
+			changed[i]->m_created = false;
+		}
+		m_changedEntities.reset();
+
+		m_incrementalSortCount++;
 	}
 
 	void CEntityManager::sortSystem()
@@ -318,6 +487,53 @@ namespace Skylicht
 		} customLess;
 
 		std::sort(m_sortUpdate.begin(), m_sortUpdate.end(), customLess);
+
+		buildUpdateStages();
+	}
+
+	void CEntityManager::buildUpdateStages()
+	{
+		m_updateStages.clear();
+
+		if (!m_multiThreadUpdate)
+			return;
+
+		// the stage of system is after the last stage that have a conflict system
+		// so the systems still update in order if they read/write the same data
+		std::vector<int> systemStage;
+
+		for (size_t i = 0, n = m_sortUpdate.size(); i < n; i++)
+		{
+			IEntitySystem* s = m_sortUpdate[i];
+			if (s->isRenderSystem())
+			{
+				systemStage.push_back(-1);
+				continue;
+			}
+
+			int stage = 0;
+			for (size_t j = 0; j < i; j++)
+			{
+				if (systemStage[j] >= stage && s->isConflictDataAccess(m_sortUpdate[j]))
+					stage = systemStage[j] + 1;
+			}
+
+			systemStage.push_back(stage);
+
+			if (stage >= (int)m_updateStages.size())
+				m_updateStages.resize(stage + 1);
+
+			m_updateStages[stage].push_back(s);
+		}
+	}
+
+	void CEntityManager::updateSystem(IEntitySystem* system)
+	{
+		CEntity** entities = m_alives.pointer();
+		int numEntity = (int)m_alives.size();
+
+		system->onQuery(this, entities, numEntity);
+		system->update(this);
 	}
 
 	void CEntityManager::update()
@@ -332,8 +548,16 @@ namespace Skylicht
 			s->beginQuery(this);
 		}
 
+		for (IEntitySystem*& s : m_sortUpdate)
+		{
+			if (!s->isRenderSystem())
+				s->preQuery(this);
+		}
+
 		if (m_needSortEntities)
 			sortAliveEntities();
+		else if (m_changedEntities.count() > 0)
+			applyChangedEntities();
 
 		CEntity** entities = m_alives.pointer();
 		int numEntity = (int)m_alives.size();
@@ -347,13 +571,41 @@ namespace Skylicht
 				g->onQuery(this, entities, numEntity);
 		}
 
-		for (IEntitySystem*& s : m_sortUpdate)
+		System::CJobSystem* jobSystem = m_multiThreadUpdate ? System::CJobSystem::getInstance() : NULL;
+
+		if (jobSystem && jobSystem->getNumWorker() > 0)
 		{
-			// note: Render system will be updated in cullingAndRender function
-			if (!s->isRenderSystem())
+			for (std::vector<IEntitySystem*>& stage : m_updateStages)
 			{
-				s->onQuery(this, entities, numEntity);
-				s->update(this);
+				if (stage.size() == 1)
+				{
+					updateSystem(stage[0]);
+					continue;
+				}
+
+				System::CJobGroup group;
+
+				for (size_t i = 1, n = stage.size(); i < n; i++)
+				{
+					IEntitySystem* s = stage[i];
+					jobSystem->run([this, s]() { updateSystem(s); }, &group);
+				}
+
+				updateSystem(stage[0]);
+
+				jobSystem->wait(&group);
+			}
+		}
+		else
+		{
+			for (IEntitySystem*& s : m_sortUpdate)
+			{
+				// note: Render system will be updated in cullingAndRender function
+				if (!s->isRenderSystem())
+				{
+					s->onQuery(this, entities, numEntity);
+					s->update(this);
+				}
 			}
 		}
 	}
@@ -417,10 +669,21 @@ namespace Skylicht
 	}
 
 	void CEntityManager::cullingAndRender()
+	{
+		cullingAndRenderView(false);
+	}
+
+	void CEntityManager::cullingAndRenderNextView()
+	{
+		cullingAndRenderView(true);
+	}
+
+	void CEntityManager::cullingAndRenderView(bool nextView)
 	{
 		for (IRenderSystem*& s : m_renders)
 		{
-			s->beginQuery(this);
+			if (!nextView || s->isUpdatePerView())
+				s->beginQuery(this);
 		}
 
 		if (m_systemChanged == true)
@@ -434,6 +697,9 @@ namespace Skylicht
 
 		for (IRenderSystem*& s : m_renders)
 		{
+			if (nextView && !s->isUpdatePerView())
+				continue;
+
 			s->onQuery(this, entities, numEntity);
 			s->update(this);
 		}
@@ -504,6 +770,7 @@ namespace Skylicht
 
 		if (release == true)
 		{
+			m_systemChanged = true;
 			delete system;
 			return true;
 		}
@@ -528,6 +795,7 @@ namespace Skylicht
 	CEntityGroup* CEntityManager::createGroup(const u32* types, int count)
 	{
 		CEntityGroup* group = new CEntityGroup(types, count);
+		group->enableIncrementalQuery(true);
 		m_groups.push_back(group);
 		return group;
 	}
@@ -535,6 +803,7 @@ namespace Skylicht
 	CEntityGroup* CEntityManager::createGroup(const u32* types, int count, CEntityGroup* parent)
 	{
 		CEntityGroup* group = new CEntityGroup(types, count, parent);
+		group->enableIncrementalQuery(true);
 		m_groups.push_back(group);
 		return group;
 	}
@@ -599,6 +868,30 @@ namespace Skylicht
 		}
 	}
 
+	void CEntityManager::notifyChangedEntity(CEntity* entity)
+	{
+		if (!entity->m_changed)
+		{
+			entity->m_changed = true;
+			m_changedEntities.push(entity);
+		}
+	}
+
+	void CEntityManager::notifyUpdateEntity(CEntity* entity, u32 dataType)
+	{
+		notifyChangedEntity(entity);
+
+		// the custom group can't update by the changed entities
+		u32 count = m_groups.size();
+		for (u32 i = 0; i < count; i++)
+		{
+			CEntityGroup* g = m_groups[i];
+
+			if (!g->isIncrementalQuery() && g->haveDataType(dataType))
+				g->notifyNeedQuery();
+		}
+	}
+
 	void CEntityManager::notifyUpdateGroup(u32 dataType)
 	{
 		u32 count = m_groups.size();
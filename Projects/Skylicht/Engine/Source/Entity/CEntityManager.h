@@ -43,19 +43,35 @@ namespace Skylicht
 		core::array<CEntity*> m_entities;
 		core::array<CEntity*> m_unused;
 
+		// entity id => entity, see CEntity::setID
+		std::unordered_map<std::string, CEntity*> m_entityByID;
+
 		core::array<CEntityGroup*> m_groups;
 
 		CFastArray<CEntity*> m_sortDepth[MAX_ENTITY_DEPTH];
 
+		// the entities that are created, removed or changed data since last update
+		CFastArray<CEntity*> m_changedEntities;
+
+		u32 m_fullSortCount;
+		u32 m_incrementalSortCount;
+
 		std::vector<IEntitySystem*> m_systems;
 		std::vector<IRenderSystem*> m_renders;
 
 		std::vector<IEntitySystem*> m_sortUpdate;
 		std::vector<IRenderSystem*> m_sortRender;
 
+		// the systems in a stage do not conflict data, so they can run parallel
+		std::vector<std::vector<IEntitySystem*>> m_updateStages;
+		bool m_multiThreadUpdate;
+
 		bool m_systemChanged;
 		bool m_needSortEntities;
 
+		CEntityDataStorage* m_dataStorage;
+		bool m_useDataStorage;
+
 		CCamera* m_camera;
 
 		IRenderPipeline* m_renderPipeline;
@@ -73,10 +89,20 @@ namespace Skylicht
 
 		void cullingAndRender();
 
+		/// @brief Cull and render the next view of the same camera (ex: the next shadow cascade).
+		/// The render systems that are not updated per view (see IRenderSystem::isUpdatePerView) keep the result of the last cullingAndRender.
+		void cullingAndRenderNextView();
+
 	protected:
 
+		void cullingAndRenderView(bool nextView);
+
 		void sortAliveEntities();
 
+		void applyChangedEntities();
+
+		int computeEntityDepth(CEntity* entity);
+
 	public:
 
 		inline void setCamera(CCamera* camera)
@@ -99,6 +125,38 @@ namespace Skylicht
 			return m_renderPipeline;
 		}
 
+		/// @brief Store the entity data in chunks (contiguous by data type) instead of the heap.
+		/// It only affects the data added after this call, the existing data is kept in the heap.
+		void enableDataStorage(bool b);
+
+		inline bool isEnableDataStorage()
+		{
+			return m_useDataStorage;
+		}
+
+		inline CEntityDataStorage* getDataStorage()
+		{
+			return m_useDataStorage ? m_dataStorage : NULL;
+		}
+
+		/// @brief Run the update systems on the job system.
+		/// The systems that declare the read/write data (IEntitySystem::declareReadData, declareWriteData) and do not conflict will run in parallel.
+		inline void enableMultiThreadUpdate(bool b)
+		{
+			m_multiThreadUpdate = b;
+			m_systemChanged = true;
+		}
+
+		inline bool isMultiThreadUpdate()
+		{
+			return m_multiThreadUpdate;
+		}
+
+		inline int getNumUpdateStage()
+		{
+			return (int)m_updateStages.size();
+		}
+
 		CEntity* createEntity();
 
 		CEntity** createEntity(int num, core::array<CEntity*>& entities);
@@ -126,6 +184,9 @@ namespace Skylicht
 
 		CEntity* getEntityByID(const char* id);
 
+		/// @brief Update the id index when the entity changes its id, it is called by CEntity::setID
+		void updateEntityID(CEntity* entity, const std::string& oldID);
+
 		void removeEntity(int index);
 
 		void removeEntity(CEntity* entity);
@@ -163,6 +224,22 @@ namespace Skylicht
 
 		void notifyUpdateGroup(u32 dataType);
 
+		void notifyUpdateEntity(CEntity* entity, u32 dataType);
+
+		void notifyChangedEntity(CEntity* entity);
+
+		/// @brief The number of times that all alive entities and groups are rebuilt
+		inline u32 getFullSortCount()
+		{
+			return m_fullSortCount;
+		}
+
+		/// @brief The number of times that the alive entities and groups are updated by the changed entities
+		inline u32 getIncrementalSortCount()
+		{
+			return m_incrementalSortCount;
+		}
+
 		inline void notifySystemOrderChanged()
 		{
 			m_systemChanged = true;
@@ -175,6 +252,10 @@ namespace Skylicht
 		void sortRenderer();
 
 		void sortSystem();
+
+		void buildUpdateStages();
+
+		void updateSystem(IEntitySystem* system);
 	};
 
 	template<class T>
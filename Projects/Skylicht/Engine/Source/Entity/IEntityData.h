@@ -33,16 +33,23 @@ namespace Skylicht
 	class IMeshExporter;
 	class IMeshImporter;
 	class CEntity;
+	class CEntityDataPool;
 
 	class SKYLICHT_API IEntityData : public IActivatorObject
 	{
 	public:
 		int EntityIndex;
 		CEntity* Entity;
+
+		// the pool that allocated this data (NULL if it is allocated by new)
+		CEntityDataPool* DataPool;
+		u32 DataSlot;
 	public:
 		IEntityData() :
 			EntityIndex(-1),
-			Entity(NULL)
+			Entity(NULL),
+			DataPool(NULL),
+			DataSlot(0)
 		{
 
 		}
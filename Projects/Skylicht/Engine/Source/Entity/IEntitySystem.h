@@ -35,9 +35,16 @@ namespace Skylicht
 	protected:
 		int m_systemOrder;
 
+		// the entity data types that this system read/write in update
+		// see CEntityManager::enableMultiThreadUpdate
+		core::array<u32> m_readDataTypes;
+		core::array<u32> m_writeDataTypes;
+		bool m_declaredDataAccess;
+
 	public:
 		IEntitySystem() :
-			m_systemOrder(0)
+			m_systemOrder(0),
+			m_declaredDataAccess(false)
 		{
 		}
 
@@ -53,6 +60,12 @@ namespace Skylicht
 
 		virtual void beginQuery(CEntityManager* entityManager) = 0;
 
+		/// @brief It is called after beginQuery and before the entity groups are queried in CEntityManager::update.
+		/// The system that changes the transforms (such as CAnimationSystem) do it here, so the changes are applied in the same frame.
+		virtual void preQuery(CEntityManager* entityManager)
+		{
+		}
+
 		virtual void onQuery(CEntityManager* entityManager, CEntity** entities, int count) = 0;
 
 		virtual void init(CEntityManager* entityManager) = 0;
@@ -68,5 +81,52 @@ namespace Skylicht
 		{
 			return m_systemOrder;
 		}
+
+		inline void declareReadData(u32 dataType)
+		{
+			m_readDataTypes.push_back(dataType);
+			m_declaredDataAccess = true;
+		}
+
+		inline void declareWriteData(u32 dataType)
+		{
+			m_writeDataTypes.push_back(dataType);
+			m_declaredDataAccess = true;
+		}
+
+		/// @brief The system does not read/write any entity data in update, so it can run parallel with any system.
+		inline void declareNoDataAccess()
+		{
+			m_declaredDataAccess = true;
+		}
+
+		inline bool isDeclaredDataAccess()
+		{
+			return m_declaredDataAccess;
+		}
+
+		/// @brief Check 2 systems can not run at the same time.
+		/// A system that never calls declareReadData, declareWriteData or declareNoDataAccess may touch any data, so it is always in conflict.
+		bool isConflictDataAccess(IEntitySystem* system)
+		{
+			if (!isDeclaredDataAccess() || !system->isDeclaredDataAccess())
+				return true;
+
+			for (u32 i = 0, n = m_writeDataTypes.size(); i < n; i++)
+			{
+				u32 type = m_writeDataTypes[i];
+				if (system->m_writeDataTypes.linear_search(type) >= 0 ||
+					system->m_readDataTypes.linear_search(type) >= 0)
+					return true;
+			}
+
+			for (u32 i = 0, n = m_readDataTypes.size(); i < n; i++)
+			{
+				if (system->m_writeDataTypes.linear_search(m_readDataTypes[i]) >= 0)
+					return true;
+			}
+
+			return false;
+		}
 	};
 }
\ No newline at end of file
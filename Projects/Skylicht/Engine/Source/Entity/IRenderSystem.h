@@ -50,11 +50,15 @@ namespace Skylicht
 		ERenderPass m_renderPass;
 		int m_sortingPriority;
 
+		// false if the update only depends on the camera, not the view that is rendered (ex: a shadow cascade)
+		bool m_updatePerView;
+
 	public:
 		IRenderSystem() :
 			m_pipelineType(IRenderPipeline::Forwarder),
 			m_renderPass(Opaque),
-			m_sortingPriority(0)
+			m_sortingPriority(0),
+			m_updatePerView(true)
 		{
 		}
 
@@ -103,5 +107,10 @@ namespace Skylicht
 		{
 			m_sortingPriority = s;
 		}
+
+		inline bool isUpdatePerView()
+		{
+			return m_updatePerView;
+		}
 	};
 }
\ No newline at end of file
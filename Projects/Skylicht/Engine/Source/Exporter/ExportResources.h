@@ -30,7 +30,8 @@ namespace Skylicht
 	{
 		Unknown = 0,
 		AssetModel,
-		AssetAnimation
+		AssetAnimation,
+		AssetScene
 	};
 
 	struct SAssetHeader
@@ -39,4 +40,91 @@ namespace Skylicht
 		u32 AssetType;
 		u32 AssetVersion;
 	};
+
+	// AssetVersion of AssetModel
+	// 1: the entities are serialized one by one in CMemoryStream
+	// 2: the packed layout, that can be memory mapped (see CMappedFile)
+	//    SAssetHeader | SMeshPackHeader | type table | string table | entity table | data table | payload | blob
+	//    all offsets are from the begin of file, the sections are aligned by MESH_PACK_ALIGN
+	//    the payload is the IEntityData serialized data, the blob is the vertex and index buffers (see CRenderMeshData::serializablePack)
+#define MESH_PACK_VERSION 2
+#define MESH_PACK_ALIGN 16
+
+	struct SMeshPackHeader
+	{
+		u32 NumEntity;
+		u32 NumData;
+		u32 NumType;
+		u32 TypeOffset;
+		u32 StringOffset;
+		u32 StringSize;
+		u32 EntityOffset;
+		u32 DataOffset;
+		u32 PayloadOffset;
+		u32 PayloadSize;
+		u32 BlobOffset;
+		u32 BlobSize;
+	};
+
+	struct SMeshPackEntity
+	{
+		s32 Index;
+		u32 Visible;
+		u32 FirstData;
+		u32 NumData;
+	};
+
+	struct SMeshPackData
+	{
+		// index in the type table, that is the offset of the type name in the string table
+		u32 Type;
+
+		// offset in the payload
+		u32 Offset;
+		u32 Size;
+	};
+
+	// AssetScene: the binary scene of CSceneExporter::exportSceneBinary
+	//    SAssetHeader | SSceneBinaryHeader | string table | scene node | object table | component table | object nodes
+	//    the node is saved by CSerializableBinary, the component table is the string id of component type names
+	//    the objects are sorted by parent (the parent is before the child), so they are created in one pass
+	//    all offsets are from the begin of file, the sections are aligned by SCENE_BINARY_ALIGN, so the tables are read in place
+#define SCENE_BINARY_VERSION 1
+#define SCENE_BINARY_ALIGN 16
+
+	struct SSceneBinaryHeader
+	{
+		u32 NumString;
+		u32 StringOffset;
+		u32 SceneOffset;
+		u32 SceneSize;
+		u32 NumObject;
+		u32 ObjectOffset;
+		u32 NumComponent;
+		u32 ComponentOffset;
+		u32 PayloadOffset;
+		u32 PayloadSize;
+	};
+
+	struct SSceneBinaryObject
+	{
+		enum EObjectType
+		{
+			Zone = 0,
+			Container,
+			GameObject
+		};
+
+		u32 Type;
+
+		// index in object table, -1 is the scene
+		s32 Parent;
+
+		u32 FirstComponent;
+		u32 NumComponent;
+
+		// the node of the object in payload
+		u32 Offset;
+		u32 Size;
+	};
 }
\ No newline at end of file
@@ -97,12 +97,14 @@ namespace Skylicht
 
 			memoryAnim.writeFloatArray(&rotations.Default.X, 4);
 
-			numKey = rotations.size();
+			numKey = entityAnim->Data.getNumRotationKey();
 			memoryAnim.writeUInt(numKey);
 
+			CRotationKey rotKey;
 			for (u32 j = 0; j < numKey; j++)
 			{
-				const CRotationKey& rotKey = rotations.Data[j];
+				// the quantized rotation is exported as float
+				entityAnim->Data.getRotationKey(j, rotKey);
 				memoryAnim.writeFloat(rotKey.Frame);
 				memoryAnim.writeFloatArray(&rotKey.Value.X, 4);
 			}
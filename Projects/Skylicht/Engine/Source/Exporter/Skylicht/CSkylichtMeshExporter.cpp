@@ -24,10 +24,10 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "Entity/CEntity.h"
-#include "Exporter/ExportResources.h"
 
 #include "CSkylichtMeshExporter.h"
-#include "Utils/CMemoryStream.h"
+#include "RenderMesh/CRenderMeshData.h"
+#include "Utils/CMappedFile.h"
 
 namespace Skylicht
 {
@@ -43,37 +43,18 @@ namespace Skylicht
 
 	bool CSkylichtMeshExporter::exportModel(CEntity** entities, u32 count, const char* output)
 	{
-		IrrlichtDevice* device = getIrrlichtDevice();
-		io::IFileSystem* fs = device->getFileSystem();
-
-		io::IWriteFile* writeFile = fs->createAndWriteFile(output);
-		if (writeFile == NULL)
-			return false;
-
-		// write header
-		SAssetHeader assetHeader;
-		strcpy(assetHeader.Sign, "SLT");
-		assetHeader.AssetType = (u32)AssetModel;
-		assetHeader.AssetVersion = 1;
-		writeFile->write(&assetHeader, sizeof(SAssetHeader));
-
-		// write num of entities
-		writeFile->write(&count, sizeof(u32));
+		beginPack();
 
 		// init memory (it will grow later)
-		CMemoryStream memoryEntity(512);
 		CMemoryStream memoryData(512);
 
 		for (u32 i = 0; i < count; i++)
 		{
-			memoryEntity.resetWrite();
-
 			CEntity* entity = entities[i];
 			if (entity->isAlive() == false)
 				continue;
 
-			memoryEntity.writeInt(entity->getIndex());
-			memoryEntity.writeChar(entity->isVisible() ? 1 : 0);
+			addPackEntity(entity->getIndex(), entity->isVisible());
 
 			// entity data info
 			for (int j = 0, n = entity->getDataCount(); j < n; j++)
@@ -96,16 +77,17 @@ namespace Skylicht
 					continue;
 				}
 
-				if (data->serializable(&memoryData))
-				{
-					// size
-					memoryEntity.writeInt(memoryData.getSize());
-
-					// name					
-					memoryEntity.writeString(typeName);
+				// the vertex and index buffers are written to the blob
+				bool serializable = false;
+				CRenderMeshData* renderMesh = dynamic_cast<CRenderMeshData*>(data);
+				if (renderMesh != NULL)
+					serializable = renderMesh->serializablePack(&memoryData, &m_blob);
+				else
+					serializable = data->serializable(&memoryData);
 
-					// data
-					memoryEntity.writeStream(&memoryData);
+				if (serializable)
+				{
+					addPackData(typeName, &memoryData);
 				}
 #if _DEBUG
 				else
@@ -116,15 +98,186 @@ namespace Skylicht
 				}
 #endif
 			}
+		}
+
+		return writePack(output);
+	}
+
+	bool CSkylichtMeshExporter::convertModel(const char* input, const char* output)
+	{
+		CMappedFile file;
+		if (!file.open(input))
+			return false;
+
+		if (file.getSize() < sizeof(SAssetHeader) + sizeof(u32))
+			return false;
+
+		CMemoryStream stream((unsigned char*)file.getData(), file.getSize());
+
+		SAssetHeader assetHeader;
+		stream.readData(&assetHeader, sizeof(SAssetHeader));
+
+		if (strcmp(assetHeader.Sign, "SLT") != 0 ||
+			assetHeader.AssetType != (u32)AssetModel ||
+			assetHeader.AssetVersion != 1)
+			return false;
+
+		beginPack();
+
+		CMemoryStream memoryData(512);
+
+		// the entities are skipped if it is not alive, so check the end of file
+		u32 numEntity = stream.readUInt();
+		for (u32 i = 0; i < numEntity && stream.getPos() < stream.getSize(); i++)
+		{
+			int entityIndex = stream.readInt();
+			bool entityVisible = stream.readChar() == 1 ? true : false;
+
+			addPackEntity(entityIndex, entityVisible);
+
+			int entityDataSize = stream.readInt();
+			while (entityDataSize != -1)
+			{
+				std::string entityDataName = stream.readString();
+				u32 seek = stream.getPos();
+
+				if (entityDataSize < 0 || seek + (u32)entityDataSize > stream.getSize())
+					return false;
+
+				memoryData.resetWrite();
+
+				if (entityDataName == "CRenderMeshData")
+				{
+					CMemoryStream data(stream.getData() + seek, (u32)entityDataSize);
+					if (!CRenderMeshData::convertPack(&data, &memoryData, &m_blob))
+						return false;
+				}
+				else
+				{
+					memoryData.writeData(stream.getData() + seek, (u32)entityDataSize);
+				}
 
-			// end of entity data
-			memoryEntity.writeInt(-1);
+				addPackData(entityDataName, &memoryData);
 
-			// flush data to file
-			writeFile->write(memoryEntity.getData(), memoryEntity.getSize());
+				// go next data
+				stream.setPos(seek + entityDataSize);
+				entityDataSize = stream.readInt();
+			}
+		}
+
+		// close the input before write, that can be the same file
+		file.close();
+
+		return writePack(output);
+	}
+
+	void CSkylichtMeshExporter::beginPack()
+	{
+		m_typeIndex.clear();
+		m_types.set_used(0);
+		m_strings.resetWrite();
+		m_entities.set_used(0);
+		m_data.set_used(0);
+		m_payload.resetWrite();
+		m_blob.resetWrite();
+	}
+
+	void CSkylichtMeshExporter::addPackEntity(int index, bool visible)
+	{
+		SMeshPackEntity entity;
+		entity.Index = index;
+		entity.Visible = visible ? 1 : 0;
+		entity.FirstData = m_data.size();
+		entity.NumData = 0;
+		m_entities.push_back(entity);
+	}
+
+	void CSkylichtMeshExporter::addPackData(const std::string& typeName, CMemoryStream* data)
+	{
+		u32 type = 0;
+
+		std::map<std::string, u32>::iterator i = m_typeIndex.find(typeName);
+		if (i == m_typeIndex.end())
+		{
+			type = m_types.size();
+			m_typeIndex[typeName] = type;
+
+			m_types.push_back(m_strings.getSize());
+			m_strings.writeData(typeName.c_str(), (u32)typeName.size() + 1);
+		}
+		else
+		{
+			type = (*i).second;
 		}
 
+		SMeshPackData packData;
+		packData.Type = type;
+		packData.Offset = m_payload.getSize();
+		packData.Size = data->getSize();
+		m_data.push_back(packData);
+
+		m_payload.writeStream(data);
+
+		m_entities.getLast().NumData++;
+	}
+
+	u32 alignPackOffset(u32 offset)
+	{
+		return (offset + MESH_PACK_ALIGN - 1) & ~(MESH_PACK_ALIGN - 1);
+	}
+
+	void writePackSection(io::IWriteFile* writeFile, u32 offset, const void* data, u32 size)
+	{
+		static const char padding[MESH_PACK_ALIGN] = { 0 };
+
+		u32 pos = (u32)writeFile->getPos();
+		if (offset > pos)
+			writeFile->write(padding, offset - pos);
+
+		if (size > 0)
+			writeFile->write(data, size);
+	}
+
+	bool CSkylichtMeshExporter::writePack(const char* output)
+	{
+		SMeshPackHeader packHeader;
+		packHeader.NumEntity = m_entities.size();
+		packHeader.NumData = m_data.size();
+		packHeader.NumType = m_types.size();
+		packHeader.StringSize = m_strings.getSize();
+		packHeader.PayloadSize = m_payload.getSize();
+		packHeader.BlobSize = m_blob.getSize();
+
+		packHeader.TypeOffset = alignPackOffset(sizeof(SAssetHeader) + sizeof(SMeshPackHeader));
+		packHeader.StringOffset = alignPackOffset(packHeader.TypeOffset + packHeader.NumType * sizeof(u32));
+		packHeader.EntityOffset = alignPackOffset(packHeader.StringOffset + packHeader.StringSize);
+		packHeader.DataOffset = alignPackOffset(packHeader.EntityOffset + packHeader.NumEntity * sizeof(SMeshPackEntity));
+		packHeader.PayloadOffset = alignPackOffset(packHeader.DataOffset + packHeader.NumData * sizeof(SMeshPackData));
+		packHeader.BlobOffset = alignPackOffset(packHeader.PayloadOffset + packHeader.PayloadSize);
+
+		IrrlichtDevice* device = getIrrlichtDevice();
+		io::IFileSystem* fs = device->getFileSystem();
+
+		io::IWriteFile* writeFile = fs->createAndWriteFile(output);
+		if (writeFile == NULL)
+			return false;
+
+		// write header
+		SAssetHeader assetHeader;
+		strcpy(assetHeader.Sign, "SLT");
+		assetHeader.AssetType = (u32)AssetModel;
+		assetHeader.AssetVersion = MESH_PACK_VERSION;
+		writeFile->write(&assetHeader, sizeof(SAssetHeader));
+		writeFile->write(&packHeader, sizeof(SMeshPackHeader));
+
+		writePackSection(writeFile, packHeader.TypeOffset, m_types.const_pointer(), packHeader.NumType * sizeof(u32));
+		writePackSection(writeFile, packHeader.StringOffset, m_strings.getData(), packHeader.StringSize);
+		writePackSection(writeFile, packHeader.EntityOffset, m_entities.const_pointer(), packHeader.NumEntity * sizeof(SMeshPackEntity));
+		writePackSection(writeFile, packHeader.DataOffset, m_data.const_pointer(), packHeader.NumData * sizeof(SMeshPackData));
+		writePackSection(writeFile, packHeader.PayloadOffset, m_payload.getData(), packHeader.PayloadSize);
+		writePackSection(writeFile, packHeader.BlobOffset, m_blob.getData(), packHeader.BlobSize);
+
 		writeFile->drop();
-		return false;
+		return true;
 	}
-}
+}
\ No newline at end of file
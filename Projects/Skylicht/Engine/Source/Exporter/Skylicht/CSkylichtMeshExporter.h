@@ -25,16 +25,43 @@ https://github.com/skylicht-lab/skylicht-engine
 #pragma once
 
 #include "Exporter/IMeshExporter.h"
+#include "Exporter/ExportResources.h"
+#include "Utils/CMemoryStream.h"
 
 namespace Skylicht
 {	
+	/// @brief Export the model in the packed layout (see MESH_PACK_VERSION in ExportResources.h)
 	class SKYLICHT_API CSkylichtMeshExporter : public IMeshExporter
 	{
+	protected:
+		std::map<std::string, u32> m_typeIndex;
+		core::array<u32> m_types;
+		CMemoryStream m_strings;
+
+		core::array<SMeshPackEntity> m_entities;
+		core::array<SMeshPackData> m_data;
+
+		CMemoryStream m_payload;
+		CMemoryStream m_blob;
+
 	public:
 		CSkylichtMeshExporter();
 
 		virtual ~CSkylichtMeshExporter();
 
 		virtual bool exportModel(CEntity** entities, u32 count, const char *output);
+
+		/// @brief Convert the model of AssetVersion 1 to the packed layout
+		bool convertModel(const char* input, const char* output);
+
+	protected:
+
+		void beginPack();
+
+		void addPackEntity(int index, bool visible);
+
+		void addPackData(const std::string& typeName, CMemoryStream* data);
+
+		bool writePack(const char* output);
 	};
 }
\ No newline at end of file
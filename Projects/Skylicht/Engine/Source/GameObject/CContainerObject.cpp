@@ -73,8 +73,6 @@ namespace Skylicht
 		}
 
 		m_childs.clear();
-		m_objectByName.clear();
-		m_objectByID.clear();
 	}
 
 	core::array<CGameObject*>& CContainerObject::getArrayChilds(bool addThis)
@@ -139,6 +137,18 @@ namespace Skylicht
 		return false;
 	}
 
+	bool CContainerObject::isParentOf(CGameObject* gameObject)
+	{
+		CGameObject* parent = gameObject->getParent();
+		while (parent != NULL)
+		{
+			if (parent == this)
+				return true;
+			parent = parent->getParent();
+		}
+		return false;
+	}
+
 	template<typename T>
 	void CContainerObject::getListObjectType(ArrayGameObject& listObjs, T type)
 	{
@@ -194,9 +204,6 @@ namespace Skylicht
 			ret->startComponent();
 		}
 
-		if (ret != NULL)
-			updateIndexSearchObject();
-
 		return ret;
 	}
 
@@ -239,9 +246,6 @@ namespace Skylicht
 
 	void CContainerObject::updateIndexSearchObject()
 	{
-		m_objectByName.clear();
-		m_objectByID.clear();
-
 		for (CGameObject*& obj : m_childs)
 		{
 			registerObjectInSearchList(obj);
@@ -289,10 +293,7 @@ namespace Skylicht
 			CContainerObject* oldParent = (CContainerObject*)object->getParent();
 			ArrayGameObject::iterator i = std::find(oldParent->m_childs.begin(), oldParent->m_childs.end(), object);
 			if (i != oldParent->m_childs.end())
-			{
 				oldParent->m_childs.erase(i);
-				oldParent->updateIndexSearchObject();
-			}
 
 			// set new parent
 			object->setParent(this);
@@ -305,7 +306,6 @@ namespace Skylicht
 			++pos;
 
 		m_childs.insert(pos, object);
-		updateIndexSearchObject();
 
 		object->getTransform()->setWorldMatrix(world);
 		m_lastGenerateID = -1;
@@ -327,10 +327,7 @@ namespace Skylicht
 			CContainerObject* oldParent = (CContainerObject*)object->getParent();
 			ArrayGameObject::iterator i = std::find(oldParent->m_childs.begin(), oldParent->m_childs.end(), object);
 			if (i != oldParent->m_childs.end())
-			{
 				oldParent->m_childs.erase(i);
-				oldParent->updateIndexSearchObject();
-			}
 
 			// set new parent
 			object->setParent(this);
@@ -339,7 +336,6 @@ namespace Skylicht
 
 		// insert new position
 		m_childs.push_back(object);
-		updateIndexSearchObject();
 
 		object->getTransform()->setWorldMatrix(world);
 		m_lastGenerateID = -1;
@@ -347,80 +343,52 @@ namespace Skylicht
 
 	CGameObject* CContainerObject::searchObject(const wchar_t* objectName)
 	{
-		core::map<std::wstring, CGameObject*>::Node* node = m_objectByName.find(std::wstring(objectName));
-		if (node == NULL)
-		{
-			// try search in list add
-			for (CGameObject* addObject : m_add)
-			{
-				if (CStringImp::comp(addObject->getName(), objectName) == 0)
-				{
-					return addObject;
-				}
-			}
-
+		ArrayGameObject* objects = getScene()->getObjectsByName(objectName);
+		if (objects == NULL)
 			return NULL;
+
+		// the first added object, the bucket is not sorted
+		CGameObject* result = NULL;
+		for (CGameObject* obj : *objects)
+		{
+			if ((result == NULL || obj->getSearchOrder() < result->getSearchOrder()) && obj->getParent() == this)
+				result = obj;
 		}
 
-		return node->getValue();
+		return result;
 	}
 
 	CGameObject* CContainerObject::searchObjectInChild(const wchar_t* objectName)
 	{
-		CGameObject* result = searchObject(objectName);
-		if (result == NULL)
+		ArrayGameObject* objects = getScene()->getObjectsByName(objectName);
+		if (objects == NULL)
+			return NULL;
+
+		// the first added object, the bucket is not sorted
+		CGameObject* result = NULL;
+		for (CGameObject* obj : *objects)
 		{
-			for (CGameObject*& obj : m_childs)
-			{
-				CContainerObject* container = dynamic_cast<CContainerObject*>(obj);
-				if (container != NULL)
-				{
-					result = container->searchObjectInChild(objectName);
-					if (result != NULL)
-						return result;
-				}
-			}
+			if ((result == NULL || obj->getSearchOrder() < result->getSearchOrder()) && isParentOf(obj))
+				result = obj;
 		}
+
 		return result;
 	}
 
 	CGameObject* CContainerObject::searchObjectByID(const char* id)
 	{
-		core::map<std::string, CGameObject*>::Node* node = m_objectByID.find(std::string(id));
-		if (node == NULL)
-		{
-			// try search in list add
-			for (CGameObject* addObject : m_add)
-			{
-				if (addObject->getID() == id)
-				{
-					return addObject;
-				}
-			}
-
-			return NULL;
-		}
-
-		return node->getValue();
+		CGameObject* obj = getScene()->getObjectByID(id);
+		if (obj != NULL && obj->getParent() == this)
+			return obj;
+		return NULL;
 	}
 
 	CGameObject* CContainerObject::searchObjectInChildByID(const char* id)
 	{
-		CGameObject* result = searchObjectByID(id);
-		if (result == NULL)
-		{
-			for (CGameObject*& obj : m_childs)
-			{
-				CContainerObject* container = dynamic_cast<CContainerObject*>(obj);
-				if (container != NULL)
-				{
-					result = container->searchObjectInChildByID(id);
-					if (result != NULL)
-						return result;
-				}
-			}
-		}
-		return result;
+		CGameObject* obj = getScene()->getObjectByID(id);
+		if (obj != NULL && isParentOf(obj))
+			return obj;
+		return NULL;
 	}
 
 	CGameObject* CContainerObject::searchObjectInScene(const wchar_t* objectName)
@@ -456,8 +424,7 @@ namespace Skylicht
 
 	void CContainerObject::registerObjectInSearchList(CGameObject* obj)
 	{
-		m_objectByName[obj->getName()] = obj;
-		m_objectByID[obj->getID()] = obj;
+		getScene()->registerObject(obj);
 	}
 
 	void CContainerObject::updateAddRemoveObject(bool force)
@@ -487,9 +454,6 @@ namespace Skylicht
 					{
 						if (obj == (*iObj))
 						{
-							m_objectByName.remove(obj->getDefaultName());
-							m_objectByID.remove(obj->getID());
-
 							m_childs.erase(iObj);
 
 							delete obj;
@@ -519,6 +483,7 @@ namespace Skylicht
 	{
 		p->setParent(this);
 		m_add.push_back(p);
+		getScene()->registerObject(p);
 		m_updateRemoveAdd = true;
 		m_updateListChild = true;
 		getZone()->notifyUpdateListChild();
@@ -37,9 +37,6 @@ namespace Skylicht
 
 		core::array<CGameObject*> m_arrayChildObjects;
 
-		core::map<std::wstring, CGameObject*> m_objectByName;
-		core::map<std::string, CGameObject*> m_objectByID;
-
 		bool m_updateRemoveAdd;
 		bool m_updateListChild;
 
@@ -108,6 +105,8 @@ namespace Skylicht
 
 		bool haveChild(CGameObject* gameObject);
 
+		bool isParentOf(CGameObject* gameObject);
+
 		DECLARE_GETTYPENAME(CContainerObject)
 	};
 
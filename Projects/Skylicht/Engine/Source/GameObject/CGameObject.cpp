@@ -61,6 +61,9 @@ namespace Skylicht
 		m_enableEditorSelect = true;
 
 		m_enableEndUpdate = false;
+		m_searchIndexed = false;
+		m_searchSlot = 0;
+		m_searchOrder = 0;
 
 		m_parent = NULL;
 		m_zone = NULL;
@@ -77,6 +80,9 @@ namespace Skylicht
 
 	CGameObject::~CGameObject()
 	{
+		if (m_searchIndexed)
+			getScene()->unRegisterObject(this);
+
 		releaseAllComponent();
 		destroyEntity();
 	}
@@ -91,11 +97,47 @@ namespace Skylicht
 		}
 	}
 
+	void CGameObject::setID(const char* id)
+	{
+		if (m_searchIndexed)
+		{
+			std::string oldID = m_objectID;
+			m_objectID = id;
+			getScene()->updateObjectID(this, oldID);
+		}
+		else
+		{
+			m_objectID = id;
+		}
+	}
+
+	void CGameObject::setName(const wchar_t* lpName)
+	{
+		changeName(lpName);
+
+		if (m_defaultName == L"")
+			m_defaultName = lpName;
+	}
+
 	void CGameObject::setName(const char* lpName)
 	{
 		wchar_t name[1024];
 		CStringImp::convertUTF8ToUnicode(lpName, name);
-		m_name = name;
+		changeName(name);
+	}
+
+	void CGameObject::changeName(const wchar_t* lpName)
+	{
+		if (m_searchIndexed)
+		{
+			std::wstring oldName = m_name;
+			m_name = lpName;
+			getScene()->updateObjectName(this, oldName);
+		}
+		else
+		{
+			m_name = lpName;
+		}
 	}
 
 	const char* CGameObject::getNameA()
@@ -42,6 +42,7 @@ namespace Skylicht
 	class SKYLICHT_API CGameObject
 	{
 		friend class CDependentComponent;
+		friend class CScene;
 
 	protected:
 		std::string m_objectID;
@@ -60,6 +61,13 @@ namespace Skylicht
 		bool m_enableEditorSelect;
 		bool m_enableEndUpdate;
 
+		// the object is in the name/id index of the scene, see CScene::registerObject
+		bool m_searchIndexed;
+
+		// the position in the name bucket of the scene index, and the order it was added to the bucket
+		u32 m_searchSlot;
+		u32 m_searchOrder;
+
 		u32 m_cullingLayer;
 
 		CEntity* m_entity;
@@ -84,6 +92,8 @@ namespace Skylicht
 	protected:
 		void initNull();
 
+		void changeName(const wchar_t* lpName);
+
 	public:
 		CEntity* createEntity();
 
@@ -91,10 +101,7 @@ namespace Skylicht
 
 		void updateEntityParent();
 
-		virtual void setID(const char* id)
-		{
-			m_objectID = id;
-		}
+		virtual void setID(const char* id);
 
 		inline std::string& getID()
 		{
@@ -113,13 +120,7 @@ namespace Skylicht
 			return m_defaultName.c_str();
 		}
 
-		inline void setName(const wchar_t* lpName)
-		{
-			m_name = lpName;
-
-			if (m_defaultName == L"")
-				m_defaultName = lpName;
-		}
+		void setName(const wchar_t* lpName);
 
 		void setName(const char* lpName);
 
@@ -128,6 +129,12 @@ namespace Skylicht
 			return m_parent;
 		}
 
+		/// @brief The order the object is added to the name index of the scene, the older object has the lower order
+		inline u32 getSearchOrder()
+		{
+			return m_searchOrder;
+		}
+
 		inline CZone* getZone()
 		{
 			return m_zone;
@@ -42,6 +42,9 @@ namespace Skylicht
 
 	CZone::~CZone()
 	{
+		// release the childs while the zone can access the scene index
+		removeAllObject(true);
+		m_scene->unRegisterObject(this);
 	}
 
 	void CZone::remove()
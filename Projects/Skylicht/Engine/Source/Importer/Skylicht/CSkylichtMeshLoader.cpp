@@ -31,8 +31,10 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "Utils/CMemoryStream.h"
 #include "Utils/CActivator.h"
+#include "Utils/CMappedFile.h"
 
 #include "Transform/CWorldTransformData.h"
+#include "RenderMesh/CRenderMeshData.h"
 
 namespace Skylicht
 {
@@ -48,46 +50,40 @@ namespace Skylicht
 
 	bool CSkylichtMeshLoader::loadModel(const char* resource, CEntityPrefab* output, bool normalMap, bool flipNormalMap, bool texcoord2, bool batching)
 	{
-		IrrlichtDevice* device = getIrrlichtDevice();
-		io::IFileSystem* fs = device->getFileSystem();
-
-		io::IReadFile* readFile = fs->createAndOpenFile(resource);
-		if (readFile == NULL)
+		// the file is mapped, so the vertex data is copied once from the file to mesh buffer
+		CMappedFile file;
+		if (!file.open(resource))
 			return false;
 
-		long size = readFile->getSize();
-
-		unsigned char* data = new unsigned char[size];
-		readFile->read(data, (u32)size);
-		readFile->drop();
-
-		CMemoryStream stream(data, (u32)size);
+		if (file.getSize() < sizeof(SAssetHeader))
+			return false;
 
 		// read header
 		SAssetHeader assetHeader;
-		stream.readData(&assetHeader, sizeof(SAssetHeader));
+		memcpy(&assetHeader, file.getData(), sizeof(SAssetHeader));
 
 		if (strcmp(assetHeader.Sign, "SLT") != 0)
-		{
-			delete[] data;
 			return false;
-		}
 
 		if (assetHeader.AssetType != (u32)AssetModel)
-		{
-			delete[] data;
 			return false;
-		}
 
 		if (assetHeader.AssetVersion == 1)
+		{
+			CMemoryStream stream((unsigned char*)file.getData(), file.getSize());
+			stream.setPos(sizeof(SAssetHeader));
+
 			loadVersion(&stream, output, assetHeader.AssetVersion, normalMap, texcoord2, batching);
+		}
+		else if (assetHeader.AssetVersion == MESH_PACK_VERSION)
+		{
+			return loadPack(file.getData(), file.getSize(), output, assetHeader.AssetVersion);
+		}
 		else
 		{
-			delete[] data;
 			return false;
 		}
 
-		delete[] data;
 		return true;
 	}
 
@@ -141,4 +137,126 @@ namespace Skylicht
 			}
 		}
 	}
-}
+	bool isPackSectionValid(u32 offset, u32 size, u32 fileSize)
+	{
+		return offset <= fileSize && fileSize - offset >= size;
+	}
+
+	// compare the count, so a crafted count can not wrap the size of the array
+	bool isPackArrayValid(u32 offset, u32 count, u32 elementSize, u32 fileSize)
+	{
+		return offset <= fileSize && (fileSize - offset) / elementSize >= count;
+	}
+
+	bool CSkylichtMeshLoader::loadPack(const unsigned char* data, u32 size, CEntityPrefab* output, int version)
+	{
+		if (size < sizeof(SAssetHeader) + sizeof(SMeshPackHeader))
+			return false;
+
+		const SMeshPackHeader* header = (const SMeshPackHeader*)(data + sizeof(SAssetHeader));
+
+		if (!isPackArrayValid(header->TypeOffset, header->NumType, sizeof(u32), size) ||
+			!isPackSectionValid(header->StringOffset, header->StringSize, size) ||
+			!isPackArrayValid(header->EntityOffset, header->NumEntity, sizeof(SMeshPackEntity), size) ||
+			!isPackArrayValid(header->DataOffset, header->NumData, sizeof(SMeshPackData), size) ||
+			!isPackSectionValid(header->PayloadOffset, header->PayloadSize, size) ||
+			!isPackSectionValid(header->BlobOffset, header->BlobSize, size))
+		{
+			os::Printer::log("[CSkylichtMeshLoader::loadPack] Invalid file");
+			return false;
+		}
+
+		const u32* types = (const u32*)(data + header->TypeOffset);
+		const char* strings = (const char*)(data + header->StringOffset);
+		const SMeshPackEntity* packEntities = (const SMeshPackEntity*)(data + header->EntityOffset);
+		const SMeshPackData* packData = (const SMeshPackData*)(data + header->DataOffset);
+		unsigned char* payload = (unsigned char*)(data + header->PayloadOffset);
+		const unsigned char* blob = data + header->BlobOffset;
+
+		// lookup the activator once per type
+		CActivator* activator = CActivator::getInstance();
+
+		core::array<int> typeActivator;
+		core::array<const char*> typeName;
+		typeActivator.set_used(header->NumType);
+		typeName.set_used(header->NumType);
+
+		int transformType = -1;
+
+		for (u32 i = 0; i < header->NumType; i++)
+		{
+			if (types[i] >= header->StringSize || memchr(strings + types[i], 0, header->StringSize - types[i]) == NULL)
+			{
+				os::Printer::log("[CSkylichtMeshLoader::loadPack] Invalid type name");
+				return false;
+			}
+
+			typeName[i] = strings + types[i];
+			typeActivator[i] = activator->getTypeID(typeName[i]);
+
+			if (strcmp(typeName[i], "CWorldTransformData") == 0)
+				transformType = (int)i;
+		}
+
+		std::map<int, int> entityID;
+		int depthChange = 0;
+
+		core::array<CEntity*> entities;
+		output->createEntity((int)header->NumEntity, entities);
+
+		for (u32 i = 0; i < header->NumEntity; i++)
+		{
+			const SMeshPackEntity& packEntity = packEntities[i];
+
+			CEntity* entity = entities[i];
+			entityID[packEntity.Index] = entity->getIndex();
+
+			entity->setVisible(packEntity.Visible == 1);
+
+			if (packEntity.FirstData > header->NumData || header->NumData - packEntity.FirstData < packEntity.NumData)
+				continue;
+
+			for (u32 j = 0; j < packEntity.NumData; j++)
+			{
+				const SMeshPackData& entityData = packData[packEntity.FirstData + j];
+
+				if (entityData.Type >= header->NumType || !isPackSectionValid(entityData.Offset, entityData.Size, header->PayloadSize))
+					continue;
+
+				int activatorID = typeActivator[entityData.Type];
+				if (activatorID < 0)
+					continue;
+
+				IEntityData* data = entity->addDataByActivatorID(activatorID, typeName[entityData.Type]);
+				if (data == NULL)
+					continue;
+
+				CMemoryStream stream(payload + entityData.Offset, entityData.Size);
+
+				CRenderMeshData* renderMesh = dynamic_cast<CRenderMeshData*>(data);
+				if (renderMesh != NULL)
+					renderMesh->deserializablePack(&stream, blob, header->BlobSize, version);
+				else
+					data->deserializable(&stream, version);
+
+				// hardcode to fix transform
+				if ((int)entityData.Type == transformType)
+				{
+					CWorldTransformData* worldTransform = dynamic_cast<CWorldTransformData*>(data);
+					if (worldTransform != NULL)
+					{
+						if (i == 0)
+							depthChange = -worldTransform->Depth;
+
+						worldTransform->Depth += depthChange;
+
+						if (entityID.find(worldTransform->ParentIndex) != entityID.end())
+							worldTransform->ParentIndex = entityID[worldTransform->ParentIndex];
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
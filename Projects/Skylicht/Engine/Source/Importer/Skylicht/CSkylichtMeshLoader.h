@@ -45,5 +45,7 @@ namespace Skylicht
 	protected:
 
 		void loadVersion(CMemoryStream* stream, CEntityPrefab* output, int version, bool normalMap, bool texcoord2, bool batching);
+
+		bool loadPack(const unsigned char* data, u32 size, CEntityPrefab* output, int version);
 	};
 }
\ No newline at end of file
@@ -56,8 +56,20 @@ namespace Skylicht
 		// the render mesh index in object
 		int MeshIndex;
 
+		// the entity index of Entities, that keep the persistent slots (see CMeshRendererInstancing)
+		CFastArray<int> EntityIndex;
+
+		// the visible entities, that are not in the slots
+		CFastArray<CEntity*> NewEntities;
+
+		// the material state, that baked in the material buffers
+		core::array<CMaterial*> BatchMaterials;
+		core::array<CShaderParams> BatchParams;
+		int BatchCount;
+
 		SMeshInstancingGroup()
 		{
+			BatchCount = 0;
 			IsVertexAnimationTexture = false;
 			TransformTexture = NULL;
 			PositionTexture = NULL;
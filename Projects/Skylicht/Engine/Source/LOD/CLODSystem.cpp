@@ -36,6 +36,7 @@ namespace Skylicht
 		m_group(NULL)
 	{
 		m_pipelineType = IRenderPipeline::Mix;
+		m_updatePerView = false;
 	}
 
 	CLODSystem::~CLODSystem()
@@ -0,0 +1,298 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CLightCluster.h"
+#include "Thread/CJobSystem.h"
+
+namespace Skylicht
+{
+	CLightCluster::CLightCluster() :
+		m_numTileX(16),
+		m_numTileY(9),
+		m_numSlice(24),
+		m_near(0.1f),
+		m_far(1000.0f),
+		m_sliceScale(1.0f)
+	{
+
+	}
+
+	CLightCluster::~CLightCluster()
+	{
+
+	}
+
+	void CLightCluster::setGridSize(u32 numTileX, u32 numTileY, u32 numSlice)
+	{
+		m_numTileX = core::max_(numTileX, 1u);
+		m_numTileY = core::max_(numTileY, 1u);
+		m_numSlice = core::max_(numSlice, 1u);
+	}
+
+	s32 CLightCluster::getSlice(float z)
+	{
+		if (z <= m_near)
+			return 0;
+
+		// exponential slice, the near slices are thinner
+		s32 slice = (s32)(logf(z / m_near) * m_sliceScale);
+		return core::clamp(slice, 0, (s32)m_numSlice - 1);
+	}
+
+	void CLightCluster::computeBound(const core::vector3df& position, float radius, SLightClusterBound& bound)
+	{
+		bound.Visible = false;
+
+		core::vector3df center;
+		m_view.transformVect(center, position);
+
+		if (center.Z + radius < m_near || center.Z - radius > m_far)
+			return;
+
+		bound.MinZ = getSlice(center.Z - radius);
+		bound.MaxZ = getSlice(center.Z + radius);
+
+		bound.MinX = 0;
+		bound.MaxX = (s32)m_numTileX - 1;
+		bound.MinY = 0;
+		bound.MaxY = (s32)m_numTileY - 1;
+
+		// the sphere cross the near plane, it can cover all tiles
+		if (center.Z - radius > m_near)
+		{
+			float minX = 1.0f, maxX = -1.0f;
+			float minY = 1.0f, maxY = -1.0f;
+			float out[4];
+
+			// project the sphere bbox
+			for (int i = 0; i < 8; i++)
+			{
+				core::vector3df corner(
+					center.X + ((i & 1) ? radius : -radius),
+					center.Y + ((i & 2) ? radius : -radius),
+					center.Z + ((i & 4) ? radius : -radius)
+				);
+
+				m_projection.transformVect(out, corner);
+
+				float x = out[0] / out[3];
+				float y = out[1] / out[3];
+
+				minX = core::min_(minX, x);
+				maxX = core::max_(maxX, x);
+				minY = core::min_(minY, y);
+				maxY = core::max_(maxY, y);
+			}
+
+			if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f)
+				return;
+
+			bound.MinX = core::clamp((s32)floorf((minX + 1.0f) * 0.5f * m_numTileX), 0, (s32)m_numTileX - 1);
+			bound.MaxX = core::clamp((s32)floorf((maxX + 1.0f) * 0.5f * m_numTileX), 0, (s32)m_numTileX - 1);
+			bound.MinY = core::clamp((s32)floorf((minY + 1.0f) * 0.5f * m_numTileY), 0, (s32)m_numTileY - 1);
+			bound.MaxY = core::clamp((s32)floorf((maxY + 1.0f) * 0.5f * m_numTileY), 0, (s32)m_numTileY - 1);
+		}
+
+		bound.Visible = true;
+	}
+
+	void CLightCluster::build(const core::matrix4& view, const core::matrix4& projection,
+		float nearValue, float farValue,
+		const core::vector3df* position, const float* radius, u32 numLight,
+		bool multiThread)
+	{
+		m_view = view;
+		m_projection = projection;
+		m_near = core::max_(nearValue, 0.01f);
+		m_far = core::max_(farValue, m_near + 0.01f);
+		m_sliceScale = m_numSlice / logf(m_far / m_near);
+
+		u32 numCluster = getNumCluster();
+
+		m_clusterOffset.set_used(numCluster);
+		m_clusterCount.set_used(numCluster);
+		memset(m_clusterOffset.pointer(), 0, numCluster * sizeof(u32));
+		memset(m_clusterCount.pointer(), 0, numCluster * sizeof(u32));
+
+		m_lightIndex.set_used(0);
+		m_bounds.set_used(numLight);
+
+		if (numLight == 0)
+			return;
+
+		System::CJobSystem* jobSystem = System::CJobSystem::getInstance();
+		SLightClusterBound* bounds = m_bounds.pointer();
+
+		// 1. cluster range of each light
+		auto computeBounds = [&](int begin, int end)
+			{
+				for (int i = begin; i < end; i++)
+					computeBound(position[i], radius[i], bounds[i]);
+			};
+
+		if (multiThread)
+			jobSystem->parallelFor((int)numLight, 256, computeBounds);
+		else
+			computeBounds(0, (int)numLight);
+
+		// 2. list lights of each slice (counting sort)
+		m_sliceOffset.set_used(m_numSlice + 1);
+		u32* sliceOffset = m_sliceOffset.pointer();
+		memset(sliceOffset, 0, (m_numSlice + 1) * sizeof(u32));
+
+		for (u32 i = 0; i < numLight; i++)
+		{
+			if (bounds[i].Visible)
+			{
+				for (s32 z = bounds[i].MinZ; z <= bounds[i].MaxZ; z++)
+					sliceOffset[z + 1]++;
+			}
+		}
+
+		for (u32 z = 0; z < m_numSlice; z++)
+			sliceOffset[z + 1] += sliceOffset[z];
+
+		m_sliceLights.set_used(sliceOffset[m_numSlice]);
+		u32* sliceLights = m_sliceLights.pointer();
+
+		for (u32 i = 0; i < numLight; i++)
+		{
+			if (bounds[i].Visible)
+			{
+				for (s32 z = bounds[i].MinZ; z <= bounds[i].MaxZ; z++)
+					sliceLights[sliceOffset[z]++] = i;
+			}
+		}
+
+		// the offset moved to the next slice
+		for (u32 z = m_numSlice; z > 0; z--)
+			sliceOffset[z] = sliceOffset[z - 1];
+		sliceOffset[0] = 0;
+
+		// 3. count lights of each cluster, a slice is only written by one job
+		u32* clusterOffset = m_clusterOffset.pointer();
+		u32* clusterCount = m_clusterCount.pointer();
+
+		auto countLights = [&](int begin, int end)
+			{
+				for (int z = begin; z < end; z++)
+				{
+					for (u32 i = sliceOffset[z]; i < sliceOffset[z + 1]; i++)
+					{
+						SLightClusterBound& b = bounds[sliceLights[i]];
+						for (s32 y = b.MinY; y <= b.MaxY; y++)
+						{
+							u32* count = clusterCount + getClusterID(0, y, z);
+							for (s32 x = b.MinX; x <= b.MaxX; x++)
+								count[x]++;
+						}
+					}
+				}
+			};
+
+		if (multiThread)
+			jobSystem->parallelFor((int)m_numSlice, 1, countLights);
+		else
+			countLights(0, (int)m_numSlice);
+
+		u32 total = 0;
+		for (u32 i = 0; i < numCluster; i++)
+		{
+			clusterOffset[i] = total;
+			total += clusterCount[i];
+		}
+
+		m_lightIndex.set_used(total);
+		u32* lightIndex = m_lightIndex.pointer();
+
+		// 4. write the light indices, the count is rebuilt as the write cursor
+		auto writeLights = [&](int begin, int end)
+			{
+				for (int z = begin; z < end; z++)
+				{
+					u32 sliceCluster = getClusterID(0, 0, z);
+					memset(clusterCount + sliceCluster, 0, m_numTileX * m_numTileY * sizeof(u32));
+
+					for (u32 i = sliceOffset[z]; i < sliceOffset[z + 1]; i++)
+					{
+						u32 light = sliceLights[i];
+						SLightClusterBound& b = bounds[light];
+
+						for (s32 y = b.MinY; y <= b.MaxY; y++)
+						{
+							u32 id = getClusterID(b.MinX, y, z);
+							for (s32 x = b.MinX; x <= b.MaxX; x++, id++)
+								lightIndex[clusterOffset[id] + clusterCount[id]++] = light;
+						}
+					}
+				}
+			};
+
+		if (multiThread)
+			jobSystem->parallelFor((int)m_numSlice, 1, writeLights);
+		else
+			writeLights(0, (int)m_numSlice);
+	}
+
+	int CLightCluster::getClusterID(const core::vector3df& position)
+	{
+		core::vector3df p;
+		m_view.transformVect(p, position);
+
+		if (p.Z < m_near || p.Z > m_far)
+			return -1;
+
+		float out[4];
+		m_projection.transformVect(out, p);
+
+		float x = out[0] / out[3];
+		float y = out[1] / out[3];
+		if (x < -1.0f || x > 1.0f || y < -1.0f || y > 1.0f)
+			return -1;
+
+		u32 tileX = core::min_((u32)((x + 1.0f) * 0.5f * m_numTileX), m_numTileX - 1);
+		u32 tileY = core::min_((u32)((y + 1.0f) * 0.5f * m_numTileY), m_numTileY - 1);
+
+		return (int)getClusterID(tileX, tileY, (u32)getSlice(p.Z));
+	}
+
+	bool CLightCluster::getLightScreenRect(u32 light, core::rectf& rect)
+	{
+		if (light >= m_bounds.size() || !m_bounds[light].Visible)
+			return false;
+
+		const SLightClusterBound& b = m_bounds[light];
+
+		float invX = 1.0f / m_numTileX;
+		float invY = 1.0f / m_numTileY;
+
+		// the tile y is bottom up
+		rect.UpperLeftCorner.X = b.MinX * invX;
+		rect.UpperLeftCorner.Y = 1.0f - (b.MaxY + 1) * invY;
+		rect.LowerRightCorner.X = (b.MaxX + 1) * invX;
+		rect.LowerRightCorner.Y = 1.0f - b.MinY * invY;
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+namespace Skylicht
+{
+	/// @brief The cluster range of a light in the froxel grid
+	struct SLightClusterBound
+	{
+		s32 MinX;
+		s32 MaxX;
+		s32 MinY;
+		s32 MaxY;
+		s32 MinZ;
+		s32 MaxZ;
+		bool Visible;
+	};
+
+	/// @brief Bin the light spheres to a froxel grid (screen tiles x exponential depth slices).
+	/// The result is a compact light index list, each cluster has an offset and a count in this list.
+	class SKYLICHT_API CLightCluster
+	{
+	protected:
+		u32 m_numTileX;
+		u32 m_numTileY;
+		u32 m_numSlice;
+
+		float m_near;
+		float m_far;
+		float m_sliceScale;
+
+		core::matrix4 m_view;
+		core::matrix4 m_projection;
+
+		core::array<SLightClusterBound> m_bounds;
+
+		core::array<u32> m_sliceOffset;
+		core::array<u32> m_sliceLights;
+
+		core::array<u32> m_clusterOffset;
+		core::array<u32> m_clusterCount;
+		core::array<u32> m_lightIndex;
+
+	public:
+		CLightCluster();
+
+		virtual ~CLightCluster();
+
+		void setGridSize(u32 numTileX, u32 numTileY, u32 numSlice);
+
+		/// @brief Bin the lights, the bound and the slices are computed in parallel with the job system if multiThread is true
+		void build(const core::matrix4& view, const core::matrix4& projection,
+			float nearValue, float farValue,
+			const core::vector3df* position, const float* radius, u32 numLight,
+			bool multiThread);
+
+		inline u32 getNumTileX()
+		{
+			return m_numTileX;
+		}
+
+		inline u32 getNumTileY()
+		{
+			return m_numTileY;
+		}
+
+		inline u32 getNumSlice()
+		{
+			return m_numSlice;
+		}
+
+		inline u32 getNumCluster()
+		{
+			return m_numTileX * m_numTileY * m_numSlice;
+		}
+
+		inline u32 getClusterID(u32 x, u32 y, u32 z)
+		{
+			return (z * m_numTileY + y) * m_numTileX + x;
+		}
+
+		/// @brief Get the cluster of a world position, -1 if it is outside the grid
+		int getClusterID(const core::vector3df& position);
+
+		/// @brief Get the light indices of a cluster, the index is the light order in build
+		inline const u32* getClusterLights(u32 cluster, u32& count)
+		{
+			count = m_clusterCount[cluster];
+			return m_lightIndex.pointer() + m_clusterOffset[cluster];
+		}
+
+		/// @brief The compact light index list of all clusters
+		inline core::array<u32>& getLightIndex()
+		{
+			return m_lightIndex;
+		}
+
+		inline core::array<u32>& getClusterOffset()
+		{
+			return m_clusterOffset;
+		}
+
+		inline core::array<u32>& getClusterCount()
+		{
+			return m_clusterCount;
+		}
+
+		inline const SLightClusterBound& getLightBound(u32 light)
+		{
+			return m_bounds[light];
+		}
+
+		/// @brief Get the tiles rect of a light in [0, 1] screen space (top left origin)
+		bool getLightScreenRect(u32 light, core::rectf& rect);
+
+	protected:
+
+		s32 getSlice(float z);
+
+		void computeBound(const core::vector3df& position, float radius, SLightClusterBound& bound);
+	};
+}
\ No newline at end of file
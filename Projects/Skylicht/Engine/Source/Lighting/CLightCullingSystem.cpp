@@ -27,13 +27,19 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Culling/CVisibleData.h"
 #include "Entity/CEntityManager.h"
 #include "Material/Shader/CShaderManager.h"
+#include "Utils/CSIMDUtils.h"
+#include "Camera/CCamera.h"
 
 namespace Skylicht
 {
 	CLightCullingSystem::CLightCullingSystem() :
-		m_group(NULL)
+		m_enableCluster(false),
+		m_clusterBuilt(false),
+		m_group(NULL),
+		m_stamp(0)
 	{
 		m_pipelineType = IRenderPipeline::Mix;
+		m_updatePerView = false;
 	}
 
 	CLightCullingSystem::~CLightCullingSystem()
@@ -45,7 +51,6 @@ namespace Skylicht
 		m_cullings.set_used(0);
 		m_visible.set_used(0);
 		m_transforms.set_used(0);
-		m_invTransforms.set_used(0);
 
 		if (!m_group)
 		{
@@ -65,11 +70,9 @@ namespace Skylicht
 
 			CLightCullingData* culling = GET_ENTITY_DATA(entity, CLightCullingData);
 			CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
-			CWorldInverseTransformData* invTransform = GET_ENTITY_DATA(entity, CWorldInverseTransformData);
 
 			m_cullings.push_back(culling);
 			m_transforms.push_back(transform);
-			m_invTransforms.push_back(invTransform);
 		}
 	}
 
@@ -82,92 +85,215 @@ namespace Skylicht
 	{
 		CLightCullingData** cullings = m_cullings.pointer();
 		CWorldTransformData** transforms = m_transforms.pointer();
-		CWorldInverseTransformData** invTransforms = m_invTransforms.pointer();
 
-		core::matrix4 invTrans;
+		m_clusterBuilt = false;
 
 		CCamera* camera = entityManager->getCamera();
 		if (!camera)
 			return;
 
-		core::aabbox3df camBox = camera->getViewFrustum().getBoundingBox();
+		const SViewFrustum& frustum = camera->getViewFrustum();
+		const core::aabbox3df& camBox = frustum.getBoundingBox();
 		core::vector3df camPos = camera->getGameObject()->getPosition();
 
-		u32 numEntity = m_cullings.size();
-		for (u32 i = 0; i < numEntity; i++)
-		{
-			// get mesh bbox
-			CLightCullingData* culling = cullings[i];
-			CWorldTransformData* transform = transforms[i];
-			CWorldInverseTransformData* invTransform = invTransforms[i];
+		updateBVH();
 
-			culling->Visible = true;
+		// query the lights that near the frustum
+		m_queryResult.set_used(0);
+		m_bvh.queryFrustum(frustum, m_queryResult);
+
+		u32 numQuery = m_queryResult.size();
+		SCullingProxy* proxies = m_proxies.pointer();
+
+		m_planeCulling.set_used(0);
+		for (int i = 0; i < 3; i++)
+			m_center[i].set_used(numQuery);
+		for (int i = 0; i < 9; i++)
+			m_halfAxis[i].set_used(numQuery);
+
+		for (u32 i = 0; i < numQuery; i++)
+		{
+			// get light bbox
+			s32 slot = proxies[m_queryResult[i]].Slot;
+			CLightCullingData* culling = cullings[slot];
+			CWorldTransformData* transform = transforms[slot];
 
 			// transform world bbox
 			core::aabbox3df lightBox = culling->BBox;
-			transform->World.transformBoxEx(lightBox);
+			CSIMDUtils::transformBox(transform->World, lightBox);
 
 			// 1. Detect by bounding box
 			culling->Visible = lightBox.intersectsWithBox(camBox);
 			culling->CameraDistance = transform->World.getTranslation().getDistanceFromSQ(camPos);
 
-			// 2. Detect algorithm
-			if (culling->Visible == true)
-			{
-				SViewFrustum frust = camera->getViewFrustum();
+			if (culling->Visible == false)
+				continue;
 
-				// transform the frustum to the node's current absolute transformation
-				invTrans = invTransform->WorldInverse;
-				frust.transform(invTrans);
+			// 2. Collect the oriented box (local box in world transform) to test with frustum planes
+			u32 id = m_planeCulling.size();
+			m_planeCulling.push_back(culling);
 
-				core::vector3df edges[8];
-				culling->BBox.getEdges(edges);
+			const f32* m = transform->World.pointer();
 
-				for (s32 i = 0; i < scene::SViewFrustum::VF_PLANE_COUNT; ++i)
-				{
-					bool boxInFrustum = false;
-					for (u32 j = 0; j < 8; ++j)
-					{
-						if (frust.planes[i].classifyPointRelation(edges[j]) != core::ISREL3D_FRONT)
-						{
-							boxInFrustum = true;
-							break;
-						}
-					}
-
-					if (!boxInFrustum)
-					{
-						culling->Visible = false;
-						break;
-					}
-				}
+			core::vector3df c = culling->BBox.getCenter();
+			core::vector3df e = culling->BBox.MaxEdge - c;
+			transform->World.transformVect(c);
+
+			m_center[0][id] = c.X;
+			m_center[1][id] = c.Y;
+			m_center[2][id] = c.Z;
+
+			const f32* extent = &e.X;
+			for (int j = 0; j < 3; j++)
+			{
+				m_halfAxis[j * 3][id] = m[j * 4] * extent[j];
+				m_halfAxis[j * 3 + 1][id] = m[j * 4 + 1] * extent[j];
+				m_halfAxis[j * 3 + 2][id] = m[j * 4 + 2] * extent[j];
 			}
+		}
+
+		u32 numPlaneCulling = m_planeCulling.size();
+		if (numPlaneCulling > 0)
+		{
+			const f32* center[3];
+			const f32* halfAxis[9];
+
+			for (int i = 0; i < 3; i++)
+				center[i] = m_center[i].const_pointer();
+
+			for (int i = 0; i < 9; i++)
+				halfAxis[i] = m_halfAxis[i].const_pointer();
+
+			m_outside.set_used(numPlaneCulling);
+			bool* outside = m_outside.pointer();
+
+			CSIMDUtils::cullOrientedBoxes(frustum, center, halfAxis, numPlaneCulling, outside);
 
 			// add list visible light
-			if (culling->Visible == true)
+			for (u32 i = 0; i < numPlaneCulling; i++)
 			{
-				int n = (int)m_visible.size();
-				if (n == 0 || culling->CameraDistance > m_visible[n - 1]->CameraDistance)
-				{
-					// add end
-					m_visible.push_back(culling);
-				}
+				if (outside[i])
+					m_planeCulling[i]->Visible = false;
 				else
+					m_visible.push_back(m_planeCulling[i]);
+			}
+		}
+
+		// sort the visible lights by camera distance
+		std::stable_sort(m_visible.pointer(), m_visible.pointer() + m_visible.size(), [](CLightCullingData* a, CLightCullingData* b)
+			{
+				return a->CameraDistance < b->CameraDistance;
+			});
+
+		// only the light pass of deferred pipeline reads the clusters
+		IRenderPipeline* rp = entityManager->getRenderPipeline();
+		if (m_enableCluster && rp != NULL && rp->getType() == IRenderPipeline::Deferred)
+			buildCluster(entityManager, camera);
+	}
+
+	void CLightCullingSystem::updateBVH()
+	{
+		m_stamp++;
+
+		CLightCullingData** cullings = m_cullings.pointer();
+		CWorldTransformData** transforms = m_transforms.pointer();
+
+		u32 numEntity = m_cullings.size();
+
+		for (u32 i = 0; i < numEntity; i++)
+		{
+			CLightCullingData* culling = cullings[i];
+			CWorldTransformData* transform = transforms[i];
+
+			u32 index = (u32)culling->Entity->getIndex();
+			while (m_proxies.size() <= index)
+				m_proxies.push_back(SCullingProxy());
+
+			SCullingProxy& proxy = m_proxies[index];
+			proxy.Slot = (s32)i;
+			proxy.Stamp = m_stamp;
+
+			// the lights that are not in query result are culled
+			culling->Visible = false;
+
+			// only refit the proxy of the moved light
+			if (proxy.Proxy == -1 ||
+				transform->NeedValidate ||
+				transform->NeedValidateForLate ||
+				proxy.LocalBox != culling->BBox)
+			{
+				proxy.LocalBox = culling->BBox;
+
+				core::aabbox3df lightBox = culling->BBox;
+				CSIMDUtils::transformBox(transform->World, lightBox);
+
+				if (proxy.Proxy == -1)
+					proxy.Proxy = m_bvh.createProxy(lightBox, (s32)index);
+				else
+					m_bvh.moveProxy(proxy.Proxy, lightBox);
+			}
+		}
+
+		// remove the proxies of the lights that are removed or hidden
+		if (m_bvh.getProxyCount() > (s32)numEntity)
+		{
+			for (u32 i = 0, n = m_proxies.size(); i < n; i++)
+			{
+				SCullingProxy& proxy = m_proxies[i];
+				if (proxy.Proxy != -1 && proxy.Stamp != m_stamp)
 				{
-					// insert sort
-					for (int i = 0; i < n; i++)
-					{
-						if (culling->CameraDistance < m_visible[i]->CameraDistance)
-						{
-							m_visible.insert(culling, i);
-							break;
-						}
-					}
+					m_bvh.destroyProxy(proxy.Proxy);
+					proxy.Proxy = -1;
 				}
 			}
 		}
 	}
 
+	void CLightCullingSystem::buildCluster(CEntityManager* entityManager, CCamera* camera)
+	{
+		u32 numVisible = m_visible.size();
+
+		m_lightPosition.set_used(numVisible);
+		m_lightRadius.set_used(numVisible);
+
+		for (u32 i = 0; i < numVisible; i++)
+		{
+			CLightCullingData* culling = m_visible[i];
+
+			// the bounding sphere of light box
+			core::vector3df c = culling->BBox.getCenter();
+			core::vector3df e = culling->BBox.MaxEdge - c;
+
+			CWorldTransformData* transform = GET_ENTITY_DATA(culling->Entity, CWorldTransformData);
+			if (transform)
+			{
+				const core::matrix4& world = transform->World;
+				world.transformVect(c);
+
+				core::vector3df scale = world.getScale();
+				e.X *= scale.X;
+				e.Y *= scale.Y;
+				e.Z *= scale.Z;
+			}
+
+			m_lightPosition[i] = c;
+			m_lightRadius[i] = e.getLength();
+		}
+
+		m_cluster.build(
+			camera->getViewMatrix(),
+			camera->getProjectionMatrix(),
+			camera->getNearValue(),
+			camera->getFarValue(),
+			m_lightPosition.pointer(),
+			m_lightRadius.pointer(),
+			numVisible,
+			entityManager->isMultiThreadUpdate()
+		);
+
+		m_clusterBuilt = true;
+	}
+
 	void CLightCullingSystem::render(CEntityManager* entityManager)
 	{
 
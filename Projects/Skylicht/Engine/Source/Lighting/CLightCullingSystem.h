@@ -25,10 +25,11 @@ https://github.com/skylicht-lab/skylicht-engine
 #pragma once
 
 #include "CLightCullingData.h"
+#include "CLightCluster.h"
+#include "Culling/CCullingSystem.h"
 #include "Entity/IRenderSystem.h"
 #include "Entity/CEntityGroup.h"
 #include "Transform/CWorldTransformData.h"
-#include "Transform/CWorldInverseTransformData.h"
 
 namespace Skylicht
 {
@@ -38,7 +39,26 @@ namespace Skylicht
 		core::array<CLightCullingData*> m_cullings;
 		core::array<CLightCullingData*> m_visible;
 		core::array<CWorldTransformData*> m_transforms;
-		core::array<CWorldInverseTransformData*> m_invTransforms;
+
+		// the world bounds of lights in bvh, that query by camera frustum
+		CCullingBVH m_bvh;
+		core::array<SCullingProxy> m_proxies;
+		core::array<s32> m_queryResult;
+		u32 m_stamp;
+
+		// the lights pass bbox test, that test with frustum planes
+		core::array<CLightCullingData*> m_planeCulling;
+		core::array<f32> m_center[3];
+		core::array<f32> m_halfAxis[9];
+		core::array<bool> m_outside;
+
+		// the visible light spheres, that bin to the clusters
+		core::array<core::vector3df> m_lightPosition;
+		core::array<f32> m_lightRadius;
+
+		CLightCluster m_cluster;
+		bool m_enableCluster;
+		bool m_clusterBuilt;
 
 		CEntityGroup* m_group;
 
@@ -65,5 +85,34 @@ namespace Skylicht
 		{
 			return m_visible;
 		}
+
+		/// @brief Bin the visible lights to the camera clusters in update, the light index is the index in getLightVisible.
+		/// It is disabled by default, CDeferredRP enables it for the light pass.
+		/// The clusters are only built when the current render pipeline is deferred, the forward pipelines do not read them.
+		inline void enableCluster(bool b)
+		{
+			m_enableCluster = b;
+		}
+
+		inline bool isEnableCluster()
+		{
+			return m_enableCluster;
+		}
+
+		inline CLightCluster* getLightCluster()
+		{
+			return m_clusterBuilt ? &m_cluster : NULL;
+		}
+
+		inline CCullingBVH* getBVH()
+		{
+			return &m_bvh;
+		}
+
+	protected:
+
+		void updateBVH();
+
+		void buildCluster(CEntityManager* entityManager, CCamera* camera);
 	};
 }
\ No newline at end of file
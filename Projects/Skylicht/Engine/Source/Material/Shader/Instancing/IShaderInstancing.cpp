@@ -217,6 +217,47 @@ namespace Skylicht
 		return dmb;
 	}
 
+	bool getVtxIndirectLighting(CIndirectLightingData* indirectLighting, SVtxIndirectLighting& indirectLight)
+	{
+		float invColor = 1.111f / 255.0f;
+
+		switch (indirectLighting->Type)
+		{
+		case CIndirectLightingData::SH9:
+		{
+			if (indirectLighting->SH)
+			{
+				indirectLight.D0 = indirectLighting->SH[0];
+				indirectLight.D1 = indirectLighting->SH[1];
+				indirectLight.D2 = indirectLighting->SH[2];
+				indirectLight.D3 = indirectLighting->SH[3];
+				return true;
+			}
+		}
+		break;
+		case CIndirectLightingData::AmbientColor:
+		{
+			indirectLight.D0.set(
+				indirectLighting->Color.getRed() * invColor,
+				indirectLighting->Color.getGreen() * invColor,
+				indirectLighting->Color.getBlue() * invColor
+			);
+
+			indirectLight.D1.set(0.0f, 0.0f, 0.0f);
+			indirectLight.D2.set(0.0f, 0.0f, 0.0f);
+			indirectLight.D3.set(0.0f, 0.0f, 0.0f);
+			return true;
+		}
+		break;
+		default:
+		{
+		}
+		break;
+		}
+
+		return false;
+	}
+
 	void IShaderInstancing::batchTransformAndLighting(
 		IVertexBuffer* tBuffer,
 		IVertexBuffer* lBuffer,
@@ -234,8 +275,6 @@ namespace Skylicht
 		transformBuffer->set_used(count);
 		indirectLightBuffer->set_used(count);
 
-		float invColor = 1.111f / 255.0f;
-
 		for (int i = 0; i < count; i++)
 		{
 			SVtxTransform& transform = transformBuffer->getVertex(i);
@@ -248,43 +287,81 @@ namespace Skylicht
 			// indirect lighting
 			CIndirectLightingData* indirectLighting = GET_ENTITY_DATA(entities[i], CIndirectLightingData);
 			if (indirectLighting)
+				getVtxIndirectLighting(indirectLighting, indirectLight);
+		}
+
+		tBuffer->setDirty();
+		lBuffer->setDirty();
+	}
+
+	int IShaderInstancing::updateTransformAndLighting(
+		IVertexBuffer* tBuffer,
+		IVertexBuffer* lBuffer,
+		CEntity** entities,
+		int count)
+	{
+		CVertexBuffer<SVtxTransform>* transformBuffer = dynamic_cast<CVertexBuffer<SVtxTransform>*>(tBuffer);
+		if (transformBuffer == NULL)
+			return 0;
+
+		CVertexBuffer<SVtxIndirectLighting>* indirectLightBuffer = dynamic_cast<CVertexBuffer<SVtxIndirectLighting>*>(lBuffer);
+		if (indirectLightBuffer == NULL)
+			return 0;
+
+		// the new instances at the end are always written
+		int oldCount = (int)transformBuffer->getVertexCount();
+		if ((int)indirectLightBuffer->getVertexCount() < oldCount)
+			oldCount = (int)indirectLightBuffer->getVertexCount();
+
+		bool transformChanged = oldCount != count;
+		bool lightingChanged = oldCount != count;
+
+		transformBuffer->set_used(count);
+		indirectLightBuffer->set_used(count);
+
+		int numChanged = 0;
+
+		for (int i = 0; i < count; i++)
+		{
+			bool changed = false;
+
+			SVtxTransform& transform = transformBuffer->getVertex(i);
+			CWorldTransformData* world = GET_ENTITY_DATA(entities[i], CWorldTransformData);
+			if (i >= oldCount || memcmp(transform.World.pointer(), world->World.pointer(), sizeof(f32) * 16) != 0)
 			{
-				switch (indirectLighting->Type)
-				{
-				case CIndirectLightingData::SH9:
-				{
-					if (indirectLighting->SH)
-					{
-						indirectLight.D0 = indirectLighting->SH[0];
-						indirectLight.D1 = indirectLighting->SH[1];
-						indirectLight.D2 = indirectLighting->SH[2];
-						indirectLight.D3 = indirectLighting->SH[3];
-					}
-				}
-				break;
-				case CIndirectLightingData::AmbientColor:
-				{
-					indirectLight.D0.set(
-						indirectLighting->Color.getRed() * invColor,
-						indirectLighting->Color.getGreen() * invColor,
-						indirectLighting->Color.getBlue() * invColor
-					);
-
-					indirectLight.D1.set(0.0f, 0.0f, 0.0f);
-					indirectLight.D2.set(0.0f, 0.0f, 0.0f);
-					indirectLight.D3.set(0.0f, 0.0f, 0.0f);
-				}
-				break;
-				default:
+				transform.World = world->World;
+				transformChanged = true;
+				changed = true;
+			}
+
+			CIndirectLightingData* indirectLighting = GET_ENTITY_DATA(entities[i], CIndirectLightingData);
+			if (indirectLighting)
+			{
+				SVtxIndirectLighting light;
+				SVtxIndirectLighting& indirectLight = indirectLightBuffer->getVertex(i);
+
+				if (getVtxIndirectLighting(indirectLighting, light) &&
+					(i >= oldCount || memcmp(&light, &indirectLight, sizeof(SVtxIndirectLighting)) != 0))
 				{
-				}
-				break;
+					indirectLight = light;
+					lightingChanged = true;
+					changed = true;
 				}
 			}
+
+			if (changed)
+				numChanged++;
 		}
 
-		tBuffer->setDirty();
-		lBuffer->setDirty();
+		// IVertexBuffer has no dirty range, so one changed instance still uploads the whole buffer,
+		// the saving is that the unchanged buffers are not uploaded
+		if (transformChanged)
+			tBuffer->setDirty();
+
+		if (lightingChanged)
+			lBuffer->setDirty();
+
+		return numChanged;
 	}
 
 	void IShaderInstancing::batchTransform(
@@ -109,6 +109,15 @@ namespace Skylicht
 			CEntity** entities,
 			int count);
 
+		/// @brief Same as batchTransformAndLighting, but only rewrite the instances that changed.
+		/// The buffer is only marked dirty when an instance or the count changed.
+		/// @return the number of rewritten instances
+		static int updateTransformAndLighting(
+			IVertexBuffer* tBuffer,
+			IVertexBuffer* lBuffer,
+			CEntity** entities,
+			int count);
+
 		video::IVertexDescriptor* getBaseVertexDescriptor()
 		{
 			return m_baseVtxDescriptor;
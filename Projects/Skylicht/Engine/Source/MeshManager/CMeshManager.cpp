@@ -58,30 +58,41 @@ namespace Skylicht
 	void CMeshManager::releaseAllInstancingMesh()
 	{
 		for (SMeshInstancing* data : m_instancingData)
+			releaseInstancingData(data);
+		m_instancingData.clear();
+
+		for (auto& it : m_autoInstancingData)
 		{
-			u32 n = data->MeshBuffers.size();
-			for (u32 i = 0; i < n; i++)
-				data->MeshBuffers[i]->drop();
+			if (it.second.Data)
+				releaseInstancingData(it.second.Data);
+			it.first->drop();
+		}
+		m_autoInstancingData.clear();
+	}
 
-			n = data->MaterialBuffer.size();
-			for (u32 i = 0; i < n; i++)
-				data->MaterialBuffer[i]->drop();
+	void CMeshManager::releaseInstancingData(SMeshInstancing* data)
+	{
+		u32 n = data->MeshBuffers.size();
+		for (u32 i = 0; i < n; i++)
+			data->MeshBuffers[i]->drop();
+
+		n = data->MaterialBuffer.size();
+		for (u32 i = 0; i < n; i++)
+			data->MaterialBuffer[i]->drop();
 
-			data->TransformBuffer->drop();
-			data->IndirectLightingBuffer->drop();
+		data->TransformBuffer->drop();
+		data->IndirectLightingBuffer->drop();
 
-			n = data->RenderMeshBuffers.size();
-			for (u32 i = 0; i < n; i++)
-				data->RenderMeshBuffers[i]->drop();
+		n = data->RenderMeshBuffers.size();
+		for (u32 i = 0; i < n; i++)
+			data->RenderMeshBuffers[i]->drop();
 
-			n = data->RenderLightMeshBuffers.size();
-			for (u32 i = 0; i < n; i++)
-				data->RenderLightMeshBuffers[i]->drop();
+		n = data->RenderLightMeshBuffers.size();
+		for (u32 i = 0; i < n; i++)
+			data->RenderLightMeshBuffers[i]->drop();
 
-			data->InstancingMesh->drop();
-			delete data;
-		}
-		m_instancingData.clear();
+		data->InstancingMesh->drop();
+		delete data;
 	}
 
 	CEntityPrefab* CMeshManager::loadModel(const char* resource, const char* texturePath, bool loadNormalMap, bool flipNormalMap, bool loadTexcoord2, bool createBatching)
@@ -188,7 +199,9 @@ namespace Skylicht
 			}
 		}
 
-		return createInstancingData(mesh);
+		SMeshInstancing* data = createInstancingData(mesh);
+		m_instancingData.push_back(data);
+		return data;
 	}
 
 	SMeshInstancing* CMeshManager::createGetInstancingMesh(CMesh* mesh, IShaderInstancing* shaderInstancing)
@@ -201,7 +214,53 @@ namespace Skylicht
 			}
 		}
 
-		return createInstancingData(mesh, shaderInstancing);
+		SMeshInstancing* data = createInstancingData(mesh, shaderInstancing);
+		m_instancingData.push_back(data);
+		return data;
+	}
+
+	SMeshInstancing* CMeshManager::getAutoInstancingMesh(CMesh* mesh)
+	{
+		auto it = m_autoInstancingData.find(mesh);
+		if (it != m_autoInstancingData.end())
+		{
+			it->second.RefCount++;
+			return it->second.Data;
+		}
+
+		SMeshInstancing* data = NULL;
+		if (canCreateAllInstancingMesh(mesh))
+		{
+			data = createInstancingData(mesh);
+			if (data->RenderMeshBuffers.size() != mesh->getMeshBufferCount())
+			{
+				releaseInstancingData(data);
+				data = NULL;
+			}
+		}
+
+		mesh->grab();
+
+		SAutoInstancingMesh& autoInstancing = m_autoInstancingData[mesh];
+		autoInstancing.Data = data;
+		autoInstancing.RefCount = 1;
+		return data;
+	}
+
+	void CMeshManager::releaseAutoInstancingMesh(CMesh* mesh)
+	{
+		auto it = m_autoInstancingData.find(mesh);
+		if (it == m_autoInstancingData.end())
+			return;
+
+		if (--it->second.RefCount > 0)
+			return;
+
+		if (it->second.Data)
+			releaseInstancingData(it->second.Data);
+
+		m_autoInstancingData.erase(it);
+		mesh->drop();
 	}
 
 	SMeshInstancing* CMeshManager::createInstancingData(CMesh* mesh)
@@ -298,7 +357,6 @@ namespace Skylicht
 			}
 		}
 
-		m_instancingData.push_back(data);
 		return data;
 	}
 
@@ -380,7 +438,6 @@ namespace Skylicht
 			}
 		}
 
-		m_instancingData.push_back(data);
 		return data;
 	}
 
@@ -409,6 +466,29 @@ namespace Skylicht
 		return false;
 	}
 
+	bool CMeshManager::canCreateAllInstancingMesh(CMesh* mesh)
+	{
+		u32 mbCount = mesh->getMeshBufferCount();
+		if (mbCount == 0)
+			return false;
+
+		for (u32 i = 0; i < mbCount; i++)
+		{
+			CMaterial* material = mesh->Materials[i];
+			if (material == NULL)
+				return false;
+
+			CShader* shader = material->getShader();
+			if (shader == NULL)
+				return false;
+
+			if (shader->getInstancing() == NULL || shader->getInstancingShader() == NULL)
+				return false;
+		}
+
+		return true;
+	}
+
 	bool CMeshManager::compareMeshBuffer(CMesh* mesh, SMeshInstancing* data)
 	{
 		u32 mbCount = mesh->getMeshBufferCount();
@@ -20,6 +20,15 @@ namespace Skylicht
 
 		std::vector<SMeshInstancing*> m_instancingData;
 
+		struct SAutoInstancingMesh
+		{
+			SMeshInstancing* Data;
+			u32 RefCount;
+		};
+
+		// the mesh is grabbed while it has any reference, so the key is not reused by a new mesh
+		std::map<CMesh*, SAutoInstancingMesh> m_autoInstancingData;
+
 	public:
 		CMeshManager();
 
@@ -43,6 +52,19 @@ namespace Skylicht
 
 		SMeshInstancing* createGetInstancingMesh(CMesh* mesh, IShaderInstancing* shaderInstancing);
 
+		/// @brief Get the instancing data of a mesh for the automatic instancing in CMeshRenderer.
+		/// The data is not shared with createGetInstancingMesh, and it is NULL if any mesh buffer can't render instancing.
+		/// Each call adds a reference, that is released by releaseAutoInstancingMesh.
+		SMeshInstancing* getAutoInstancingMesh(CMesh* mesh);
+
+		/// @brief Release a reference of getAutoInstancingMesh, the data and the mesh are released with the last reference.
+		void releaseAutoInstancingMesh(CMesh* mesh);
+
+		inline u32 getNumAutoInstancingMesh()
+		{
+			return (u32)m_autoInstancingData.size();
+		}
+
 		void changeInstancingTransformBuffer(SMeshInstancing* mesh, IVertexBuffer* transform, IVertexBuffer* lighting);
 
 		void changeInstancingMaterialBuffer(SMeshInstancing* mesh, IVertexBuffer* materials);
@@ -51,6 +73,10 @@ namespace Skylicht
 
 		bool canCreateInstancingMesh(CMesh* mesh);
 
+		bool canCreateAllInstancingMesh(CMesh* mesh);
+
+		void releaseInstancingData(SMeshInstancing* data);
+
 		bool compareMeshBuffer(CMesh* mesh, SMeshInstancing* data);
 
 		SMeshInstancing* createInstancingData(CMesh* mesh);
@@ -26,13 +26,20 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CJointAnimationSystem.h"
 #include "Entity/CEntityManager.h"
 #include "Culling/CVisibleData.h"
+#include "Transform/CWorldTransformSystem.h"
+#include "Utils/CSIMDUtils.h"
+
+#include "Thread/CJobSystem.h"
 
 namespace Skylicht
 {
 	CJointAnimationSystem::CJointAnimationSystem() :
-		m_group(NULL)
+		m_group(NULL),
+		m_groupTransform(NULL)
 	{
-
+		declareReadData(DATA_TYPE_INDEX(CWorldTransformData));
+		declareReadData(DATA_TYPE_INDEX(CWorldInverseTransformData));
+		declareWriteData(DATA_TYPE_INDEX(CJointData));
 	}
 
 	CJointAnimationSystem::~CJointAnimationSystem()
@@ -61,9 +68,33 @@ namespace Skylicht
 
 	void CJointAnimationSystem::update(CEntityManager* entityManager)
 	{
+		if (m_groupTransform == NULL)
+		{
+			CWorldTransformSystem* transformSystem = entityManager->getSystem<CWorldTransformSystem>();
+			if (transformSystem)
+				m_groupTransform = transformSystem->getGroupTransform();
+		}
+
 		CEntity** entities = m_group->getEntities();
 		int numEntity = m_group->getEntityCount();
 
+		// the static joints is skipped, just loop the changed list if it's shorter
+		if (m_groupTransform && m_groupTransform->getEntityCount() < numEntity)
+		{
+			CEntity** changed = m_groupTransform->getEntities();
+			int numChanged = m_groupTransform->getEntityCount();
+
+			m_changedJoints.reset();
+			for (int i = 0; i < numChanged; i++)
+			{
+				if (GET_ENTITY_DATA(changed[i], CJointData) != NULL)
+					m_changedJoints.push(changed[i]);
+			}
+
+			entities = m_changedJoints.pointer();
+			numEntity = m_changedJoints.count();
+		}
+
 		updateAnimationMatrix(entityManager, entities, numEntity);
 	}
 
@@ -71,28 +102,36 @@ namespace Skylicht
 	{
 		CEntity** allEntities = entityManager->getEntities();
 
-		for (int i = 0; i < numEntity; i++)
-		{
-			CEntity* entity = entities[i];
-
-			CJointData* joint = GET_ENTITY_DATA(entity, CJointData);
-			CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
-
-			if (transform->NeedValidate && joint->RootIndex != 0)
+		auto updateJoint = [entities, allEntities](int begin, int end)
 			{
-				CWorldInverseTransformData* rootInvTransform = GET_ENTITY_DATA(allEntities[joint->RootIndex], CWorldInverseTransformData);
-
-				if (rootInvTransform != NULL)
+				for (int i = begin; i < end; i++)
 				{
-					// move bone transform to Zero location
-					joint->AnimationMatrix.setbyproduct_nocheck(rootInvTransform->WorldInverse, transform->World);
+					CEntity* entity = entities[i];
+
+					CJointData* joint = GET_ENTITY_DATA(entity, CJointData);
+					CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+
+					if (transform->NeedValidate && joint->RootIndex != 0)
+					{
+						CWorldInverseTransformData* rootInvTransform = GET_ENTITY_DATA(allEntities[joint->RootIndex], CWorldInverseTransformData);
+
+						if (rootInvTransform != NULL)
+						{
+							// move bone transform to Zero location
+							CSIMDUtils::mulMatrix(joint->AnimationMatrix, rootInvTransform->WorldInverse, transform->World);
+						}
+						else
+						{
+							// if will have bugs if the SkinnedMesh isnot stand at Zero location
+							joint->AnimationMatrix = transform->World;
+						}
+					}
 				}
-				else
-				{
-					// if will have bugs if the SkinnedMesh isnot stand at Zero location
-					joint->AnimationMatrix = transform->World;
-				}
-			}
-		}
+			};
+
+		if (entityManager->isMultiThreadUpdate())
+			System::CJobSystem::getInstance()->parallelFor(numEntity, 512, updateJoint);
+		else
+			updateJoint(0, numEntity);
 	}
 }
\ No newline at end of file
@@ -28,6 +28,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Entity/CEntityGroup.h"
 #include "Transform/CWorldTransformData.h"
 #include "Transform/CWorldInverseTransformData.h"
+#include "Transform/CGroupTransform.h"
 #include "CJointData.h"
 
 namespace Skylicht
@@ -36,6 +37,9 @@ namespace Skylicht
 	{
 	protected:
 		CEntityGroup* m_group;
+		CGroupTransform* m_groupTransform;
+
+		CFastArray<CEntity*> m_changedJoints;
 
 	public:
 		CJointAnimationSystem();
@@ -27,26 +27,39 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "Culling/CCullingData.h"
 #include "Entity/CEntityManager.h"
+#include "Camera/CCamera.h"
+#include "MeshManager/CMeshManager.h"
 
 #include "Material/Shader/ShaderCallback/CShaderSH.h"
 #include "Material/Shader/ShaderCallback/CShaderLighting.h"
+#include "Material/Shader/ShaderCallback/CShaderMaterial.h"
 
 namespace Skylicht
 {
-	CMeshRenderer::CMeshRenderer()
+	CMeshRenderer::CMeshRenderer() :
+		m_numOpaque(0),
+		m_autoInstancing(false),
+		m_autoInstancingMinCount(4)
 	{
 		m_pipelineType = IRenderPipeline::Mix;
 	}
 
 	CMeshRenderer::~CMeshRenderer()
 	{
+		CMeshManager* meshManager = CMeshManager::getInstance();
 
+		for (auto& it : m_instancing)
+		{
+			if (it.second.Group)
+				delete it.second.Group;
+			meshManager->releaseAutoInstancingMesh(it.first);
+		}
+		m_instancing.clear();
 	}
 
 	void CMeshRenderer::beginQuery(CEntityManager* entityManager)
 	{
 		m_meshs.set_used(0);
-		m_transparents.set_used(0);
 
 		CMeshRenderSystem::beginQuery(entityManager);
 	}
@@ -93,186 +106,375 @@ namespace Skylicht
 
 	}
 
-	int cmpRenderMeshFunc(const void* a, const void* b)
+	u64 hashSortKey(const void* p, int bits)
 	{
-		CRenderMeshData* pa = *((CRenderMeshData**)a);
-		CRenderMeshData* pb = *((CRenderMeshData**)b);
+		// fibonacci hash of the pointer, the key is only used to group the same state
+		u64 v = (u64)(size_t)p * 0x9E3779B97F4A7C15ULL;
+		return p == NULL ? 0 : (v >> (64 - bits));
+	}
 
-		CMesh* meshA = pa->getMesh();
-		CMesh* meshB = pb->getMesh();
+	void CMeshRenderer::addDrawCommand(CRenderMeshData* meshData, const core::vector3df& cameraPosition)
+	{
+		CMesh* mesh = meshData->getMesh();
+		if (meshData->isSoftwareBlendShape())
+			mesh = meshData->getSoftwareBlendShapeMesh();
+		if (meshData->isSoftwareSkinning())
+			mesh = meshData->getSoftwareSkinnedMesh();
 
-		std::vector<CMaterial*>& materialsA = meshA->Materials;
-		std::vector<CMaterial*>& materialsB = meshB->Materials;
+		CWorldTransformData* transform = GET_ENTITY_DATA(meshData->Entity, CWorldTransformData);
 
-		// no material, compare by mesh
-		if (materialsA.size() == 0 || materialsA.size() == 0)
+		// positive float bits have the same order as the value
+		f32 distance = cameraPosition.getDistanceFromSQ(transform->World.getTranslation());
+		u32 depth;
+		memcpy(&depth, &distance, sizeof(u32));
+
+		for (u32 j = 0, m = mesh->getMeshBufferCount(); j < m; j++)
 		{
-			if (meshA == meshB)
-				return 0;
+			CMaterial* material = mesh->Materials[j];
+			CShader* shader = material != NULL ? material->getShader() : NULL;
+			IMeshBuffer* mb = mesh->getMeshBuffer(j);
+
+			u64 key;
+
+			if (shader != NULL && shader->isOpaque() == false)
+			{
+				// transparent: back to front
+				key = ((u64)1 << 63) |
+					((u64)(0x7fffffff - (depth & 0x7fffffff)) << 32) |
+					(hashSortKey(shader, 10) << 22) |
+					(hashSortKey(material, 12) << 10) |
+					hashSortKey(mb, 10);
+			}
+			else
+			{
+				// opaque: by state, then front to back
+				ITexture* texture = material != NULL ? material->getTexture(0) : NULL;
+
+				key = (hashSortKey(shader, 12) << 51) |
+					(hashSortKey(material, 14) << 37) |
+					(hashSortKey(texture, 12) << 25) |
+					(hashSortKey(mb, 12) << 13) |
+					((depth >> 18) & 0x1fff);
 
-			return meshA < meshB ? -1 : 1;
+				m_numOpaque++;
+			}
+
+			SMeshDrawCommand cmd;
+			cmd.Key = key;
+			cmd.MeshData = meshData;
+			cmd.Mesh = mesh;
+			cmd.BufferID = j;
+			m_commands.push_back(cmd);
 		}
+	}
 
-		CMaterial* materialA = materialsA[0];
-		CMaterial* materialB = materialsB[0];
+	void CMeshRenderer::sortDrawCommand(SMeshDrawCommand* commands, SMeshDrawCommand* temp, u32 count)
+	{
+		if (count == 0)
+			return;
+
+		u32 histogram[256];
+
+		SMeshDrawCommand* src = commands;
+		SMeshDrawCommand* dst = temp;
 
-		// compare by mesh
-		if (materialA == NULL || materialB == NULL)
+		for (int shift = 0; shift < 64; shift += 8)
 		{
-			IMeshBuffer* mbA = meshA->getMeshBuffer(0);
-			IMeshBuffer* mbB = meshB->getMeshBuffer(0);
+			memset(histogram, 0, sizeof(histogram));
 
-			if (mbA == mbB)
-				return 0;
+			for (u32 i = 0; i < count; i++)
+				histogram[(src[i].Key >> shift) & 0xff]++;
 
-			return mbA < mbB ? -1 : 1;
+			// skip the pass if all keys have the same byte
+			if (histogram[(src[0].Key >> shift) & 0xff] == count)
+				continue;
+
+			u32 offset = 0;
+			for (int i = 0; i < 256; i++)
+			{
+				u32 c = histogram[i];
+				histogram[i] = offset;
+				offset += c;
+			}
+
+			for (u32 i = 0; i < count; i++)
+				dst[histogram[(src[i].Key >> shift) & 0xff]++] = src[i];
+
+			SMeshDrawCommand* t = src;
+			src = dst;
+			dst = t;
 		}
 
-		// comprate by texture
-		ITexture* textureA = materialA->getTexture(0);
-		ITexture* textureB = materialB->getTexture(0);
+		if (src != commands)
+			memcpy(commands, src, sizeof(SMeshDrawCommand) * count);
+	}
+
+	SMeshAutoInstancing* CMeshRenderer::getAutoInstancing(CMesh* mesh)
+	{
+		auto it = m_instancing.find(mesh);
+		if (it != m_instancing.end())
+			return &it->second;
+
+		SMeshAutoInstancing& instancing = m_instancing[mesh];
+		instancing.Mesh = mesh;
+		instancing.Data = CMeshManager::getInstance()->getAutoInstancingMesh(mesh);
+		instancing.Group = instancing.Data != NULL ? new SMeshInstancingGroup() : NULL;
+		instancing.ReflectionTexture = NULL;
+		return &instancing;
+	}
 
-		// if no texture
-		if (textureA == NULL || textureB == NULL)
+	void CMeshRenderer::releaseUnusedAutoInstancing()
+	{
+		CMeshManager* meshManager = CMeshManager::getInstance();
+
+		auto it = m_instancing.begin();
+		while (it != m_instancing.end())
 		{
-			if (materialA == materialB)
+			// only CMeshManager keeps the mesh, no entity renders it
+			if (it->first->getReferenceCount() == 1)
 			{
-				// compare mesh
-				IMeshBuffer* mbA = meshA->getMeshBuffer(0);
-				IMeshBuffer* mbB = meshB->getMeshBuffer(0);
+				if (it->second.Group)
+					delete it->second.Group;
 
-				if (mbA == mbB)
-					return 0;
+				meshManager->releaseAutoInstancingMesh(it->first);
+				it = m_instancing.erase(it);
+			}
+			else
+			{
+				++it;
 			}
-
-			return materialA < materialB ? -1 : 1;
 		}
+	}
 
-		// sort by texture 0
-		if (textureA == textureB)
-		{
-			// compare mesh
-			IMeshBuffer* mbA = meshA->getMeshBuffer(0);
-			IMeshBuffer* mbB = meshB->getMeshBuffer(0);
+	bool CMeshRenderer::canAutoInstancing(SMeshAutoInstancing* instancing)
+	{
+		if ((u32)instancing->Group->Entities.count() < m_autoInstancingMinCount)
+			return false;
+
+		// the materials can be changed after the instancing data created
+		SMeshInstancing* data = instancing->Data;
+		CMesh* mesh = instancing->Mesh;
 
-			if (mbA == mbB)
-				return 0;
+		for (u32 i = 0, n = data->Materials.size(); i < n; i++)
+		{
+			CMaterial* material = mesh->Materials[i];
+			if (material != data->Materials[i])
+				return false;
 
-			return mbA < mbB ? -1 : 1;
+			// transparent mesh need sort back to front
+			if (!material->getShader()->isOpaque())
+				return false;
 		}
 
-		return textureA < textureB ? -1 : 1;
+		return true;
 	}
 
-	void CMeshRenderer::update(CEntityManager* entityManager)
+	bool CMeshRenderer::canAutoInstancing(CEntity* entity)
 	{
-		// need sort render by material, texture, mesh		
-		u32 count = m_meshs.size();
-		if (count > 0)
+		CIndirectLightingData* lightingData = GET_ENTITY_DATA(entity, CIndirectLightingData);
+		if (lightingData == NULL)
+			return true;
+
+		return lightingData->Type == CIndirectLightingData::SH9 ||
+			lightingData->Type == CIndirectLightingData::AmbientColor;
+	}
+
+	void CMeshRenderer::batchAutoInstancing(SMeshAutoInstancing* instancing)
+	{
+		SMeshInstancing* data = instancing->Data;
+		SMeshInstancingGroup* group = instancing->Group;
+
+		CEntity** entities = group->Entities.pointer();
+		int count = group->Entities.count();
+
+		group->RootEntityIndex = entities[0]->getIndex();
+
+		for (u32 i = 0, n = data->RenderMeshBuffers.size(); i < n; i++)
 		{
-			// need sort by material
-			qsort(m_meshs.pointer(), count, sizeof(CRenderMeshData*), cmpRenderMeshFunc);
+			group->Materials.reset();
+			for (int j = 0; j < count; j++)
+				group->Materials.push(data->Materials[i]);
+
+			data->InstancingShader[i]->batchIntancing(
+				data->MaterialBuffer[i],
+				group->Materials.pointer(),
+				entities,
+				count
+			);
 		}
+
+		IShaderInstancing::batchTransformAndLighting(
+			data->TransformBuffer,
+			data->IndirectLightingBuffer,
+			entities,
+			count
+		);
 	}
 
-	void CMeshRenderer::render(CEntityManager* entityManager)
+	void CMeshRenderer::update(CEntityManager* entityManager)
 	{
-		IVideoDriver* driver = getVideoDriver();
-		IRenderPipeline* rp = entityManager->getRenderPipeline();
-		CRenderMeshData** meshs = m_meshs.pointer();
+		m_commands.set_used(0);
+		m_numOpaque = 0;
 
-		for (u32 i = 0, n = m_meshs.size(); i < n; i++)
-		{
-			CRenderMeshData* meshData = m_meshs[i];
-			CEntity* entity = meshData->Entity;
+		for (u32 i = 0, n = m_renderInstancing.size(); i < n; i++)
+			m_renderInstancing[i]->Group->Entities.reset();
+		m_renderInstancing.set_used(0);
 
-			CMesh* mesh = meshData->getMesh();
-			if (meshData->isSoftwareBlendShape())
-				mesh = meshData->getSoftwareBlendShapeMesh();
-			if (meshData->isSoftwareSkinning())
-				mesh = meshData->getSoftwareSkinnedMesh();
+		releaseUnusedAutoInstancing();
 
-			CIndirectLightingData* lightingData = GET_ENTITY_DATA(entity, CIndirectLightingData);
-			if (lightingData != NULL)
-			{
-				if (lightingData->Type == CIndirectLightingData::SH9)
-					CShaderSH::setSH9(lightingData->SH);
-				else if (lightingData->Type == CIndirectLightingData::AmbientColor)
-					CShaderLighting::setLightAmbient(lightingData->Color);
-			}
+		u32 count = m_meshs.size();
+		if (count == 0)
+			return;
 
-			CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
-			driver->setTransform(video::ETS_WORLD, transform->World);
+		core::vector3df cameraPosition;
+		CCamera* camera = entityManager->getCamera();
+		if (camera != NULL)
+			cameraPosition = camera->getPosition();
 
-			bool haveTransparent = false;
+		CRenderMeshData** meshs = m_meshs.pointer();
+		for (u32 i = 0; i < count; i++)
+		{
+			CRenderMeshData* meshData = meshs[i];
 
-			for (u32 j = 0, m = mesh->getMeshBufferCount(); j < m; j++)
+			if (m_autoInstancing &&
+				!meshData->isSoftwareSkinning() &&
+				!meshData->isSoftwareBlendShape() &&
+				canAutoInstancing(meshData->Entity))
 			{
-				CMaterial* material = mesh->Materials[j];
-				if (material == NULL)
+				// collect the entities of the same mesh
+				SMeshAutoInstancing* instancing = getAutoInstancing(meshData->getMesh());
+				if (instancing->Group != NULL)
 				{
-					// draw opaque mesh because unknown material
-					rp->drawMeshBuffer(mesh, j, entityManager, meshData->EntityIndex, false);
-				}
-				else if (material->getShader() != NULL && material->getShader()->isOpaque() == false)
-				{
-					haveTransparent = true;
-				}
-				else
-				{
-					rp->drawMeshBuffer(mesh, j, entityManager, meshData->EntityIndex, false);
+					CIndirectLightingData* lightingData = GET_ENTITY_DATA(meshData->Entity, CIndirectLightingData);
+					ITexture* reflection = lightingData != NULL ? lightingData->ReflectionTexture : NULL;
+
+					if (instancing->Group->Entities.count() == 0)
+					{
+						m_renderInstancing.push_back(instancing);
+						instancing->ReflectionTexture = reflection;
+					}
+
+					// the instancing data is shared by the mesh, so the entities of other probes are not batched
+					if (instancing->ReflectionTexture == reflection)
+					{
+						instancing->Group->Entities.push(meshData->Entity);
+						continue;
+					}
 				}
 			}
 
-			if (haveTransparent == true)
+			addDrawCommand(meshData, cameraPosition);
+		}
+
+		// batch the instancing, or fallback to the draw commands
+		u32 numInstancing = 0;
+		for (u32 i = 0, n = m_renderInstancing.size(); i < n; i++)
+		{
+			SMeshAutoInstancing* instancing = m_renderInstancing[i];
+
+			if (canAutoInstancing(instancing))
+			{
+				batchAutoInstancing(instancing);
+				m_renderInstancing[numInstancing++] = instancing;
+			}
+			else
 			{
-				// this will render in transparent pass
-				m_transparents.push_back(i);
+				CEntity** entities = instancing->Group->Entities.pointer();
+				for (int j = 0, m = instancing->Group->Entities.count(); j < m; j++)
+					addDrawCommand(GET_ENTITY_DATA(entities[j], CRenderMeshData), cameraPosition);
+				instancing->Group->Entities.reset();
 			}
 		}
+		m_renderInstancing.set_used(numInstancing);
+
+		// need sort render by shader, material, texture, mesh
+		u32 numCommand = m_commands.size();
+		if (numCommand > 1)
+		{
+			m_sortBuffer.set_used(numCommand);
+			sortDrawCommand(m_commands.pointer(), m_sortBuffer.pointer(), numCommand);
+		}
 	}
 
-	void CMeshRenderer::renderTransparent(CEntityManager* entityManager)
+	void CMeshRenderer::drawCommands(CEntityManager* entityManager, u32 begin, u32 end)
 	{
-		u32 numTransparent = m_transparents.size();
-		if (numTransparent == 0)
-			return;
-
 		IVideoDriver* driver = getVideoDriver();
-		CShaderManager* shaderManager = CShaderManager::getInstance();
 		IRenderPipeline* rp = entityManager->getRenderPipeline();
-		CRenderMeshData** meshs = m_meshs.pointer();
-		CEntity** allEntities = entityManager->getEntities();
+		SMeshDrawCommand* commands = m_commands.pointer();
 
-		for (u32 i = 0; i < numTransparent; i++)
+		CRenderMeshData* lastMeshData = NULL;
+
+		for (u32 i = begin; i < end; i++)
 		{
-			u32 meshID = m_transparents[i];
+			SMeshDrawCommand& cmd = commands[i];
+			CRenderMeshData* meshData = cmd.MeshData;
+
+			// skip the state of the same entity
+			if (meshData != lastMeshData)
+			{
+				CEntity* entity = meshData->Entity;
 
-			CRenderMeshData* meshData = m_meshs[meshID];
-			CEntity* entity = meshData->Entity;
+				CIndirectLightingData* lightingData = GET_ENTITY_DATA(entity, CIndirectLightingData);
+				if (lightingData != NULL)
+				{
+					if (lightingData->Type == CIndirectLightingData::SH9)
+						CShaderSH::setSH9(lightingData->SH);
+					else if (lightingData->Type == CIndirectLightingData::AmbientColor)
+						CShaderLighting::setLightAmbient(lightingData->Color);
+				}
 
-			// set transform
-			CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
-			driver->setTransform(video::ETS_WORLD, transform->World);
+				CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+				driver->setTransform(video::ETS_WORLD, transform->World);
+
+				lastMeshData = meshData;
+			}
+
+			rp->drawMeshBuffer(cmd.Mesh, cmd.BufferID, entityManager, meshData->EntityIndex, false);
+		}
+	}
 
-			CMesh* mesh = meshData->getMesh();
-			if (meshData->isSoftwareBlendShape())
-				mesh = meshData->getSoftwareBlendShapeMesh();
-			if (meshData->isSoftwareSkinning())
-				mesh = meshData->getSoftwareSkinnedMesh();
+	void CMeshRenderer::drawAutoInstancing(CEntityManager* entityManager)
+	{
+		IVideoDriver* driver = getVideoDriver();
+		IRenderPipeline* rp = entityManager->getRenderPipeline();
+
+		driver->setTransform(video::ETS_WORLD, core::IdentityMatrix);
+
+		for (u32 i = 0, n = m_renderInstancing.size(); i < n; i++)
+		{
+			SMeshAutoInstancing* instancing = m_renderInstancing[i];
+			SMeshInstancing* data = instancing->Data;
 
-			// render mesh
-			for (u32 j = 0, m = mesh->getMeshBufferCount(); j < m; j++)
+			for (u32 j = 0, m = data->RenderMeshBuffers.size(); j < m; j++)
 			{
-				CMaterial* material = mesh->Materials[j];
+				CShader* shader = data->Materials[j]->getShader();
 
-				if (material != NULL &&
-					material->getShader() != NULL &&
-					material->getShader()->isOpaque() == false)
-				{
-					rp->drawMeshBuffer(mesh, j, entityManager, meshData->EntityIndex, false);
-				}
+				if (!rp->canRenderShader(shader))
+					continue;
+
+				CShaderMaterial::setMaterial(data->Materials[j]);
+
+				rp->drawInstancingMeshBuffer(
+					(CMesh*)data->InstancingMesh,
+					j,
+					shader->getInstancingShader(),
+					entityManager,
+					instancing->Group->RootEntityIndex,
+					false
+				);
 			}
 		}
 	}
+
+	void CMeshRenderer::render(CEntityManager* entityManager)
+	{
+		drawAutoInstancing(entityManager);
+
+		drawCommands(entityManager, 0, m_numOpaque);
+	}
+
+	void CMeshRenderer::renderTransparent(CEntityManager* entityManager)
+	{
+		drawCommands(entityManager, m_numOpaque, m_commands.size());
+	}
 }
\ No newline at end of file
@@ -29,13 +29,48 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Transform/CWorldTransformData.h"
 #include "IndirectLighting/CIndirectLightingData.h"
 
+#include "Instancing/SMeshInstancing.h"
+#include "Instancing/SMeshInstancingGroup.h"
+
 namespace Skylicht
 {
+	/// @brief A draw of one mesh buffer, sorted by the 64-bit key.
+	/// Opaque: pass(1) shader(12) material(14) texture(12) mesh buffer(12) depth(13), front to back.
+	/// Transparent: pass(1) depth(31) shader(10) material(12) mesh buffer(10), back to front.
+	struct SMeshDrawCommand
+	{
+		u64 Key;
+		CRenderMeshData* MeshData;
+		CMesh* Mesh;
+		u32 BufferID;
+	};
+
+	/// @brief The visible entities of one mesh, that are drawn by an instancing draw.
+	struct SMeshAutoInstancing
+	{
+		CMesh* Mesh;
+		SMeshInstancing* Data;
+		SMeshInstancingGroup* Group;
+
+		// the reflection probe of the batch, the pipeline binds it from the root entity
+		ITexture* ReflectionTexture;
+	};
+
 	class SKYLICHT_API CMeshRenderer : public CMeshRenderSystem
 	{
 	protected:
 		core::array<CRenderMeshData*> m_meshs;
-		core::array<u32> m_transparents;
+
+		core::array<SMeshDrawCommand> m_commands;
+		core::array<SMeshDrawCommand> m_sortBuffer;
+		u32 m_numOpaque;
+
+		bool m_autoInstancing;
+		u32 m_autoInstancingMinCount;
+
+		std::map<CMesh*, SMeshAutoInstancing> m_instancing;
+		core::array<SMeshAutoInstancing*> m_renderInstancing;
+
 	public:
 		CMeshRenderer();
 
@@ -54,5 +89,53 @@ namespace Skylicht
 		virtual void render(CEntityManager* entityManager);
 
 		virtual void renderTransparent(CEntityManager* entityManager);
+
+		inline u32 getNumDrawCommand()
+		{
+			return m_commands.size();
+		}
+
+		inline u32 getNumAutoInstancing()
+		{
+			return m_renderInstancing.size();
+		}
+
+		/// @brief Batch the visible static meshes, that have the same mesh and material, to instancing draws.
+		/// The mesh is only batched when it has at least minCount visible entities.
+		/// Only the entities lit by SH9 or ambient color are batched, and a batch has one reflection texture,
+		/// the entities of other reflection probes are drawn by the draw commands. It is disabled by default.
+		inline void setAutoInstancing(bool b, u32 minCount = 4)
+		{
+			m_autoInstancing = b;
+			m_autoInstancingMinCount = minCount < 2 ? 2 : minCount;
+		}
+
+		inline bool isAutoInstancing()
+		{
+			return m_autoInstancing;
+		}
+
+		/// @brief Sort the commands by key (LSD radix sort, 8 bits per pass)
+		static void sortDrawCommand(SMeshDrawCommand* commands, SMeshDrawCommand* temp, u32 count);
+
+	protected:
+
+		void addDrawCommand(CRenderMeshData* meshData, const core::vector3df& cameraPosition);
+
+		void drawCommands(CEntityManager* entityManager, u32 begin, u32 end);
+
+		SMeshAutoInstancing* getAutoInstancing(CMesh* mesh);
+
+		/// @brief Release the instancing of the meshes, that are not rendered by any entity
+		void releaseUnusedAutoInstancing();
+
+		bool canAutoInstancing(SMeshAutoInstancing* instancing);
+
+		/// @brief The instancing shader only has the SH and ambient color per instance, the lightmap and vertex color are not batched
+		bool canAutoInstancing(CEntity* entity);
+
+		void batchAutoInstancing(SMeshAutoInstancing* instancing);
+
+		void drawAutoInstancing(CEntityManager* entityManager);
 	};
 }
\ No newline at end of file
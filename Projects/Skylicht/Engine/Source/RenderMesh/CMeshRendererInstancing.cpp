@@ -34,7 +34,10 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
-	CMeshRendererInstancing::CMeshRendererInstancing()
+	CMeshRendererInstancing::CMeshRendererInstancing() :
+		m_frame(0),
+		m_uploadBytes(0),
+		m_numUpdateInstance(0)
 	{
 		m_pipelineType = IRenderPipeline::Mix;
 	}
@@ -56,7 +59,7 @@ namespace Skylicht
 		{
 			SMeshInstancingGroup* group = it.second;
 			group->Materials.reset();
-			group->Entities.reset();
+			group->NewEntities.reset();
 		}
 
 		CMeshRenderSystem::beginQuery(entityManager);
@@ -104,14 +107,99 @@ namespace Skylicht
 
 	}
 
+	bool CMeshRendererInstancing::isVisibleSlot(SMeshInstancingGroup* group, int slot)
+	{
+		SInstancingSlot& s = m_slots[group->EntityIndex.pointer()[slot]];
+		return s.Frame == m_frame && s.Group == group && s.Slot == slot;
+	}
+
+	void CMeshRendererInstancing::updateSlots(SMeshInstancingGroup* group)
+	{
+		CEntity** entities = group->Entities.pointer();
+		int* entityIndex = group->EntityIndex.pointer();
+		int count = group->Entities.count();
+
+		CEntity** newEntities = group->NewEntities.pointer();
+		int numNew = group->NewEntities.count();
+		int newId = 0;
+
+		// fill the hidden slots by new entities, or the last slot
+		int i = 0;
+		while (i < count)
+		{
+			if (isVisibleSlot(group, i))
+			{
+				i++;
+				continue;
+			}
+
+			if (newId < numNew)
+			{
+				CEntity* entity = newEntities[newId++];
+				entities[i] = entity;
+				entityIndex[i] = entity->getIndex();
+				m_slots[entityIndex[i]].Slot = i;
+				i++;
+				continue;
+			}
+
+			// the moved slot is checked again in next loop
+			count--;
+			if (i < count)
+			{
+				if (isVisibleSlot(group, count))
+					m_slots[entityIndex[count]].Slot = i;
+
+				entities[i] = entities[count];
+				entityIndex[i] = entityIndex[count];
+			}
+		}
+
+		group->Entities.setCount(count);
+		group->EntityIndex.setCount(count);
+
+		for (; newId < numNew; newId++)
+		{
+			CEntity* entity = newEntities[newId];
+			m_slots[entity->getIndex()].Slot = group->Entities.count();
+			group->Entities.push(entity);
+			group->EntityIndex.push(entity->getIndex());
+		}
+	}
+
+	bool CMeshRendererInstancing::needBatchMaterial(SMeshInstancingGroup* group, u32 id, CMaterial* material, int count)
+	{
+		if (group->BatchMaterials.size() <= id)
+		{
+			group->BatchMaterials.set_used(id + 1);
+			group->BatchParams.set_used(id + 1);
+			group->BatchMaterials[id] = NULL;
+		}
+
+		// all instances have the same material, so just check the count and params
+		CShaderParams& params = material->getShaderParams();
+		if (group->BatchCount == count &&
+			group->BatchMaterials[id] == material &&
+			memcmp(group->BatchParams[id].getParamData(0), params.getParamData(0), sizeof(SVec4) * MAX_SHADERPARAMS) == 0)
+		{
+			return false;
+		}
+
+		group->BatchMaterials[id] = material;
+		group->BatchParams[id] = params;
+		return true;
+	}
+
 	void CMeshRendererInstancing::update(CEntityManager* entityManager)
 	{
 		u32 numEntity = m_meshs.size();
 		CRenderMeshData** renderData = m_meshs.pointer();
 
-		CEntity** allEntities = entityManager->getEntities();
+		m_frame++;
+		m_uploadBytes = 0;
+		m_numUpdateInstance = 0;
 
-		// update instancing
+		// keep the slot of entities that still visible
 		for (u32 i = 0; i < numEntity; i++)
 		{
 			SMeshInstancing* data = renderData[i]->getMeshInstancing();
@@ -127,7 +215,32 @@ namespace Skylicht
 				data->InstancingGroup = group;
 			}
 
-			group->Entities.push(renderData[i]->Entity);
+			CEntity* entity = renderData[i]->Entity;
+			int entityIndex = renderData[i]->EntityIndex;
+
+			while ((int)m_slots.size() <= entityIndex)
+			{
+				SInstancingSlot s;
+				s.Entity = NULL;
+				s.Group = NULL;
+				s.Slot = -1;
+				s.Frame = 0;
+				m_slots.push_back(s);
+			}
+
+			SInstancingSlot& s = m_slots[entityIndex];
+			if (s.Group != group ||
+				s.Entity != entity ||
+				s.Slot < 0 ||
+				s.Slot >= group->Entities.count() ||
+				group->Entities.pointer()[s.Slot] != entity)
+			{
+				s.Entity = entity;
+				s.Group = group;
+				s.Slot = -1;
+				group->NewEntities.push(entity);
+			}
+			s.Frame = m_frame;
 		}
 
 		// bake instancing in group
@@ -136,7 +249,9 @@ namespace Skylicht
 			SMeshInstancing* data = it.first;
 			SMeshInstancingGroup* group = it.second;
 
-			u32 count = group->Entities.count();
+			updateSlots(group);
+
+			int count = group->Entities.count();
 			if (count == 0)
 				continue;
 
@@ -154,9 +269,9 @@ namespace Skylicht
 						batchMaterial = false;
 				}
 
-				if (batchMaterial)
+				if (batchMaterial && needBatchMaterial(group, i, data->Materials[i], count))
 				{
-					for (u32 j = 0; j < count; j++)
+					for (int j = 0; j < count; j++)
 						group->Materials.push(data->Materials[i]);
 
 					// batching transform & material data to buffer
@@ -166,8 +281,12 @@ namespace Skylicht
 						group->Entities.pointer(),
 						count
 					);
+
+					IVertexBuffer* materialBuffer = data->MaterialBuffer[i];
+					m_uploadBytes += materialBuffer->getVertexCount() * materialBuffer->getVertexSize();
 				}
 			}
+			group->BatchCount = count;
 
 			bool batchTransform = true;
 			if (data->UseShareTransformBuffer)
@@ -182,12 +301,25 @@ namespace Skylicht
 
 			if (batchTransform)
 			{
-				IShaderInstancing::batchTransformAndLighting(
-					data->TransformBuffer,
-					data->IndirectLightingBuffer,
+				IVertexBuffer* transformBuffer = data->TransformBuffer;
+				IVertexBuffer* lightingBuffer = data->IndirectLightingBuffer;
+
+				u32 transformID = transformBuffer->getChangedID();
+				u32 lightingID = lightingBuffer->getChangedID();
+
+				// only rewrite the instances, that changed
+				m_numUpdateInstance += IShaderInstancing::updateTransformAndLighting(
+					transformBuffer,
+					lightingBuffer,
 					group->Entities.pointer(),
 					count
 				);
+
+				if (transformID != transformBuffer->getChangedID())
+					m_uploadBytes += transformBuffer->getVertexCount() * transformBuffer->getVertexSize();
+
+				if (lightingID != lightingBuffer->getChangedID())
+					m_uploadBytes += lightingBuffer->getVertexCount() * lightingBuffer->getVertexSize();
 			}
 		}
 	}
@@ -34,6 +34,15 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
+	/// @brief The slot of a visible entity in its instancing group
+	struct SInstancingSlot
+	{
+		CEntity* Entity;
+		SMeshInstancingGroup* Group;
+		int Slot;
+		u32 Frame;
+	};
+
 	class SKYLICHT_API CMeshRendererInstancing : public CMeshRenderSystem
 	{
 	protected:
@@ -41,6 +50,15 @@ namespace Skylicht
 
 		std::map<SMeshInstancing*, SMeshInstancingGroup*> m_groups;
 
+		// slot by entity index
+		core::array<SInstancingSlot> m_slots;
+
+		u32 m_frame;
+
+		u32 m_uploadBytes;
+
+		u32 m_numUpdateInstance;
+
 	public:
 		CMeshRendererInstancing();
 
@@ -55,5 +73,25 @@ namespace Skylicht
 		virtual void update(CEntityManager* entityManager);
 
 		virtual void render(CEntityManager* entityManager);
+
+		/// @brief The size of instancing buffers, that changed in last update and will upload to gpu
+		inline u32 getUploadBytes()
+		{
+			return m_uploadBytes;
+		}
+
+		/// @brief The number of instances, that rewrote transform or lighting in last update
+		inline u32 getNumUpdateInstance()
+		{
+			return m_numUpdateInstance;
+		}
+
+	protected:
+
+		bool isVisibleSlot(SMeshInstancingGroup* group, int slot);
+
+		void updateSlots(SMeshInstancingGroup* group);
+
+		bool needBatchMaterial(SMeshInstancingGroup* group, u32 id, CMaterial* material, int count);
 	};
 }
\ No newline at end of file
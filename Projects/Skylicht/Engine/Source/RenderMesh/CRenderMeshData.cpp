@@ -32,6 +32,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "MeshManager/CMeshManager.h"
 #include "Utils/CPath.h"
 #include "Importer/IMeshImporter.h"
+#include "Exporter/ExportResources.h"
 #include "VertexAnimation/CSoftwareSkinningUtils.h"
 
 namespace Skylicht
@@ -255,7 +256,29 @@ namespace Skylicht
 		IsSkinnedInstancing = false;
 	}
 
+	u32 writeMeshBlob(CMemoryStream* blob, const void* data, u32 size)
+	{
+		// align the buffer in blob
+		u32 padding = (MESH_PACK_ALIGN - (blob->getSize() % MESH_PACK_ALIGN)) % MESH_PACK_ALIGN;
+		for (u32 i = 0; i < padding; i++)
+			blob->writeChar(0);
+
+		u32 offset = blob->getSize();
+		blob->writeData(data, size);
+		return offset;
+	}
+
 	bool CRenderMeshData::serializable(CMemoryStream* stream)
+	{
+		return serializableMesh(stream, NULL);
+	}
+
+	bool CRenderMeshData::serializablePack(CMemoryStream* stream, CMemoryStream* blob)
+	{
+		return serializableMesh(stream, blob);
+	}
+
+	bool CRenderMeshData::serializableMesh(CMemoryStream* stream, CMemoryStream* blob)
 	{
 		stream->writeChar(IsSkinnedMesh ? 1 : 0);
 
@@ -341,17 +364,35 @@ namespace Skylicht
 				stream->writeShort(attribute->getTypeSize());
 			}
 
-			// write vertex data
-			stream->writeData(vb->getVertices(), vtxBufferSize);
+			if (blob == NULL)
+			{
+				// write vertex data
+				stream->writeData(vb->getVertices(), vtxBufferSize);
 
-			// write indices data
-			stream->writeData(ib->getIndices(), idxBufferSize);
+				// write indices data
+				stream->writeData(ib->getIndices(), idxBufferSize);
+			}
+			else
+			{
+				stream->writeUInt(writeMeshBlob(blob, vb->getVertices(), vtxBufferSize));
+				stream->writeUInt(writeMeshBlob(blob, ib->getIndices(), idxBufferSize));
+			}
 		}
 
 		return true;
 	}
 
 	bool CRenderMeshData::deserializable(CMemoryStream* stream, int version)
+	{
+		return deserializableMesh(stream, NULL, 0, version);
+	}
+
+	bool CRenderMeshData::deserializablePack(CMemoryStream* stream, const unsigned char* blob, u32 blobSize, int version)
+	{
+		return deserializableMesh(stream, blob, blobSize, version);
+	}
+
+	bool CRenderMeshData::deserializableMesh(CMemoryStream* stream, const unsigned char* blob, u32 blobSize, int version)
 	{
 		CShaderManager* shaderMgr = CShaderManager::getInstance();
 
@@ -462,16 +503,47 @@ namespace Skylicht
 				short typeSize = stream->readShort();
 			}
 
+			// the vertex and index data is inline (version 1) or in the blob (packed)
+			const unsigned char* data = blob;
+			u32 dataSize = blobSize;
+			u32 vtxOffset = 0;
+			u32 idxOffset = 0;
+
+			if (blob == NULL)
+			{
+				data = stream->getData();
+				dataSize = stream->getSize();
+				vtxOffset = stream->getPos();
+				idxOffset = vtxOffset + vtxBufferSize;
+				stream->setPos(idxOffset + idxBufferSize);
+			}
+			else
+			{
+				vtxOffset = stream->readUInt();
+				idxOffset = stream->readUInt();
+			}
+
+			if (vtxOffset > dataSize || dataSize - vtxOffset < vtxBufferSize ||
+				idxOffset > dataSize || dataSize - idxOffset < idxBufferSize)
+			{
+				os::Printer::log("[CRenderMeshData::deserializable] Buffer data is out of range");
+				if (mb != NULL)
+				{
+					mb->drop();
+					mb = NULL;
+				}
+			}
+
 			if (mb != NULL)
 			{
 				IVertexBuffer* vtxBuffer = mb->getVertexBuffer();
 				IIndexBuffer* idxBuffer = mb->getIndexBuffer();
 
 				vtxBuffer->set_used(vtxCount);
-				stream->readData(vtxBuffer->getVertices(), vtxBufferSize);
+				memcpy(vtxBuffer->getVertices(), data + vtxOffset, vtxBufferSize);
 
 				idxBuffer->set_used(idxCount);
-				stream->readData(idxBuffer->getIndices(), idxBufferSize);
+				memcpy(idxBuffer->getIndices(), data + idxOffset, idxBufferSize);
 
 				mb->getBoundingBox() = bbox;
 				mb->setHardwareMappingHint(EHM_STATIC);
@@ -505,4 +577,79 @@ namespace Skylicht
 
 		return true;
 	}
+
+	bool CRenderMeshData::convertPack(CMemoryStream* input, CMemoryStream* output, CMemoryStream* blob)
+	{
+		char isSkinnedMesh = input->readChar();
+		output->writeChar(isSkinnedMesh);
+
+		if (isSkinnedMesh == 1)
+		{
+			u32 numJoint = input->readUInt();
+			output->writeUInt(numJoint);
+
+			core::matrix4 bindPose;
+			for (u32 i = 0; i < numJoint; i++)
+			{
+				output->writeString(input->readString());
+				output->writeInt(input->readInt());
+
+				input->readFloatArray(bindPose.pointer(), 16);
+				output->writeFloatArray(bindPose.pointer(), 16);
+			}
+		}
+
+		u32 numMB = input->readUInt();
+		output->writeUInt(numMB);
+
+		for (u32 i = 0; i < numMB; i++)
+		{
+			// material & textures
+			for (int t = 0; t < 4; t++)
+				output->writeString(input->readString());
+
+			core::aabbox3df bbox;
+			input->readFloatArray(&bbox.MinEdge.X, 3);
+			input->readFloatArray(&bbox.MaxEdge.X, 3);
+			output->writeFloatArray(&bbox.MinEdge.X, 3);
+			output->writeFloatArray(&bbox.MaxEdge.X, 3);
+
+			u32 vtxCount = input->readUInt();
+			u32 vtxSize = input->readUInt();
+			u32 idxCount = input->readUInt();
+			u32 idxSize = input->readUInt();
+
+			output->writeUInt(vtxCount);
+			output->writeUInt(vtxSize);
+			output->writeUInt(idxCount);
+			output->writeUInt(idxSize);
+
+			output->writeString(input->readString());
+
+			u32 numAttribute = input->readUInt();
+			output->writeUInt(numAttribute);
+			for (u32 j = 0; j < numAttribute; j++)
+			{
+				output->writeString(input->readString());
+				output->writeShort(input->readShort());
+				output->writeShort(input->readShort());
+				output->writeShort(input->readShort());
+			}
+
+			u32 vtxBufferSize = vtxCount * vtxSize;
+			u32 idxBufferSize = idxCount * idxSize;
+
+			u32 pos = input->getPos();
+			if (pos > input->getSize() || input->getSize() - pos < vtxBufferSize + idxBufferSize)
+				return false;
+
+			const unsigned char* data = input->getData() + pos;
+			output->writeUInt(writeMeshBlob(blob, data, vtxBufferSize));
+			output->writeUInt(writeMeshBlob(blob, data + vtxBufferSize, idxBufferSize));
+
+			input->setPos(pos + vtxBufferSize + idxBufferSize);
+		}
+
+		return true;
+	}
 }
@@ -147,7 +147,22 @@ namespace Skylicht
 
 		virtual bool deserializable(CMemoryStream* stream, int version);
 
+		/// @brief Serialize for the packed model (AssetVersion 2), the vertex and index buffers are written aligned to the blob, and the stream saves their offsets
+		bool serializablePack(CMemoryStream* stream, CMemoryStream* blob);
+
+		/// @brief Deserialize the packed model, the vertex and index buffers are bulk copied from the blob
+		bool deserializablePack(CMemoryStream* stream, const unsigned char* blob, u32 blobSize, int version);
+
+		/// @brief Convert the data of AssetVersion 1 to the packed data, without create the mesh
+		static bool convertPack(CMemoryStream* input, CMemoryStream* output, CMemoryStream* blob);
+
 		DECLARE_GETTYPENAME(CRenderMeshData)
+
+	protected:
+
+		bool serializableMesh(CMemoryStream* stream, CMemoryStream* blob);
+
+		bool deserializableMesh(CMemoryStream* stream, const unsigned char* blob, u32 blobSize, int version);
 	};
 
 	DECLARE_PUBLIC_DATA_TYPE_INDEX(CRenderMeshData);
@@ -25,13 +25,15 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "pch.h"
 #include "Culling/CVisibleData.h"
 #include "Entity/CEntityManager.h"
+#include "RenderMesh/CJointData.h"
 #include "CSkinnedMeshSystem.h"
 
 namespace Skylicht
 {
 	CSkinnedMeshSystem::CSkinnedMeshSystem()
 	{
-
+		declareReadData(DATA_TYPE_INDEX(CJointData));
+		declareWriteData(DATA_TYPE_INDEX(CRenderMeshData));
 	}
 
 	CSkinnedMeshSystem::~CSkinnedMeshSystem()
@@ -33,7 +33,8 @@ namespace Skylicht
 {
 	CSoftwareBlendShapeSystem::CSoftwareBlendShapeSystem()
 	{
-
+		declareReadData(DATA_TYPE_INDEX(CCullingData));
+		declareWriteData(DATA_TYPE_INDEX(CRenderMeshData));
 	}
 
 	CSoftwareBlendShapeSystem::~CSoftwareBlendShapeSystem()
@@ -31,7 +31,8 @@ namespace Skylicht
 {
 	CSoftwareSkinningSystem::CSoftwareSkinningSystem()
 	{
-
+		declareReadData(DATA_TYPE_INDEX(CCullingData));
+		declareWriteData(DATA_TYPE_INDEX(CRenderMeshData));
 	}
 
 	CSoftwareSkinningSystem::~CSoftwareSkinningSystem()
@@ -262,6 +262,17 @@ namespace Skylicht
 		m.ZWriteEnable = false;
 	}
 
+	void CDeferredRP::renderLightRect(const core::rectf& rect, float w, float h, SMaterial& material)
+	{
+		// the rect is in [0, 1] screen space, the gbuffer has the same size of target
+		float x = floorf(rect.UpperLeftCorner.X * w);
+		float y = floorf(rect.UpperLeftCorner.Y * h);
+		float rw = ceilf(rect.LowerRightCorner.X * w) - x;
+		float rh = ceilf(rect.LowerRightCorner.Y * h) - y;
+
+		renderBufferToTarget(x, y, rw, rh, x, y, rw, rh, material);
+	}
+
 	void CDeferredRP::enableTestIndirect(bool b)
 	{
 		g_enableRenderTestIndirect = b;
@@ -465,6 +476,11 @@ namespace Skylicht
 		entityManager->setCamera(camera);
 		entityManager->setRenderPipeline(this);
 
+		// the light pass draws the lights over the tiles of the light clusters
+		CLightCullingSystem* lightCulling = entityManager->getSystem<CLightCullingSystem>();
+		if (lightCulling != NULL)
+			lightCulling->enableCluster(true);
+
 		float renderW = (float)m_size.Width;
 		float renderH = (float)m_size.Height;
 
@@ -543,6 +559,10 @@ namespace Skylicht
 			{
 				CShadowRTTManager* shadowRTT = CShadowRTTManager::getInstance();
 
+				// the light clusters limit the light pass to the tiles it affects
+				CLightCluster* lightCluster = lightCullingSystem->getLightCluster();
+				core::rectf lightRect(0.0f, 0.0f, 1.0f, 1.0f);
+
 				core::array<CLightCullingData*>& listLight = lightCullingSystem->getLightVisible();
 				for (u32 i = 0, n = (u32)listLight.size(); i < n && i < s_maxLight; i++)
 				{
@@ -550,6 +570,10 @@ namespace Skylicht
 
 					bool renderLight = true;
 
+					// the light is out of the clusters
+					if (lightCluster != NULL && !lightCluster->getLightScreenRect(i, lightRect))
+						renderLight = false;
+
 					if (s_bakeMode == true && s_bakeLMMode == true)
 					{
 						u32 lightBounce = light->getBounce();
@@ -582,7 +606,7 @@ namespace Skylicht
 							}
 
 							beginRender2D(renderW, renderH);
-							renderBufferToTarget(0.0f, 0.0f, renderW, renderH, m_pointLightPass);
+							renderLightRect(lightRect, renderW, renderH, m_pointLightPass);
 						}
 						else
 						{
@@ -595,7 +619,7 @@ namespace Skylicht
 								m_spotLightPass.setTexture(3, NULL);
 
 								beginRender2D(renderW, renderH);
-								renderBufferToTarget(0.0f, 0.0f, renderW, renderH, m_spotLightPass);
+								renderLightRect(lightRect, renderW, renderH, m_spotLightPass);
 							}
 						}
 					}
@@ -89,6 +89,7 @@ namespace Skylicht
 		void initDefferredMaterial();
 		void initPointLightMaterial();
 		void disableFloatTextureFilter(SMaterial& m);
+		void renderLightRect(const core::rectf& rect, float w, float h, SMaterial& material);
 
 	public:
 		CDeferredRP();
@@ -452,6 +452,14 @@ namespace Skylicht
 		return m_sm->getFrustumBox();
 	}
 
+	const scene::SViewFrustum& CShadowMapRP::getFrustum()
+	{
+		if (m_shadowMapType == CShadowMapRP::CascadedShadow)
+			return m_csm->getFrustum(m_currentCSM);
+
+		return m_sm->getFrustum();
+	}
+
 	float* CShadowMapRP::getShadowDistance()
 	{
 		if (m_shadowMapType == CShadowMapRP::CascadedShadow)
@@ -518,12 +526,14 @@ namespace Skylicht
 
 				m_currentCSM = i;
 
+				// cull the casters with the frustum of each cascade,
+				// the systems that only depend on the camera are updated at the first cascade
 				if (castShadow)
 				{
 					if (i == m_numCascade - 1)
 						entityManager->cullingAndRender();
 					else
-						entityManager->render();
+						entityManager->cullingAndRenderNextView();
 				}
 			}
 		}
@@ -121,6 +121,9 @@ namespace Skylicht
 
 		virtual const core::aabbox3df& getFrustumBox();
 
+		/// @brief The view frustum of the current cascade, the culling systems use it to cull the shadow casters
+		const scene::SViewFrustum& getFrustum();
+
 		inline ITexture* getDepthTexture()
 		{
 			return m_depthTexture;
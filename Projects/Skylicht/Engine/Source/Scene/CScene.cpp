@@ -30,7 +30,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
-	CScene::CScene()
+	CScene::CScene() :
+		m_searchOrder(0)
 	{
 		m_entityManager = new CEntityManager();
 		CEventManager::getInstance()->registerEvent("Scene", this);
@@ -69,17 +70,18 @@ namespace Skylicht
 
 	CGameObject* CScene::searchObjectInChild(const wchar_t* name)
 	{
-		CGameObject* obj = searchObject(name);
-		if (obj == NULL)
+		ArrayGameObject* objects = getObjectsByName(name);
+		if (objects == NULL)
+			return NULL;
+
+		// the first added object
+		CGameObject* result = NULL;
+		for (CGameObject* obj : *objects)
 		{
-			for (CZone*& zone : m_zones)
-			{
-				obj = zone->searchObjectInChild(name);
-				if (obj != NULL)
-					return obj;
-			}
+			if (result == NULL || obj->getSearchOrder() < result->getSearchOrder())
+				result = obj;
 		}
-		return obj;
+		return result;
 	}
 
 	CGameObject* CScene::searchObjectByID(const char* id)
@@ -94,17 +96,97 @@ namespace Skylicht
 
 	CGameObject* CScene::searchObjectInChildByID(const char* id)
 	{
-		CGameObject* obj = searchObjectByID(id);
-		if (obj == NULL)
-		{
-			for (CZone*& zone : m_zones)
-			{
-				obj = zone->searchObjectInChildByID(id);
-				if (obj != NULL)
-					return obj;
-			}
-		}
-		return obj;
+		return getObjectByID(id);
+	}
+
+	void CScene::registerObject(CGameObject* object)
+	{
+		if (object->m_searchIndexed)
+			return;
+
+		object->m_searchIndexed = true;
+
+		addObjectName(object);
+
+		if (!object->getID().empty())
+			m_objectByID[object->getID()] = object;
+	}
+
+	void CScene::unRegisterObject(CGameObject* object)
+	{
+		if (!object->m_searchIndexed)
+			return;
+
+		object->m_searchIndexed = false;
+
+		removeObjectName(object, object->getName());
+
+		std::unordered_map<std::string, CGameObject*>::iterator j = m_objectByID.find(object->getID());
+		if (j != m_objectByID.end() && j->second == object)
+			m_objectByID.erase(j);
+	}
+
+	void CScene::updateObjectName(CGameObject* object, const std::wstring& oldName)
+	{
+		removeObjectName(object, oldName);
+		addObjectName(object);
+	}
+
+	void CScene::addObjectName(CGameObject* object)
+	{
+		ArrayGameObject& objects = m_objectByName[object->getName()];
+
+		object->m_searchSlot = (u32)objects.size();
+		object->m_searchOrder = ++m_searchOrder;
+		objects.push_back(object);
+	}
+
+	void CScene::removeObjectName(CGameObject* object, const std::wstring& name)
+	{
+		std::unordered_map<std::wstring, ArrayGameObject>::iterator i = m_objectByName.find(name);
+		if (i == m_objectByName.end())
+			return;
+
+		ArrayGameObject& objects = i->second;
+
+		u32 slot = object->m_searchSlot;
+		if (slot >= objects.size() || objects[slot] != object)
+			return;
+
+		// swap with the last object, the order of the bucket is not kept
+		CGameObject* last = objects.back();
+		objects[slot] = last;
+		last->m_searchSlot = slot;
+		objects.pop_back();
+
+		if (objects.size() == 0)
+			m_objectByName.erase(i);
+	}
+
+	void CScene::updateObjectID(CGameObject* object, const std::string& oldID)
+	{
+		std::unordered_map<std::string, CGameObject*>::iterator i = m_objectByID.find(oldID);
+		if (i != m_objectByID.end() && i->second == object)
+			m_objectByID.erase(i);
+
+		if (!object->getID().empty())
+			m_objectByID[object->getID()] = object;
+	}
+
+	ArrayGameObject* CScene::getObjectsByName(const wchar_t* name)
+	{
+		std::unordered_map<std::wstring, ArrayGameObject>::iterator i = m_objectByName.find(name);
+		if (i == m_objectByName.end())
+			return NULL;
+		return &i->second;
+	}
+
+	CGameObject* CScene::getObjectByID(const char* id)
+	{
+		std::unordered_map<std::string, CGameObject*>::iterator i = m_objectByID.find(id);
+		if (i == m_objectByID.end())
+			return NULL;
+		return i->second;
 	}
 
 	void CScene::releaseScene()
@@ -116,6 +198,9 @@ namespace Skylicht
 		}
 		m_zones.clear();
 
+		m_objectByName.clear();
+		m_objectByID.clear();
+
 		delete m_entityManager;
 		m_entityManager = NULL;
 	}
@@ -142,8 +227,13 @@ namespace Skylicht
 
 	void CScene::updateIndexSearchObject()
 	{
+		// the index is updated on add, remove and rename
+		// so this only registers the objects that are missing
 		for (CZone*& zone : m_zones)
+		{
+			registerObject(zone);
 			zone->updateIndexSearchObject();
+		}
 	}
 
 	CZone* CScene::createZone()
@@ -158,6 +248,7 @@ namespace Skylicht
 		zone->setupEulerTransform();
 
 		m_zones.push_back(zone);
+		registerObject(zone);
 		return zone;
 	}
 
@@ -42,6 +42,11 @@ namespace Skylicht
 
 		ArrayZone m_zones;
 
+		// name/id index of all objects in the scene, that is updated on add, remove and rename
+		std::unordered_map<std::wstring, ArrayGameObject> m_objectByName;
+		std::unordered_map<std::string, CGameObject*> m_objectByID;
+		u32 m_searchOrder;
+
 		CEntityManager* m_entityManager;
 
 		typedef std::pair<std::string, IEventReceiver*> eventType;
@@ -81,6 +86,22 @@ namespace Skylicht
 
 		virtual CGameObject* searchObjectInChildByID(const char* id);
 
+		/// @brief Add the object to the name/id index, it is called when the object is added to a container
+		void registerObject(CGameObject* object);
+
+		/// @brief Remove the object from the name/id index, it is called when the object is deleted
+		void unRegisterObject(CGameObject* object);
+
+		void updateObjectName(CGameObject* object, const std::wstring& oldName);
+
+		void updateObjectID(CGameObject* object, const std::string& oldID);
+
+		/// @brief Get all objects in the scene that have the name, return NULL if there is no object.
+		/// The objects are not sorted, because the removed object is swapped with the last one, use CGameObject::getSearchOrder to find the oldest.
+		ArrayGameObject* getObjectsByName(const wchar_t* name);
+
+		CGameObject* getObjectByID(const char* id);
+
 		virtual CZone* createZone();
 
 		virtual void removeZone(CGameObject* zone);
@@ -120,5 +141,11 @@ namespace Skylicht
 		void loadSerializable(CObjectSerializable* object);
 
 		DECLARE_GETTYPENAME(CScene)
+
+	protected:
+
+		void addObjectName(CGameObject* object);
+
+		void removeObjectName(CGameObject* object, const std::wstring& name);
 	};
 }
\ No newline at end of file
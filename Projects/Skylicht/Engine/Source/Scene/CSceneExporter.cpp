@@ -102,4 +102,131 @@ namespace Skylicht
 		data->save(path);
 		delete data;
 	}
+
+	void CSceneExporter::addBinaryObject(CSerializableBinary* binary, CGameObject* object, s32 parent, core::array<SSceneBinaryObject>& objects, core::array<u32>& components, CMemoryStream* payload)
+	{
+		CContainerObject* container = dynamic_cast<CContainerObject*>(object);
+
+		SSceneBinaryObject binaryObject;
+		if (dynamic_cast<CZone*>(object) != NULL)
+			binaryObject.Type = SSceneBinaryObject::Zone;
+		else if (container != NULL)
+			binaryObject.Type = SSceneBinaryObject::Container;
+		else
+			binaryObject.Type = SSceneBinaryObject::GameObject;
+
+		binaryObject.Parent = parent;
+
+		// the node of object does not have the childs, they are in the object table
+		CObjectSerializable* data = object->createSerializable();
+
+		binaryObject.FirstComponent = components.size();
+
+		CObjectSerializable* coms = data->getProperty<CObjectSerializable>("Components");
+		if (coms != NULL)
+		{
+			for (u32 i = 0, n = coms->getNumProperty(); i < n; i++)
+				components.push_back(binary->getStringID(coms->getPropertyID(i)->Name));
+		}
+
+		binaryObject.NumComponent = components.size() - binaryObject.FirstComponent;
+
+		binaryObject.Offset = payload->getSize();
+		binary->write(payload, data);
+		binaryObject.Size = payload->getSize() - binaryObject.Offset;
+
+		delete data;
+
+		s32 id = (s32)objects.size();
+		objects.push_back(binaryObject);
+
+		if (container != NULL)
+		{
+			ArrayGameObject* go = container->getChilds();
+			for (size_t i = 0, n = go->size(); i < n; i++)
+			{
+				CGameObject* childObject = go->at(i);
+				if (childObject->isEditorObject())
+					continue;
+
+				addBinaryObject(binary, childObject, id, objects, components, payload);
+			}
+		}
+	}
+
+	u32 alignSceneOffset(u32 offset)
+	{
+		return (offset + SCENE_BINARY_ALIGN - 1) & ~(SCENE_BINARY_ALIGN - 1);
+	}
+
+	void writeSceneSection(io::IWriteFile* writeFile, u32 offset, const void* data, u32 size)
+	{
+		static const char padding[SCENE_BINARY_ALIGN] = { 0 };
+
+		u32 pos = (u32)writeFile->getPos();
+		if (offset > pos)
+			writeFile->write(padding, offset - pos);
+
+		if (size > 0)
+			writeFile->write(data, size);
+	}
+
+	bool CSceneExporter::exportSceneBinary(CScene* scene, const char* path)
+	{
+		CSerializableBinary binary;
+
+		CMemoryStream sceneNode(512);
+		CMemoryStream payload(4096);
+
+		core::array<SSceneBinaryObject> objects;
+		core::array<u32> components;
+
+		CObjectSerializable* data = scene->createSerializable();
+		binary.write(&sceneNode, data);
+		delete data;
+
+		ArrayZone* zones = scene->getAllZone();
+		for (CZone* zone : *zones)
+		{
+			if (zone->isEditorObject())
+				continue;
+
+			addBinaryObject(&binary, zone, -1, objects, components, &payload);
+		}
+
+		CMemoryStream strings(4096);
+		binary.writeStrings(&strings);
+
+		SSceneBinaryHeader header;
+		header.NumString = binary.getStringCount();
+		header.StringOffset = alignSceneOffset(sizeof(SAssetHeader) + sizeof(SSceneBinaryHeader));
+		header.SceneOffset = alignSceneOffset(header.StringOffset + strings.getSize());
+		header.SceneSize = sceneNode.getSize();
+		header.NumObject = objects.size();
+		header.ObjectOffset = alignSceneOffset(header.SceneOffset + header.SceneSize);
+		header.NumComponent = components.size();
+		header.ComponentOffset = alignSceneOffset(header.ObjectOffset + header.NumObject * sizeof(SSceneBinaryObject));
+		header.PayloadOffset = alignSceneOffset(header.ComponentOffset + header.NumComponent * sizeof(u32));
+		header.PayloadSize = payload.getSize();
+
+		io::IWriteFile* writeFile = getIrrlichtDevice()->getFileSystem()->createAndWriteFile(path);
+		if (writeFile == NULL)
+			return false;
+
+		SAssetHeader assetHeader;
+		strcpy(assetHeader.Sign, "SLT");
+		assetHeader.AssetType = (u32)AssetScene;
+		assetHeader.AssetVersion = SCENE_BINARY_VERSION;
+
+		writeFile->write(&assetHeader, sizeof(SAssetHeader));
+		writeFile->write(&header, sizeof(SSceneBinaryHeader));
+		writeSceneSection(writeFile, header.StringOffset, strings.getData(), strings.getSize());
+		writeSceneSection(writeFile, header.SceneOffset, sceneNode.getData(), header.SceneSize);
+		writeSceneSection(writeFile, header.ObjectOffset, objects.const_pointer(), header.NumObject * sizeof(SSceneBinaryObject));
+		writeSceneSection(writeFile, header.ComponentOffset, components.const_pointer(), header.NumComponent * sizeof(u32));
+		writeSceneSection(writeFile, header.PayloadOffset, payload.getData(), header.PayloadSize);
+
+		writeFile->drop();
+		return true;
+	}
 }
\ No newline at end of file
@@ -27,6 +27,8 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "GameObject/CZone.h"
 #include "CScene.h"
 #include "Serializable/CObjectSerializable.h"
+#include "Serializable/CSerializableBinary.h"
+#include "Exporter/ExportResources.h"
 
 namespace Skylicht
 {
@@ -35,11 +37,16 @@ namespace Skylicht
 	protected:
 		static void loadChildObjectSerializable(CContainerObject* container, CObjectSerializable* data);
 
+		static void addBinaryObject(CSerializableBinary* binary, CGameObject* object, s32 parent, core::array<SSceneBinaryObject>& objects, core::array<u32>& components, CMemoryStream* payload);
+
 	public:
 		static CObjectSerializable* exportGameObject(CGameObject* object);
 
 		static void exportGameObject(CGameObject* object, const char* path);
 
 		static void exportScene(CScene* scene, const char* path);
+
+		/// @brief Export the scene to the binary, that is loaded by CSceneImporter::beginImportScene (see AssetScene in ExportResources.h)
+		static bool exportSceneBinary(CScene* scene, const char* path);
 	};
 }
\ No newline at end of file
@@ -25,6 +25,12 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "pch.h"
 #include "CSceneImporter.h"
 #include "Utils/CStringImp.h"
+#include "Utils/CMappedFile.h"
+#include "Serializable/CSerializableBinary.h"
+#include "Exporter/ExportResources.h"
+#include "Thread/CJobSystem.h"
+
+#define SCENE_BINARY_PARSE_BATCH 32
 
 namespace Skylicht
 {
@@ -38,6 +44,13 @@ namespace Skylicht
 	std::list<CGameObject*> g_listGameObject;
 	std::list<CGameObject*>::iterator g_currentGameObject;
 
+	// binary scene
+	CMappedFile* g_sceneFile = NULL;
+	CSerializableBinary* g_sceneBinary = NULL;
+	std::vector<CObjectSerializable*> g_sceneObjectData;
+	System::CJobGroup* g_sceneParseGroups = NULL;
+	u32 g_sceneParseBatchCount = 0;
+
 	void CSceneImporter::buildComponent(CGameObject* object, io::IXMLReader* reader)
 	{
 		std::wstring nodeName = L"node";
@@ -60,22 +73,7 @@ namespace Skylicht
 					{
 						attributeName = reader->getAttributeValue(L"type");
 						std::string componentName = CStringImp::convertUnicodeToUTF8(attributeName.c_str());
-
-						CComponentSystem* comSystem = object->getComponentByTypeName(componentName.c_str());
-						if (comSystem == NULL)
-						{
-							// try add component
-							if (object->addComponentByTypeName(componentName.c_str()) == NULL)
-							{
-								char log[512];
-								sprintf(log, "[CSceneImporter] Found unsupport component '%s'", componentName.c_str());
-								os::Printer::log(log);
-
-								// unsupport component
-								CNullComponent* nullComponent = object->addComponent<CNullComponent>();
-								nullComponent->setName(componentName);
-							}
-						}
+						addComponent(object, componentName.c_str());
 					}
 				}
 				break;
@@ -92,6 +90,25 @@ namespace Skylicht
 		}
 	}
 
+	void CSceneImporter::addComponent(CGameObject* object, const char* componentName)
+	{
+		CComponentSystem* comSystem = object->getComponentByTypeName(componentName);
+		if (comSystem == NULL)
+		{
+			// try add component
+			if (object->addComponentByTypeName(componentName) == NULL)
+			{
+				char log[512];
+				sprintf(log, "[CSceneImporter] Found unsupport component '%s'", componentName);
+				os::Printer::log(log);
+
+				// unsupport component
+				CNullComponent* nullComponent = object->addComponent<CNullComponent>();
+				nullComponent->setName(componentName);
+			}
+		}
+	}
+
 	void CSceneImporter::buildScene(CScene* scene, io::IXMLReader* reader)
 	{
 		std::wstring nodeName = L"node";
@@ -182,6 +199,32 @@ namespace Skylicht
 
 	bool CSceneImporter::beginImportScene(CScene* scene, const char* file)
 	{
+		endImportBinary();
+
+		// check the binary header
+		SAssetHeader assetHeader;
+		memset(&assetHeader, 0, sizeof(SAssetHeader));
+
+		io::IReadFile* readFile = getIrrlichtDevice()->getFileSystem()->createAndOpenFile(file);
+		if (readFile == NULL)
+			return false;
+
+		readFile->read(&assetHeader, sizeof(SAssetHeader));
+		readFile->drop();
+
+		if (memcmp(assetHeader.Sign, "SLT", 4) == 0 && assetHeader.AssetType == (u32)AssetScene)
+		{
+			g_sceneFile = new CMappedFile();
+
+			if (assetHeader.AssetVersion == SCENE_BINARY_VERSION &&
+				g_sceneFile->open(file) &&
+				beginImportBinary(scene))
+				return true;
+
+			endImportBinary();
+			return false;
+		}
+
 		// step 1
 		// build scene object
 		g_sceneReader = getIrrlichtDevice()->getFileSystem()->createXMLReader(file);
@@ -262,8 +305,222 @@ namespace Skylicht
 		return g_loadingScene / (float)size;
 	}
 
+	bool CSceneImporter::beginImportBinary(CScene* scene)
+	{
+		const unsigned char* data = g_sceneFile->getData();
+		u32 size = g_sceneFile->getSize();
+
+		if (size < sizeof(SAssetHeader) + sizeof(SSceneBinaryHeader))
+			return false;
+
+		SSceneBinaryHeader header;
+		memcpy(&header, data + sizeof(SAssetHeader), sizeof(SSceneBinaryHeader));
+
+		// the object and component tables are read in place, so their offsets must be aligned
+		if (header.StringOffset > size ||
+			header.SceneOffset > size || size - header.SceneOffset < header.SceneSize ||
+			header.ObjectOffset > size || (size - header.ObjectOffset) / sizeof(SSceneBinaryObject) < header.NumObject ||
+			header.ComponentOffset > size || (size - header.ComponentOffset) / sizeof(u32) < header.NumComponent ||
+			header.PayloadOffset > size || size - header.PayloadOffset < header.PayloadSize ||
+			header.ObjectOffset % SCENE_BINARY_ALIGN != 0 || header.ComponentOffset % SCENE_BINARY_ALIGN != 0)
+		{
+			os::Printer::log("[CSceneImporter] Invalid binary scene");
+			return false;
+		}
+
+		g_sceneBinary = new CSerializableBinary();
+
+		CMemoryStream strings((unsigned char*)data + header.StringOffset, size - header.StringOffset);
+		if (!g_sceneBinary->readStrings(&strings, header.NumString))
+			return false;
+
+		// check the object table, the parent must be created before
+		const SSceneBinaryObject* objects = (const SSceneBinaryObject*)(data + header.ObjectOffset);
+		const u32* components = (const u32*)(data + header.ComponentOffset);
+
+		for (u32 i = 0; i < header.NumObject; i++)
+		{
+			const SSceneBinaryObject& object = objects[i];
+
+			bool validParent = false;
+			if (object.Parent < 0)
+				validParent = object.Type == SSceneBinaryObject::Zone;
+			else if ((u32)object.Parent < i)
+				validParent = object.Type != SSceneBinaryObject::Zone && objects[object.Parent].Type != SSceneBinaryObject::GameObject;
+
+			if (!validParent ||
+				object.FirstComponent > header.NumComponent || header.NumComponent - object.FirstComponent < object.NumComponent ||
+				object.Offset > header.PayloadSize || header.PayloadSize - object.Offset < object.Size)
+			{
+				os::Printer::log("[CSceneImporter] Invalid binary scene object");
+				return false;
+			}
+
+			for (u32 j = 0; j < object.NumComponent; j++)
+			{
+				if (components[object.FirstComponent + j] >= g_sceneBinary->getStringCount())
+					return false;
+			}
+		}
+
+		// scene
+		CMemoryStream sceneStream((unsigned char*)data + header.SceneOffset, header.SceneSize);
+		CObjectSerializable* sceneData = scene->createSerializable();
+		if (g_sceneBinary->read(&sceneStream, sceneData))
+			scene->loadSerializable(sceneData);
+		delete sceneData;
+
+		// step 1
+		// build scene object in one pass
+		std::vector<CGameObject*> gameObjects;
+		gameObjects.resize(header.NumObject);
+
+		g_listGameObject.clear();
+
+		for (u32 i = 0; i < header.NumObject; i++)
+		{
+			const SSceneBinaryObject& object = objects[i];
+
+			CGameObject* gameObject = NULL;
+			if (object.Type == SSceneBinaryObject::Zone)
+			{
+				gameObject = scene->createZone();
+			}
+			else
+			{
+				CContainerObject* container = dynamic_cast<CContainerObject*>(gameObjects[object.Parent]);
+				if (object.Type == SSceneBinaryObject::Container)
+					gameObject = container->createContainerObject();
+				else
+					gameObject = container->createEmptyObject();
+			}
+
+			for (u32 j = 0; j < object.NumComponent; j++)
+				addComponent(gameObject, g_sceneBinary->getString(components[object.FirstComponent + j]).c_str());
+
+			gameObjects[i] = gameObject;
+			g_listGameObject.push_back(gameObject);
+		}
+
+		g_currentGameObject = g_listGameObject.begin();
+		g_scene = scene;
+		g_loadingScene = 0;
+
+		// step 2
+		// parse the object data on the job system, that is applied on the main thread at updateLoadScene
+		g_sceneObjectData.clear();
+		g_sceneObjectData.resize(header.NumObject, NULL);
+
+		g_sceneParseBatchCount = (header.NumObject + SCENE_BINARY_PARSE_BATCH - 1) / SCENE_BINARY_PARSE_BATCH;
+		g_sceneParseGroups = new System::CJobGroup[g_sceneParseBatchCount > 0 ? g_sceneParseBatchCount : 1];
+
+		System::CJobSystem* jobSystem = System::CJobSystem::getInstance();
+
+		const unsigned char* payload = data + header.PayloadOffset;
+
+		for (u32 batch = 0; batch < g_sceneParseBatchCount; batch++)
+		{
+			u32 begin = batch * SCENE_BINARY_PARSE_BATCH;
+			u32 end = core::min_(begin + SCENE_BINARY_PARSE_BATCH, header.NumObject);
+
+			jobSystem->run([objects, payload, begin, end]()
+				{
+					for (u32 i = begin; i < end; i++)
+					{
+						CMemoryStream stream((unsigned char*)payload + objects[i].Offset, objects[i].Size);
+						g_sceneObjectData[i] = g_sceneBinary->readObject(&stream);
+					}
+				}, &g_sceneParseGroups[batch]);
+		}
+
+		return true;
+	}
+
+	bool CSceneImporter::loadBinaryStep()
+	{
+		int step = 0;
+
+		while (step < g_loadSceneStep && g_currentGameObject != g_listGameObject.end())
+		{
+			u32 i = (u32)g_loadingScene;
+
+			// the data is not parsed, wait the next update
+			if (!g_sceneParseGroups[i / SCENE_BINARY_PARSE_BATCH].isDone())
+				break;
+
+			CGameObject* gameobject = *g_currentGameObject;
+			++g_currentGameObject;
+			++g_loadingScene;
+			++step;
+
+			CObjectSerializable* data = g_sceneObjectData[i];
+			if (data != NULL)
+			{
+				gameobject->loadSerializable(data);
+				delete data;
+				g_sceneObjectData[i] = NULL;
+			}
+			else
+			{
+				os::Printer::log("[CSceneImporter] Skip the wrong binary object data");
+			}
+
+			gameobject->startComponent();
+		}
+
+		return g_currentGameObject == g_listGameObject.end();
+	}
+
+	void CSceneImporter::endImportBinary()
+	{
+		if (g_sceneParseGroups != NULL)
+		{
+			System::CJobSystem* jobSystem = System::CJobSystem::getInstance();
+			for (u32 i = 0; i < g_sceneParseBatchCount; i++)
+				jobSystem->wait(&g_sceneParseGroups[i]);
+
+			delete[] g_sceneParseGroups;
+			g_sceneParseGroups = NULL;
+			g_sceneParseBatchCount = 0;
+		}
+
+		for (CObjectSerializable* data : g_sceneObjectData)
+		{
+			if (data != NULL)
+				delete data;
+		}
+		g_sceneObjectData.clear();
+
+		if (g_sceneBinary != NULL)
+		{
+			delete g_sceneBinary;
+			g_sceneBinary = NULL;
+		}
+
+		if (g_sceneFile != NULL)
+		{
+			delete g_sceneFile;
+			g_sceneFile = NULL;
+		}
+	}
+
 	bool CSceneImporter::updateLoadScene()
 	{
+		if (g_sceneFile != NULL)
+		{
+			if (loadBinaryStep())
+			{
+				endImportBinary();
+
+				// final index search object
+				g_scene->updateIndexSearchObject();
+				g_scene = NULL;
+				return true;
+			}
+
+			return false;
+		}
+
 		// step 2
 		// load object attribute
 		if (CSceneImporter::loadStep(g_scene, g_sceneReader))
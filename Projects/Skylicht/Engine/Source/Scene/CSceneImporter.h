@@ -39,9 +39,19 @@ namespace Skylicht
 
 		static bool loadStep(CScene* scene, io::IXMLReader* reader);
 
+		static void addComponent(CGameObject* object, const char* componentName);
+
+		static bool beginImportBinary(CScene* scene);
+
+		static bool loadBinaryStep();
+
+		static void endImportBinary();
+
 	public:
 		static void exportGameObject(CObjectSerializable* data, CContainerObject* target);
 
+		/// @brief Begin import the scene xml or the binary of CSceneExporter::exportSceneBinary.
+		/// The binary objects are created in one pass, their component data is parsed on the job system and applied in updateLoadScene
 		static bool beginImportScene(CScene* scene, const char* path);
 
 		static bool updateLoadScene();
@@ -0,0 +1,367 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CSerializableBinary.h"
+#include "CSerializableLoader.h"
+
+#define SERIALIZABLE_BINARY_MAX_DEPTH 128
+
+namespace Skylicht
+{
+	inline bool hasStreamData(CMemoryStream* stream, u32 size)
+	{
+		return stream->getPos() <= stream->getSize() && stream->getSize() - stream->getPos() >= size;
+	}
+
+	CSerializableBinary::CSerializableBinary()
+	{
+
+	}
+
+	CSerializableBinary::~CSerializableBinary()
+	{
+
+	}
+
+	u32 CSerializableBinary::getStringID(const std::string& s)
+	{
+		std::map<std::string, u32>::iterator i = m_stringID.find(s);
+		if (i != m_stringID.end())
+			return (*i).second;
+
+		u32 id = (u32)m_strings.size();
+		m_stringID[s] = id;
+		m_strings.push_back(s);
+		return id;
+	}
+
+	void CSerializableBinary::writeStrings(CMemoryStream* stream)
+	{
+		for (const std::string& s : m_strings)
+			stream->writeString(s);
+	}
+
+	bool CSerializableBinary::readStrings(CMemoryStream* stream, u32 count)
+	{
+		m_stringID.clear();
+		m_strings.clear();
+		m_strings.reserve(count);
+
+		for (u32 i = 0; i < count; i++)
+		{
+			if (!hasStreamData(stream, sizeof(int)))
+				return false;
+
+			int size = stream->readInt();
+			if (size <= 0 || !hasStreamData(stream, (u32)size))
+				return false;
+
+			// the string is saved with the null character
+			const char* s = (const char*)stream->getData() + stream->getPos();
+			if (s[size - 1] != 0)
+				return false;
+
+			m_strings.push_back(std::string(s, size - 1));
+			stream->setPos(stream->getPos() + size);
+		}
+
+		return true;
+	}
+
+	void CSerializableBinary::write(CMemoryStream* stream, CObjectSerializable* object)
+	{
+		stream->writeUInt(getStringID(object->Name));
+		stream->writeChar(object->isArray() ? 1 : 0);
+
+		io::IAttributes* attr = getIrrlichtDevice()->getFileSystem()->createEmptyAttributes();
+		object->serialize(attr);
+		writeAttributes(stream, attr);
+		attr->drop();
+
+		// save child object
+		u32 numChild = 0;
+		for (u32 i = 0, n = object->getNumProperty(); i < n; i++)
+		{
+			if (object->getPropertyID(i)->getType() == EPropertyDataType::Object)
+				numChild++;
+		}
+
+		stream->writeUInt(numChild);
+
+		for (u32 i = 0, n = object->getNumProperty(); i < n; i++)
+		{
+			CValueProperty* p = object->getPropertyID(i);
+			if (p->getType() == EPropertyDataType::Object)
+				write(stream, (CObjectSerializable*)p);
+		}
+	}
+
+	void CSerializableBinary::writeAttributes(CMemoryStream* stream, io::IAttributes* attr)
+	{
+		u32 count = attr->getAttributeCount();
+		stream->writeUInt(count);
+
+		for (u32 i = 0; i < count; i++)
+		{
+			io::E_ATTRIBUTE_TYPE type = attr->getAttributeType(i);
+
+			stream->writeUInt(getStringID(attr->getAttributeName(i)));
+
+			switch (type)
+			{
+			case io::EAT_INT:
+				stream->writeChar((char)type);
+				stream->writeInt(attr->getAttributeAsInt(i));
+				break;
+			case io::EAT_UINT:
+				stream->writeChar((char)type);
+				stream->writeUInt(attr->getAttributeAsUInt(i));
+				break;
+			case io::EAT_FLOAT:
+				stream->writeChar((char)type);
+				stream->writeFloat(attr->getAttributeAsFloat(i));
+				break;
+			case io::EAT_BOOL:
+				stream->writeChar((char)type);
+				stream->writeChar(attr->getAttributeAsBool(i) ? 1 : 0);
+				break;
+			case io::EAT_VECTOR3D:
+			{
+				core::vector3df v = attr->getAttributeAsVector3d(i);
+				stream->writeChar((char)type);
+				stream->writeFloatArray(&v.X, 3);
+			}
+			break;
+			case io::EAT_QUATERNION:
+			{
+				core::quaternion q = attr->getAttributeAsQuaternion(i);
+				stream->writeChar((char)type);
+				stream->writeFloatArray(&q.X, 4);
+			}
+			break;
+			case io::EAT_COLOR:
+				stream->writeChar((char)type);
+				stream->writeUInt(attr->getAttributeAsColor(i).color);
+				break;
+			case io::EAT_MATRIX:
+			{
+				core::matrix4 m = attr->getAttributeAsMatrix(i);
+				stream->writeChar((char)type);
+				stream->writeFloatArray(m.pointer(), 16);
+			}
+			break;
+			default:
+				// the other types are saved as string
+				stream->writeChar((char)io::EAT_STRING);
+				stream->writeUInt(getStringID(attr->getAttributeAsString(i).c_str()));
+				break;
+			}
+		}
+	}
+
+	bool CSerializableBinary::read(CMemoryStream* stream, CObjectSerializable* object)
+	{
+		u32 nameID = 0;
+		if (!readStringID(stream, nameID) || !hasStreamData(stream, 1))
+			return false;
+
+		// skip the array flag
+		stream->readChar();
+
+		if (m_strings[nameID] != object->Name)
+		{
+			char log[512];
+			sprintf(log, "[CSerializableBinary::read] Skip wrong data: type: %s", object->Name.c_str());
+			os::Printer::log(log);
+			return false;
+		}
+
+		io::IAttributes* attr = getIrrlichtDevice()->getFileSystem()->createEmptyAttributes();
+		bool ret = readNode(stream, object, attr, 0);
+		attr->drop();
+
+		return ret;
+	}
+
+	CObjectSerializable* CSerializableBinary::readObject(CMemoryStream* stream)
+	{
+		u32 nameID = 0;
+		if (!readStringID(stream, nameID) || !hasStreamData(stream, 1))
+			return NULL;
+
+		CObjectSerializable* object = NULL;
+		if (stream->readChar() == 1)
+			object = new CArraySerializable(m_strings[nameID].c_str());
+		else
+			object = new CObjectSerializable(m_strings[nameID].c_str());
+
+		io::IAttributes* attr = getIrrlichtDevice()->getFileSystem()->createEmptyAttributes();
+		bool ret = readNode(stream, object, attr, 0);
+		attr->drop();
+
+		if (!ret)
+		{
+			delete object;
+			return NULL;
+		}
+
+		return object;
+	}
+
+	bool CSerializableBinary::readNode(CMemoryStream* stream, CObjectSerializable* object, io::IAttributes* attr, int depth)
+	{
+		if (depth > SERIALIZABLE_BINARY_MAX_DEPTH)
+			return false;
+
+		attr->clear();
+		if (!readAttributes(stream, attr))
+			return false;
+
+		CSerializableLoader::loadAttributes(object, attr);
+
+		if (!hasStreamData(stream, sizeof(u32)))
+			return false;
+
+		u32 numChild = stream->readUInt();
+		for (u32 i = 0; i < numChild; i++)
+		{
+			u32 nameID = 0;
+			if (!readStringID(stream, nameID) || !hasStreamData(stream, 1))
+				return false;
+
+			bool isArray = stream->readChar() == 1;
+
+			bool newObject = true;
+			CObjectSerializable* data = CSerializableLoader::createChild(object, m_strings[nameID].c_str(), isArray, newObject);
+
+			bool ret = readNode(stream, data, attr, depth + 1);
+
+			if (newObject)
+			{
+				object->addProperty(data);
+				object->autoRelease(data);
+			}
+
+			if (!ret)
+				return false;
+		}
+
+		return true;
+	}
+
+	bool CSerializableBinary::readAttributes(CMemoryStream* stream, io::IAttributes* attr)
+	{
+		if (!hasStreamData(stream, sizeof(u32)))
+			return false;
+
+		u32 count = stream->readUInt();
+		for (u32 i = 0; i < count; i++)
+		{
+			u32 nameID = 0;
+			if (!readStringID(stream, nameID) || !hasStreamData(stream, 1))
+				return false;
+
+			const char* name = m_strings[nameID].c_str();
+			io::E_ATTRIBUTE_TYPE type = (io::E_ATTRIBUTE_TYPE)stream->readChar();
+
+			switch (type)
+			{
+			case io::EAT_INT:
+				if (!hasStreamData(stream, sizeof(int)))
+					return false;
+				attr->addInt(name, stream->readInt());
+				break;
+			case io::EAT_UINT:
+				if (!hasStreamData(stream, sizeof(u32)))
+					return false;
+				attr->addUInt(name, stream->readUInt());
+				break;
+			case io::EAT_FLOAT:
+				if (!hasStreamData(stream, sizeof(float)))
+					return false;
+				attr->addFloat(name, stream->readFloat());
+				break;
+			case io::EAT_BOOL:
+				if (!hasStreamData(stream, 1))
+					return false;
+				attr->addBool(name, stream->readChar() == 1);
+				break;
+			case io::EAT_VECTOR3D:
+			{
+				if (!hasStreamData(stream, 3 * sizeof(float)))
+					return false;
+				core::vector3df v;
+				stream->readFloatArray(&v.X, 3);
+				attr->addVector3d(name, v);
+			}
+			break;
+			case io::EAT_QUATERNION:
+			{
+				if (!hasStreamData(stream, 4 * sizeof(float)))
+					return false;
+				core::quaternion q;
+				stream->readFloatArray(&q.X, 4);
+				attr->addQuaternion(name, q);
+			}
+			break;
+			case io::EAT_COLOR:
+				if (!hasStreamData(stream, sizeof(u32)))
+					return false;
+				attr->addColor(name, video::SColor(stream->readUInt()));
+				break;
+			case io::EAT_MATRIX:
+			{
+				if (!hasStreamData(stream, 16 * sizeof(float)))
+					return false;
+				core::matrix4 m;
+				stream->readFloatArray(m.pointer(), 16);
+				attr->addMatrix(name, m);
+			}
+			break;
+			case io::EAT_STRING:
+			{
+				u32 valueID = 0;
+				if (!readStringID(stream, valueID))
+					return false;
+				attr->addString(name, m_strings[valueID].c_str());
+			}
+			break;
+			default:
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool CSerializableBinary::readStringID(CMemoryStream* stream, u32& id)
+	{
+		if (!hasStreamData(stream, sizeof(u32)))
+			return false;
+
+		id = stream->readUInt();
+		return id < (u32)m_strings.size();
+	}
+}
\ No newline at end of file
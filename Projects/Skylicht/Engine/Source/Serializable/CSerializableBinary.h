@@ -0,0 +1,81 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CObjectSerializable.h"
+#include "Utils/CMemoryStream.h"
+
+namespace Skylicht
+{
+	/// @brief The compact binary of the CObjectSerializable tree, that is the same data of the xml node.
+	/// The node type and the attribute names & string values are saved in a string table.
+	/// The node is: type, array, attributes (name, type, value), childs
+	class SKYLICHT_API CSerializableBinary
+	{
+	protected:
+		std::map<std::string, u32> m_stringID;
+
+		std::vector<std::string> m_strings;
+
+	public:
+		CSerializableBinary();
+
+		virtual ~CSerializableBinary();
+
+		u32 getStringID(const std::string& s);
+
+		inline u32 getStringCount()
+		{
+			return (u32)m_strings.size();
+		}
+
+		inline const std::string& getString(u32 id)
+		{
+			return m_strings[id];
+		}
+
+		void writeStrings(CMemoryStream* stream);
+
+		bool readStrings(CMemoryStream* stream, u32 count);
+
+		void write(CMemoryStream* stream, CObjectSerializable* object);
+
+		/// @brief Read the node to the object, it is thread safe (the string table is read only)
+		bool read(CMemoryStream* stream, CObjectSerializable* object);
+
+		/// @brief Create the object with the type of node and read it, return NULL if the data is wrong
+		CObjectSerializable* readObject(CMemoryStream* stream);
+
+	protected:
+
+		void writeAttributes(CMemoryStream* stream, io::IAttributes* attributes);
+
+		bool readAttributes(CMemoryStream* stream, io::IAttributes* attributes);
+
+		bool readNode(CMemoryStream* stream, CObjectSerializable* object, io::IAttributes* attributes, int depth);
+
+		bool readStringID(CMemoryStream* stream, u32& id);
+	};
+}
\ No newline at end of file
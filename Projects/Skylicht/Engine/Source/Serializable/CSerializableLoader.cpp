@@ -41,32 +41,7 @@ namespace Skylicht
 		if (nodeName == reader->getNodeName() && attributeName == reader->getAttributeValue(L"type"))
 		{
 			attr->read(reader);
-
-			if (object->getNumProperty() > 0)
-				object->deserialize(attr);	// for SerializableActivator
-			else
-			{
-				if (object->isArray())
-				{
-					CArraySerializable* arrayObject = dynamic_cast<CArraySerializable*>(object);
-					if (arrayObject->haveCreateElementFunction())
-					{
-						// create element and deserialize
-						int numElement = attr->getAttributeCount();
-						arrayObject->resize(numElement);
-						arrayObject->deserialize(attr);
-					}
-					else
-					{
-						// this is array but no create element function
-						initProperty(object, attr);
-					}
-				}
-				else
-				{
-					initProperty(object, attr);
-				}
-			}
+			loadAttributes(object, attr);
 		}
 		else
 		{
@@ -94,30 +69,7 @@ namespace Skylicht
 					const wchar_t* isArray = reader->getAttributeValue(L"array");
 
 					bool newObject = true;
-					CObjectSerializable* data;
-
-					// activator
-					data = CSerializableActivator::getInstance()->createInstance(name.c_str());
-					if (data == NULL)
-					{
-						// try find the current object with the name
-						data = dynamic_cast<CObjectSerializable*>(object->getProperty(name.c_str()));
-						if (data != NULL)
-						{
-							// use exist property
-							newObject = false;
-						}
-						else
-						{
-							// we will add new object serializable
-							if (isArray)
-								data = new CArraySerializable(name.c_str());
-							else
-								data = new CObjectSerializable(name.c_str());
-
-							newObject = true;
-						}
-					}
+					CObjectSerializable* data = createChild(object, name.c_str(), isArray != NULL, newObject);
 
 					load(reader, data, exitNode);
 
@@ -181,6 +133,63 @@ namespace Skylicht
 		return true;
 	}
 
+	void CSerializableLoader::loadAttributes(CObjectSerializable* object, io::IAttributes* attr)
+	{
+		if (object->getNumProperty() > 0)
+			object->deserialize(attr);	// for SerializableActivator
+		else
+		{
+			if (object->isArray())
+			{
+				CArraySerializable* arrayObject = dynamic_cast<CArraySerializable*>(object);
+				if (arrayObject->haveCreateElementFunction())
+				{
+					// create element and deserialize
+					int numElement = attr->getAttributeCount();
+					arrayObject->resize(numElement);
+					arrayObject->deserialize(attr);
+				}
+				else
+				{
+					// this is array but no create element function
+					initProperty(object, attr);
+				}
+			}
+			else
+			{
+				initProperty(object, attr);
+			}
+		}
+	}
+
+	CObjectSerializable* CSerializableLoader::createChild(CObjectSerializable* object, const char* name, bool isArray, bool& newObject)
+	{
+		newObject = true;
+
+		// activator
+		CObjectSerializable* data = CSerializableActivator::getInstance()->createInstance(name);
+		if (data == NULL)
+		{
+			// try find the current object with the name
+			data = dynamic_cast<CObjectSerializable*>(object->getProperty(name));
+			if (data != NULL)
+			{
+				// use exist property
+				newObject = false;
+			}
+			else
+			{
+				// we will add new object serializable
+				if (isArray)
+					data = new CArraySerializable(name);
+				else
+					data = new CObjectSerializable(name);
+			}
+		}
+
+		return data;
+	}
+
 	void CSerializableLoader::initProperty(CObjectSerializable* object, io::IAttributes* attributes)
 	{
 		for (u32 i = 0, n = attributes->getAttributeCount(); i < n; i++)
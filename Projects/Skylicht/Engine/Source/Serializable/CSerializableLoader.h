@@ -37,6 +37,12 @@ namespace Skylicht
 		
 		static bool loadSerializable(const char* file, CObjectSerializable* object);
 
+		/// @brief Apply the attributes of a node to the object, it is shared by the xml and the binary loader
+		static void loadAttributes(CObjectSerializable* object, io::IAttributes* attributes);
+
+		/// @brief Get the child object of a node, newObject is true if the caller must add it to the object
+		static CObjectSerializable* createChild(CObjectSerializable* object, const char* name, bool isArray, bool& newObject);
+
 	protected:
 
 		static void initProperty(CObjectSerializable* object, io::IAttributes* attributes);
@@ -256,6 +256,8 @@ namespace Skylicht
 			shadowProj(3, 2) += roundOffset.Z;
 
 			core::matrix4 mvp = m_projMatrices[i] * m_viewMatrices[i];
+			m_frustums[i].setFrom(mvp);
+
 			core::matrix4 shadowMatrix = m_bias * mvp;
 			memcpy(m_shadowMatrices + i * 16, shadowMatrix.pointer(), 16 * sizeof(float));
 		}
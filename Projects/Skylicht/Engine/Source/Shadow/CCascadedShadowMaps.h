@@ -50,6 +50,7 @@ namespace Skylicht
 		core::matrix4 m_textureMatrices[MAX_FRUSTUM_SPLITS];
 
 		core::aabbox3df m_frustumBox[MAX_FRUSTUM_SPLITS];
+		scene::SViewFrustum m_frustums[MAX_FRUSTUM_SPLITS];
 
 		float m_shadowMatrices[16 * MAX_FRUSTUM_SPLITS];
 
@@ -69,6 +70,11 @@ namespace Skylicht
 			return m_frustumBox[cascaded];
 		}
 
+		const scene::SViewFrustum& getFrustum(int cascaded)
+		{
+			return m_frustums[cascaded];
+		}
+
 		int getSplitCount()
 		{
 			return m_splitCount;
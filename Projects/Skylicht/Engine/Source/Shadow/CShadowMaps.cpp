@@ -188,6 +188,8 @@ namespace Skylicht
 		m_viewMatrices = view;
 
 		core::matrix4 mvp = m_projMatrices * m_viewMatrices;
+		m_viewFrustum.setFrom(mvp);
+
 		core::matrix4 shadowMatrix = m_bias * mvp;
 
 		// we clone to 4 matrices to fit with cascaded shadow shader
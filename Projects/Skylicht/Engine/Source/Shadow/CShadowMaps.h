@@ -44,6 +44,7 @@ namespace Skylicht
 
 		SFrustumSplit m_frustum;
 		core::aabbox3df m_frustumBox;
+		scene::SViewFrustum m_viewFrustum;
 
 		float m_farBounds[4];
 		float m_shadowMatrices[16 * 4];
@@ -64,6 +65,11 @@ namespace Skylicht
 			return m_frustumBox;
 		}
 
+		const scene::SViewFrustum& getFrustum()
+		{
+			return m_viewFrustum;
+		}
+
 		const core::matrix4& getViewMatrices()
 		{
 			return m_viewMatrices;
@@ -58,6 +58,9 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "Graphics2D/Glyph/CGlyphFreetype.h"
 
+// Job system
+#include "Thread/CJobSystem.h"
+
 
 namespace Skylicht
 {
@@ -137,6 +140,8 @@ namespace Skylicht
 		CJoystick::releaseInstance();
 
 		CEventManager::releaseInstance();
+
+		System::CJobSystem::releaseInstance();
 	}
 
 	void updateSkylicht()
@@ -145,6 +150,7 @@ namespace Skylicht
 		CAccelerometer::getInstance()->update();
 		CJoystick::getInstance()->update();
 		CTweenManager::getInstance()->update();
+		CTextureManager::getInstance()->updateStreaming();
 	}
 
 	IrrlichtDevice* getIrrlichtDevice()
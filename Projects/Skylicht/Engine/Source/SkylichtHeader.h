@@ -74,6 +74,7 @@ using namespace irr::video;
 #include <vector>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <stack>
 #include <queue>
 #include <fstream>
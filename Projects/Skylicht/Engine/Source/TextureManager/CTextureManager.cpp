@@ -15,10 +15,19 @@ namespace Skylicht
 
 	CTextureManager::CTextureManager() :
 		m_nullNormalMap(NULL),
-		m_nullTexture(NULL)
+		m_nullTexture(NULL),
+		m_streamCallbackId(0),
+		m_streamQueueSorted(true),
+		m_streamLoading(0),
+		m_maxStreamJobs(4),
+		m_maxStreamUpload(2),
+		m_streamBudget(256 * 1024 * 1024),
+		m_streamMemory(0),
+		m_streamMipDistance(50.0f)
 	{
 		m_currentPackage = GlobalPackage;
 		m_loadCommonPos = 0;
+		m_streamMutex = System::IMutex::createMutex();
 	}
 
 	CTextureManager::~CTextureManager()
@@ -37,32 +46,51 @@ namespace Skylicht
 			driver->removeTexture(m_nullTexture);
 			m_nullTexture = NULL;
 		}
+
+		delete m_streamMutex;
 	}
 
 	void CTextureManager::registerTexture(ITexture* tex)
+	{
+		registerTexture(tex, m_currentPackage);
+	}
+
+	CTextureManager::STexturePackage* CTextureManager::registerTexture(ITexture* tex, const std::string& package)
 	{
 		if (tex == NULL)
-			return;
+			return NULL;
 
-		std::vector<STexturePackage*>::iterator i = m_textureList.begin(), end = m_textureList.end();
-		while (i != end)
-		{
-			if ((*i)->texture == tex)
-				return;
+		std::unordered_map<ITexture*, STexturePackage*>::iterator i = m_textureMap.find(tex);
+		if (i != m_textureMap.end())
+			return i->second;
 
-			i++;
+		STexturePackage* texturePackage = new STexturePackage();
+		texturePackage->package = package;
+		texturePackage->texture = tex;
+
+		m_textureList.push_back(texturePackage);
+		m_textureMap[tex] = texturePackage;
+		return texturePackage;
+	}
+
+	void CTextureManager::releasePackage(STexturePackage* package)
+	{
+		for (const std::string& path : package->paths)
+		{
+			std::unordered_map<std::string, ITexture*>::iterator i = m_textureByPath.find(path);
+			if (i != m_textureByPath.end() && i->second == package->texture)
+				m_textureByPath.erase(i);
 		}
 
-		m_textureList.push_back(new STexturePackage());
+		m_textureMap.erase(package->texture);
 
-		STexturePackage* package = m_textureList.back();
-		package->package = m_currentPackage;
-		package->texture = tex;
+		getVideoDriver()->removeTexture(package->texture);
+		delete package;
 	}
 
 	void CTextureManager::removeAllTexture()
 	{
-		IVideoDriver* driver = getVideoDriver();
+		removeAllStream();
 
 		std::vector<STexturePackage*>::iterator i = m_textureList.begin(), end = m_textureList.end();
 		while (i != end)
@@ -71,61 +99,67 @@ namespace Skylicht
 			sprintf(log, "Remove Texture: %s", (*i)->texture->getName().getPath().c_str());
 			os::Printer::log(log);
 
-			driver->removeTexture((*i)->texture);
-			delete (*i);
+			releasePackage(*i);
 			i++;
 		}
 		m_textureList.clear();
+		m_textureMap.clear();
+		m_textureByPath.clear();
 	}
 
 	void CTextureManager::removeTexture(ITexture* tex)
 	{
-		IVideoDriver* driver = getVideoDriver();
-
-		std::vector<STexturePackage*>::iterator i = m_textureList.begin(), end = m_textureList.end();
-		while (i != end)
+		for (std::pair<const std::string, STextureStream*>& s : m_streams)
 		{
-			if ((*i)->texture == tex)
+			if (s.second->Texture == tex)
 			{
-				driver->removeTexture((*i)->texture);
-				delete (*i);
-
-				m_textureList.erase(i);
+				removeStream(s.second);
 				break;
 			}
-			i++;
 		}
+
+		std::unordered_map<ITexture*, STexturePackage*>::iterator i = m_textureMap.find(tex);
+		if (i == m_textureMap.end())
+			return;
+
+		STexturePackage* package = i->second;
+
+		std::vector<STexturePackage*>::iterator p = std::find(m_textureList.begin(), m_textureList.end(), package);
+		if (p != m_textureList.end())
+			m_textureList.erase(p);
+
+		releasePackage(package);
 	}
 
 	void CTextureManager::removeTexture(const char* namePackage)
 	{
-		IVideoDriver* driver = getVideoDriver();
-		bool needContinue = false;
-		do
+		std::vector<STextureStream*> removeStreams;
+		for (std::pair<const std::string, STextureStream*>& s : m_streams)
 		{
-			needContinue = false;
+			if (s.second->Package == namePackage)
+				removeStreams.push_back(s.second);
+		}
 
-			std::vector<STexturePackage*>::iterator i = m_textureList.begin(), end = m_textureList.end();
-			while (i != end)
-			{
-				if ((*i)->package == namePackage)
-				{
-					char log[512];
-					sprintf(log, "Remove Texture: %s", (*i)->texture->getName().getPath().c_str());
-					os::Printer::log(log);
+		for (STextureStream* stream : removeStreams)
+			removeStream(stream);
 
-					driver->removeTexture((*i)->texture);
-					delete (*i);
+		std::vector<STexturePackage*>::iterator i = m_textureList.begin();
+		while (i != m_textureList.end())
+		{
+			if ((*i)->package == namePackage)
+			{
+				char log[512];
+				sprintf(log, "Remove Texture: %s", (*i)->texture->getName().getPath().c_str());
+				os::Printer::log(log);
 
-					m_textureList.erase(i);
-					needContinue = true;
-					break;
-				}
+				releasePackage(*i);
+				i = m_textureList.erase(i);
+			}
+			else
+			{
 				i++;
 			}
-
-		} while (needContinue);
-
+		}
 	}
 
 	ITexture* CTextureManager::getTextureFromRealPath(const char* path)
@@ -147,15 +181,12 @@ namespace Skylicht
 		return texture;
 	}
 
-	bool CTextureManager::existTexture(const char* path)
+	bool CTextureManager::findTexturePath(const char* path, char* ansiPath)
 	{
-		char ansiPath[512];
-
 		IVideoDriver* driver = getVideoDriver();
 		io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
 
-		std::string fixPath = CPath::normalizePath(path);
-		strcpy(ansiPath, fixPath.c_str());
+		strcpy(ansiPath, path);
 
 		// try to load compress texture
 		if (driver->getDriverType() == video::EDT_OPENGLES)
@@ -218,6 +249,27 @@ namespace Skylicht
 		return true;
 	}
 
+	void CTextureManager::loadNullTexture()
+	{
+		IVideoDriver* driver = getVideoDriver();
+
+		if (m_nullNormalMap == NULL)
+			m_nullNormalMap = driver->getTexture("BuiltIn/Textures/NullNormalMap.png");
+
+		if (m_nullTexture == NULL)
+			m_nullTexture = driver->getTexture("BuiltIn/Textures/NullTexture.png");
+	}
+
+	bool CTextureManager::existTexture(const char* path)
+	{
+		std::string fixPath = CPath::normalizePath(path);
+		if (m_textureByPath.find(fixPath) != m_textureByPath.end())
+			return true;
+
+		char ansiPath[512];
+		return findTexturePath(fixPath.c_str(), ansiPath);
+	}
+
 	ITexture* CTextureManager::getTexture(const char* filename, const std::vector<std::string>& textureFolder)
 	{
 		ITexture* t = getTexture(filename);
@@ -265,96 +317,558 @@ namespace Skylicht
 
 	ITexture* CTextureManager::getTexture(const char* path)
 	{
+		std::string fixPath = CPath::normalizePath(path);
+
+		// the texture is loaded
+		std::unordered_map<std::string, ITexture*>::iterator i = m_textureByPath.find(fixPath);
+		if (i != m_textureByPath.end())
+		{
+			// the caller keeps the streaming texture, so it is not released on the mip level change
+			std::unordered_map<std::string, STextureStream*>::iterator s = m_streams.find(fixPath);
+			if (s != m_streams.end() && s->second->Texture == i->second)
+				s->second->TextureShared = true;
+
+			return i->second;
+		}
+
 		char ansiPath[512];
+		if (!findTexturePath(fixPath.c_str(), ansiPath))
+		{
+			char errorLog[512];
+			sprintf(errorLog, "Can not load texture (file not found): %s", path);
+			os::Printer::log(errorLog);
+			return NULL;
+		}
 
+		IVideoDriver* driver = getVideoDriver();
+
+		ITexture* texture = NULL;
+		texture = driver->getTexture(ansiPath);
+
+		// register the texture
+		if (texture)
+		{
+			STexturePackage* package = registerTexture(texture, m_currentPackage);
+			package->paths.push_back(fixPath);
+			m_textureByPath[fixPath] = texture;
+		}
+		else
+		{
+			char errorLog[512];
+			sprintf(errorLog, "Can not load texture: %s", path);
+			os::Printer::log(errorLog);
+		}
+
+		// load null
+		loadNullTexture();
+
+		return texture;
+	}
+
+	ITexture* CTextureManager::getTextureAsync(const char* path, float distance, const std::function<void(ITexture*)>& onLoaded, u32* callbackId)
+	{
 		std::string fixPath = CPath::normalizePath(path);
-		strcpy(ansiPath, fixPath.c_str());
 
-		IVideoDriver* driver = getVideoDriver();
-		io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+		if (callbackId != NULL)
+			*callbackId = 0;
 
-		// try to load compress texture
-		if (driver->getDriverType() == video::EDT_OPENGLES)
+		// the texture is streaming
+		std::unordered_map<std::string, STextureStream*>::iterator s = m_streams.find(fixPath);
+		if (s != m_streams.end())
 		{
-#if defined(ANDROID)
-			// etc compress
-			CStringImp::replacePathExt(ansiPath, ".etc2");
-#elif defined(IOS)
-#if defined(USE_ETC_TEXTURE)
-			CStringImp::replacePathExt(ansiPath, ".etc2");
-#else
-			CStringImp::replacePathExt(ansiPath, ".pvr");
-#endif
-#elif defined(MACOS)
-			// dxt compress
-			CStringImp::replacePathExt(ansiPath, ".dds");
-#elif defined(__EMSCRIPTEN__)
-			if (driver->queryFeature(EVDF_TEXTURE_COMPRESSED_DXT) == true)
-				CStringImp::replacePathExt(ansiPath, ".dds");
-			else
-				CStringImp::replacePathExt(ansiPath, ".etc2");
-#else
-			CStringImp::replacePathExt(ansiPath, ".tga");
-#endif
+			STextureStream* stream = s->second;
+
+			if (distance < stream->Distance)
+				setStreamingDistance(fixPath.c_str(), distance);
+
+			ITexture* texture = stream->Texture;
+			if (texture != NULL)
+			{
+				// the caller that is not notified keeps this texture
+				if (callbackId == NULL)
+					stream->TextureShared = true;
+				else if (onLoaded)
+					addStreamCallback(stream, onLoaded, callbackId);
+
+				if (onLoaded)
+					onLoaded(texture);
+				return texture;
+			}
+
+			if (onLoaded)
+				addStreamCallback(stream, onLoaded, callbackId);
+
+			return m_nullTexture;
 		}
-		else if (driver->getDriverType() == video::EDT_DIRECT3D11 || driver->getDriverType() == video::EDT_OPENGL)
+
+		// the texture is loaded by getTexture
+		std::unordered_map<std::string, ITexture*>::iterator i = m_textureByPath.find(fixPath);
+		if (i != m_textureByPath.end())
 		{
-			CStringImp::replacePathExt(ansiPath, ".dds");
+			if (onLoaded)
+				onLoaded(i->second);
+			return i->second;
 		}
 
-		if (fs->existFile(ansiPath) == false)
+		char ansiPath[512];
+		if (!findTexturePath(fixPath.c_str(), ansiPath))
 		{
-			CStringImp::replacePathExt(ansiPath, ".tga");
+			char errorLog[512];
+			sprintf(errorLog, "Can not load texture (file not found): %s", path);
+			os::Printer::log(errorLog);
+			return NULL;
+		}
 
-			if (fs->existFile(ansiPath) == false)
+		loadNullTexture();
+
+		STextureStream* stream = new STextureStream();
+		stream->Path = fixPath;
+		stream->RealPath = ansiPath;
+		stream->Package = m_currentPackage;
+		stream->Distance = distance;
+		stream->MipBias = getStreamMipBias(distance);
+		stream->Image = NULL;
+		stream->ImageMipBias = 0;
+		stream->Texture = NULL;
+		stream->TextureMipBias = 0;
+		stream->TextureMemory = 0;
+		stream->Compressed = false;
+		stream->TextureShared = false;
+
+		if (onLoaded)
+			addStreamCallback(stream, onLoaded, callbackId);
+
+		m_streams[fixPath] = stream;
+		queueStream(stream);
+
+		return m_nullTexture;
+	}
+
+	void CTextureManager::addStreamCallback(STextureStream* stream, const std::function<void(ITexture*)>& onLoaded, u32* callbackId)
+	{
+		STextureCallback callback;
+		callback.Id = 0;
+		callback.Callback = onLoaded;
+
+		if (callbackId != NULL)
+		{
+			callback.Id = ++m_streamCallbackId;
+			m_streamCallbacks[callback.Id] = stream;
+			*callbackId = callback.Id;
+		}
+
+		stream->Callbacks.push_back(callback);
+	}
+
+	void CTextureManager::removeTextureCallback(u32 callbackId)
+	{
+		std::unordered_map<u32, STextureStream*>::iterator i = m_streamCallbacks.find(callbackId);
+		if (i == m_streamCallbacks.end())
+			return;
+
+		std::vector<STextureCallback>& callbacks = i->second->Callbacks;
+		for (size_t j = 0, n = callbacks.size(); j < n; j++)
+		{
+			if (callbacks[j].Id == callbackId)
 			{
-				CStringImp::replacePathExt(ansiPath, ".bmp");
+				callbacks.erase(callbacks.begin() + j);
+				break;
+			}
+		}
 
-				if (fs->existFile(ansiPath) == false)
+		m_streamCallbacks.erase(i);
+	}
+
+	void CTextureManager::setStreamingDistance(const char* path, float distance)
+	{
+		std::unordered_map<std::string, STextureStream*>::iterator s = m_streams.find(CPath::normalizePath(path));
+		if (s == m_streams.end())
+			return;
+
+		STextureStream* stream = s->second;
+		stream->Distance = distance;
+		m_streamQueueSorted = false;
+
+		u32 mipBias = getStreamMipBias(distance);
+
+		if (stream->State != StreamResident)
+		{
+			// the new mip level is loaded on the next submit, or after the upload
+			if (stream->State != StreamFailed)
+				stream->MipBias = mipBias;
+			return;
+		}
+
+		// the far texture keeps its mip level, it is reduced by updateStreamBudget
+		if (stream->Compressed || mipBias >= stream->TextureMipBias)
+			return;
+
+		// the memory grows 4 times on each mip level
+		while (mipBias < stream->TextureMipBias)
+		{
+			u32 memory = stream->TextureMemory << (2 * (stream->TextureMipBias - mipBias));
+			if (m_streamMemory - stream->TextureMemory + memory <= m_streamBudget)
+				break;
+			mipBias++;
+		}
+
+		if (mipBias < stream->TextureMipBias)
+		{
+			stream->MipBias = mipBias;
+			queueStream(stream);
+		}
+	}
+
+	u32 CTextureManager::getStreamMipBias(float distance)
+	{
+		u32 mipBias = 0;
+		float mipDistance = m_streamMipDistance;
+
+		while (distance > mipDistance && mipBias < TEXTURE_STREAM_MAX_MIP_BIAS)
+		{
+			mipBias++;
+			mipDistance = mipDistance * 2.0f;
+		}
+
+		return mipBias;
+	}
+
+	void CTextureManager::queueStream(STextureStream* stream)
+	{
+		stream->State = StreamQueue;
+		m_streamQueue.push_back(stream);
+		m_streamQueueSorted = false;
+	}
+
+	void CTextureManager::submitStream(STextureStream* stream)
+	{
+		// read the file on main thread, the worker only decodes it
+		// the files in an archive share the archive file, so they can not be read on the worker threads
+		io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+		io::IReadFile* readFile = fs->createAndOpenFile(stream->RealPath.c_str());
+		if (readFile == NULL)
+		{
+			char errorLog[512];
+			sprintf(errorLog, "Can not load texture (file not found): %s", stream->RealPath.c_str());
+			os::Printer::log(errorLog);
+
+			stream->State = StreamFailed;
+			return;
+		}
+
+		s32 size = (s32)readFile->getSize();
+		unsigned char* data = new unsigned char[size];
+		size = readFile->read(data, size);
+
+		io::IReadFile* file = fs->createMemoryReadFile(data, size, readFile->getFileName(), true);
+		readFile->drop();
+
+		stream->State = StreamLoading;
+		m_streamLoading++;
+
+		u32 mipBias = stream->MipBias;
+
+		System::CJobSystem::getInstance()->run([this, stream, file, mipBias]()
+			{
+				IVideoDriver* driver = getVideoDriver();
+
+				IImage* image = driver->createImageFromFile(file);
+				file->drop();
+
+				u32 imageMipBias = 0;
+
+				// skip the top mip levels, the compressed image is loaded full
+				if (image != NULL && mipBias > 0 && !image->isCompressed())
 				{
-					CStringImp::replacePathExt(ansiPath, ".png");
+					const core::dimension2du& size = image->getDimension();
 
-					if (fs->existFile(ansiPath) == false)
+					imageMipBias = mipBias;
+					while (imageMipBias > 0 && ((size.Width >> imageMipBias) == 0 || (size.Height >> imageMipBias) == 0))
+						imageMipBias--;
+
+					if (imageMipBias > 0)
 					{
-						CStringImp::replacePathExt(ansiPath, ".jpeg");
+						core::dimension2du mipSize(size.Width >> imageMipBias, size.Height >> imageMipBias);
 
-						if (fs->existFile(ansiPath) == false)
-						{
-							CStringImp::replacePathExt(ansiPath, ".jpg");
-							if (fs->existFile(ansiPath) == false)
-							{
-								char errorLog[512];
-								sprintf(errorLog, "Can not load texture (file not found): %s", path);
-								os::Printer::log(errorLog);
-								return NULL;
-							}
-						}
+						IImage* mipImage = driver->createImage(image->getColorFormat(), mipSize);
+						image->copyToScalingBoxFilter(mipImage);
+						image->drop();
+
+						image = mipImage;
 					}
 				}
-			}
+
+				stream->Image = image;
+				stream->ImageMipBias = imageMipBias;
+
+				System::SScopeMutex lock(m_streamMutex);
+				m_streamDecoded.push_back(stream);
+			}, &m_streamGroup);
+	}
+
+	void CTextureManager::collectStream()
+	{
+		System::SScopeMutex lock(m_streamMutex);
+
+		for (STextureStream* stream : m_streamDecoded)
+		{
+			stream->State = StreamDecoded;
+			m_streamUpload.push_back(stream);
+			m_streamLoading--;
 		}
 
-		ITexture* texture = NULL;
-		texture = driver->getTexture(ansiPath);
+		m_streamDecoded.clear();
+	}
 
-		// register the texture
-		if (texture)
-			registerTexture(texture);
-		else
+	void CTextureManager::uploadStream(STextureStream* stream)
+	{
+		IImage* image = stream->Image;
+		stream->Image = NULL;
+
+		if (image == NULL)
 		{
 			char errorLog[512];
-			sprintf(errorLog, "Can not load texture: %s", path);
+			sprintf(errorLog, "Can not load texture: %s", stream->RealPath.c_str());
 			os::Printer::log(errorLog);
+
+			stream->State = StreamFailed;
+			return;
 		}
 
-		// load null
-		if (m_nullNormalMap == NULL)
-			m_nullNormalMap = driver->getTexture("BuiltIn/Textures/NullNormalMap.png");
+		IVideoDriver* driver = getVideoDriver();
 
-		if (m_nullTexture == NULL)
-			m_nullTexture = driver->getTexture("BuiltIn/Textures/NullTexture.png");
+		u32 mipBias = stream->ImageMipBias;
 
-		return texture;
+		io::path name = stream->RealPath.c_str();
+		if (mipBias > 0)
+		{
+			char postfix[32];
+			sprintf(postfix, "@mip%d", mipBias);
+			name += postfix;
+		}
+
+		// the full texture can be loaded by getTexture before, or it is kept by a caller
+		bool sharedTexture = true;
+		ITexture* texture = driver->findTexture(name);
+		if (texture == NULL)
+		{
+			texture = driver->addTexture(name, image);
+			sharedTexture = false;
+		}
+
+		bool compressed = image->isCompressed();
+
+		// the uncompressed texture create 1/3 more memory for the mipmaps
+		u32 memory = image->getImageDataSizeInBytes();
+		if (!compressed)
+			memory += memory / 3;
+
+		image->drop();
+
+		if (texture == NULL)
+		{
+			char errorLog[512];
+			sprintf(errorLog, "Can not load texture: %s", stream->RealPath.c_str());
+			os::Printer::log(errorLog);
+
+			stream->State = StreamFailed;
+			return;
+		}
+
+		ITexture* oldTexture = stream->Texture;
+		bool oldTextureShared = stream->TextureShared;
+
+		m_streamMemory = m_streamMemory - stream->TextureMemory + memory;
+
+		stream->State = StreamResident;
+		stream->Texture = texture;
+		stream->TextureMipBias = mipBias;
+		stream->TextureMemory = memory;
+		stream->Compressed = compressed;
+		stream->TextureShared = oldTexture == texture ? oldTextureShared : sharedTexture;
+
+		STexturePackage* package = registerTexture(texture, stream->Package);
+		if (mipBias == 0)
+		{
+			package->paths.push_back(stream->Path);
+			m_textureByPath[stream->Path] = texture;
+		}
+
+		// the callback can request other texture or remove a callback, so call on the copy
+		std::vector<STextureCallback> callbacks = stream->Callbacks;
+
+		// the callback that is called once keeps the texture
+		std::vector<STextureCallback>::iterator once = std::remove_if(stream->Callbacks.begin(), stream->Callbacks.end(), [](const STextureCallback& c)
+			{
+				return c.Id == 0;
+			});
+		if (once != stream->Callbacks.end())
+		{
+			stream->Callbacks.erase(once, stream->Callbacks.end());
+			stream->TextureShared = true;
+		}
+
+		for (STextureCallback& callback : callbacks)
+		{
+			if (callback.Id == 0 || m_streamCallbacks.find(callback.Id) != m_streamCallbacks.end())
+				callback.Callback(texture);
+		}
+
+		// the old texture is released if all its users are notified, else it is released with the package
+		if (oldTexture != NULL && oldTexture != texture && !oldTextureShared)
+			removeTexture(oldTexture);
+
+		// the distance is changed while loading
+		if (!compressed && stream->MipBias < mipBias)
+			queueStream(stream);
+	}
+
+	void CTextureManager::updateStreamBudget()
+	{
+		if (m_streamMemory <= m_streamBudget)
+			return;
+
+		// the memory after the requested reloads
+		u32 memory = m_streamMemory;
+
+		std::vector<STextureStream*> candidates;
+
+		for (std::pair<const std::string, STextureStream*>& s : m_streams)
+		{
+			STextureStream* stream = s.second;
+			if (stream->Texture == NULL || stream->Compressed)
+				continue;
+
+			if (stream->State == StreamResident)
+			{
+				if (stream->TextureMipBias < TEXTURE_STREAM_MAX_MIP_BIAS)
+					candidates.push_back(stream);
+			}
+			else if (stream->MipBias > stream->TextureMipBias)
+			{
+				u32 reduce = stream->TextureMemory - (stream->TextureMemory >> (2 * (stream->MipBias - stream->TextureMipBias)));
+				memory = memory - reduce;
+			}
+		}
+
+		// drop the top mip level of the far textures
+		std::sort(candidates.begin(), candidates.end(), [](STextureStream* a, STextureStream* b)
+			{
+				return a->Distance > b->Distance;
+			});
+
+		for (STextureStream* stream : candidates)
+		{
+			if (memory <= m_streamBudget)
+				break;
+
+			stream->MipBias = stream->TextureMipBias + 1;
+			queueStream(stream);
+
+			memory = memory - (stream->TextureMemory - (stream->TextureMemory >> 2));
+		}
+	}
+
+	void CTextureManager::updateStreaming()
+	{
+		collectStream();
+
+		// limit the upload per frame to avoid the hitch
+		int upload = 0;
+		while (m_streamUpload.size() > 0 && upload < m_maxStreamUpload)
+		{
+			STextureStream* stream = m_streamUpload.front();
+			m_streamUpload.erase(m_streamUpload.begin());
+
+			uploadStream(stream);
+			upload++;
+		}
+
+		updateStreamBudget();
+
+		if (!m_streamQueueSorted)
+		{
+			// the near texture is at the back of the queue
+			std::sort(m_streamQueue.begin(), m_streamQueue.end(), [](STextureStream* a, STextureStream* b)
+				{
+					return a->Distance > b->Distance;
+				});
+			m_streamQueueSorted = true;
+		}
+
+		while (m_streamQueue.size() > 0 && m_streamLoading < m_maxStreamJobs)
+		{
+			STextureStream* stream = m_streamQueue.back();
+			m_streamQueue.pop_back();
+
+			submitStream(stream);
+		}
+	}
+
+	void CTextureManager::finishStreaming()
+	{
+		while (isStreaming())
+		{
+			updateStreaming();
+
+			if (m_streamLoading > 0 && m_streamUpload.size() == 0)
+				System::CJobSystem::getInstance()->wait(&m_streamGroup);
+		}
+	}
+
+	void CTextureManager::removeStream(STextureStream* stream)
+	{
+		// wait the worker that is decoding this texture
+		if (stream->State == StreamLoading)
+		{
+			System::CJobSystem::getInstance()->wait(&m_streamGroup);
+			collectStream();
+		}
+
+		std::vector<STextureStream*>::iterator i = std::find(m_streamQueue.begin(), m_streamQueue.end(), stream);
+		if (i != m_streamQueue.end())
+			m_streamQueue.erase(i);
+
+		i = std::find(m_streamUpload.begin(), m_streamUpload.end(), stream);
+		if (i != m_streamUpload.end())
+			m_streamUpload.erase(i);
+
+		if (stream->Image != NULL)
+			stream->Image->drop();
+
+		for (STextureCallback& callback : stream->Callbacks)
+		{
+			if (callback.Id != 0)
+				m_streamCallbacks.erase(callback.Id);
+		}
+
+		m_streamMemory = m_streamMemory - stream->TextureMemory;
+
+		m_streams.erase(stream->Path);
+		delete stream;
+	}
+
+	void CTextureManager::removeAllStream()
+	{
+		System::CJobSystem* jobSystem = System::CJobSystem::getInstance();
+		if (jobSystem != NULL)
+			jobSystem->wait(&m_streamGroup);
+
+		collectStream();
+
+		for (std::pair<const std::string, STextureStream*>& s : m_streams)
+		{
+			if (s.second->Image != NULL)
+				s.second->Image->drop();
+			delete s.second;
+		}
+
+		m_streams.clear();
+		m_streamCallbacks.clear();
+		m_streamQueue.clear();
+		m_streamUpload.clear();
+		m_streamLoading = 0;
+		m_streamMemory = 0;
 	}
 
 	ITexture* CTextureManager::getTextureArray(std::vector<std::string>& listTexture)
@@ -379,67 +893,13 @@ namespace Skylicht
 		for (u32 i = 0, n = paths.size(); i < n; i++)
 		{
 			char ansiPath[512];
-			strcpy(ansiPath, paths[i].c_str());
-
-			// try to load compress texture
-			if (driver->getDriverType() == video::EDT_OPENGLES)
-			{
-#if defined(ANDROID)
-				// etc compress
-				CStringImp::replacePathExt(ansiPath, ".etc2");
-#elif defined(IOS)
-#if defined(USE_ETC_TEXTURE)
-				CStringImp::replacePathExt(ansiPath, ".etc2");
-#else
-				CStringImp::replacePathExt(ansiPath, ".pvr");
-#endif
-#elif defined(MACOS)
-				CStringImp::replacePathExt(ansiPath, ".dds");
-#elif defined(__EMSCRIPTEN__)
-				if (driver->queryFeature(EVDF_TEXTURE_COMPRESSED_DXT) == true)
-					CStringImp::replacePathExt(ansiPath, ".dds");
-				else
-					CStringImp::replacePathExt(ansiPath, ".etc2");
-#else
-				CStringImp::replacePathExt(ansiPath, ".tga");
-#endif
-			}
-			else if (driver->getDriverType() == video::EDT_DIRECT3D11 || driver->getDriverType() == video::EDT_OPENGL)
-				CStringImp::replacePathExt(ansiPath, ".dds");
 
-			bool loadImage = true;
-
-			if (fs->existFile(ansiPath) == false)
+			bool loadImage = findTexturePath(paths[i].c_str(), ansiPath);
+			if (loadImage == false)
 			{
-				CStringImp::replacePathExt(ansiPath, ".tga");
-
-				if (fs->existFile(ansiPath) == false)
-				{
-					CStringImp::replacePathExt(ansiPath, ".bmp");
-
-					if (fs->existFile(ansiPath) == false)
-					{
-						CStringImp::replacePathExt(ansiPath, ".png");
-
-						if (fs->existFile(ansiPath) == false)
-						{
-							CStringImp::replacePathExt(ansiPath, ".jpeg");
-
-							if (fs->existFile(ansiPath) == false)
-							{
-								CStringImp::replacePathExt(ansiPath, ".jpg");
-
-								if (fs->existFile(ansiPath) == false)
-								{
-									char errorLog[512];
-									sprintf(errorLog, "Can not load array texture (file not found): %s", paths[i].c_str());
-									os::Printer::log(errorLog);
-									loadImage = false;
-								}
-							}
-						}
-					}
-				}
+				char errorLog[512];
+				sprintf(errorLog, "Can not load array texture (file not found): %s", paths[i].c_str());
+				os::Printer::log(errorLog);
 			}
 
 			IImage* image = NULL;
@@ -29,6 +29,12 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Utils/CSingleton.h"
 #include "Utils/CStringImp.h"
 
+#include "Thread/IMutex.h"
+#include "Thread/CJobSystem.h"
+
+// the far texture skip max 4 mip levels (1/16 size)
+#define TEXTURE_STREAM_MAX_MIP_BIAS 4
+
 namespace Skylicht
 {
 	class SKYLICHT_API CTextureManager
@@ -43,11 +49,84 @@ namespace Skylicht
 		{
 			std::string package;
 			ITexture* texture;
+
+			// the request paths of this texture in m_textureByPath
+			std::vector<std::string> paths;
+		};
+
+		enum EStreamState
+		{
+			StreamQueue = 0,
+			StreamLoading,
+			StreamDecoded,
+			StreamResident,
+			StreamFailed
+		};
+
+		struct STextureCallback
+		{
+			// 0 is the callback that is called once, see getTextureAsync
+			u32 Id;
+			std::function<void(ITexture*)> Callback;
+		};
+
+		struct STextureStream
+		{
+			std::string Path;
+			std::string RealPath;
+			std::string Package;
+
+			EStreamState State;
+
+			// the near texture is loaded first
+			float Distance;
+
+			// the number of top mip levels that are not loaded
+			u32 MipBias;
+
+			// the image that is decoded on the worker thread
+			IImage* Image;
+			u32 ImageMipBias;
+
+			// the texture that is uploaded on the main thread
+			ITexture* Texture;
+			u32 TextureMipBias;
+			u32 TextureMemory;
+			bool Compressed;
+
+			// the texture is returned to the caller that is not notified on the mip level change,
+			// so it is not released when the mip level changes, it is released with the package
+			bool TextureShared;
+
+			std::vector<STextureCallback> Callbacks;
 		};
 
 		std::string m_currentPackage;
 		std::vector<STexturePackage*> m_textureList;
 
+		std::unordered_map<ITexture*, STexturePackage*> m_textureMap;
+		std::unordered_map<std::string, ITexture*> m_textureByPath;
+
+		std::unordered_map<std::string, STextureStream*> m_streams;
+		std::unordered_map<u32, STextureStream*> m_streamCallbacks;
+		u32 m_streamCallbackId;
+		std::vector<STextureStream*> m_streamQueue;
+		std::vector<STextureStream*> m_streamUpload;
+
+		// the images that are decoded on worker threads, it is locked by m_streamMutex
+		std::vector<STextureStream*> m_streamDecoded;
+		System::IMutex* m_streamMutex;
+		System::CJobGroup m_streamGroup;
+
+		bool m_streamQueueSorted;
+		int m_streamLoading;
+		int m_maxStreamJobs;
+		int m_maxStreamUpload;
+
+		u32 m_streamBudget;
+		u32 m_streamMemory;
+		float m_streamMipDistance;
+
 		std::vector<std::string> m_listCommonTexture;
 		int m_loadCommonPos;
 
@@ -84,6 +163,57 @@ namespace Skylicht
 
 		ITexture* getTextureFromRealPath(const char* path);
 
+		/// @brief Load the texture on the worker threads. It returns the texture if it is loaded, else it returns the null texture and the texture is loaded later in updateStreaming.
+		/// @param distance The near texture is loaded first, the far texture skips the top mip levels, see setStreamingMipDistance.
+		/// @param onLoaded It is called on the main thread when the texture is uploaded.
+		/// @param callbackId If it is not NULL, onLoaded is also called when the resident mip level changes, until removeTextureCallback is called.
+		/// Else onLoaded is called once, and the returned texture is not released when the mip level changes.
+		ITexture* getTextureAsync(const char* path, float distance = 0.0f, const std::function<void(ITexture*)>& onLoaded = nullptr, u32* callbackId = NULL);
+
+		/// @brief Remove the callback of getTextureAsync, call it before the objects that are captured by the callback are destroyed.
+		void removeTextureCallback(u32 callbackId);
+
+		/// @brief Update the distance of the streaming texture, the texture is reloaded if it needs a different mip level.
+		void setStreamingDistance(const char* path, float distance);
+
+		/// @brief Upload the decoded images and submit the next load jobs. Call it once per frame on the main thread.
+		void updateStreaming();
+
+		/// @brief Wait all streaming textures are uploaded, that can be used on the loading screen.
+		void finishStreaming();
+
+		inline bool isStreaming()
+		{
+			return m_streamQueue.size() > 0 || m_streamLoading > 0 || m_streamUpload.size() > 0;
+		}
+
+		/// @brief The memory of the streaming textures, the far textures drop their top mip level if the memory is over budget.
+		inline void setStreamingBudget(u32 bytes)
+		{
+			m_streamBudget = bytes;
+		}
+
+		inline u32 getStreamingBudget()
+		{
+			return m_streamBudget;
+		}
+
+		inline u32 getStreamingMemory()
+		{
+			return m_streamMemory;
+		}
+
+		/// @brief The texture in this distance loads full mip levels, each double of the distance skips one more mip level.
+		inline void setStreamingMipDistance(float distance)
+		{
+			m_streamMipDistance = distance;
+		}
+
+		inline void setMaxStreamingUpload(int count)
+		{
+			m_maxStreamUpload = count;
+		}
+
 		ITexture* getCubeTexture(
 			const char* pathX1,
 			const char* pathX2,
@@ -107,6 +237,34 @@ namespace Skylicht
 		ITexture* createTransformTexture2D(const char* name, core::matrix4* transforms, int w, int h);
 
 		ITexture* createVectorTexture2D(const char* name, core::vector3df* vectors, int w, int h);
+
+	protected:
+
+		bool findTexturePath(const char* path, char* ansiPath);
+
+		void loadNullTexture();
+
+		STexturePackage* registerTexture(ITexture* tex, const std::string& package);
+
+		void releasePackage(STexturePackage* package);
+
+		u32 getStreamMipBias(float distance);
+
+		void queueStream(STextureStream* stream);
+
+		void addStreamCallback(STextureStream* stream, const std::function<void(ITexture*)>& onLoaded, u32* callbackId);
+
+		void submitStream(STextureStream* stream);
+
+		void collectStream();
+
+		void uploadStream(STextureStream* stream);
+
+		void updateStreamBudget();
+
+		void removeStream(STextureStream* stream);
+
+		void removeAllStream();
 	};
 
 }
\ No newline at end of file
@@ -28,6 +28,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
+	/// @brief The group query the transform changed at this frame, m_entities is the list of changed entities (NeedValidate = true)
 	class SKYLICHT_API CGroupTransform : public CEntityGroup
 	{
 	protected:
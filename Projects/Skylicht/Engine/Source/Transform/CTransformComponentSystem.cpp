@@ -35,7 +35,8 @@ namespace Skylicht
 	CComponentTransformSystem::CComponentTransformSystem() :
 		m_group(NULL)
 	{
-
+		declareReadData(DATA_TYPE_INDEX(CTransformComponentData));
+		declareWriteData(DATA_TYPE_INDEX(CWorldTransformData));
 	}
 
 	CComponentTransformSystem::~CComponentTransformSystem()
@@ -27,16 +27,25 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Entity/CEntityManager.h"
 #include "Culling/CVisibleData.h"
 #include "Transform/CTransform.h"
+#include "Transform/CWorldTransformSystem.h"
+
+#include "Thread/CJobSystem.h"
+
+#include <atomic>
 
 namespace Skylicht
 {
 	CWorldInverseTransformSystem::CWorldInverseTransformSystem() :
-		m_group(NULL)
+		m_group(NULL),
+		m_groupTransform(NULL)
 	{
+		declareReadData(DATA_TYPE_INDEX(CWorldTransformData));
+		declareWriteData(DATA_TYPE_INDEX(CWorldInverseTransformData));
 	}
 
 	CWorldInverseTransformSystem::~CWorldInverseTransformSystem()
 	{
+
 	}
 
 	void CWorldInverseTransformSystem::beginQuery(CEntityManager* entityManager)
@@ -60,21 +69,102 @@ namespace Skylicht
 
 	void CWorldInverseTransformSystem::update(CEntityManager* entityManager)
 	{
+		if (m_groupTransform == NULL)
+		{
+			CWorldTransformSystem* transformSystem = entityManager->getSystem<CWorldTransformSystem>();
+			if (transformSystem)
+				m_groupTransform = transformSystem->getGroupTransform();
+		}
+
 		CEntity** entities = m_group->getEntities();
 		int numEntity = m_group->getEntityCount();
 
-		for (int i = 0; i < numEntity; i++)
+		// the static entities is skipped, just loop the changed list if it's shorter
+		bool useChangedList = m_groupTransform && m_groupTransform->getEntityCount() < numEntity;
+
+		// loop the data in the chunk memory order, if the data is in the storage
+		CEntityDataStorage* storage = entityManager->getDataStorage();
+		CEntityDataPool* pool = storage ? storage->getPool(DATA_TYPE_INDEX(CWorldInverseTransformData)) : NULL;
+		if (!useChangedList && pool && pool->getUsedCount() > 0)
 		{
-			CEntity* entity = entities[i];
+			if (updateStorage(entityManager, pool) == numEntity)
+				return;
 
-			CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
-			CWorldInverseTransformData* worldInv = GET_ENTITY_DATA(entity, CWorldInverseTransformData);
+			// some data was added before the storage is enabled, they are in the heap
+		}
 
-			if (world->NeedValidate)
-			{
-				// Get inverse matrix of world
-				world->World.getInverse(worldInv->WorldInverse);
-			}
+		if (useChangedList)
+		{
+			entities = m_groupTransform->getEntities();
+			numEntity = m_groupTransform->getEntityCount();
 		}
+
+		auto updateInverse = [entities](int begin, int end)
+			{
+				for (int i = begin; i < end; i++)
+				{
+					CEntity* entity = entities[i];
+
+					CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
+					CWorldInverseTransformData* worldInv = GET_ENTITY_DATA(entity, CWorldInverseTransformData);
+
+					if (worldInv != NULL && world->NeedValidate)
+					{
+						// Get inverse matrix of world
+						world->World.getInverse(worldInv->WorldInverse);
+					}
+				}
+			};
+
+		if (entityManager->isMultiThreadUpdate())
+			System::CJobSystem::getInstance()->parallelFor(numEntity, 512, updateInverse);
+		else
+			updateInverse(0, numEntity);
+	}
+
+	int CWorldInverseTransformSystem::updateStorage(CEntityManager* entityManager, CEntityDataPool* pool)
+	{
+		// contains is thread safe after it
+		m_group->validateMembership();
+
+		CEntityGroup* group = m_group;
+		std::atomic<int> numVisit(0);
+
+		auto updateInverse = [group, pool, &numVisit](int begin, int end)
+			{
+				int visit = 0;
+
+				for (int i = begin; i < end; i++)
+				{
+					if (!pool->isAlive((u32)i))
+						continue;
+
+					CWorldInverseTransformData* worldInv = pool->getData<CWorldInverseTransformData>((u32)i);
+
+					CEntity* entity = worldInv->Entity;
+					if (entity == NULL || !group->contains(entity))
+						continue;
+
+					visit++;
+
+					CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
+					if (world->NeedValidate)
+					{
+						// Get inverse matrix of world
+						world->World.getInverse(worldInv->WorldInverse);
+					}
+				}
+
+				numVisit += visit;
+			};
+
+		int numSlot = (int)pool->getSlotCount();
+
+		if (entityManager->isMultiThreadUpdate())
+			System::CJobSystem::getInstance()->parallelFor(numSlot, 512, updateInverse);
+		else
+			updateInverse(0, numSlot);
+
+		return numVisit;
 	}
 }
\ No newline at end of file
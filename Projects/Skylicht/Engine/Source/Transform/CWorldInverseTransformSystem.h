@@ -28,6 +28,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CWorldInverseTransformData.h"
 #include "Entity/IEntitySystem.h"
 #include "Entity/CEntityGroup.h"
+#include "CGroupTransform.h"
 
 namespace Skylicht
 {
@@ -35,6 +36,7 @@ namespace Skylicht
 	{
 	protected:
 		CEntityGroup* m_group;
+		CGroupTransform* m_groupTransform;
 
 	public:
 		CWorldInverseTransformSystem();
@@ -48,5 +50,9 @@ namespace Skylicht
 		virtual void init(CEntityManager* entityManager);
 
 		virtual void update(CEntityManager* entityManager);
+
+	protected:
+
+		int updateStorage(CEntityManager* entityManager, CEntityDataPool* pool);
 	};
 }
\ No newline at end of file
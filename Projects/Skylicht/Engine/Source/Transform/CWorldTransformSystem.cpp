@@ -28,6 +28,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Entity/CEntityManager.h"
 #include "Transform/CTransform.h"
 #include "Culling/CVisibleData.h"
+#include "Utils/CSIMDUtils.h"
 
 namespace Skylicht
 {
@@ -100,7 +101,7 @@ namespace Skylicht
 			// calc world = parent * relative
 			// - relative is copied from CTransformComponentSystem
 			// - relative is also defined in CEntityPrefab
-			t->World.setbyproduct_nocheck(t->Parent->World, t->Relative);
+			CSIMDUtils::mulMatrix(t->World, t->Parent->World, t->Relative);
 		}
 
 		lateUpdate(entityManager);
@@ -118,7 +119,7 @@ namespace Skylicht
 		for (int i = 0; i < numEntity; i++)
 		{
 			CWorldTransformData* t = transforms[i];
-			t->World.setbyproduct_nocheck(t->Parent->World, t->Relative);
+			CSIMDUtils::mulMatrix(t->World, t->Parent->World, t->Relative);
 		}
 	}
 }
\ No newline at end of file
@@ -56,5 +56,10 @@ namespace Skylicht
 		virtual void update(CEntityManager* entityManager);
 
 		virtual void lateUpdate(CEntityManager* entityManager);
+
+		inline CGroupTransform* getGroupTransform()
+		{
+			return m_groupTransform;
+		}
 	};
 }
\ No newline at end of file
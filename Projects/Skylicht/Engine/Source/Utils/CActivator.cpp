@@ -49,4 +49,21 @@ namespace Skylicht
 		int id = (*i).second;
 		return m_factoryFunc[id]();
 	}
+
+	int CActivator::getTypeID(const char* type)
+	{
+		std::map<std::string, int>::iterator i = m_factoryName.find(type);
+		if (i == m_factoryName.end())
+			return -1;
+
+		return (*i).second;
+	}
+
+	IActivatorObject* CActivator::createInstance(int id)
+	{
+		if (id < 0 || id >= (int)m_factoryFunc.size())
+			return NULL;
+
+		return m_factoryFunc[id]();
+	}
 }
\ No newline at end of file
@@ -59,5 +59,10 @@ namespace Skylicht
 		bool registerType(const char* type, ActivatorCreateInstance func);
 
 		IActivatorObject* createInstance(const char* type);
+
+		/// @brief Return the id of the registered type (-1 if not found), that is used to create many instances without the name lookup
+		int getTypeID(const char* type);
+
+		IActivatorObject* createInstance(int id);
 	};
 }
\ No newline at end of file
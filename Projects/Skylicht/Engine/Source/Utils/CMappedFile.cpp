@@ -0,0 +1,198 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CMappedFile.h"
+
+#if defined(_WIN32)
+#if !defined(WINDOWS_STORE)
+#include <Windows.h>
+#endif
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace Skylicht
+{
+	CMappedFile::CMappedFile() :
+		m_data(NULL),
+		m_size(0),
+		m_mapped(false)
+	{
+#if defined(_WIN32) && !defined(WINDOWS_STORE)
+		m_file = INVALID_HANDLE_VALUE;
+		m_mapping = NULL;
+#endif
+	}
+
+	CMappedFile::~CMappedFile()
+	{
+		close();
+	}
+
+	bool CMappedFile::open(const char* path)
+	{
+		close();
+
+		io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+
+		io::IReadFile* readFile = fs->createAndOpenFile(path);
+		if (readFile == NULL)
+			return false;
+
+		u32 size = (u32)readFile->getSize();
+		if (size == 0)
+		{
+			readFile->drop();
+			return false;
+		}
+
+		// the file system opens the archives first, so only the file that is not in any archive is on the disk
+		if (!isInArchive(path) && map(readFile->getFileName().c_str(), size))
+		{
+			readFile->drop();
+			return true;
+		}
+
+		m_data = new unsigned char[size];
+		m_size = (u32)readFile->read(m_data, size);
+		readFile->drop();
+
+		if (m_size != size)
+		{
+			close();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool CMappedFile::isInArchive(const char* path)
+	{
+		io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+
+		for (u32 i = 0, n = fs->getFileArchiveCount(); i < n; i++)
+		{
+			const io::IFileList* fileList = fs->getFileArchive(i)->getFileList();
+			if (fileList != NULL && fileList->findFile(path) >= 0)
+				return true;
+		}
+
+		return false;
+	}
+
+	bool CMappedFile::map(const char* path, u32 size)
+	{
+#if defined(_WIN32) && !defined(WINDOWS_STORE)
+		HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart != (LONGLONG)size)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping == NULL)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data == NULL)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_file = file;
+		m_mapping = mapping;
+		m_data = (unsigned char*)data;
+		m_size = size;
+		m_mapped = true;
+		return true;
+#elif !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+		int file = ::open(path, O_RDONLY);
+		if (file < 0)
+			return false;
+
+		struct stat fileStat;
+		if (fstat(file, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size != (off_t)size)
+		{
+			::close(file);
+			return false;
+		}
+
+		void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+		// the mapping is still valid after the file is closed
+		::close(file);
+
+		if (data == MAP_FAILED)
+			return false;
+
+		m_data = (unsigned char*)data;
+		m_size = size;
+		m_mapped = true;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void CMappedFile::close()
+	{
+		if (m_data == NULL)
+			return;
+
+		if (m_mapped)
+		{
+#if defined(_WIN32) && !defined(WINDOWS_STORE)
+			UnmapViewOfFile(m_data);
+			CloseHandle(m_mapping);
+			CloseHandle(m_file);
+			m_mapping = NULL;
+			m_file = INVALID_HANDLE_VALUE;
+#elif !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+			munmap(m_data, m_size);
+#endif
+		}
+		else
+		{
+			delete[] m_data;
+		}
+
+		m_data = NULL;
+		m_size = 0;
+		m_mapped = false;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+namespace Skylicht
+{
+	/// @brief Read only view of a whole file.
+	/// The file on the disk is mapped to memory (no copy), the file in an archive (zip, android asset...) is read to memory.
+	class SKYLICHT_API CMappedFile
+	{
+	protected:
+		unsigned char* m_data;
+		u32 m_size;
+		bool m_mapped;
+
+#if defined(_WIN32) && !defined(WINDOWS_STORE)
+		void* m_file;
+		void* m_mapping;
+#endif
+
+	public:
+		CMappedFile();
+
+		virtual ~CMappedFile();
+
+		bool open(const char* path);
+
+		void close();
+
+		inline const unsigned char* getData()
+		{
+			return m_data;
+		}
+
+		inline u32 getSize()
+		{
+			return m_size;
+		}
+
+		inline bool isMapped()
+		{
+			return m_mapped;
+		}
+
+	protected:
+
+		bool isInArchive(const char* path);
+
+		bool map(const char* path, u32 size);
+	};
+}
\ No newline at end of file
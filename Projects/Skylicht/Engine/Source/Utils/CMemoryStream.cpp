@@ -76,7 +76,7 @@ namespace Skylicht
 
 		unsigned char* newMemory = new unsigned char[newSize];
 		memcpy(newMemory, m_memory, m_size);
-		delete m_memory;
+		delete[] m_memory;
 
 		m_memory = newMemory;
 		m_totalSize = newSize;
@@ -163,7 +163,7 @@ namespace Skylicht
 	void CMemoryStream::writeString(const std::string& s)
 	{
 		int size = (int)s.size() + 1;
-		autoGrow(size);
+		autoGrow(sizeof(int) + size);
 
 		// write num char
 		memcpy(&m_memory[m_size], &size, sizeof(int));
@@ -180,7 +180,7 @@ namespace Skylicht
 	void CMemoryStream::writeString(const std::wstring& s)
 	{
 		int size = (int)s.size() + 1;
-		autoGrow(size * sizeof(wchar_t));	// unicode
+		autoGrow(sizeof(int) + size * sizeof(wchar_t));	// unicode
 
 		// write num char
 		memcpy(&m_memory[m_size], &size, sizeof(int));
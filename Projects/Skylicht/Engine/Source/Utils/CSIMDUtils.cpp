@@ -0,0 +1,874 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CSIMDUtils.h"
+
+#if defined(SKYLICHT_SIMD_SSE)
+#include <emmintrin.h>
+#elif defined(SKYLICHT_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Skylicht
+{
+	// m = m1 * m2, the column major matrix (see core::matrix4::setbyproduct_nocheck)
+	static inline void mulMatrixArray(f32* m, const f32* m1, const f32* m2)
+	{
+#if defined(SKYLICHT_SIMD_SSE)
+		__m128 a0 = _mm_loadu_ps(m1);
+		__m128 a1 = _mm_loadu_ps(m1 + 4);
+		__m128 a2 = _mm_loadu_ps(m1 + 8);
+		__m128 a3 = _mm_loadu_ps(m1 + 12);
+
+		for (int i = 0; i < 16; i += 4)
+		{
+			__m128 r = _mm_mul_ps(a0, _mm_set1_ps(m2[i]));
+			r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(m2[i + 1])));
+			r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(m2[i + 2])));
+			r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(m2[i + 3])));
+			_mm_storeu_ps(m + i, r);
+		}
+#elif defined(SKYLICHT_SIMD_NEON)
+		float32x4_t a0 = vld1q_f32(m1);
+		float32x4_t a1 = vld1q_f32(m1 + 4);
+		float32x4_t a2 = vld1q_f32(m1 + 8);
+		float32x4_t a3 = vld1q_f32(m1 + 12);
+
+		for (int i = 0; i < 16; i += 4)
+		{
+			float32x4_t r = vmulq_n_f32(a0, m2[i]);
+			r = vmlaq_n_f32(r, a1, m2[i + 1]);
+			r = vmlaq_n_f32(r, a2, m2[i + 2]);
+			r = vmlaq_n_f32(r, a3, m2[i + 3]);
+			vst1q_f32(m + i, r);
+		}
+#else
+		f32 r[16];
+
+		for (int i = 0; i < 16; i += 4)
+		{
+			r[i] = m1[0] * m2[i] + m1[4] * m2[i + 1] + m1[8] * m2[i + 2] + m1[12] * m2[i + 3];
+			r[i + 1] = m1[1] * m2[i] + m1[5] * m2[i + 1] + m1[9] * m2[i + 2] + m1[13] * m2[i + 3];
+			r[i + 2] = m1[2] * m2[i] + m1[6] * m2[i + 1] + m1[10] * m2[i + 2] + m1[14] * m2[i + 3];
+			r[i + 3] = m1[3] * m2[i] + m1[7] * m2[i + 1] + m1[11] * m2[i + 2] + m1[15] * m2[i + 3];
+		}
+
+		memcpy(m, r, sizeof(r));
+#endif
+	}
+
+	// transform the box by m and recalculate the axis aligned box (see core::matrix4::transformBoxEx)
+	static inline void transformBoxArray(const f32* m, const core::aabbox3df& box, core::aabbox3df& out)
+	{
+		const f32* minEdge = &box.MinEdge.X;
+		const f32* maxEdge = &box.MaxEdge.X;
+
+#if defined(SKYLICHT_SIMD_SSE)
+		__m128 bmin = _mm_loadu_ps(m + 12);
+		__m128 bmax = bmin;
+
+		for (int i = 0; i < 3; i++)
+		{
+			__m128 col = _mm_loadu_ps(m + i * 4);
+			__m128 a = _mm_mul_ps(col, _mm_set1_ps(minEdge[i]));
+			__m128 b = _mm_mul_ps(col, _mm_set1_ps(maxEdge[i]));
+			bmin = _mm_add_ps(bmin, _mm_min_ps(a, b));
+			bmax = _mm_add_ps(bmax, _mm_max_ps(a, b));
+		}
+
+		alignas(16) f32 rmin[4];
+		alignas(16) f32 rmax[4];
+		_mm_store_ps(rmin, bmin);
+		_mm_store_ps(rmax, bmax);
+#elif defined(SKYLICHT_SIMD_NEON)
+		float32x4_t bmin = vld1q_f32(m + 12);
+		float32x4_t bmax = bmin;
+
+		for (int i = 0; i < 3; i++)
+		{
+			float32x4_t col = vld1q_f32(m + i * 4);
+			float32x4_t a = vmulq_n_f32(col, minEdge[i]);
+			float32x4_t b = vmulq_n_f32(col, maxEdge[i]);
+			bmin = vaddq_f32(bmin, vminq_f32(a, b));
+			bmax = vaddq_f32(bmax, vmaxq_f32(a, b));
+		}
+
+		f32 rmin[4];
+		f32 rmax[4];
+		vst1q_f32(rmin, bmin);
+		vst1q_f32(rmax, bmax);
+#else
+		f32 rmin[3] = { m[12], m[13], m[14] };
+		f32 rmax[3] = { m[12], m[13], m[14] };
+
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				f32 a = m[i * 4 + j] * minEdge[i];
+				f32 b = m[i * 4 + j] * maxEdge[i];
+				rmin[j] += core::min_(a, b);
+				rmax[j] += core::max_(a, b);
+			}
+		}
+#endif
+
+		out.MinEdge.set(rmin[0], rmin[1], rmin[2]);
+		out.MaxEdge.set(rmax[0], rmax[1], rmax[2]);
+	}
+
+	void CSIMDUtils::mulMatrix(core::matrix4& out, const core::matrix4& a, const core::matrix4& b)
+	{
+		mulMatrixArray(out.pointer(), a.pointer(), b.pointer());
+	}
+
+	void CSIMDUtils::mulMatrices(core::matrix4* out, const core::matrix4* a, const core::matrix4* b, int count)
+	{
+		for (int i = 0; i < count; i++)
+			mulMatrixArray(out[i].pointer(), a[i].pointer(), b[i].pointer());
+	}
+
+	void CSIMDUtils::transformBox(const core::matrix4& mat, core::aabbox3df& box)
+	{
+		transformBoxArray(mat.pointer(), box, box);
+	}
+
+	void CSIMDUtils::transformBoxes(const core::matrix4* m, const core::aabbox3df* box, core::aabbox3df* out, int count)
+	{
+		for (int i = 0; i < count; i++)
+			transformBoxArray(m[i].pointer(), box[i], out[i]);
+	}
+
+	bool CSIMDUtils::isBoxOutsideFrustum(const scene::SViewFrustum& frustum, const core::aabbox3df& box)
+	{
+		core::vector3df center = box.getCenter();
+		core::vector3df extent = box.MaxEdge - center;
+
+		for (int i = 0; i < scene::SViewFrustum::VF_PLANE_COUNT; i++)
+		{
+			const core::plane3df& p = frustum.planes[i];
+
+			// the distance of the nearest edge
+			f32 d = p.Normal.dotProduct(center) + p.D -
+				(fabsf(p.Normal.X) * extent.X + fabsf(p.Normal.Y) * extent.Y + fabsf(p.Normal.Z) * extent.Z);
+
+			// all the edges are front of plane (see plane3d::classifyPointRelation)
+			if (d > core::ROUNDING_ERROR_f32)
+				return true;
+		}
+
+		return false;
+	}
+
+	void CSIMDUtils::cullOrientedBoxes(const scene::SViewFrustum& frustum, const f32* const* center, const f32* const* halfAxis, int count, bool* outside)
+	{
+		int i = 0;
+
+#if defined(SKYLICHT_SIMD_SSE)
+		const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+		const __m128 epsilon = _mm_set1_ps(core::ROUNDING_ERROR_f32);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 cx = _mm_loadu_ps(center[0] + i);
+			__m128 cy = _mm_loadu_ps(center[1] + i);
+			__m128 cz = _mm_loadu_ps(center[2] + i);
+
+			__m128 a[9];
+			for (int j = 0; j < 9; j++)
+				a[j] = _mm_loadu_ps(halfAxis[j] + i);
+
+			__m128 result = _mm_setzero_ps();
+
+			for (int p = 0; p < scene::SViewFrustum::VF_PLANE_COUNT; p++)
+			{
+				const core::plane3df& plane = frustum.planes[p];
+
+				__m128 nx = _mm_set1_ps(plane.Normal.X);
+				__m128 ny = _mm_set1_ps(plane.Normal.Y);
+				__m128 nz = _mm_set1_ps(plane.Normal.Z);
+
+				__m128 d = _mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy));
+				d = _mm_add_ps(d, _mm_mul_ps(nz, cz));
+				d = _mm_add_ps(d, _mm_set1_ps(plane.D));
+
+				// projected radius of box on the plane normal
+				__m128 r = _mm_setzero_ps();
+				for (int j = 0; j < 9; j += 3)
+				{
+					__m128 t = _mm_add_ps(_mm_mul_ps(nx, a[j]), _mm_mul_ps(ny, a[j + 1]));
+					t = _mm_add_ps(t, _mm_mul_ps(nz, a[j + 2]));
+					r = _mm_add_ps(r, _mm_and_ps(t, absMask));
+				}
+
+				result = _mm_or_ps(result, _mm_cmpgt_ps(_mm_sub_ps(d, r), epsilon));
+			}
+
+			int mask = _mm_movemask_ps(result);
+			outside[i] = (mask & 1) != 0;
+			outside[i + 1] = (mask & 2) != 0;
+			outside[i + 2] = (mask & 4) != 0;
+			outside[i + 3] = (mask & 8) != 0;
+		}
+#elif defined(SKYLICHT_SIMD_NEON)
+		const float32x4_t epsilon = vdupq_n_f32(core::ROUNDING_ERROR_f32);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			float32x4_t cx = vld1q_f32(center[0] + i);
+			float32x4_t cy = vld1q_f32(center[1] + i);
+			float32x4_t cz = vld1q_f32(center[2] + i);
+
+			float32x4_t a[9];
+			for (int j = 0; j < 9; j++)
+				a[j] = vld1q_f32(halfAxis[j] + i);
+
+			uint32x4_t result = vdupq_n_u32(0);
+
+			for (int p = 0; p < scene::SViewFrustum::VF_PLANE_COUNT; p++)
+			{
+				const core::plane3df& plane = frustum.planes[p];
+
+				float32x4_t d = vmulq_n_f32(cx, plane.Normal.X);
+				d = vmlaq_n_f32(d, cy, plane.Normal.Y);
+				d = vmlaq_n_f32(d, cz, plane.Normal.Z);
+				d = vaddq_f32(d, vdupq_n_f32(plane.D));
+
+				float32x4_t r = vdupq_n_f32(0.0f);
+				for (int j = 0; j < 9; j += 3)
+				{
+					float32x4_t t = vmulq_n_f32(a[j], plane.Normal.X);
+					t = vmlaq_n_f32(t, a[j + 1], plane.Normal.Y);
+					t = vmlaq_n_f32(t, a[j + 2], plane.Normal.Z);
+					r = vaddq_f32(r, vabsq_f32(t));
+				}
+
+				result = vorrq_u32(result, vcgtq_f32(vsubq_f32(d, r), epsilon));
+			}
+
+			outside[i] = vgetq_lane_u32(result, 0) != 0;
+			outside[i + 1] = vgetq_lane_u32(result, 1) != 0;
+			outside[i + 2] = vgetq_lane_u32(result, 2) != 0;
+			outside[i + 3] = vgetq_lane_u32(result, 3) != 0;
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			outside[i] = false;
+
+			for (int p = 0; p < scene::SViewFrustum::VF_PLANE_COUNT; p++)
+			{
+				const core::plane3df& plane = frustum.planes[p];
+
+				f32 d = plane.Normal.X * center[0][i] + plane.Normal.Y * center[1][i] + plane.Normal.Z * center[2][i] + plane.D;
+
+				f32 r = 0.0f;
+				for (int j = 0; j < 9; j += 3)
+					r += fabsf(plane.Normal.X * halfAxis[j][i] + plane.Normal.Y * halfAxis[j + 1][i] + plane.Normal.Z * halfAxis[j + 2][i]);
+
+				if (d - r > core::ROUNDING_ERROR_f32)
+				{
+					outside[i] = true;
+					break;
+				}
+			}
+		}
+	}
+
+	void CSIMDUtils::lerpArray(const f32* start, const f32* end, const f32* t, f32* out, int count)
+	{
+		int i = 0;
+
+#if defined(SKYLICHT_SIMD_SSE)
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 a = _mm_loadu_ps(start + i);
+			__m128 b = _mm_loadu_ps(end + i);
+			__m128 f = _mm_loadu_ps(t + i);
+			_mm_storeu_ps(out + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), f)));
+		}
+#elif defined(SKYLICHT_SIMD_NEON)
+		for (; i + 4 <= count; i += 4)
+		{
+			float32x4_t a = vld1q_f32(start + i);
+			float32x4_t b = vld1q_f32(end + i);
+			float32x4_t f = vld1q_f32(t + i);
+			vst1q_f32(out + i, vmlaq_f32(a, vsubq_f32(b, a), f));
+		}
+#endif
+
+		for (; i < count; i++)
+			out[i] = start[i] + (end[i] - start[i]) * t[i];
+	}
+
+	void CSIMDUtils::evaluateCurve(const f32* keyX, const f32* keyY, int numKey, const f32* x, f32* y, int count)
+	{
+		if (numKey <= 0)
+		{
+			memset(y, 0, sizeof(f32) * count);
+			return;
+		}
+
+		int last = numKey - 1;
+		int i = 0;
+
+		// the keys are increasing, so the last segment that x >= keyX[k] is the result
+#if defined(SKYLICHT_SIMD_SSE)
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 v = _mm_loadu_ps(x + i);
+			__m128 result = _mm_set1_ps(keyY[0]);
+
+			for (int k = 0; k < last; k++)
+			{
+				f32 slope = (keyY[k + 1] - keyY[k]) / (keyX[k + 1] - keyX[k]);
+				__m128 x0 = _mm_set1_ps(keyX[k]);
+				__m128 value = _mm_add_ps(_mm_set1_ps(keyY[k]), _mm_mul_ps(_mm_sub_ps(v, x0), _mm_set1_ps(slope)));
+				__m128 mask = _mm_cmpge_ps(v, x0);
+				result = _mm_or_ps(_mm_and_ps(mask, value), _mm_andnot_ps(mask, result));
+			}
+
+			__m128 mask = _mm_cmpge_ps(v, _mm_set1_ps(keyX[last]));
+			result = _mm_or_ps(_mm_and_ps(mask, _mm_set1_ps(keyY[last])), _mm_andnot_ps(mask, result));
+
+			_mm_storeu_ps(y + i, result);
+		}
+#elif defined(SKYLICHT_SIMD_NEON)
+		for (; i + 4 <= count; i += 4)
+		{
+			float32x4_t v = vld1q_f32(x + i);
+			float32x4_t result = vdupq_n_f32(keyY[0]);
+
+			for (int k = 0; k < last; k++)
+			{
+				f32 slope = (keyY[k + 1] - keyY[k]) / (keyX[k + 1] - keyX[k]);
+				float32x4_t x0 = vdupq_n_f32(keyX[k]);
+				float32x4_t value = vmlaq_f32(vdupq_n_f32(keyY[k]), vsubq_f32(v, x0), vdupq_n_f32(slope));
+				result = vbslq_f32(vcgeq_f32(v, x0), value, result);
+			}
+
+			result = vbslq_f32(vcgeq_f32(v, vdupq_n_f32(keyX[last])), vdupq_n_f32(keyY[last]), result);
+
+			vst1q_f32(y + i, result);
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			f32 v = x[i];
+
+			if (v >= keyX[last])
+			{
+				y[i] = keyY[last];
+				continue;
+			}
+
+			f32 result = keyY[0];
+			for (int k = 0; k < last && v >= keyX[k]; k++)
+				result = keyY[k] + (v - keyX[k]) * ((keyY[k + 1] - keyY[k]) / (keyX[k + 1] - keyX[k]));
+
+			y[i] = result;
+		}
+	}
+
+	void CSIMDUtils::skinVertex(const float** matrix, const float* weight, int count,
+		const core::vector3df& srcPos,
+		const core::vector3df& srcNormal,
+		core::vector3df& pos,
+		core::vector3df& normal)
+	{
+#if defined(SKYLICHT_SIMD_SSE)
+		// blend the matrices, then transform once
+		__m128 c0 = _mm_setzero_ps();
+		__m128 c1 = _mm_setzero_ps();
+		__m128 c2 = _mm_setzero_ps();
+		__m128 c3 = _mm_setzero_ps();
+
+		for (int i = 0; i < count; i++)
+		{
+			const float* m = matrix[i];
+			__m128 w = _mm_set1_ps(weight[i]);
+			c0 = _mm_add_ps(c0, _mm_mul_ps(_mm_loadu_ps(m), w));
+			c1 = _mm_add_ps(c1, _mm_mul_ps(_mm_loadu_ps(m + 4), w));
+			c2 = _mm_add_ps(c2, _mm_mul_ps(_mm_loadu_ps(m + 8), w));
+			c3 = _mm_add_ps(c3, _mm_mul_ps(_mm_loadu_ps(m + 12), w));
+		}
+
+		__m128 p = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(srcPos.X)), _mm_mul_ps(c1, _mm_set1_ps(srcPos.Y)));
+		p = _mm_add_ps(p, _mm_mul_ps(c2, _mm_set1_ps(srcPos.Z)));
+		p = _mm_add_ps(p, c3);
+
+		__m128 n = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(srcNormal.X)), _mm_mul_ps(c1, _mm_set1_ps(srcNormal.Y)));
+		n = _mm_add_ps(n, _mm_mul_ps(c2, _mm_set1_ps(srcNormal.Z)));
+
+		alignas(16) f32 rp[4];
+		alignas(16) f32 rn[4];
+		_mm_store_ps(rp, p);
+		_mm_store_ps(rn, n);
+
+		pos.set(rp[0], rp[1], rp[2]);
+		normal.set(rn[0], rn[1], rn[2]);
+#elif defined(SKYLICHT_SIMD_NEON)
+		float32x4_t c0 = vdupq_n_f32(0.0f);
+		float32x4_t c1 = c0;
+		float32x4_t c2 = c0;
+		float32x4_t c3 = c0;
+
+		for (int i = 0; i < count; i++)
+		{
+			const float* m = matrix[i];
+			c0 = vmlaq_n_f32(c0, vld1q_f32(m), weight[i]);
+			c1 = vmlaq_n_f32(c1, vld1q_f32(m + 4), weight[i]);
+			c2 = vmlaq_n_f32(c2, vld1q_f32(m + 8), weight[i]);
+			c3 = vmlaq_n_f32(c3, vld1q_f32(m + 12), weight[i]);
+		}
+
+		float32x4_t p = vmulq_n_f32(c0, srcPos.X);
+		p = vmlaq_n_f32(p, c1, srcPos.Y);
+		p = vmlaq_n_f32(p, c2, srcPos.Z);
+		p = vaddq_f32(p, c3);
+
+		float32x4_t n = vmulq_n_f32(c0, srcNormal.X);
+		n = vmlaq_n_f32(n, c1, srcNormal.Y);
+		n = vmlaq_n_f32(n, c2, srcNormal.Z);
+
+		f32 rp[4];
+		f32 rn[4];
+		vst1q_f32(rp, p);
+		vst1q_f32(rn, n);
+
+		pos.set(rp[0], rp[1], rp[2]);
+		normal.set(rn[0], rn[1], rn[2]);
+#else
+		f32 m[16];
+		for (int j = 0; j < 16; j++)
+			m[j] = 0.0f;
+
+		for (int i = 0; i < count; i++)
+		{
+			for (int j = 0; j < 16; j++)
+				m[j] += matrix[i][j] * weight[i];
+		}
+
+		pos.X = srcPos.X * m[0] + srcPos.Y * m[4] + srcPos.Z * m[8] + m[12];
+		pos.Y = srcPos.X * m[1] + srcPos.Y * m[5] + srcPos.Z * m[9] + m[13];
+		pos.Z = srcPos.X * m[2] + srcPos.Y * m[6] + srcPos.Z * m[10] + m[14];
+
+		normal.X = srcNormal.X * m[0] + srcNormal.Y * m[4] + srcNormal.Z * m[8];
+		normal.Y = srcNormal.X * m[1] + srcNormal.Y * m[5] + srcNormal.Z * m[9];
+		normal.Z = srcNormal.X * m[2] + srcNormal.Y * m[6] + srcNormal.Z * m[10];
+#endif
+	}
+
+	static inline bool intersectRayTriangle(const f32* o, const f32* d, const f32* const* tri, int i, f32& t)
+	{
+		f32 e1x = tri[3][i], e1y = tri[4][i], e1z = tri[5][i];
+		f32 e2x = tri[6][i], e2y = tri[7][i], e2z = tri[8][i];
+
+		// p = dir x e2
+		f32 px = d[1] * e2z - d[2] * e2y;
+		f32 py = d[2] * e2x - d[0] * e2z;
+		f32 pz = d[0] * e2y - d[1] * e2x;
+
+		f32 det = e1x * px + e1y * py + e1z * pz;
+		if (fabsf(det) < 1e-12f)
+			return false;
+
+		f32 inv = 1.0f / det;
+
+		f32 sx = o[0] - tri[0][i];
+		f32 sy = o[1] - tri[1][i];
+		f32 sz = o[2] - tri[2][i];
+
+		f32 u = (sx * px + sy * py + sz * pz) * inv;
+		if (u < 0.0f || u > 1.0f)
+			return false;
+
+		// q = s x e1
+		f32 qx = sy * e1z - sz * e1y;
+		f32 qy = sz * e1x - sx * e1z;
+		f32 qz = sx * e1y - sy * e1x;
+
+		f32 v = (d[0] * qx + d[1] * qy + d[2] * qz) * inv;
+		if (v < 0.0f || u + v > 1.0f)
+			return false;
+
+		f32 hit = (e2x * qx + e2y * qy + e2z * qz) * inv;
+		if (hit < 0.0f || hit >= t)
+			return false;
+
+		t = hit;
+		return true;
+	}
+
+	int CSIMDUtils::intersectRayTriangles(const core::vector3df& origin, const core::vector3df& dir, const f32* const* triangle, int count, f32& t)
+	{
+		const f32* o = &origin.X;
+		const f32* d = &dir.X;
+
+		int best = -1;
+		int i = 0;
+
+#if defined(SKYLICHT_SIMD_SSE)
+		const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+		const __m128 epsilon = _mm_set1_ps(1e-12f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		__m128 ox = _mm_set1_ps(o[0]);
+		__m128 oy = _mm_set1_ps(o[1]);
+		__m128 oz = _mm_set1_ps(o[2]);
+		__m128 dx = _mm_set1_ps(d[0]);
+		__m128 dy = _mm_set1_ps(d[1]);
+		__m128 dz = _mm_set1_ps(d[2]);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 e1x = _mm_loadu_ps(triangle[3] + i);
+			__m128 e1y = _mm_loadu_ps(triangle[4] + i);
+			__m128 e1z = _mm_loadu_ps(triangle[5] + i);
+			__m128 e2x = _mm_loadu_ps(triangle[6] + i);
+			__m128 e2y = _mm_loadu_ps(triangle[7] + i);
+			__m128 e2z = _mm_loadu_ps(triangle[8] + i);
+
+			__m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+			__m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+			__m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+
+			__m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+			__m128 mask = _mm_cmpge_ps(_mm_and_ps(det, absMask), epsilon);
+			__m128 inv = _mm_div_ps(one, det);
+
+			__m128 sx = _mm_sub_ps(ox, _mm_loadu_ps(triangle[0] + i));
+			__m128 sy = _mm_sub_ps(oy, _mm_loadu_ps(triangle[1] + i));
+			__m128 sz = _mm_sub_ps(oz, _mm_loadu_ps(triangle[2] + i));
+
+			__m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), inv);
+
+			__m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+			__m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+			__m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+
+			__m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), inv);
+			__m128 hit = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inv);
+
+			mask = _mm_and_ps(mask, _mm_cmpge_ps(u, zero));
+			mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+			mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), one));
+			mask = _mm_and_ps(mask, _mm_cmpge_ps(hit, zero));
+			mask = _mm_and_ps(mask, _mm_cmplt_ps(hit, _mm_set1_ps(t)));
+
+			int m = _mm_movemask_ps(mask);
+			if (m != 0)
+			{
+				f32 h[4];
+				_mm_storeu_ps(h, hit);
+
+				for (int j = 0; j < 4; j++)
+				{
+					if ((m & (1 << j)) && h[j] < t)
+					{
+						t = h[j];
+						best = i + j;
+					}
+				}
+			}
+		}
+#elif defined(SKYLICHT_SIMD_NEON)
+		const float32x4_t epsilon = vdupq_n_f32(1e-12f);
+		const float32x4_t zero = vdupq_n_f32(0.0f);
+		const float32x4_t one = vdupq_n_f32(1.0f);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			float32x4_t e1x = vld1q_f32(triangle[3] + i);
+			float32x4_t e1y = vld1q_f32(triangle[4] + i);
+			float32x4_t e1z = vld1q_f32(triangle[5] + i);
+			float32x4_t e2x = vld1q_f32(triangle[6] + i);
+			float32x4_t e2y = vld1q_f32(triangle[7] + i);
+			float32x4_t e2z = vld1q_f32(triangle[8] + i);
+
+			float32x4_t px = vmlsq_n_f32(vmulq_n_f32(e2z, d[1]), e2y, d[2]);
+			float32x4_t py = vmlsq_n_f32(vmulq_n_f32(e2x, d[2]), e2z, d[0]);
+			float32x4_t pz = vmlsq_n_f32(vmulq_n_f32(e2y, d[0]), e2x, d[1]);
+
+			float32x4_t det = vmlaq_f32(vmlaq_f32(vmulq_f32(e1x, px), e1y, py), e1z, pz);
+			uint32x4_t mask = vcgeq_f32(vabsq_f32(det), epsilon);
+
+			// reciprocal with a newton step
+			float32x4_t inv = vrecpeq_f32(det);
+			inv = vmulq_f32(inv, vrecpsq_f32(det, inv));
+			inv = vmulq_f32(inv, vrecpsq_f32(det, inv));
+
+			float32x4_t sx = vsubq_f32(vdupq_n_f32(o[0]), vld1q_f32(triangle[0] + i));
+			float32x4_t sy = vsubq_f32(vdupq_n_f32(o[1]), vld1q_f32(triangle[1] + i));
+			float32x4_t sz = vsubq_f32(vdupq_n_f32(o[2]), vld1q_f32(triangle[2] + i));
+
+			float32x4_t u = vmulq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(sx, px), sy, py), sz, pz), inv);
+
+			float32x4_t qx = vmlsq_f32(vmulq_f32(sy, e1z), sz, e1y);
+			float32x4_t qy = vmlsq_f32(vmulq_f32(sz, e1x), sx, e1z);
+			float32x4_t qz = vmlsq_f32(vmulq_f32(sx, e1y), sy, e1x);
+
+			float32x4_t v = vmulq_f32(vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(qx, d[0]), qy, d[1]), qz, d[2]), inv);
+			float32x4_t hit = vmulq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(e2x, qx), e2y, qy), e2z, qz), inv);
+
+			mask = vandq_u32(mask, vcgeq_f32(u, zero));
+			mask = vandq_u32(mask, vcgeq_f32(v, zero));
+			mask = vandq_u32(mask, vcleq_f32(vaddq_f32(u, v), one));
+			mask = vandq_u32(mask, vcgeq_f32(hit, zero));
+			mask = vandq_u32(mask, vcltq_f32(hit, vdupq_n_f32(t)));
+
+			u32 m[4];
+			f32 h[4];
+			vst1q_u32(m, mask);
+			vst1q_f32(h, hit);
+
+			for (int j = 0; j < 4; j++)
+			{
+				if (m[j] != 0 && h[j] < t)
+				{
+					t = h[j];
+					best = i + j;
+				}
+			}
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			if (intersectRayTriangle(o, d, triangle, i, t))
+				best = i;
+		}
+
+		return best;
+	}
+
+	void CSIMDUtils::overlapBoxTriangles(const core::aabbox3df& box, const f32* const* triangle, int count, bool* overlap)
+	{
+		int i = 0;
+
+#if defined(SKYLICHT_SIMD_SSE)
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 result = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+			for (int a = 0; a < 3; a++)
+			{
+				__m128 v0 = _mm_loadu_ps(triangle[a] + i);
+				__m128 v1 = _mm_add_ps(v0, _mm_loadu_ps(triangle[a + 3] + i));
+				__m128 v2 = _mm_add_ps(v0, _mm_loadu_ps(triangle[a + 6] + i));
+
+				__m128 minV = _mm_min_ps(v0, _mm_min_ps(v1, v2));
+				__m128 maxV = _mm_max_ps(v0, _mm_max_ps(v1, v2));
+
+				result = _mm_and_ps(result, _mm_cmple_ps(minV, _mm_set1_ps((&box.MaxEdge.X)[a])));
+				result = _mm_and_ps(result, _mm_cmpge_ps(maxV, _mm_set1_ps((&box.MinEdge.X)[a])));
+			}
+
+			int mask = _mm_movemask_ps(result);
+			overlap[i] = (mask & 1) != 0;
+			overlap[i + 1] = (mask & 2) != 0;
+			overlap[i + 2] = (mask & 4) != 0;
+			overlap[i + 3] = (mask & 8) != 0;
+		}
+#elif defined(SKYLICHT_SIMD_NEON)
+		for (; i + 4 <= count; i += 4)
+		{
+			uint32x4_t result = vdupq_n_u32(0xffffffff);
+
+			for (int a = 0; a < 3; a++)
+			{
+				float32x4_t v0 = vld1q_f32(triangle[a] + i);
+				float32x4_t v1 = vaddq_f32(v0, vld1q_f32(triangle[a + 3] + i));
+				float32x4_t v2 = vaddq_f32(v0, vld1q_f32(triangle[a + 6] + i));
+
+				float32x4_t minV = vminq_f32(v0, vminq_f32(v1, v2));
+				float32x4_t maxV = vmaxq_f32(v0, vmaxq_f32(v1, v2));
+
+				result = vandq_u32(result, vcleq_f32(minV, vdupq_n_f32((&box.MaxEdge.X)[a])));
+				result = vandq_u32(result, vcgeq_f32(maxV, vdupq_n_f32((&box.MinEdge.X)[a])));
+			}
+
+			overlap[i] = vgetq_lane_u32(result, 0) != 0;
+			overlap[i + 1] = vgetq_lane_u32(result, 1) != 0;
+			overlap[i + 2] = vgetq_lane_u32(result, 2) != 0;
+			overlap[i + 3] = vgetq_lane_u32(result, 3) != 0;
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			bool result = true;
+
+			for (int a = 0; a < 3 && result; a++)
+			{
+				f32 v0 = triangle[a][i];
+				f32 v1 = v0 + triangle[a + 3][i];
+				f32 v2 = v0 + triangle[a + 6][i];
+
+				f32 minV = core::min_(v0, v1, v2);
+				f32 maxV = core::max_(v0, v1, v2);
+
+				result = minV <= (&box.MaxEdge.X)[a] && maxV >= (&box.MinEdge.X)[a];
+			}
+
+			overlap[i] = result;
+		}
+	}
+
+	int CSIMDUtils::intersectRayPacketBox(const f32* const* origin, const f32* const* invDir, const f32* maxT, const core::aabbox3df& box)
+	{
+#if defined(SKYLICHT_SIMD_SSE)
+		__m128 tMin = _mm_setzero_ps();
+		__m128 tMax = _mm_loadu_ps(maxT);
+
+		for (int a = 0; a < 3; a++)
+		{
+			__m128 o = _mm_loadu_ps(origin[a]);
+			__m128 inv = _mm_loadu_ps(invDir[a]);
+
+			__m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps((&box.MinEdge.X)[a]), o), inv);
+			__m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps((&box.MaxEdge.X)[a]), o), inv);
+
+			tMin = _mm_max_ps(tMin, _mm_min_ps(t1, t2));
+			tMax = _mm_min_ps(tMax, _mm_max_ps(t1, t2));
+		}
+
+		return _mm_movemask_ps(_mm_cmple_ps(tMin, tMax));
+#elif defined(SKYLICHT_SIMD_NEON)
+		float32x4_t tMin = vdupq_n_f32(0.0f);
+		float32x4_t tMax = vld1q_f32(maxT);
+
+		for (int a = 0; a < 3; a++)
+		{
+			float32x4_t o = vld1q_f32(origin[a]);
+			float32x4_t inv = vld1q_f32(invDir[a]);
+
+			float32x4_t t1 = vmulq_f32(vsubq_f32(vdupq_n_f32((&box.MinEdge.X)[a]), o), inv);
+			float32x4_t t2 = vmulq_f32(vsubq_f32(vdupq_n_f32((&box.MaxEdge.X)[a]), o), inv);
+
+			tMin = vmaxq_f32(tMin, vminq_f32(t1, t2));
+			tMax = vminq_f32(tMax, vmaxq_f32(t1, t2));
+		}
+
+		uint32x4_t result = vcleq_f32(tMin, tMax);
+		return (vgetq_lane_u32(result, 0) ? 1 : 0) |
+			(vgetq_lane_u32(result, 1) ? 2 : 0) |
+			(vgetq_lane_u32(result, 2) ? 4 : 0) |
+			(vgetq_lane_u32(result, 3) ? 8 : 0);
+#else
+		int mask = 0;
+
+		for (int r = 0; r < 4; r++)
+		{
+			f32 tMin = 0.0f;
+			f32 tMax = maxT[r];
+
+			for (int a = 0; a < 3; a++)
+			{
+				f32 t1 = ((&box.MinEdge.X)[a] - origin[a][r]) * invDir[a][r];
+				f32 t2 = ((&box.MaxEdge.X)[a] - origin[a][r]) * invDir[a][r];
+
+				tMin = core::max_(tMin, core::min_(t1, t2));
+				tMax = core::min_(tMax, core::max_(t1, t2));
+			}
+
+			if (tMin <= tMax)
+				mask |= (1 << r);
+		}
+
+		return mask;
+#endif
+	}
+
+	int CSIMDUtils::intersectRayPacketTriangle(const f32* const* origin, const f32* const* dir, const f32* const* triangle, int id, f32* t)
+	{
+#if defined(SKYLICHT_SIMD_SSE)
+		const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		__m128 e1x = _mm_set1_ps(triangle[3][id]);
+		__m128 e1y = _mm_set1_ps(triangle[4][id]);
+		__m128 e1z = _mm_set1_ps(triangle[5][id]);
+		__m128 e2x = _mm_set1_ps(triangle[6][id]);
+		__m128 e2y = _mm_set1_ps(triangle[7][id]);
+		__m128 e2z = _mm_set1_ps(triangle[8][id]);
+
+		__m128 dx = _mm_loadu_ps(dir[0]);
+		__m128 dy = _mm_loadu_ps(dir[1]);
+		__m128 dz = _mm_loadu_ps(dir[2]);
+
+		__m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+		__m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+		__m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+
+		__m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+		__m128 mask = _mm_cmpge_ps(_mm_and_ps(det, absMask), _mm_set1_ps(1e-12f));
+		__m128 inv = _mm_div_ps(one, det);
+
+		__m128 sx = _mm_sub_ps(_mm_loadu_ps(origin[0]), _mm_set1_ps(triangle[0][id]));
+		__m128 sy = _mm_sub_ps(_mm_loadu_ps(origin[1]), _mm_set1_ps(triangle[1][id]));
+		__m128 sz = _mm_sub_ps(_mm_loadu_ps(origin[2]), _mm_set1_ps(triangle[2][id]));
+
+		__m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), inv);
+
+		__m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+		__m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+		__m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+
+		__m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), inv);
+		__m128 hit = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inv);
+
+		__m128 current = _mm_loadu_ps(t);
+
+		mask = _mm_and_ps(mask, _mm_cmpge_ps(u, zero));
+		mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+		mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), one));
+		mask = _mm_and_ps(mask, _mm_cmpge_ps(hit, zero));
+		mask = _mm_and_ps(mask, _mm_cmplt_ps(hit, current));
+
+		// t = mask ? hit : t
+		_mm_storeu_ps(t, _mm_or_ps(_mm_and_ps(mask, hit), _mm_andnot_ps(mask, current)));
+
+		return _mm_movemask_ps(mask);
+#else
+		int mask = 0;
+
+		for (int r = 0; r < 4; r++)
+		{
+			f32 o[3] = { origin[0][r], origin[1][r], origin[2][r] };
+			f32 d[3] = { dir[0][r], dir[1][r], dir[2][r] };
+
+			if (intersectRayTriangle(o, d, triangle, id, t[r]))
+				mask |= (1 << r);
+		}
+
+		return mask;
+#endif
+	}
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SKYLICHT_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SKYLICHT_SIMD_NEON
+#endif
+
+namespace Skylicht
+{
+	/// @brief The math kernels for the hot loops of transform, culling and skinning.
+	/// They use SSE2 or NEON when the compiler supports, and fallback to scalar code.
+	class SKYLICHT_API CSIMDUtils
+	{
+	public:
+		/// @brief out = a * b, same as core::matrix4::setbyproduct_nocheck(a, b)
+		static void mulMatrix(core::matrix4& out, const core::matrix4& a, const core::matrix4& b);
+
+		/// @brief out[i] = a[i] * b[i]
+		static void mulMatrices(core::matrix4* out, const core::matrix4* a, const core::matrix4* b, int count);
+
+		/// @brief Transform the box and recalculate the axis aligned box, same as core::matrix4::transformBoxEx
+		static void transformBox(const core::matrix4& m, core::aabbox3df& box);
+
+		/// @brief out[i] = transform box[i] by m[i], box and out can be the same array
+		static void transformBoxes(const core::matrix4* m, const core::aabbox3df* box, core::aabbox3df* out, int count);
+
+		/// @brief Return true if all the edges of box are front of a frustum plane
+		static bool isBoxOutsideFrustum(const scene::SViewFrustum& frustum, const core::aabbox3df& box);
+
+		/// @brief outside[i] is true if the oriented box i is front of a frustum plane.
+		/// The boxes are in SoA layout: center[0..2][i] is the center, halfAxis[0..8][i] is 3 half axis vectors (x, y, z of each axis)
+		static void cullOrientedBoxes(const scene::SViewFrustum& frustum, const f32* const* center, const f32* const* halfAxis, int count, bool* outside);
+
+		/// @brief Intersect the ray (origin + dir * t) with the triangles, both faces, 4 triangles are tested at once.
+		/// The triangles are in SoA layout: triangle[0..2][i] is vertex 0, triangle[3..5][i] is edge 1 (v1 - v0), triangle[6..8][i] is edge 2 (v2 - v0).
+		/// Return the nearest triangle that 0 <= hit < t and update t, or -1 if there is no hit.
+		static int intersectRayTriangles(const core::vector3df& origin, const core::vector3df& dir, const f32* const* triangle, int count, f32& t);
+
+		/// @brief overlap[i] is true if the bbox of the triangle i (SoA layout of intersectRayTriangles) overlaps the box, same as !triangle.isTotalOutsideBox(box)
+		static void overlapBoxTriangles(const core::aabbox3df& box, const f32* const* triangle, int count, bool* overlap);
+
+		/// @brief Intersect a packet of 4 rays with the box, the rays are in SoA layout: origin[0..2][ray], invDir[0..2][ray].
+		/// Return the mask of rays (bit i is ray i) that hit the box in [0, maxT[ray]]
+		static int intersectRayPacketBox(const f32* const* origin, const f32* const* invDir, const f32* maxT, const core::aabbox3df& box);
+
+		/// @brief Intersect a packet of 4 rays with the triangle id (SoA layout of intersectRayTriangles).
+		/// t[ray] is updated if the hit is nearer, return the mask of rays that are updated
+		static int intersectRayPacketTriangle(const f32* const* origin, const f32* const* dir, const f32* const* triangle, int id, f32* t);
+
+		/// @brief out[i] = start[i] + (end[i] - start[i]) * t[i]
+		static void lerpArray(const f32* start, const f32* end, const f32* t, f32* out, int count);
+
+		/// @brief y[i] = the piecewise linear curve at x[i]. The keys are sorted by keyX,
+		/// y is keyY[0] before the first key and keyY[numKey - 1] after the last key.
+		static void evaluateCurve(const f32* keyX, const f32* keyY, int numKey, const f32* x, f32* y, int count);
+
+		/// @brief pos = sum(weight[i] * matrix[i] * srcPos), normal = sum(weight[i] * matrix[i] * srcNormal)
+		static void skinVertex(const float** matrix, const float* weight, int count,
+			const core::vector3df& srcPos,
+			const core::vector3df& srcNormal,
+			core::vector3df& pos,
+			core::vector3df& normal);
+	};
+}
\ No newline at end of file
@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CSoftwareSkinningUtils.h"
+#include "Utils/CSIMDUtils.h"
 
 // #define VERTEX_NORMALIZE
 
@@ -208,61 +209,49 @@ namespace Skylicht
 #ifdef VERTEX_NORMALIZE
 			float length, invLength;
 #endif
+			const float* boneMatrix[4];
+			float boneWeight[4];
+			int numBone;
+
 			// skinning
 			for (int i = 0; i < numVertex; i++)
 			{
-				resultVertex->Pos.X = 0.0f;
-				resultVertex->Pos.Y = 0.0f;
-				resultVertex->Pos.Z = 0.0f;
-
-				resultVertex->Normal.X = 0.0f;
-				resultVertex->Normal.Y = 0.0f;
-				resultVertex->Normal.Z = 0.0f;
+				numBone = 0;
 
 				// bone 0
 				if (vertex->BoneWeight.X > 0.0f)
 				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.X].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.X);
+					boneMatrix[numBone] = arrayJoint[(int)vertex->BoneIndex.X].SkinningMatrix;
+					boneWeight[numBone++] = vertex->BoneWeight.X;
 				}
 
 				// bone 1
 				if (vertex->BoneWeight.Y > 0.0f)
 				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.Y].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.Y);
+					boneMatrix[numBone] = arrayJoint[(int)vertex->BoneIndex.Y].SkinningMatrix;
+					boneWeight[numBone++] = vertex->BoneWeight.Y;
 				}
 
 				// bone 2
 				if (vertex->BoneWeight.Z > 0.0f)
 				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.Z].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.Z);
+					boneMatrix[numBone] = arrayJoint[(int)vertex->BoneIndex.Z].SkinningMatrix;
+					boneWeight[numBone++] = vertex->BoneWeight.Z;
 				}
 
 				// bone 3
 				if (vertex->BoneWeight.W > 0.0f)
 				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.W].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.W);
+					boneMatrix[numBone] = arrayJoint[(int)vertex->BoneIndex.W].SkinningMatrix;
+					boneWeight[numBone++] = vertex->BoneWeight.W;
 				}
 
+				CSIMDUtils::skinVertex(boneMatrix, boneWeight, numBone,
+					vertex->Pos,
+					vertex->Normal,
+					resultVertex->Pos,
+					resultVertex->Normal);
+
 				// apply skin normal
 #ifdef VERTEX_NORMALIZE
 				length = resultVertex->Normal.X * resultVertex->Normal.X +
@@ -304,62 +293,49 @@ namespace Skylicht
 #ifdef VERTEX_NORMALIZE
 			float length, invLength;
 #endif
+			const float* boneMatrix[4];
+			float boneWeight[4];
+			int numBone;
 
 			// skinning
 			for (int i = 0; i < numVertex; i++)
 			{
-				resultVertex->Pos.X = 0.0f;
-				resultVertex->Pos.Y = 0.0f;
-				resultVertex->Pos.Z = 0.0f;
-
-				resultVertex->Normal.X = 0.0f;
-				resultVertex->Normal.Y = 0.0f;
-				resultVertex->Normal.Z = 0.0f;
+				numBone = 0;
 
 				// bone 0
 				if (vertex->BoneWeight.X > 0.0f)
 				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.X].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.X);
+					boneMatrix[numBone] = arrayJoint[(int)vertex->BoneIndex.X].SkinningMatrix;
+					boneWeight[numBone++] = vertex->BoneWeight.X;
 				}
 
 				// bone 1
 				if (vertex->BoneWeight.Y > 0.0f)
 				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.Y].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.Y);
+					boneMatrix[numBone] = arrayJoint[(int)vertex->BoneIndex.Y].SkinningMatrix;
+					boneWeight[numBone++] = vertex->BoneWeight.Y;
 				}
 
 				// bone 2
 				if (vertex->BoneWeight.Z > 0.0f)
 				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.Z].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.Z);
+					boneMatrix[numBone] = arrayJoint[(int)vertex->BoneIndex.Z].SkinningMatrix;
+					boneWeight[numBone++] = vertex->BoneWeight.Z;
 				}
 
 				// bone 3
 				if (vertex->BoneWeight.W > 0.0f)
 				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.W].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.W);
+					boneMatrix[numBone] = arrayJoint[(int)vertex->BoneIndex.W].SkinningMatrix;
+					boneWeight[numBone++] = vertex->BoneWeight.W;
 				}
 
+				CSIMDUtils::skinVertex(boneMatrix, boneWeight, numBone,
+					vertex->Pos,
+					vertex->Normal,
+					resultVertex->Pos,
+					resultVertex->Normal);
+
 				// apply skin normal
 #ifdef VERTEX_NORMALIZE
 				length = resultVertex->Normal.X * resultVertex->Normal.X +
@@ -380,40 +356,6 @@ namespace Skylicht
 		skinnedMesh->setDirty(EBT_VERTEX);
 	}
 
-	float px, py, pz, nx, ny, nz;
-
-	void CSoftwareSkinningUtils::skinVertex(const float* m,
-		core::vector3df& vertex,
-		core::vector3df& normal,
-		const core::vector3df& srcPos,
-		const core::vector3df& srcNormal,
-		const float& weight)
-	{
-		px = srcPos.X * m[0] + srcPos.Y * m[4] + srcPos.Z * m[8] + m[12];
-		py = srcPos.X * m[1] + srcPos.Y * m[5] + srcPos.Z * m[9] + m[13];
-		pz = srcPos.X * m[2] + srcPos.Y * m[6] + srcPos.Z * m[10] + m[14];
-
-		nx = srcNormal.X * m[0] + srcNormal.Y * m[4] + srcNormal.Z * m[8];
-		ny = srcNormal.X * m[1] + srcNormal.Y * m[5] + srcNormal.Z * m[9];
-		nz = srcNormal.X * m[2] + srcNormal.Y * m[6] + srcNormal.Z * m[10];
-
-		px *= weight;
-		py *= weight;
-		pz *= weight;
-
-		nx *= weight;
-		ny *= weight;
-		nz *= weight;
-
-		vertex.X += px;
-		vertex.Y += py;
-		vertex.Z += pz;
-
-		normal.X += nx;
-		normal.Y += ny;
-		normal.Z += nz;
-	}
-
 	void CSoftwareSkinningUtils::softwareBlendShape(CMesh* blendShape, CMesh* originalMesh)
 	{
 		CBlendShape** blendShapeData = originalMesh->BlendShape.pointer();
@@ -0,0 +1,341 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+#include "pch.h"
+#include "CPhysicsBatchQuery.h"
+
+#include "Thread/CJobSystem.h"
+
+#ifdef USE_BULLET_PHYSIC_ENGINE
+#include "Bullet/CBulletUtils.h"
+#include "BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h"
+#include "BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h"
+#include "BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h"
+#endif
+
+namespace Skylicht
+{
+	namespace Physics
+	{
+#ifdef USE_BULLET_PHYSIC_ENGINE
+		// btDbvtBroadphase::rayTest shares one stack (if no BT_THREADSAFE), so the queries walk the btDbvt of the broadphase
+		// with btDbvt::rayTest and btDbvt::collideTV, that use the local stack and can be called in parallel
+
+		struct SQueryRayCallback : public btDbvt::ICollide
+		{
+			btTransform From;
+			btTransform To;
+			btCollisionWorld::RayResultCallback* Result;
+
+			void Process(const btDbvtNode* leaf)
+			{
+				btBroadphaseProxy* proxy = (btBroadphaseProxy*)leaf->data;
+				if (!Result->needsCollision(proxy))
+					return;
+
+				btCollisionObject* object = (btCollisionObject*)proxy->m_clientObject;
+				btCollisionWorld::rayTestSingle(From, To, object, object->getCollisionShape(), object->getWorldTransform(), *Result);
+			}
+		};
+
+		struct SQuerySweepCallback : public btDbvt::ICollide
+		{
+			const btConvexShape* Shape;
+			btTransform From;
+			btTransform To;
+			btCollisionWorld::ConvexResultCallback* Result;
+
+			void Process(const btDbvtNode* leaf)
+			{
+				btBroadphaseProxy* proxy = (btBroadphaseProxy*)leaf->data;
+				if (!Result->needsCollision(proxy))
+					return;
+
+				btCollisionObject* object = (btCollisionObject*)proxy->m_clientObject;
+				btCollisionWorld::objectQuerySingle(Shape, From, To, object, object->getCollisionShape(), object->getWorldTransform(), *Result, 0.0f);
+			}
+		};
+
+		struct SQueryDistanceResult : public btStorageResult
+		{
+			virtual void setShapeIdentifiersA(int partId0, int index0)
+			{
+			}
+
+			virtual void setShapeIdentifiersB(int partId1, int index1)
+			{
+			}
+		};
+
+		struct SQueryOverlapCallback : public btDbvt::ICollide
+		{
+			btSphereShape* Sphere;
+			btTransform Transform;
+			int CollisionGroup;
+			int CollisionMask;
+			core::array<SPhysicsOverlap>* Overlaps;
+
+			void Process(const btDbvtNode* leaf)
+			{
+				btBroadphaseProxy* proxy = (btBroadphaseProxy*)leaf->data;
+
+				// same as btCollisionWorld::ContactResultCallback::needsCollision
+				if ((proxy->m_collisionFilterGroup & CollisionMask) == 0 ||
+					(CollisionGroup & proxy->m_collisionFilterMask) == 0)
+					return;
+
+				btCollisionObject* object = (btCollisionObject*)proxy->m_clientObject;
+				btCollisionShape* shape = object->getCollisionShape();
+
+				// the convex shape is tested by GJK distance, the concave shape is tested by its bbox
+				if (shape->isConvex())
+				{
+					btVoronoiSimplexSolver simplexSolver;
+					btGjkEpaPenetrationDepthSolver penetrationSolver;
+					btGjkPairDetector gjk(Sphere, (btConvexShape*)shape, &simplexSolver, &penetrationSolver);
+
+					btGjkPairDetector::ClosestPointInput input;
+					input.m_transformA = Transform;
+					input.m_transformB = object->getWorldTransform();
+
+					SQueryDistanceResult result;
+					gjk.getClosestPoints(input, result, NULL);
+
+					if (result.m_distance > 0.0f)
+						return;
+				}
+
+				SPhysicsOverlap overlap;
+				overlap.Collider = (CCollider*)shape->getUserPointer();
+				overlap.Body = (CRigidbody*)object->getUserPointer();
+				Overlaps->push_back(overlap);
+			}
+		};
+#endif
+
+		CPhysicsBatchQuery::CPhysicsBatchQuery()
+		{
+
+		}
+
+		CPhysicsBatchQuery::~CPhysicsBatchQuery()
+		{
+
+		}
+
+		u32 CPhysicsBatchQuery::addRayTest(const core::vector3df& from, const core::vector3df& to, int group, int mask)
+		{
+			SPhysicsQuery query;
+			query.Type = SPhysicsQuery::Ray;
+			query.From = from;
+			query.To = to;
+			query.Radius = 0.0f;
+			query.CollisionGroup = group;
+			query.CollisionMask = mask;
+			m_queries.push_back(query);
+			return m_queries.size() - 1;
+		}
+
+		u32 CPhysicsBatchQuery::addSweepTest(const core::vector3df& from, const core::vector3df& to, float radius, int group, int mask)
+		{
+			SPhysicsQuery query;
+			query.Type = SPhysicsQuery::Sweep;
+			query.From = from;
+			query.To = to;
+			query.Radius = radius;
+			query.CollisionGroup = group;
+			query.CollisionMask = mask;
+			m_queries.push_back(query);
+			return m_queries.size() - 1;
+		}
+
+		u32 CPhysicsBatchQuery::addOverlapTest(const core::vector3df& center, float radius, int group, int mask)
+		{
+			SPhysicsQuery query;
+			query.Type = SPhysicsQuery::Overlap;
+			query.From = center;
+			query.To = center;
+			query.Radius = radius;
+			query.CollisionGroup = group;
+			query.CollisionMask = mask;
+			m_queries.push_back(query);
+			return m_queries.size() - 1;
+		}
+
+		void CPhysicsBatchQuery::clear()
+		{
+			m_queries.set_used(0);
+			m_executedQueries.set_used(0);
+			m_results.set_used(0);
+			m_overlaps.set_used(0);
+		}
+
+#ifdef USE_BULLET_PHYSIC_ENGINE
+		void CPhysicsBatchQuery::execute(btCollisionWorld* world)
+		{
+			// the new queries are added to m_queries while the results are read
+			m_executedQueries.swap(m_queries);
+			m_queries.set_used(0);
+
+			u32 count = m_executedQueries.size();
+
+			m_results.set_used(count);
+			// set_used does not construct the nested array
+			while (m_queryOverlaps.size() < count)
+				m_queryOverlaps.push_back(core::array<SPhysicsOverlap>());
+
+			m_overlaps.set_used(0);
+
+			if (count == 0)
+				return;
+
+			SPhysicsQuery* queries = m_executedQueries.pointer();
+			SPhysicsQueryResult* results = m_results.pointer();
+			core::array<SPhysicsOverlap>* queryOverlaps = m_queryOverlaps.pointer();
+
+			System::CJobSystem::getInstance()->parallelFor((int)count, 16, [this, world, queries, results, queryOverlaps](int begin, int end)
+				{
+					for (int i = begin; i < end; i++)
+					{
+						queryOverlaps[i].set_used(0);
+						executeQuery(world, queries[i], results[i], queryOverlaps[i]);
+					}
+				});
+
+			// flat array of overlaps
+			for (u32 i = 0; i < count; i++)
+			{
+				results[i].OverlapOffset = m_overlaps.size();
+				results[i].OverlapCount = queryOverlaps[i].size();
+
+				for (u32 j = 0, n = queryOverlaps[i].size(); j < n; j++)
+					m_overlaps.push_back(queryOverlaps[i][j]);
+			}
+		}
+
+		void CPhysicsBatchQuery::executeQuery(btCollisionWorld* world, const SPhysicsQuery& query, SPhysicsQueryResult& result, core::array<SPhysicsOverlap>& overlaps)
+		{
+			result.Hit = false;
+			result.Collider = NULL;
+			result.Body = NULL;
+			result.HitFraction = 1.0f;
+			result.OverlapOffset = 0;
+			result.OverlapCount = 0;
+
+			// the world is created with btDbvtBroadphase (see CPhysicsEngine::initPhysics)
+			btDbvtBroadphase* broadphase = static_cast<btDbvtBroadphase*>(world->getBroadphase());
+
+			btVector3 from = Bullet::irrVectorToBulletVector(query.From);
+			btVector3 to = Bullet::irrVectorToBulletVector(query.To);
+
+			const btCollisionObject* hitObject = NULL;
+
+			if (query.Type == SPhysicsQuery::Ray)
+			{
+				btCollisionWorld::ClosestRayResultCallback closestResult(from, to);
+				closestResult.m_collisionFilterGroup = query.CollisionGroup;
+				closestResult.m_collisionFilterMask = query.CollisionMask;
+
+				SQueryRayCallback callback;
+				callback.From.setIdentity();
+				callback.From.setOrigin(from);
+				callback.To.setIdentity();
+				callback.To.setOrigin(to);
+				callback.Result = &closestResult;
+
+				for (int i = 0; i < 2; i++)
+					btDbvt::rayTest(broadphase->m_sets[i].m_root, from, to, callback);
+
+				if (closestResult.hasHit())
+				{
+					hitObject = closestResult.m_collisionObject;
+					result.HitFraction = closestResult.m_closestHitFraction;
+					result.HitPointWorld = Bullet::bulletVectorToIrrVector(closestResult.m_hitPointWorld);
+					result.HitNormalWorld = Bullet::bulletVectorToIrrVector(closestResult.m_hitNormalWorld);
+				}
+			}
+			else if (query.Type == SPhysicsQuery::Sweep)
+			{
+				btSphereShape sphere(query.Radius);
+				btCollisionWorld::ClosestConvexResultCallback closestResult(from, to);
+				closestResult.m_collisionFilterGroup = query.CollisionGroup;
+				closestResult.m_collisionFilterMask = query.CollisionMask;
+
+				SQuerySweepCallback callback;
+				callback.Shape = &sphere;
+				callback.From.setIdentity();
+				callback.From.setOrigin(from);
+				callback.To.setIdentity();
+				callback.To.setOrigin(to);
+				callback.Result = &closestResult;
+
+				// bbox of the swept sphere
+				btVector3 radius(query.Radius, query.Radius, query.Radius);
+				btDbvtVolume volume = btDbvtVolume::FromMM(btVector3(btMin(from.x(), to.x()), btMin(from.y(), to.y()), btMin(from.z(), to.z())) - radius,
+					btVector3(btMax(from.x(), to.x()), btMax(from.y(), to.y()), btMax(from.z(), to.z())) + radius);
+
+				for (int i = 0; i < 2; i++)
+					broadphase->m_sets[i].collideTV(broadphase->m_sets[i].m_root, volume, callback);
+
+				if (closestResult.hasHit())
+				{
+					hitObject = closestResult.m_hitCollisionObject;
+					result.HitFraction = closestResult.m_closestHitFraction;
+					result.HitPointWorld = Bullet::bulletVectorToIrrVector(closestResult.m_hitPointWorld);
+					result.HitNormalWorld = Bullet::bulletVectorToIrrVector(closestResult.m_hitNormalWorld);
+				}
+			}
+			else
+			{
+				btSphereShape sphere(query.Radius);
+
+				SQueryOverlapCallback callback;
+				callback.Sphere = &sphere;
+				callback.Transform.setIdentity();
+				callback.Transform.setOrigin(from);
+				callback.CollisionGroup = query.CollisionGroup;
+				callback.CollisionMask = query.CollisionMask;
+				callback.Overlaps = &overlaps;
+
+				btVector3 radius(query.Radius, query.Radius, query.Radius);
+				btDbvtVolume volume = btDbvtVolume::FromMM(from - radius, from + radius);
+
+				for (int i = 0; i < 2; i++)
+					broadphase->m_sets[i].collideTV(broadphase->m_sets[i].m_root, volume, callback);
+
+				result.Hit = overlaps.size() > 0;
+			}
+
+			if (hitObject != NULL)
+			{
+				result.Hit = true;
+				result.Body = (CRigidbody*)hitObject->getUserPointer();
+
+				const btCollisionShape* shape = hitObject->getCollisionShape();
+				if (shape)
+					result.Collider = (CCollider*)shape->getUserPointer();
+			}
+		}
+#endif
+	}
+}
\ No newline at end of file
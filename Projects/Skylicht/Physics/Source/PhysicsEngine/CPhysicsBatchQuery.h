@@ -0,0 +1,154 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+#pragma once
+
+#include "Collider/CCollider.h"
+#include "RigidBody/CRigidbody.h"
+
+#ifdef USE_BULLET_PHYSIC_ENGINE
+#include <btBulletCollisionCommon.h>
+#endif
+
+namespace Skylicht
+{
+	namespace Physics
+	{
+		struct SPhysicsQuery
+		{
+			enum EQueryType
+			{
+				Ray,
+				Sweep,
+				Overlap,
+			};
+
+			EQueryType Type;
+
+			core::vector3df From;
+			core::vector3df To;
+
+			// sphere radius of the sweep and overlap
+			float Radius;
+
+			// the collision filter, same as the group and mask of btBroadphaseProxy
+			int CollisionGroup;
+			int CollisionMask;
+		};
+
+		struct SPhysicsQueryResult
+		{
+			bool Hit;
+
+			// the closest hit of the ray and sweep
+			CCollider* Collider;
+			CRigidbody* Body;
+			float HitFraction;
+			core::vector3df HitPointWorld;
+			core::vector3df HitNormalWorld;
+
+			// the overlaps are [OverlapOffset, OverlapOffset + OverlapCount) in CPhysicsBatchQuery::getOverlaps
+			u32 OverlapOffset;
+			u32 OverlapCount;
+		};
+
+		struct SPhysicsOverlap
+		{
+			CCollider* Collider;
+			CRigidbody* Body;
+		};
+
+		/// @brief Batch of ray, sphere sweep and sphere overlap queries.
+		/// The queries that are added in the frame are executed in parallel by CPhysicsEngine::updatePhysics after stepSimulation,
+		/// the result i is the result of the query id i, and they are valid until the next updatePhysics
+		class CPhysicsBatchQuery
+		{
+		protected:
+			core::array<SPhysicsQuery> m_queries;
+
+			core::array<SPhysicsQuery> m_executedQueries;
+
+			core::array<SPhysicsQueryResult> m_results;
+
+			core::array<SPhysicsOverlap> m_overlaps;
+
+			core::array<core::array<SPhysicsOverlap>> m_queryOverlaps;
+
+		public:
+			CPhysicsBatchQuery();
+
+			virtual ~CPhysicsBatchQuery();
+
+			/// @brief Add the closest ray test, return the query id.
+			/// The bodies are filtered by group and mask as Bullet does, the default is btBroadphaseProxy::DefaultFilter and AllFilter.
+			u32 addRayTest(const core::vector3df& from, const core::vector3df& to, int group = 1, int mask = -1);
+
+			/// @brief Add the closest sphere sweep test, return the query id
+			u32 addSweepTest(const core::vector3df& from, const core::vector3df& to, float radius, int group = 1, int mask = -1);
+
+			/// @brief Add the sphere overlap test, return the query id
+			u32 addOverlapTest(const core::vector3df& center, float radius, int group = 1, int mask = -1);
+
+			inline u32 getQueryCount()
+			{
+				return m_queries.size();
+			}
+
+			inline u32 getResultCount()
+			{
+				return m_results.size();
+			}
+
+			inline const SPhysicsQuery* getExecutedQueries()
+			{
+				return m_executedQueries.const_pointer();
+			}
+
+			inline const SPhysicsQueryResult* getResults()
+			{
+				return m_results.const_pointer();
+			}
+
+			inline const SPhysicsOverlap* getOverlaps()
+			{
+				return m_overlaps.const_pointer();
+			}
+
+			inline u32 getOverlapCount()
+			{
+				return m_overlaps.size();
+			}
+
+			void clear();
+
+#ifdef USE_BULLET_PHYSIC_ENGINE
+			/// @brief Execute the added queries on the job system, the world must not be changed while it runs
+			void execute(btCollisionWorld* world);
+
+		protected:
+
+			void executeQuery(btCollisionWorld* world, const SPhysicsQuery& query, SPhysicsQueryResult& result, core::array<SPhysicsOverlap>& overlaps);
+#endif
+		};
+	}
+}
\ No newline at end of file
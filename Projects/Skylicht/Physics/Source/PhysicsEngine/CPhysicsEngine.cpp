@@ -87,6 +87,8 @@ namespace Skylicht
 
 		void CPhysicsEngine::exitPhysics()
 		{
+			m_batchQuery.clear();
+
 #ifdef USE_BULLET_PHYSIC_ENGINE
 			if (m_dynamicsWorld)
 			{
@@ -163,6 +165,8 @@ namespace Skylicht
 				syncTransforms();
 
 				checkCollision();
+
+				m_batchQuery.execute(m_dynamicsWorld);
 			}
 #endif
 		}
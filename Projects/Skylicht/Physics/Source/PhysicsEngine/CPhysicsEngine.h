@@ -27,6 +27,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Utils/CSingleton.h"
 #include "Transform/CTransformMatrix.h"
 #include "CPhysicsRaycast.h"
+#include "CPhysicsBatchQuery.h"
 
 #ifdef USE_BULLET_PHYSIC_ENGINE
 #include <btBulletCollisionCommon.h>
@@ -66,6 +67,8 @@ namespace Skylicht
 
 			core::array<SRigidbodyData*> m_bodies;
 
+			CPhysicsBatchQuery m_batchQuery;
+
 		public:
 			CPhysicsEngine();
 
@@ -90,6 +93,12 @@ namespace Skylicht
 
 			bool rayTest(const core::vector3df& from, const core::vector3df& to, SClosestRaycastResult& result);
 
+			/// @brief The queries are added in the frame and executed in parallel after stepSimulation on the next updatePhysics
+			inline CPhysicsBatchQuery* getBatchQuery()
+			{
+				return &m_batchQuery;
+			}
+
 		private:
 
 #ifdef USE_BULLET_PHYSIC_ENGINE
@@ -0,0 +1,270 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+
+#include "stdafx.h"
+#include "CJobSystem.h"
+
+namespace Skylicht
+{
+	namespace System
+	{
+		// the worker id of current thread, -1 is the thread that is not a worker (main thread)
+		static thread_local int s_workerID = -1;
+
+		CJobSystem* CJobSystem::s_instance = NULL;
+
+		CJobSystem::CWorker::CWorker(CJobSystem* jobSystem, int id) :
+			JobSystem(jobSystem),
+			ID(id),
+			Thread(NULL),
+			IdleLoop(0)
+		{
+			Lock = IMutex::createMutex();
+		}
+
+		CJobSystem::CWorker::~CWorker()
+		{
+			delete Lock;
+		}
+
+		void CJobSystem::CWorker::runThread()
+		{
+			s_workerID = ID;
+			JobSystem->m_started++;
+		}
+
+		void CJobSystem::CWorker::updateThread()
+		{
+			if (JobSystem->m_quit)
+			{
+				IThread::sleep(1);
+				return;
+			}
+
+			if (JobSystem->executeJob(ID))
+			{
+				IdleLoop = 0;
+				return;
+			}
+
+			// yield for a while, then sleep until have new job
+			if (IdleLoop < 64)
+			{
+				IdleLoop++;
+				IThread::sleep(0);
+			}
+			else
+			{
+				IThread::sleep(1);
+			}
+		}
+
+		CJobSystem::CJobSystem(int numWorker) :
+			m_pending(0),
+			m_started(0),
+			m_next(0),
+			m_quit(false)
+		{
+			for (int i = 0; i < numWorker; i++)
+			{
+				CWorker* worker = new CWorker(this, i);
+				worker->Thread = IThread::createThread(worker);
+				if (worker->Thread == NULL)
+				{
+					// the platform is not support thread
+					delete worker;
+					break;
+				}
+				m_workers.push_back(worker);
+			}
+
+			// wait all workers started, that we can stop them safely
+			int numStarted = (int)m_workers.size();
+			while (m_started.load() < numStarted)
+				IThread::sleep(0);
+		}
+
+		CJobSystem::~CJobSystem()
+		{
+			// finish all jobs
+			while (executeJob(-1))
+			{
+			}
+
+			m_quit = true;
+
+			for (CWorker* worker : m_workers)
+			{
+				worker->Thread->stop();
+				delete worker->Thread;
+				delete worker;
+			}
+			m_workers.clear();
+		}
+
+		int CJobSystem::getDefaultNumWorker()
+		{
+			int n = IThread::getNumCore() - 1;
+			return n > 0 ? n : 0;
+		}
+
+		CJobSystem* CJobSystem::getInstance()
+		{
+			if (s_instance == NULL)
+				s_instance = new CJobSystem(getDefaultNumWorker());
+			return s_instance;
+		}
+
+		void CJobSystem::releaseInstance()
+		{
+			if (s_instance != NULL)
+			{
+				delete s_instance;
+				s_instance = NULL;
+			}
+		}
+
+		void CJobSystem::run(const std::function<void()>& job, CJobGroup* group)
+		{
+			if (m_workers.size() == 0)
+			{
+				// no thread, just run serial
+				job();
+				return;
+			}
+
+			if (group)
+				group->m_count++;
+
+			// push to the queue of this worker, or round robin from the main thread
+			int id = s_workerID;
+			if (id < 0)
+				id = (int)(m_next++ % (unsigned int)m_workers.size());
+
+			CWorker* worker = m_workers[id];
+			{
+				SScopeMutex lock(worker->Lock);
+				worker->Jobs.push_back({ job, group });
+			}
+
+			m_pending++;
+		}
+
+		void CJobSystem::wait(CJobGroup* group)
+		{
+			// help the workers instead of sleep
+			while (!group->isDone())
+			{
+				if (!executeJob(s_workerID))
+					IThread::sleep(0);
+			}
+		}
+
+		void CJobSystem::parallelFor(int count, int batchSize, const std::function<void(int, int)>& job)
+		{
+			if (count <= 0)
+				return;
+
+			if (batchSize <= 0)
+				batchSize = 1;
+
+			if (m_workers.size() == 0 || count <= batchSize)
+			{
+				job(0, count);
+				return;
+			}
+
+			CJobGroup group;
+
+			for (int begin = batchSize; begin < count; begin += batchSize)
+			{
+				int end = begin + batchSize;
+				if (end > count)
+					end = count;
+
+				run([&job, begin, end]() { job(begin, end); }, &group);
+			}
+
+			// the calling thread run the first batch
+			job(0, batchSize);
+
+			wait(&group);
+		}
+
+		bool CJobSystem::popJob(int workerID, SJob& job)
+		{
+			int numWorker = (int)m_workers.size();
+			if (numWorker == 0 || m_pending.load() == 0)
+				return false;
+
+			// pop from the back of own queue
+			if (workerID >= 0)
+			{
+				CWorker* worker = m_workers[workerID];
+
+				SScopeMutex lock(worker->Lock);
+				if (worker->Jobs.size() > 0)
+				{
+					job = worker->Jobs.back();
+					worker->Jobs.pop_back();
+					return true;
+				}
+			}
+
+			// steal from the front of other queues
+			int start = workerID >= 0 ? workerID + 1 : 0;
+			for (int i = 0; i < numWorker; i++)
+			{
+				CWorker* worker = m_workers[(start + i) % numWorker];
+
+				SScopeMutex lock(worker->Lock);
+				if (worker->Jobs.size() > 0)
+				{
+					job = worker->Jobs.front();
+					worker->Jobs.pop_front();
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		bool CJobSystem::executeJob(int workerID)
+		{
+			SJob job;
+			if (!popJob(workerID, job))
+				return false;
+
+			m_pending--;
+
+			job.Function();
+
+			if (job.Group)
+				job.Group->m_count--;
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,138 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+
+#pragma once
+
+#include "stdafx.h"
+#include "IThread.h"
+#include "IMutex.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+
+namespace Skylicht
+{
+	namespace System
+	{
+		class CJobSystem;
+
+		/// @brief Count the jobs that are running, use CJobSystem::wait to wait all jobs in the group.
+		class SYSTEM_SHARED_API CJobGroup
+		{
+			friend class CJobSystem;
+
+		protected:
+			std::atomic<int> m_count;
+
+		public:
+			CJobGroup() :
+				m_count(0)
+			{
+			}
+
+			inline bool isDone()
+			{
+				return m_count.load() == 0;
+			}
+		};
+
+		/// @brief Work stealing job system.
+		/// Each worker thread have a job queue, the idle worker (and the thread that is waiting a group) steals the job from the other queues.
+		/// If the platform is not support thread (emscripten), the jobs run serial on the calling thread.
+		class SYSTEM_SHARED_API CJobSystem
+		{
+		public:
+			struct SJob
+			{
+				std::function<void()> Function;
+				CJobGroup* Group;
+			};
+
+		protected:
+			class CWorker : public IThreadCallback
+			{
+			public:
+				CJobSystem* JobSystem;
+				int ID;
+				IThread* Thread;
+
+				std::deque<SJob> Jobs;
+				IMutex* Lock;
+
+				// the number of loops that have no job
+				int IdleLoop;
+
+			public:
+				CWorker(CJobSystem* jobSystem, int id);
+
+				virtual ~CWorker();
+
+				virtual void runThread();
+
+				virtual void updateThread();
+			};
+
+			std::vector<CWorker*> m_workers;
+
+			std::atomic<int> m_pending;
+			std::atomic<int> m_started;
+			std::atomic<unsigned int> m_next;
+
+			std::atomic<bool> m_quit;
+
+			static CJobSystem* s_instance;
+
+		public:
+			CJobSystem(int numWorker);
+
+			virtual ~CJobSystem();
+
+			static CJobSystem* getInstance();
+
+			static void releaseInstance();
+
+			static int getDefaultNumWorker();
+
+			inline int getNumWorker()
+			{
+				return (int)m_workers.size();
+			}
+
+			void run(const std::function<void()>& job, CJobGroup* group);
+
+			void wait(CJobGroup* group);
+
+			/// @brief Split [0, count) to the batches and run them on worker threads, then wait all batches done.
+			void parallelFor(int count, int batchSize, const std::function<void(int, int)>& job);
+
+		protected:
+
+			bool executeJob(int workerID);
+
+			bool popJob(int workerID, SJob& job);
+		};
+	}
+}
@@ -81,6 +81,8 @@ namespace Skylicht
 			static void sleep(unsigned int time);
 			
 			static float getTime();
+
+			static int getNumCore();
 			
 			static IThread* createThread(IThreadCallback* callback);
 		};
@@ -34,11 +34,10 @@ https://github.com/skylicht-lab/skylicht-engine
 #endif
 
 
+#include <thread>
+
 #if defined(_WIN32)
 #include <Windows.h>
-#ifdef WINDOWS_STORE
-#include <thread>
-#endif
 #elif defined(EMSCRIPTEN)
 #include <sys/time.h>
 #else		
@@ -98,6 +97,16 @@ namespace Skylicht
 	#endif
 		}
 		
+		int IThread::getNumCore()
+		{
+	#if defined(EMSCRIPTEN)
+			return 1;
+	#else
+			int n = (int)std::thread::hardware_concurrency();
+			return n > 0 ? n : 1;
+	#endif
+		}
+		
 		IThread* IThread::createThread(IThreadCallback* callback)
 		{
 	#if defined(USE_PTHREAD)
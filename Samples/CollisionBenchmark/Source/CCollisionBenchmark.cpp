@@ -0,0 +1,214 @@
+#include "pch.h"
+#include "SkylichtEngine.h"
+#include "CCollisionBenchmark.h"
+
+#include <chrono>
+
+// number of frames that the ray queries are measured
+#define BENCHMARK_FRAMES 100
+
+void installApplication(const std::vector<std::string>& argv)
+{
+	CCollisionBenchmark* demo = new CCollisionBenchmark();
+	getApplication()->registerAppEvent("CCollisionBenchmark", demo);
+}
+
+CCollisionBenchmark::CCollisionBenchmark() :
+	m_scene(NULL),
+	m_guiCamera(NULL),
+	m_font(NULL),
+	m_textInfo(NULL),
+	m_frame(0),
+	m_octreeTime(0.0f),
+	m_bvhTime(0.0f),
+	m_packetTime(0.0f)
+{
+
+}
+
+CCollisionBenchmark::~CCollisionBenchmark()
+{
+	delete m_scene;
+	delete m_font;
+}
+
+void CCollisionBenchmark::onInitApp()
+{
+	// init application
+	CBaseApp* app = getApplication();
+
+	// Show console
+	app->showDebugConsole();
+
+	// Load "BuiltIn.zip" to read files inside it
+	app->getFileSystem()->addFileArchive(app->getBuiltInPath("BuiltIn.zip"), false, false);
+
+	// init segoeuil.ttf inside BuiltIn.zip
+	CGlyphFreetype* freetypeFont = CGlyphFreetype::getInstance();
+	freetypeFont->initFont("Segoe UI Light", "BuiltIn/Fonts/segoeui/segoeuil.ttf");
+
+	// Load basic shader
+	CShaderManager* shaderMgr = CShaderManager::getInstance();
+	shaderMgr->initBasicShader();
+
+	// Create a Scene
+	m_scene = new CScene();
+
+	// Create a Zone in Scene
+	CZone* zone = m_scene->createZone();
+
+	// Create 2D camera
+	CGameObject* guiCameraObject = zone->createEmptyObject();
+	m_guiCamera = guiCameraObject->addComponent<CCamera>();
+	m_guiCamera->setProjectionType(CCamera::OrthoUI);
+
+	m_font = new CGlyphFont();
+	m_font->setFont("Segoe UI Light", 25);
+
+	// Create 2D Canvas
+	CGameObject* canvasObject = zone->createEmptyObject();
+	CCanvas* canvas = canvasObject->addComponent<CCanvas>();
+
+	m_textInfo = canvas->createText(m_font);
+	m_textInfo->setDock(EGUIDock::DockFill);
+	m_textInfo->setTextAlign(EGUIHorizontalAlign::Left, EGUIVerticalAlign::Top);
+
+	// The random triangles, 4 nodes of 5000 triangles
+	srand(0);
+	initCollision(&m_octree, 4, 5000);
+	srand(0);
+	initCollision(&m_bvh, 4, 5000);
+
+	m_octree.build();
+	m_bvh.build();
+
+	initRays(1000);
+}
+
+void CCollisionBenchmark::initCollision(CCollisionBuilder* builder, int numNode, int numTriangle)
+{
+	for (int i = 0; i < numNode; i++)
+	{
+		CCollisionNode* node = new CCollisionNode(NULL, NULL, NULL);
+
+		for (int j = 0; j < numTriangle; j++)
+		{
+			core::vector3df a((f32)(rand() % 10000) * 0.01f, (f32)(rand() % 10000) * 0.01f, (f32)(rand() % 10000) * 0.01f);
+			core::vector3df b(a.X + (f32)(rand() % 100) * 0.01f, a.Y + (f32)(rand() % 100) * 0.01f, a.Z);
+			core::vector3df c(a.X, a.Y + (f32)(rand() % 100) * 0.01f, a.Z + (f32)(rand() % 100) * 0.01f);
+			node->Triangles.push_back(core::triangle3df(a, b, c));
+		}
+
+		builder->addCollision(node);
+	}
+}
+
+void CCollisionBenchmark::initRays(int numRay)
+{
+	for (int i = 0; i < numRay; i++)
+	{
+		core::vector3df start((f32)(rand() % 100), (f32)(rand() % 100), (f32)(rand() % 100));
+		core::vector3df end((f32)(rand() % 100), (f32)(rand() % 100), (f32)(rand() % 100));
+		m_rays.push_back(core::line3df(start, end));
+	}
+
+	m_hits.set_used(numRay);
+}
+
+void CCollisionBenchmark::onUpdate()
+{
+	// update application
+	m_scene->update();
+}
+
+void CCollisionBenchmark::onRender()
+{
+	int numRay = (int)m_rays.size();
+
+	f32 d;
+	core::vector3df p;
+	core::triangle3df t;
+	CCollisionNode* n = NULL;
+
+	// octree, a ray per query
+	auto begin = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < numRay; i++)
+	{
+		d = m_rays[i].getLengthSQ();
+		m_octree.getCollisionPoint(m_rays[i], d, p, t, n);
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	m_octreeTime += std::chrono::duration<float, std::milli>(end - begin).count();
+
+	// bvh, a ray per query
+	begin = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < numRay; i++)
+	{
+		d = m_rays[i].getLengthSQ();
+		m_bvh.getCollisionPoint(m_rays[i], d, p, t, n);
+	}
+	end = std::chrono::high_resolution_clock::now();
+	m_bvhTime += std::chrono::duration<float, std::milli>(end - begin).count();
+
+	// bvh, all rays in one query
+	begin = std::chrono::high_resolution_clock::now();
+	m_bvh.getCollisionPoints(m_rays.pointer(), numRay, m_hits.pointer());
+	end = std::chrono::high_resolution_clock::now();
+	m_packetTime += std::chrono::duration<float, std::milli>(end - begin).count();
+
+	m_frame++;
+
+	if (m_frame % BENCHMARK_FRAMES == 0)
+	{
+		char info[512];
+		sprintf(info, "%d triangles, %d rays: octree %.3f ms, bvh %.3f ms, bvh packet %.3f ms",
+			m_bvh.getPolyCount(),
+			numRay,
+			m_octreeTime / BENCHMARK_FRAMES,
+			m_bvhTime / BENCHMARK_FRAMES,
+			m_packetTime / BENCHMARK_FRAMES);
+
+		os::Printer::log(info);
+		m_textInfo->setText(info);
+
+		m_octreeTime = 0.0f;
+		m_bvhTime = 0.0f;
+		m_packetTime = 0.0f;
+	}
+
+	CGraphics2D::getInstance()->render(m_guiCamera);
+}
+
+void CCollisionBenchmark::onPostRender()
+{
+	// post render application
+}
+
+bool CCollisionBenchmark::onBack()
+{
+	// on back key press
+	// return TRUE will run default by OS (Mobile)
+	// return FALSE will cancel BACK FUNCTION by OS (Mobile)
+	return true;
+}
+
+void CCollisionBenchmark::onResize(int w, int h)
+{
+
+}
+
+void CCollisionBenchmark::onResume()
+{
+	// resume application
+}
+
+void CCollisionBenchmark::onPause()
+{
+	// pause application
+}
+
+void CCollisionBenchmark::onQuitApp()
+{
+	// end application
+	delete this;
+}
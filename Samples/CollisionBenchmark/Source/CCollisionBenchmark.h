@@ -0,0 +1,56 @@
+#pragma once
+
+#include "IApplicationEventReceiver.h"
+
+#include "Collision/COctreeBuilder.h"
+#include "Collision/CBVHBuilder.h"
+
+class CCollisionBenchmark : public IApplicationEventReceiver
+{
+private:
+	CScene* m_scene;
+	CCamera* m_guiCamera;
+
+	CGlyphFont* m_font;
+	CGUIText* m_textInfo;
+
+	// the same triangles on both builders
+	COctreeBuilder m_octree;
+	CBVHBuilder m_bvh;
+
+	core::array<core::line3df> m_rays;
+	core::array<SCollisionHit> m_hits;
+
+	int m_frame;
+	float m_octreeTime;
+	float m_bvhTime;
+	float m_packetTime;
+
+public:
+	CCollisionBenchmark();
+	virtual ~CCollisionBenchmark();
+
+	virtual void onUpdate();
+
+	virtual void onRender();
+
+	virtual void onPostRender();
+
+	virtual void onResume();
+
+	virtual void onPause();
+
+	virtual bool onBack();
+
+	virtual void onResize(int w, int h);
+
+	virtual void onInitApp();
+
+	virtual void onQuitApp();
+
+protected:
+
+	void initCollision(CCollisionBuilder* builder, int numNode, int numTriangle);
+
+	void initRays(int numRay);
+};
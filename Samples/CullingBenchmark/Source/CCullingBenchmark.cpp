@@ -0,0 +1,289 @@
+#include "pch.h"
+#include "SkylichtEngine.h"
+#include "CCullingBenchmark.h"
+
+#include "Culling/CCullingSystem.h"
+#include "Culling/CCullingBBoxData.h"
+
+#include <chrono>
+
+// number of frames that the culling is measured before switch the method
+#define BENCHMARK_FRAMES 200
+
+void installApplication(const std::vector<std::string>& argv)
+{
+	CCullingBenchmark* demo = new CCullingBenchmark();
+	getApplication()->registerAppEvent("CCullingBenchmark", demo);
+}
+
+CCullingBenchmark::CCullingBenchmark() :
+	m_scene(NULL),
+	m_camera(NULL),
+	m_guiCamera(NULL),
+	m_forwardRP(NULL),
+	m_font(NULL),
+	m_textInfo(NULL),
+	m_frame(0),
+	m_numObject(0),
+	m_numVisible(0),
+	m_cullingTime(0.0f)
+{
+
+}
+
+CCullingBenchmark::~CCullingBenchmark()
+{
+	delete m_scene;
+	delete m_forwardRP;
+	delete m_font;
+}
+
+void CCullingBenchmark::onInitApp()
+{
+	// init application
+	CBaseApp* app = getApplication();
+
+	// Show console
+	app->showDebugConsole();
+
+	// Load "BuiltIn.zip" to read files inside it
+	app->getFileSystem()->addFileArchive(app->getBuiltInPath("BuiltIn.zip"), false, false);
+
+	// init segoeuil.ttf inside BuiltIn.zip
+	CGlyphFreetype* freetypeFont = CGlyphFreetype::getInstance();
+	freetypeFont->initFont("Segoe UI Light", "BuiltIn/Fonts/segoeui/segoeuil.ttf");
+
+	// Load basic shader
+	CShaderManager* shaderMgr = CShaderManager::getInstance();
+	shaderMgr->initBasicShader();
+
+	// Create a Scene
+	m_scene = new CScene();
+
+	// Create a Zone in Scene
+	CZone* zone = m_scene->createZone();
+
+	// Create 3D camera
+	CGameObject* cameraObject = zone->createEmptyObject();
+	m_camera = cameraObject->addComponent<CCamera>();
+	m_camera->setPosition(core::vector3df(0.0f, 10.0f, 0.0f));
+	m_camera->lookAt(core::vector3df(100.0f, 0.0f, 100.0f), core::vector3df(0.0f, 1.0f, 0.0f));
+
+	// Create 2D camera
+	CGameObject* guiCameraObject = zone->createEmptyObject();
+	m_guiCamera = guiCameraObject->addComponent<CCamera>();
+	m_guiCamera->setProjectionType(CCamera::OrthoUI);
+
+	m_font = new CGlyphFont();
+	m_font->setFont("Segoe UI Light", 25);
+
+	// Create 2D Canvas
+	CGameObject* canvasObject = zone->createEmptyObject();
+	CCanvas* canvas = canvasObject->addComponent<CCanvas>();
+
+	m_textInfo = canvas->createText(m_font);
+	m_textInfo->setDock(EGUIDock::DockFill);
+	m_textInfo->setTextAlign(EGUIHorizontalAlign::Left, EGUIVerticalAlign::Top);
+
+	// Render pipeline
+	m_forwardRP = new CForwardRP();
+	m_forwardRP->initRender(app->getWidth(), app->getHeight());
+
+	// The objects that only have bounding box
+	initObjects(m_scene->getEntityManager(), 200, 4.0f);
+
+	// The light spheres for the cluster benchmark
+	initLights(10000);
+}
+
+void CCullingBenchmark::initObjects(CEntityManager* entityManager, int numObjectInRow, float space)
+{
+	core::aabbox3df box(core::vector3df(-0.5f, 0.0f, -0.5f), core::vector3df(0.5f, 2.0f, 0.5f));
+
+	int n = numObjectInRow / 2;
+	for (int x = -n; x < n; x++)
+	{
+		for (int z = -n; z < n; z++)
+		{
+			CEntity* entity = entityManager->createEntity();
+
+			CWorldTransformData* transform = entity->addData<CWorldTransformData>();
+			transform->Relative.setTranslation(core::vector3df(x * space, 0.0f, z * space));
+
+			entity->addData<CCullingData>();
+
+			CCullingBBoxData* bbox = entity->addData<CCullingBBoxData>();
+			bbox->BBox = box;
+
+			// 1% of objects are moving
+			if (m_numObject % 100 == 0)
+				m_movingObjects.push_back(transform);
+
+			m_numObject++;
+		}
+	}
+}
+
+void CCullingBenchmark::initLights(int numLight)
+{
+	srand(0);
+	for (int i = 0; i < numLight; i++)
+	{
+		m_lightPosition.push_back(core::vector3df((f32)(rand() % 400) - 200.0f, (f32)(rand() % 20), (f32)(rand() % 400) - 200.0f));
+		m_lightRadius.push_back(1.0f + (f32)(rand() % 10));
+	}
+}
+
+void CCullingBenchmark::benchmarkLightCluster()
+{
+	const core::matrix4& view = m_camera->getViewMatrix();
+	const core::matrix4& proj = m_camera->getProjectionMatrix();
+	f32 nearValue = m_camera->getNearValue();
+	f32 farValue = m_camera->getFarValue();
+
+	for (u32 numLight = 1000; numLight <= m_lightPosition.size(); numLight *= 10)
+	{
+		int numLoop = 10;
+
+		auto begin = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < numLoop; i++)
+			m_lightCluster.build(view, proj, nearValue, farValue, m_lightPosition.pointer(), m_lightRadius.pointer(), numLight, true);
+
+		auto end = std::chrono::high_resolution_clock::now();
+		float ms = std::chrono::duration<float, std::milli>(end - begin).count() / numLoop;
+
+		char info[512];
+		sprintf(info, "Light cluster: %d lights, %.3f ms, %d light indices",
+			numLight,
+			ms,
+			m_lightCluster.getLightIndex().size());
+
+		os::Printer::log(info);
+	}
+}
+
+void CCullingBenchmark::onUpdate()
+{
+	float t = m_frame * 0.01f;
+
+	// rotate the camera
+	core::vector3df target(cosf(t) * 100.0f, 0.0f, sinf(t) * 100.0f);
+	m_camera->lookAt(target, core::vector3df(0.0f, 1.0f, 0.0f));
+
+	// move the dynamic objects
+	for (u32 i = 0, n = m_movingObjects.size(); i < n; i++)
+	{
+		CWorldTransformData* transform = m_movingObjects[i];
+
+		core::vector3df pos = transform->Relative.getTranslation();
+		pos.Y = sinf(t + i) * 5.0f;
+
+		transform->Relative.setTranslation(pos);
+		transform->HasChanged = true;
+	}
+
+	// update application
+	m_scene->update();
+
+	// the scene is not rendered by pipeline, so update the entities here
+	m_scene->getEntityManager()->update();
+}
+
+void CCullingBenchmark::onRender()
+{
+	CEntityManager* entityManager = m_scene->getEntityManager();
+	entityManager->setCamera(m_camera);
+	entityManager->setRenderPipeline(m_forwardRP);
+
+	CCullingSystem* cullingSystem = entityManager->getSystem<CCullingSystem>();
+
+	// switch between linear test and bvh query
+	bool useBVH = (m_frame / BENCHMARK_FRAMES) % 2 == 1;
+	cullingSystem->enableBVH(useBVH);
+
+	cullingSystem->beginQuery(entityManager);
+	cullingSystem->onQuery(entityManager, NULL, 0);
+
+	auto begin = std::chrono::high_resolution_clock::now();
+
+	cullingSystem->update(entityManager);
+
+	auto end = std::chrono::high_resolution_clock::now();
+	m_cullingTime += std::chrono::duration<float, std::milli>(end - begin).count();
+
+	m_frame++;
+
+	if (m_frame % BENCHMARK_FRAMES == 0)
+	{
+		// count the visible objects of last frame
+		m_numVisible = 0;
+
+		CEntity** entities = entityManager->getEntities();
+		int numEntity = entityManager->getNumEntities();
+		for (int i = 0; i < numEntity; i++)
+		{
+			if (!entities[i]->isAlive())
+				continue;
+
+			CCullingData* culling = entities[i]->getData<CCullingData>();
+			if (culling != NULL && culling->Visible)
+				m_numVisible++;
+		}
+
+		float avgTime = m_cullingTime / BENCHMARK_FRAMES;
+		float objectsPerMs = avgTime > 0.0f ? m_numObject / avgTime : 0.0f;
+
+		char info[512];
+		sprintf(info, "%s: %d objects, %d visible, %.3f ms, %.1f culled objects/ms",
+			useBVH ? "BVH" : "Linear",
+			m_numObject,
+			m_numVisible,
+			avgTime,
+			objectsPerMs);
+
+		os::Printer::log(info);
+		m_textInfo->setText(info);
+
+		m_cullingTime = 0.0f;
+
+		benchmarkLightCluster();
+	}
+
+	CGraphics2D::getInstance()->render(m_guiCamera);
+}
+
+void CCullingBenchmark::onPostRender()
+{
+	// post render application
+}
+
+bool CCullingBenchmark::onBack()
+{
+	// on back key press
+	// return TRUE will run default by OS (Mobile)
+	// return FALSE will cancel BACK FUNCTION by OS (Mobile)
+	return true;
+}
+
+void CCullingBenchmark::onResize(int w, int h)
+{
+	if (m_forwardRP != NULL)
+		m_forwardRP->resize(w, h);
+}
+
+void CCullingBenchmark::onResume()
+{
+	// resume application
+}
+
+void CCullingBenchmark::onPause()
+{
+	// pause application
+}
+
+void CCullingBenchmark::onQuitApp()
+{
+	// end application
+	delete this;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "IApplicationEventReceiver.h"
+#include "Lighting/CLightCluster.h"
+
+class CCullingBenchmark : public IApplicationEventReceiver
+{
+private:
+	CScene* m_scene;
+	CCamera* m_camera;
+	CCamera* m_guiCamera;
+
+	CForwardRP* m_forwardRP;
+
+	CGlyphFont* m_font;
+	CGUIText* m_textInfo;
+
+	core::array<CWorldTransformData*> m_movingObjects;
+
+	// the light spheres, that bin to the clusters of the camera
+	CLightCluster m_lightCluster;
+	core::array<core::vector3df> m_lightPosition;
+	core::array<f32> m_lightRadius;
+
+	int m_frame;
+	int m_numObject;
+	int m_numVisible;
+	float m_cullingTime;
+
+public:
+	CCullingBenchmark();
+	virtual ~CCullingBenchmark();
+
+	virtual void onUpdate();
+
+	virtual void onRender();
+
+	virtual void onPostRender();
+
+	virtual void onResume();
+
+	virtual void onPause();
+
+	virtual bool onBack();
+
+	virtual void onResize(int w, int h);
+
+	virtual void onInitApp();
+
+	virtual void onQuitApp();
+
+protected:
+
+	void initObjects(CEntityManager* entityManager, int numObjectInRow, float space);
+
+	void initLights(int numLight);
+
+	void benchmarkLightCluster();
+};
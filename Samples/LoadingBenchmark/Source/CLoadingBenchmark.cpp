@@ -0,0 +1,232 @@
+#include "pch.h"
+#include "SkylichtEngine.h"
+#include "CLoadingBenchmark.h"
+
+#include "Importer/Skylicht/CSkylichtMeshLoader.h"
+#include "Exporter/Skylicht/CSkylichtMeshExporter.h"
+#include "Scene/CSceneExporter.h"
+#include "Scene/CSceneImporter.h"
+
+#include <chrono>
+
+// number of loads that are measured per file
+#define BENCHMARK_LOADS 5
+
+void installApplication(const std::vector<std::string>& argv)
+{
+	CLoadingBenchmark* demo = new CLoadingBenchmark();
+	getApplication()->registerAppEvent("CLoadingBenchmark", demo);
+}
+
+CLoadingBenchmark::CLoadingBenchmark() :
+	m_scene(NULL),
+	m_guiCamera(NULL),
+	m_font(NULL),
+	m_textInfo(NULL)
+{
+
+}
+
+CLoadingBenchmark::~CLoadingBenchmark()
+{
+	delete m_scene;
+	delete m_font;
+}
+
+void CLoadingBenchmark::onInitApp()
+{
+	// init application
+	CBaseApp* app = getApplication();
+
+	// Show console
+	app->showDebugConsole();
+
+	// Load "BuiltIn.zip" to read files inside it
+	app->getFileSystem()->addFileArchive(app->getBuiltInPath("BuiltIn.zip"), false, false);
+
+	// The models that are measured
+	app->getFileSystem()->addFileArchive(app->getBuiltInPath("Sponza.zip"), false, false);
+	app->getFileSystem()->addFileArchive(app->getBuiltInPath("SampleModels.zip"), false, false);
+
+	// init segoeuil.ttf inside BuiltIn.zip
+	CGlyphFreetype* freetypeFont = CGlyphFreetype::getInstance();
+	freetypeFont->initFont("Segoe UI Light", "BuiltIn/Fonts/segoeui/segoeuil.ttf");
+
+	// Load basic shader
+	CShaderManager* shaderMgr = CShaderManager::getInstance();
+	shaderMgr->initBasicShader();
+
+	// Create a Scene
+	m_scene = new CScene();
+
+	// Create a Zone in Scene
+	CZone* zone = m_scene->createZone();
+
+	// Create 2D camera
+	CGameObject* guiCameraObject = zone->createEmptyObject();
+	m_guiCamera = guiCameraObject->addComponent<CCamera>();
+	m_guiCamera->setProjectionType(CCamera::OrthoUI);
+
+	m_font = new CGlyphFont();
+	m_font->setFont("Segoe UI Light", 25);
+
+	// Create 2D Canvas
+	CGameObject* canvasObject = zone->createEmptyObject();
+	CCanvas* canvas = canvasObject->addComponent<CCanvas>();
+
+	m_textInfo = canvas->createText(m_font);
+	m_textInfo->setDock(EGUIDock::DockFill);
+	m_textInfo->setTextAlign(EGUIHorizontalAlign::Left, EGUIVerticalAlign::Top);
+
+	// The model version 1 in the archive and the packed model on the disk
+	benchmarkModel("Sponza/Sponza.smesh");
+	benchmarkModel("SampleModels/Gazebo/gazebo.smesh");
+
+	// The xml scene and the binary scene
+	benchmarkScene(10, 100);
+
+	m_textInfo->setText(m_info.c_str());
+}
+
+double CLoadingBenchmark::benchmarkLoadModel(const char* path, int count)
+{
+	auto begin = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < count; i++)
+	{
+		CEntityPrefab prefab;
+		CSkylichtMeshLoader loader;
+		loader.loadModel(path, &prefab, false, false, false, false);
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double, std::milli>(end - begin).count() / count;
+}
+
+void CLoadingBenchmark::benchmarkModel(const char* path)
+{
+	const char* packFile = "LoadingBenchmark.smesh";
+
+	CSkylichtMeshExporter exporter;
+	if (!exporter.convertModel(path, packFile))
+	{
+		char info[512];
+		sprintf(info, "%s: can not convert to the packed model", path);
+		addInfo(info);
+		return;
+	}
+
+	double v1Ms = benchmarkLoadModel(path, BENCHMARK_LOADS);
+	double packMs = benchmarkLoadModel(packFile, BENCHMARK_LOADS);
+
+	char info[512];
+	sprintf(info, "%s: version 1 %.3f ms, pack %.3f ms", path, v1Ms, packMs);
+	addInfo(info);
+
+	remove(packFile);
+}
+
+double CLoadingBenchmark::benchmarkLoadScene(const char* path, int count)
+{
+	auto begin = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < count; i++)
+	{
+		CScene scene;
+		if (CSceneImporter::beginImportScene(&scene, path))
+		{
+			while (!CSceneImporter::updateLoadScene())
+			{
+			}
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double, std::milli>(end - begin).count() / count;
+}
+
+void CLoadingBenchmark::benchmarkScene(int numContainer, int numObject)
+{
+	const char* xmlFile = "LoadingBenchmarkXML.scene";
+	const char* binaryFile = "LoadingBenchmarkBinary.scene";
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+
+	for (int i = 0; i < numContainer; i++)
+	{
+		CContainerObject* container = zone->createContainerObject();
+		container->getTransformEuler()->setPosition(core::vector3df((f32)i, 0.0f, 0.0f));
+
+		for (int j = 0; j < numObject; j++)
+		{
+			CGameObject* object = container->createEmptyObject();
+			object->getTransformEuler()->setPosition(core::vector3df((f32)i, (f32)j, 0.0f));
+		}
+	}
+
+	scene->updateAddRemoveObject();
+
+	CSceneExporter::exportScene(scene, xmlFile);
+	CSceneExporter::exportSceneBinary(scene, binaryFile);
+	delete scene;
+
+	double xmlMs = benchmarkLoadScene(xmlFile, BENCHMARK_LOADS);
+	double binaryMs = benchmarkLoadScene(binaryFile, BENCHMARK_LOADS);
+
+	char info[512];
+	sprintf(info, "scene %d objects: xml %.3f ms, binary %.3f ms", 1 + numContainer + numContainer * numObject, xmlMs, binaryMs);
+	addInfo(info);
+
+	remove(xmlFile);
+	remove(binaryFile);
+}
+
+void CLoadingBenchmark::addInfo(const char* info)
+{
+	os::Printer::log(info);
+
+	m_info += info;
+	m_info += "\n";
+}
+
+void CLoadingBenchmark::onUpdate()
+{
+	// update application
+	m_scene->update();
+}
+
+void CLoadingBenchmark::onRender()
+{
+	CGraphics2D::getInstance()->render(m_guiCamera);
+}
+
+void CLoadingBenchmark::onPostRender()
+{
+	// post render application
+}
+
+bool CLoadingBenchmark::onBack()
+{
+	// on back key press
+	// return TRUE will run default by OS (Mobile)
+	// return FALSE will cancel BACK FUNCTION by OS (Mobile)
+	return true;
+}
+
+void CLoadingBenchmark::onResize(int w, int h)
+{
+
+}
+
+void CLoadingBenchmark::onResume()
+{
+	// resume application
+}
+
+void CLoadingBenchmark::onPause()
+{
+	// pause application
+}
+
+void CLoadingBenchmark::onQuitApp()
+{
+	// end application
+	delete this;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "IApplicationEventReceiver.h"
+
+class CLoadingBenchmark : public IApplicationEventReceiver
+{
+private:
+	CScene* m_scene;
+	CCamera* m_guiCamera;
+
+	CGlyphFont* m_font;
+	CGUIText* m_textInfo;
+
+	std::string m_info;
+
+public:
+	CLoadingBenchmark();
+	virtual ~CLoadingBenchmark();
+
+	virtual void onUpdate();
+
+	virtual void onRender();
+
+	virtual void onPostRender();
+
+	virtual void onResume();
+
+	virtual void onPause();
+
+	virtual bool onBack();
+
+	virtual void onResize(int w, int h);
+
+	virtual void onInitApp();
+
+	virtual void onQuitApp();
+
+protected:
+
+	double benchmarkLoadModel(const char* path, int count);
+
+	void benchmarkModel(const char* path);
+
+	double benchmarkLoadScene(const char* path, int count);
+
+	void benchmarkScene(int numContainer, int numObject);
+
+	void addInfo(const char* info);
+};
@@ -1,9 +1,21 @@
 #include "CApp.h"
 #include "TestCoreUtils.h"
+#include "TestSIMDUtils.h"
+#include "TestCulling.h"
+#include "TestAnimation.h"
+#include "TestParticle.h"
+#include "TestMeshRenderer.h"
+#include "TestLighting.h"
+#include "TestCollision.h"
+#include "TestMeshLoader.h"
+#include "TestFileSystem.h"
 #include "TestSystemThread.h"
 #include "TestScene.h"
 #include "TestMemoryStream.h"
 #include "TestSpreadsheet.h"
+#include "TestEntityManager.h"
+#include "TestPhysics.h"
+#include "TestTexture.h"
 
 #include "CApplication.h"
 #include "Material/Shader/CShaderManager.h"
@@ -50,13 +62,45 @@ void CApp::onInitApp()
 	// Run unit test
 	testCoreUtils();
 
+	testSIMDUtils();
+
+	testCullingBVH();
+
+	testAnimationCompress();
+
+	testParticleGroup();
+
+	testParticleRendererUpdate();
+
+	testDrawCommandSort();
+
+	testAutoInstancingLighting();
+
+	testLightCluster();
+
+	testCollisionBVH();
+
+	testCollisionDynamic();
+
+	testMeshPack();
+
+	testFileSystemPathCache();
+
 	testMemoryStream();
 
 	testSystemThread();
 
+	testJobSystem();
+
 	testScene();
 
 	testSpreadsheet();
+
+	testEntityManager();
+
+	testTextureStreaming();
+
+	testPhysics();
 }
 
 void CApp::onUpdate()
@@ -0,0 +1,87 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestAnimation.h"
+
+#include "Animation/CAnimationTrack.h"
+
+using namespace Skylicht;
+
+void testAnimationCompress()
+{
+	TEST_CASE("CAnimationTrack cursor");
+
+	CAnimationData data;
+	for (int i = 0; i <= 120; i++)
+	{
+		f32 t = i / 30.0f;
+
+		CPositionKey pos;
+		pos.Frame = t;
+		pos.Value = core::vector3df(t * 2.0f, 1.0f, 0.0f);
+		data.Positions.Data.push_back(pos);
+
+		CRotationKey rot;
+		rot.Frame = t;
+		rot.Value.fromAngleAxis(t, core::vector3df(0.0f, 1.0f, 0.0f));
+		data.Rotations.Data.push_back(rot);
+	}
+
+	int cursor = 0;
+	bool pass = true;
+	for (int i = 0; i < 500; i++)
+	{
+		// increasing frame, then jump
+		f32 frame = (i % 100) * 0.041f;
+		if (data.Positions.getIndex(frame, cursor) != data.Positions.getIndex(frame))
+			pass = false;
+	}
+	TEST_ASSERT_THROW(pass);
+	TEST_ASSERT_THROW(data.Positions.getIndex(10.0f, cursor) == -1);
+
+
+	TEST_CASE("CAnimationData::compress");
+
+	// sample before compress
+	CAnimationTrack track;
+	track.setAnimationData(&data);
+
+	core::array<core::vector3df> refPosition;
+	core::array<core::quaternion> refRotation;
+	core::vector3df position, scale;
+	core::quaternion rotation;
+
+	for (int i = 0; i < 100; i++)
+	{
+		track.getFrameData(i * 0.04f, position, scale, rotation);
+		refPosition.push_back(position);
+		refRotation.push_back(rotation);
+	}
+
+	data.compress(0.001f, 0.001f, 0.001f, true);
+	track.setAnimationData(&data);
+
+	TEST_ASSERT_THROW(data.isQuantizedRotation());
+	TEST_ASSERT_THROW(data.Rotations.size() == 0);
+	// the linear keys are reduced, a key is kept each MaxReduceKeySpan keys
+	TEST_ASSERT_THROW(data.Positions.size() <= 6);
+	TEST_ASSERT_THROW(data.getNumRotationKey() < 20);
+	TEST_ASSERT_FLOAT_EQUAL(data.getLastFrame(), 4.0f);
+
+	f32 maxPosError = 0.0f;
+	f32 maxRotError = 0.0f;
+	for (int i = 0; i < 100; i++)
+	{
+		track.getFrameData(i * 0.04f, position, scale, rotation);
+		maxPosError = core::max_(maxPosError, position.getDistanceFrom(refPosition[i]));
+
+		// compare the rotated vectors
+		core::quaternion ref = refRotation[i];
+		rotation.normalize();
+		ref.normalize();
+		core::vector3df v1 = rotation * core::vector3df(1.0f, 0.0f, 0.0f);
+		core::vector3df v2 = ref * core::vector3df(1.0f, 0.0f, 0.0f);
+		maxRotError = core::max_(maxRotError, v1.getDistanceFrom(v2));
+	}
+	TEST_ASSERT_THROW(maxPosError < 0.001f);
+	TEST_ASSERT_THROW(maxRotError < 0.002f);
+}
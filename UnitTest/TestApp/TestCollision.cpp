@@ -0,0 +1,216 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestCollision.h"
+
+#include "Collision/COctreeBuilder.h"
+#include "Collision/CBVHBuilder.h"
+#include "Collision/CDynamicBVHBuilder.h"
+
+using namespace Skylicht;
+
+void addRandomCollision(CCollisionBuilder* builder, int numNode, int numTriangle)
+{
+	for (int i = 0; i < numNode; i++)
+	{
+		CCollisionNode* node = new CCollisionNode(NULL, NULL, NULL);
+
+		for (int j = 0; j < numTriangle; j++)
+		{
+			core::vector3df a((f32)(rand() % 10000) * 0.01f, (f32)(rand() % 10000) * 0.01f, (f32)(rand() % 10000) * 0.01f);
+			core::vector3df b(a.X + (f32)(rand() % 100) * 0.01f, a.Y + (f32)(rand() % 100) * 0.01f, a.Z);
+			core::vector3df c(a.X, a.Y + (f32)(rand() % 100) * 0.01f, a.Z + (f32)(rand() % 100) * 0.01f);
+			node->Triangles.push_back(core::triangle3df(a, b, c));
+		}
+
+		builder->addCollision(node);
+	}
+}
+
+void testCollisionBVH()
+{
+	TEST_CASE("CBVHBuilder");
+
+	// the same triangles on both builders
+	COctreeBuilder octree;
+	CBVHBuilder bvh;
+
+	srand(0);
+	addRandomCollision(&octree, 4, 5000);
+	srand(0);
+	addRandomCollision(&bvh, 4, 5000);
+
+	octree.build();
+	bvh.build();
+
+	TEST_ASSERT_THROW(bvh.getPolyCount() == 20000);
+	TEST_ASSERT_THROW(bvh.getNodeCount() > 0 && bvh.getNodeCount() < 40000);
+
+	const int numRay = 1000;
+	core::array<core::line3df> rays;
+	for (int i = 0; i < numRay; i++)
+	{
+		core::vector3df start((f32)(rand() % 100), (f32)(rand() % 100), (f32)(rand() % 100));
+		core::vector3df end((f32)(rand() % 100), (f32)(rand() % 100), (f32)(rand() % 100));
+		rays.push_back(core::line3df(start, end));
+	}
+
+	core::array<SCollisionHit> hits;
+	hits.set_used(numRay);
+	bvh.getCollisionPoints(rays.pointer(), numRay, hits.pointer());
+
+	int numHit = 0;
+	int numMismatch = 0;
+	int numPacketMismatch = 0;
+
+	for (int i = 0; i < numRay; i++)
+	{
+		f32 d1 = rays[i].getLengthSQ();
+		f32 d2 = d1;
+		core::vector3df p1, p2;
+		core::triangle3df t1, t2;
+		CCollisionNode* n1 = NULL;
+		CCollisionNode* n2 = NULL;
+
+		bool hit1 = octree.getCollisionPoint(rays[i], d1, p1, t1, n1);
+		bool hit2 = bvh.getCollisionPoint(rays[i], d2, p2, t2, n2);
+
+		if (hit1 != hit2 || (hit1 && fabsf(sqrtf(d1) - sqrtf(d2)) > 0.01f))
+			numMismatch++;
+
+		if (hits[i].Hit != hit2 || (hit2 && (hits[i].Node != n2 || fabsf(hits[i].DistanceSquared - d2) > 0.01f)))
+			numPacketMismatch++;
+
+		if (hit2)
+			numHit++;
+	}
+
+	TEST_ASSERT_THROW(numHit > 0);
+	TEST_ASSERT_THROW(numMismatch == 0);
+	TEST_ASSERT_THROW(numPacketMismatch == 0);
+
+	// box query
+	int numBoxMismatch = 0;
+	for (int i = 0; i < 100; i++)
+	{
+		core::vector3df p((f32)(rand() % 100), (f32)(rand() % 100), (f32)(rand() % 100));
+		core::aabbox3df box(p - core::vector3df(5.0f, 5.0f, 5.0f), p + core::vector3df(5.0f, 5.0f, 5.0f));
+
+		core::array<core::triangle3df*> result1, result2;
+		core::array<CCollisionNode*> nodes1, nodes2;
+
+		octree.getTriangles(box, result1, nodes1);
+		bvh.getTriangles(box, result2, nodes2);
+
+		if (result1.size() != result2.size() || nodes2.size() != result2.size())
+			numBoxMismatch++;
+	}
+	TEST_ASSERT_THROW(numBoxMismatch == 0);
+
+	// empty
+	CBVHBuilder empty;
+	empty.build();
+
+	f32 d = rays[0].getLengthSQ();
+	core::vector3df p;
+	core::triangle3df t;
+	CCollisionNode* n = NULL;
+	TEST_ASSERT_THROW(empty.getCollisionPoint(rays[0], d, p, t, n) == false);
+}
+
+CCollisionNode* createQuadCollision()
+{
+	// quad [-1, 1] on XY plane
+	CCollisionNode* node = new CCollisionNode(NULL, NULL, NULL);
+	node->Triangles.push_back(core::triangle3df(core::vector3df(-1.0f, -1.0f, 0.0f), core::vector3df(1.0f, -1.0f, 0.0f), core::vector3df(1.0f, 1.0f, 0.0f)));
+	node->Triangles.push_back(core::triangle3df(core::vector3df(-1.0f, -1.0f, 0.0f), core::vector3df(1.0f, 1.0f, 0.0f), core::vector3df(-1.0f, 1.0f, 0.0f)));
+	return node;
+}
+
+void testCollisionDynamic()
+{
+	TEST_CASE("CDynamicBVHBuilder");
+
+	CDynamicBVHBuilder dynamic;
+
+	CCollisionNode* door = createQuadCollision();
+	dynamic.addCollision(door);
+	dynamic.build();
+
+	TEST_ASSERT_THROW(dynamic.getDynamicCount() == 1);
+
+	core::line3df ray(core::vector3df(0.0f, 0.0f, -5.0f), core::vector3df(0.0f, 0.0f, 20.0f));
+	f32 d = 0.0f;
+	core::vector3df p;
+	core::triangle3df t;
+	CCollisionNode* n = NULL;
+
+	// move the door without rebuild
+	core::matrix4 world;
+	world.setTranslation(core::vector3df(0.0f, 0.0f, 10.0f));
+	TEST_ASSERT_THROW(dynamic.setTransform(door, world));
+
+	d = ray.getLengthSQ();
+	TEST_ASSERT_THROW(dynamic.getCollisionPoint(ray, d, p, t, n));
+	TEST_ASSERT_THROW(n == door && core::equals(p.Z, 10.0f, 0.001f) && core::equals(d, 225.0f, 0.01f));
+
+	world.setTranslation(core::vector3df(0.0f, 0.0f, 5.0f));
+	dynamic.setTransform(door, world);
+
+	d = ray.getLengthSQ();
+	TEST_ASSERT_THROW(dynamic.getCollisionPoint(ray, d, p, t, n));
+	TEST_ASSERT_THROW(core::equals(p.Z, 5.0f, 0.001f) && core::equals(t.pointA.Z, 5.0f, 0.001f));
+
+	// the nearer hit is kept
+	d = 4.0f;
+	TEST_ASSERT_THROW(dynamic.getCollisionPoint(ray, d, p, t, n) == false);
+
+	// scale
+	world.makeIdentity();
+	world.setScale(core::vector3df(2.0f, 2.0f, 2.0f));
+	dynamic.setTransform(door, world);
+
+	core::line3df sideRay(core::vector3df(1.5f, 0.0f, -5.0f), core::vector3df(1.5f, 0.0f, 5.0f));
+	d = sideRay.getLengthSQ();
+	TEST_ASSERT_THROW(dynamic.getCollisionPoint(sideRay, d, p, t, n));
+	TEST_ASSERT_THROW(core::equals(d, 25.0f, 0.01f));
+
+	// move away
+	world.makeIdentity();
+	world.setTranslation(core::vector3df(100.0f, 0.0f, 0.0f));
+	dynamic.setTransform(door, world);
+
+	d = ray.getLengthSQ();
+	TEST_ASSERT_THROW(dynamic.getCollisionPoint(ray, d, p, t, n) == false);
+
+	core::array<core::triangle3df*> triangles;
+	core::array<CCollisionNode*> nodes;
+	dynamic.getTriangles(core::aabbox3df(core::vector3df(99.0f, -0.5f, -0.5f), core::vector3df(101.0f, 0.5f, 0.5f)), triangles, nodes);
+	TEST_ASSERT_THROW(triangles.size() == 2 && nodes.size() == 2);
+	TEST_ASSERT_THROW(triangles.size() == 2 && core::equals(triangles[0]->pointA.X, 99.0f, 0.001f));
+
+	triangles.set_used(0);
+	nodes.set_used(0);
+	dynamic.getTriangles(core::aabbox3df(core::vector3df(-1.0f, -1.0f, -1.0f), core::vector3df(1.0f, 1.0f, 1.0f)), triangles, nodes);
+	TEST_ASSERT_THROW(triangles.size() == 0);
+
+	// add a node, the door keeps its transform
+	CCollisionNode* wall = createQuadCollision();
+	dynamic.addCollision(wall);
+	dynamic.build();
+	TEST_ASSERT_THROW(dynamic.getDynamicCount() == 2);
+
+	d = ray.getLengthSQ();
+	TEST_ASSERT_THROW(dynamic.getCollisionPoint(ray, d, p, t, n));
+	TEST_ASSERT_THROW(n == wall && core::equals(p.Z, 0.0f, 0.001f));
+
+	// the removed node is skipped before the build
+	dynamic.removeCollision(&wall, 1);
+	d = ray.getLengthSQ();
+	TEST_ASSERT_THROW(dynamic.getCollisionPoint(ray, d, p, t, n) == false);
+
+	dynamic.build();
+	TEST_ASSERT_THROW(dynamic.getDynamicCount() == 1);
+
+	// entity is null
+	TEST_ASSERT_THROW(dynamic.update() == 0);
+}
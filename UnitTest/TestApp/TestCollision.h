@@ -0,0 +1,5 @@
+#pragma once
+
+void testCollisionBVH();
+
+void testCollisionDynamic();
@@ -1,3 +1,4 @@
+#include "pch.h"
 #include "Base.hh"
 #include "TestCoreUtils.h"
 
@@ -347,6 +348,7 @@ void testStringImp()
 	TEST_ASSERT_STRING_EQUAL(stringTest, "Skylicht__Technology");
 }
 
+// the zip of one stored (uncompressed) file, CZipReader only needs the local file header
 void testCoreUtils()
 {
 	testStringImp();
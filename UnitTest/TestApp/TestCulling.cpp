@@ -0,0 +1,105 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestCulling.h"
+
+#include "Culling/CCullingBVH.h"
+#include "Utils/CSIMDUtils.h"
+
+using namespace Skylicht;
+
+void testCullingBVH()
+{
+	TEST_CASE("CCullingBVH");
+
+	CCullingBVH bvh;
+	core::array<core::aabbox3df> boxes;
+	core::array<s32> proxies;
+
+	srand(0);
+	for (int i = 0; i < 1000; i++)
+	{
+		core::vector3df p((f32)(rand() % 400) - 200.0f, (f32)(rand() % 20), (f32)(rand() % 400) - 200.0f);
+		boxes.push_back(core::aabbox3df(p - core::vector3df(1.0f, 1.0f, 1.0f), p + core::vector3df(1.0f, 1.0f, 1.0f)));
+		proxies.push_back(bvh.createProxy(boxes[i], i));
+	}
+
+	// move and remove some boxes
+	for (int i = 0; i < 1000; i += 3)
+	{
+		core::vector3df offset((f32)(rand() % 40) - 20.0f, 0.0f, (f32)(rand() % 40) - 20.0f);
+		boxes[i].MinEdge += offset;
+		boxes[i].MaxEdge += offset;
+		bvh.moveProxy(proxies[i], boxes[i]);
+	}
+
+	for (int i = 1; i < 1000; i += 7)
+	{
+		bvh.destroyProxy(proxies[i]);
+		proxies[i] = -1;
+	}
+
+	TEST_ASSERT_THROW(bvh.getProxyCount() == 1000 - 143);
+	TEST_ASSERT_THROW(bvh.getHeight() < 32);
+
+	// the query must contain all the boxes that brute force test found
+	core::matrix4 proj, view;
+	proj.buildProjectionMatrixPerspectiveFovLH(core::PI / 3.0f, 1.0f, 1.0f, 100.0f);
+	view.buildCameraLookAtMatrixLH(core::vector3df(0.0f, 5.0f, 0.0f), core::vector3df(1.0f, 5.0f, 1.0f), core::vector3df(0.0f, 1.0f, 0.0f));
+
+	scene::SViewFrustum frustum;
+	frustum.setFrom(proj * view);
+
+	core::array<s32> result;
+	bvh.queryFrustum(frustum, result);
+
+	core::array<bool> inResult;
+	inResult.set_used(1000);
+	for (int i = 0; i < 1000; i++)
+		inResult[i] = false;
+	for (u32 i = 0; i < result.size(); i++)
+		inResult[result[i]] = true;
+
+	int numVisible = 0;
+	bool pass = true;
+	for (int i = 0; i < 1000; i++)
+	{
+		if (proxies[i] == -1)
+		{
+			if (inResult[i])
+				pass = false;
+			continue;
+		}
+
+		if (!CSIMDUtils::isBoxOutsideFrustum(frustum, boxes[i]))
+		{
+			numVisible++;
+			if (!inResult[i])
+				pass = false;
+		}
+		else if (inResult[i] && CSIMDUtils::isBoxOutsideFrustum(frustum, bvh.getFatBox(proxies[i])))
+		{
+			pass = false;
+		}
+	}
+	TEST_ASSERT_THROW(pass);
+	TEST_ASSERT_THROW(numVisible > 0);
+	TEST_ASSERT_THROW((int)result.size() < bvh.getProxyCount());
+
+	// query box
+	core::aabbox3df queryBox(core::vector3df(-50.0f, 0.0f, -50.0f), core::vector3df(50.0f, 20.0f, 50.0f));
+	result.set_used(0);
+	bvh.queryBox(queryBox, result);
+
+	for (int i = 0; i < 1000; i++)
+		inResult[i] = false;
+	for (u32 i = 0; i < result.size(); i++)
+		inResult[result[i]] = true;
+
+	pass = true;
+	for (int i = 0; i < 1000; i++)
+	{
+		if (proxies[i] != -1 && boxes[i].intersectsWithBox(queryBox) && !inResult[i])
+			pass = false;
+	}
+	TEST_ASSERT_THROW(pass);
+}
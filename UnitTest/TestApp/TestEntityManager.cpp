@@ -0,0 +1,692 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestEntityManager.h"
+
+#include "Entity/CEntityManager.h"
+#include "Transform/CWorldTransformData.h"
+#include "Transform/CWorldInverseTransformData.h"
+#include "Transform/CWorldTransformSystem.h"
+#include "Culling/CCullingSystem.h"
+#include "Culling/CVisibleData.h"
+#include "Culling/CCullingBBoxData.h"
+#include "Lighting/CLightCullingSystem.h"
+#include "Utils/CSIMDUtils.h"
+#include "RenderPipeline/CForwardRP.h"
+#include "Scene/CScene.h"
+#include "Animation/CAnimationController.h"
+#include "Animation/CAnimationSystem.h"
+#include "ReflectionProbe/CReflectionProbeSystem.h"
+#include "IndirectLighting/CIndirectLightingSystem.h"
+#include "Material/Shader/Instancing/IShaderInstancing.h"
+#include "RenderMesh/CRenderMeshData.h"
+#include "RenderMesh/CMeshRenderer.h"
+#include "MeshManager/CMeshManager.h"
+
+using namespace Skylicht;
+
+void testEntityDataStorage()
+{
+	TEST_CASE("Entity data storage");
+
+	CEntityManager* entityMgr = new CEntityManager();
+	entityMgr->enableDataStorage(true);
+	TEST_ASSERT_THROW(entityMgr->getDataStorage() != NULL);
+
+	core::array<CEntity*> entities;
+	entityMgr->createEntity(2000, entities);
+
+	for (u32 i = 0, n = entities.size(); i < n; i++)
+	{
+		CWorldTransformData* transform = entities[i]->addData<CWorldTransformData>();
+		transform->Relative.setTranslation(core::vector3df((f32)i, 0.0f, 0.0f));
+	}
+
+	CEntityDataPool* pool = entityMgr->getDataStorage()->getPool(DATA_TYPE_INDEX(CWorldTransformData));
+	TEST_ASSERT_THROW(pool != NULL);
+	TEST_ASSERT_THROW(pool->getUsedCount() == 2000);
+
+	// the data of entities is contiguous in the chunk
+	u8* data0 = (u8*)GET_ENTITY_DATA(entities[0], CWorldTransformData);
+	u8* data1 = (u8*)GET_ENTITY_DATA(entities[1], CWorldTransformData);
+	TEST_ASSERT_THROW(data1 - data0 == (int)pool->getStride());
+	TEST_ASSERT_THROW(data0 == pool->getChunk(0));
+
+	// the released slot is reused
+	entityMgr->removeEntity(entities[1]);
+	TEST_ASSERT_THROW(pool->getUsedCount() == 1999);
+
+	CEntity* entity = entityMgr->createEntity();
+	CWorldTransformData* transform = entity->addData<CWorldTransformData>();
+	TEST_ASSERT_THROW((u8*)transform == data1);
+	TEST_ASSERT_THROW(pool->getUsedCount() == 2000);
+
+	entityMgr->update();
+
+	// the inverse transform system loops the data in the chunk
+	core::array<CEntity*> inverseEntities;
+	entityMgr->createEntity(1000, inverseEntities);
+
+	for (u32 i = 0, n = inverseEntities.size(); i < n; i++)
+	{
+		inverseEntities[i]->addData<CVisibleData>();
+		inverseEntities[i]->addData<CWorldTransformData>()->Relative.setTranslation(core::vector3df(0.0f, (f32)i, 0.0f));
+		inverseEntities[i]->addData<CWorldInverseTransformData>();
+	}
+
+	CEntityDataPool* inversePool = entityMgr->getDataStorage()->getPool(DATA_TYPE_INDEX(CWorldInverseTransformData));
+	TEST_ASSERT_THROW(inversePool != NULL);
+
+	entityMgr->removeEntity(inverseEntities[5]);
+	TEST_ASSERT_THROW(!inversePool->isAlive(5));
+	TEST_ASSERT_THROW(inversePool->isAlive(6));
+	TEST_ASSERT_THROW(inversePool->getSlotCount() == 1000);
+
+	entityMgr->update();
+
+	for (u32 i = 0, n = inverseEntities.size(); i < n; i++)
+	{
+		if (i == 5)
+			continue;
+
+		CWorldInverseTransformData* worldInv = GET_ENTITY_DATA(inverseEntities[i], CWorldInverseTransformData);
+		TEST_ASSERT_THROW(worldInv == inversePool->getData<CWorldInverseTransformData>(i));
+		TEST_ASSERT_THROW(core::equals(worldInv->WorldInverse.getTranslation().Y, -(f32)i));
+	}
+
+	delete entityMgr;
+}
+
+class CTestNoDataSystem : public IEntitySystem
+{
+public:
+	CTestNoDataSystem(bool declare = true)
+	{
+		if (declare)
+			declareNoDataAccess();
+	}
+
+	virtual void beginQuery(CEntityManager* entityManager) {}
+
+	virtual void onQuery(CEntityManager* entityManager, CEntity** entities, int count) {}
+
+	virtual void init(CEntityManager* entityManager) {}
+
+	virtual void update(CEntityManager* entityManager) {}
+};
+
+void testMultiThreadUpdate()
+{
+	TEST_CASE("Entity manager multithread update");
+
+	CEntityManager* entityMgr = new CEntityManager();
+	entityMgr->enableMultiThreadUpdate(true);
+
+	core::array<CEntity*> entities;
+	entityMgr->createEntity(1000, entities);
+
+	for (u32 i = 0, n = entities.size(); i < n; i++)
+		entities[i]->addData<CWorldTransformData>();
+
+	entityMgr->update();
+
+	// 11 core update systems, the independent systems are grouped in the same stage
+	TEST_ASSERT_THROW(entityMgr->getNumUpdateStage() > 0);
+	TEST_ASSERT_THROW(entityMgr->getNumUpdateStage() < 11);
+
+	// both systems write CIndirectLightingData
+	CReflectionProbeSystem* reflectionSystem = entityMgr->getSystem<CReflectionProbeSystem>();
+	CIndirectLightingSystem* indirectSystem = entityMgr->getSystem<CIndirectLightingSystem>();
+	TEST_ASSERT_THROW(reflectionSystem->isConflictDataAccess(indirectSystem));
+
+	// the system that declares no data runs with any declared system
+	CTestNoDataSystem noDataSystem;
+	TEST_ASSERT_THROW(!noDataSystem.isConflictDataAccess(reflectionSystem));
+
+	// the undeclared system is always in conflict
+	CTestNoDataSystem undeclaredSystem(false);
+	TEST_ASSERT_THROW(undeclaredSystem.isConflictDataAccess(&noDataSystem));
+
+	delete entityMgr;
+}
+
+void testIncrementalSort()
+{
+	TEST_CASE("Entity manager incremental sort");
+
+	CEntityManager* entityMgr = new CEntityManager();
+
+	core::array<CEntity*> entities;
+	entityMgr->createEntity(1000, entities);
+
+	for (u32 i = 0, n = entities.size(); i < n; i++)
+	{
+		entities[i]->addData<CWorldTransformData>();
+		entities[i]->addData<CWorldInverseTransformData>();
+	}
+
+	const u32 type[] = GET_LIST_ENTITY_DATA(CWorldInverseTransformData);
+	CEntityGroup* group = entityMgr->createGroupFromVisible(type, 1);
+
+	entityMgr->update();
+	TEST_ASSERT_THROW(group->getEntityCount() == 1000);
+
+	u32 fullSortCount = entityMgr->getFullSortCount();
+	u32 incrementalSortCount = entityMgr->getIncrementalSortCount();
+
+	// spawn the child and remove some entities
+	CEntity* child = entityMgr->createEntity();
+	child->addData<CWorldInverseTransformData>();
+	child->addData<CWorldTransformData>()->ParentIndex = entities[10]->getIndex();
+
+	entityMgr->removeEntity(entities[0]);
+	entityMgr->removeEntity(entities[1]);
+	entities[2]->removeData<CWorldInverseTransformData>();
+
+	entityMgr->update();
+
+	TEST_ASSERT_THROW(entityMgr->getFullSortCount() == fullSortCount);
+	TEST_ASSERT_THROW(entityMgr->getIncrementalSortCount() == incrementalSortCount + 1);
+
+	TEST_ASSERT_THROW(group->getEntityCount() == 998);
+	TEST_ASSERT_THROW(group->contains(child));
+	TEST_ASSERT_THROW(!group->contains(entities[0]));
+	TEST_ASSERT_THROW(!group->contains(entities[2]));
+	TEST_ASSERT_THROW(GET_ENTITY_DATA(child, CWorldTransformData)->Depth == 1);
+
+	// the parent is updated before the child
+	CEntity** groupEntities = group->getEntities();
+	int parentPos = -1, childPos = -1;
+	for (int i = 0, n = group->getEntityCount(); i < n; i++)
+	{
+		if (groupEntities[i] == entities[10])
+			parentPos = i;
+		else if (groupEntities[i] == child)
+			childPos = i;
+	}
+	TEST_ASSERT_THROW(parentPos >= 0 && parentPos < childPos);
+
+	delete entityMgr;
+}
+
+void testTransformDirtyUpdate()
+{
+	TEST_CASE("Entity manager update changed transform");
+
+	CEntityManager* entityMgr = new CEntityManager();
+
+	core::array<CEntity*> entities;
+	entityMgr->createEntity(1000, entities);
+
+	for (u32 i = 0, n = entities.size(); i < n; i++)
+	{
+		entities[i]->addData<CWorldTransformData>();
+		entities[i]->addData<CWorldInverseTransformData>();
+	}
+
+	// entity 1 is child of entity 0
+	GET_ENTITY_DATA(entities[1], CWorldTransformData)->ParentIndex = entities[0]->getIndex();
+
+	entityMgr->update();
+	entityMgr->update();
+
+	CGroupTransform* groupTransform = entityMgr->getSystem<CWorldTransformSystem>()->getGroupTransform();
+	TEST_ASSERT_THROW(groupTransform->getEntityCount() == 0);
+
+	// move the parent
+	CWorldTransformData* parent = GET_ENTITY_DATA(entities[0], CWorldTransformData);
+	parent->Relative.setTranslation(core::vector3df(10.0f, 0.0f, 0.0f));
+	parent->HasChanged = true;
+
+	// the static entity must not be updated
+	CWorldInverseTransformData* staticInv = GET_ENTITY_DATA(entities[2], CWorldInverseTransformData);
+	staticInv->WorldInverse.setTranslation(core::vector3df(1.0f, 2.0f, 3.0f));
+
+	entityMgr->update();
+
+	TEST_ASSERT_THROW(groupTransform->getEntityCount() == 2);
+
+	CWorldInverseTransformData* childInv = GET_ENTITY_DATA(entities[1], CWorldInverseTransformData);
+	TEST_ASSERT_FLOAT_EQUAL(childInv->WorldInverse.getTranslation().X, -10.0f);
+	TEST_ASSERT_FLOAT_EQUAL(staticInv->WorldInverse.getTranslation().Z, 3.0f);
+
+	delete entityMgr;
+}
+
+void testGroupSignature()
+{
+	TEST_CASE("Entity group signature");
+
+	CEntityManager* entityMgr = new CEntityManager();
+	entityMgr->enableMultiThreadUpdate(true);
+
+	core::array<CEntity*> entities;
+	entityMgr->createEntity(5000, entities);
+
+	for (u32 i = 0, n = entities.size(); i < n; i++)
+	{
+		entities[i]->addData<CWorldTransformData>();
+		if (i % 2 == 0)
+			entities[i]->addData<CWorldInverseTransformData>();
+	}
+
+	CEntity* entity = entities[1];
+	u64 bit = (u64)1 << DATA_TYPE_INDEX(CWorldInverseTransformData);
+	TEST_ASSERT_THROW((entity->getSignature() & bit) == 0);
+
+	entity->addData<CWorldInverseTransformData>();
+	TEST_ASSERT_THROW((entity->getSignature() & bit) != 0);
+
+	entity->removeData<CWorldInverseTransformData>();
+	TEST_ASSERT_THROW((entity->getSignature() & bit) == 0);
+
+	const u32 type[] = GET_LIST_ENTITY_DATA2(CWorldTransformData, CWorldInverseTransformData);
+	CEntityGroup* group = entityMgr->createGroup(type, 2);
+	TEST_ASSERT_THROW(group->getSignature() == (bit | ((u64)1 << DATA_TYPE_INDEX(CWorldTransformData))));
+
+	entityMgr->update();
+	TEST_ASSERT_THROW(group->getEntityCount() == 2500);
+
+	// the entities keep the order of alive list
+	CEntity** groupEntities = group->getEntities();
+	bool pass = true;
+	for (int i = 0, n = group->getEntityCount(); i < n; i++)
+	{
+		if (groupEntities[i] != entities[i * 2])
+			pass = false;
+	}
+	TEST_ASSERT_THROW(pass);
+
+	delete entityMgr;
+}
+
+void testCullingSystemBVH()
+{
+	TEST_CASE("Culling system with bvh");
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+
+	CCamera* camera = zone->createEmptyObject()->addComponent<CCamera>();
+	camera->setPosition(core::vector3df(0.0f, 5.0f, 0.0f));
+	camera->lookAt(core::vector3df(50.0f, 0.0f, 50.0f), core::vector3df(0.0f, 1.0f, 0.0f));
+
+	CForwardRP* rp = new CForwardRP();
+
+	CEntityManager* entityMgr = scene->getEntityManager();
+	entityMgr->setCamera(camera);
+	entityMgr->setRenderPipeline(rp);
+
+	core::array<CEntity*> entities;
+	entityMgr->createEntity(2500, entities);
+
+	for (u32 i = 0, n = entities.size(); i < n; i++)
+	{
+		CWorldTransformData* transform = entities[i]->addData<CWorldTransformData>();
+		transform->Relative.setTranslation(core::vector3df((f32)(i % 50) * 4.0f - 100.0f, 0.0f, (f32)(i / 50) * 4.0f - 100.0f));
+
+		entities[i]->addData<CCullingData>();
+		entities[i]->addData<CCullingBBoxData>()->BBox = core::aabbox3df(core::vector3df(-1.0f, -1.0f, -1.0f), core::vector3df(1.0f, 1.0f, 1.0f));
+	}
+
+	CCullingSystem* cullingSystem = entityMgr->getSystem<CCullingSystem>();
+
+	core::array<bool> linearVisible;
+	linearVisible.set_used(entities.size());
+
+	bool pass = true;
+	int numVisible = 0;
+
+	for (int step = 0; step < 3; step++)
+	{
+		// move some objects
+		if (step > 0)
+		{
+			for (u32 i = step; i < entities.size(); i += 10)
+			{
+				CWorldTransformData* transform = GET_ENTITY_DATA(entities[i], CWorldTransformData);
+				transform->Relative.setTranslation(transform->Relative.getTranslation() + core::vector3df(30.0f, 0.0f, 30.0f));
+				transform->HasChanged = true;
+			}
+		}
+
+		scene->update();
+		entityMgr->update();
+
+		cullingSystem->enableBVH(false);
+		entityMgr->cullingAndRender();
+
+		for (u32 i = 0, n = entities.size(); i < n; i++)
+			linearVisible[i] = GET_ENTITY_DATA(entities[i], CCullingData)->Visible;
+
+		cullingSystem->enableBVH(true);
+		entityMgr->cullingAndRender();
+
+		// the second query use the proxies that are refitted
+		entityMgr->cullingAndRender();
+
+		for (u32 i = 0, n = entities.size(); i < n; i++)
+		{
+			bool visible = GET_ENTITY_DATA(entities[i], CCullingData)->Visible;
+			if (visible != linearVisible[i])
+				pass = false;
+			if (visible)
+				numVisible++;
+		}
+	}
+
+	TEST_ASSERT_THROW(pass);
+	TEST_ASSERT_THROW(numVisible > 0);
+	TEST_ASSERT_THROW(cullingSystem->getBVH()->getProxyCount() == 2500);
+
+	delete scene;
+	delete rp;
+}
+
+void testLightCullingSystemBVH()
+{
+	TEST_CASE("Light culling system with bvh");
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+
+	CCamera* camera = zone->createEmptyObject()->addComponent<CCamera>();
+	camera->setPosition(core::vector3df(0.0f, 5.0f, 0.0f));
+	camera->lookAt(core::vector3df(50.0f, 0.0f, 50.0f), core::vector3df(0.0f, 1.0f, 0.0f));
+
+	CForwardRP* rp = new CForwardRP();
+
+	CEntityManager* entityMgr = scene->getEntityManager();
+	entityMgr->setCamera(camera);
+	entityMgr->setRenderPipeline(rp);
+
+	core::array<CEntity*> entities;
+	entityMgr->createEntity(400, entities);
+
+	for (u32 i = 0, n = entities.size(); i < n; i++)
+	{
+		entities[i]->addData<CVisibleData>();
+
+		CWorldTransformData* transform = entities[i]->addData<CWorldTransformData>();
+		transform->Relative.setTranslation(core::vector3df((f32)(i % 20) * 10.0f - 100.0f, 0.0f, (f32)(i / 20) * 10.0f - 100.0f));
+
+		entities[i]->addData<CLightCullingData>()->BBox = core::aabbox3df(core::vector3df(-2.0f, -2.0f, -2.0f), core::vector3df(2.0f, 2.0f, 2.0f));
+	}
+
+	// the hidden lights are removed from bvh
+	for (u32 i = 0; i < 10; i++)
+		entities[i * 3]->setVisible(false);
+
+	CLightCullingSystem* lightCulling = entityMgr->getSystem<CLightCullingSystem>();
+
+	bool pass = true;
+	int numVisible = 0;
+
+	for (int step = 0; step < 2; step++)
+	{
+		// move some lights
+		if (step > 0)
+		{
+			for (u32 i = 1; i < entities.size(); i += 7)
+			{
+				CWorldTransformData* transform = GET_ENTITY_DATA(entities[i], CWorldTransformData);
+				transform->Relative.setTranslation(transform->Relative.getTranslation() + core::vector3df(25.0f, 0.0f, 25.0f));
+				transform->HasChanged = true;
+			}
+		}
+
+		scene->update();
+		entityMgr->update();
+		entityMgr->cullingAndRender();
+
+		const SViewFrustum& frustum = camera->getViewFrustum();
+
+		for (u32 i = 0, n = entities.size(); i < n; i++)
+		{
+			CVisibleData* visible = GET_ENTITY_DATA(entities[i], CVisibleData);
+			CLightCullingData* culling = GET_ENTITY_DATA(entities[i], CLightCullingData);
+
+			if (!visible->Visible)
+				continue;
+
+			// the same result as the linear test
+			core::aabbox3df box = culling->BBox;
+			GET_ENTITY_DATA(entities[i], CWorldTransformData)->World.transformBoxEx(box);
+
+			bool expected = box.intersectsWithBox(frustum.getBoundingBox()) && !CSIMDUtils::isBoxOutsideFrustum(frustum, box);
+			if (culling->Visible != expected)
+				pass = false;
+			if (culling->Visible)
+				numVisible++;
+		}
+	}
+
+	TEST_ASSERT_THROW(pass);
+	TEST_ASSERT_THROW(numVisible > 0);
+	TEST_ASSERT_THROW(lightCulling->getBVH()->getProxyCount() == 390);
+	TEST_ASSERT_THROW((int)lightCulling->getLightVisible().size() < 390);
+
+	delete scene;
+	delete rp;
+}
+
+void testAnimationSystem()
+{
+	TEST_CASE("Animation system");
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+
+	CEntityManager* entityMgr = scene->getEntityManager();
+	entityMgr->enableMultiThreadUpdate(true);
+
+	// the joints: root -> bone
+	core::array<CEntity*> entities;
+	entityMgr->createEntity(2, entities);
+
+	CWorldTransformData* root = entities[0]->addData<CWorldTransformData>();
+	root->Name = "Root";
+
+	CWorldTransformData* bone = entities[1]->addData<CWorldTransformData>();
+	bone->Name = "Bone";
+	bone->ParentIndex = entities[0]->getIndex();
+
+	CAnimationClip* clip = new CAnimationClip();
+	SEntityAnim* anim = new SEntityAnim();
+	anim->Name = "Bone";
+
+	for (int i = 0; i <= 1; i++)
+	{
+		CPositionKey pos;
+		pos.Frame = (f32)i;
+		pos.Value = core::vector3df(i * 10.0f, 0.0f, 0.0f);
+		anim->Data.Positions.Data.push_back(pos);
+
+		CRotationKey rot;
+		rot.Frame = (f32)i;
+		anim->Data.Rotations.Data.push_back(rot);
+
+		CScaleKey scale;
+		scale.Frame = (f32)i;
+		scale.Value = core::vector3df(1.0f, 1.0f, 1.0f);
+		anim->Data.Scales.Data.push_back(scale);
+	}
+	clip->addAnim(anim);
+
+	CAnimationController* controller = zone->createEmptyObject()->addComponent<CAnimationController>();
+	CSkeleton* skeleton = controller->createSkeleton(entities);
+	skeleton->setAnimation(clip, true, true);
+	skeleton->getTimeline().Frame = 0.5f;
+
+	CAnimationSystem* animationSystem = entityMgr->getSystem<CAnimationSystem>();
+	TEST_ASSERT_THROW(animationSystem != NULL);
+
+	// the controller is queued, the skeleton is evaluated in entity manager update
+	scene->update();
+	TEST_ASSERT_THROW(animationSystem->getNumController() == 1);
+	TEST_ASSERT_FLOAT_EQUAL(bone->Relative.getTranslation().X, 0.0f);
+
+	// the controller is queued once per frame
+	controller->updateComponent();
+	TEST_ASSERT_THROW(animationSystem->getNumController() == 1);
+
+	entityMgr->update();
+	TEST_ASSERT_THROW(animationSystem->getNumController() == 0);
+	TEST_ASSERT_FLOAT_EQUAL(bone->Relative.getTranslation().X, 5.0f);
+	TEST_ASSERT_FLOAT_EQUAL(bone->World.getTranslation().X, 5.0f);
+
+	// the next frame, the joint world matrix is updated in the same frame
+	skeleton->getTimeline().Frame = 0.8f;
+	scene->update();
+	entityMgr->update();
+	TEST_ASSERT_FLOAT_EQUAL(bone->Relative.getTranslation().X, 8.0f);
+	TEST_ASSERT_FLOAT_EQUAL(bone->World.getTranslation().X, 8.0f);
+
+	// a queued controller is removed when it is destroyed
+	scene->update();
+	TEST_ASSERT_THROW(animationSystem->getNumController() == 1);
+	controller->getGameObject()->removeComponent<CAnimationController>();
+	TEST_ASSERT_THROW(animationSystem->getNumController() == 0);
+	entityMgr->update();
+
+	delete scene;
+	delete clip;
+}
+
+void testInstancingDeltaUpdate()
+{
+	TEST_CASE("Instancing update changed instances");
+
+	CEntityManager* entityMgr = new CEntityManager();
+
+	core::array<CEntity*> entities;
+	entityMgr->createEntity(3, entities);
+
+	for (u32 i = 0; i < 3; i++)
+	{
+		CWorldTransformData* transform = entities[i]->addData<CWorldTransformData>();
+		transform->World.setTranslation(core::vector3df((f32)i, 0.0f, 0.0f));
+	}
+
+	CIndirectLightingData* lighting = entities[2]->addData<CIndirectLightingData>();
+	lighting->Type = CIndirectLightingData::AmbientColor;
+
+	IVertexBuffer* transformBuffer = IShaderInstancing::createTransformVertexBuffer();
+	IVertexBuffer* lightingBuffer = IShaderInstancing::createIndirectLightingVertexBuffer();
+
+	// all instances are new
+	TEST_ASSERT_THROW(IShaderInstancing::updateTransformAndLighting(transformBuffer, lightingBuffer, entities.pointer(), 3) == 3);
+
+	// nothing changed, the buffer is not dirty
+	u32 transformID = transformBuffer->getChangedID();
+	u32 lightingID = lightingBuffer->getChangedID();
+	TEST_ASSERT_THROW(IShaderInstancing::updateTransformAndLighting(transformBuffer, lightingBuffer, entities.pointer(), 3) == 0);
+	TEST_ASSERT_THROW(transformBuffer->getChangedID() == transformID);
+	TEST_ASSERT_THROW(lightingBuffer->getChangedID() == lightingID);
+
+	// move 1 instance
+	GET_ENTITY_DATA(entities[1], CWorldTransformData)->World.setTranslation(core::vector3df(5.0f, 0.0f, 0.0f));
+	TEST_ASSERT_THROW(IShaderInstancing::updateTransformAndLighting(transformBuffer, lightingBuffer, entities.pointer(), 3) == 1);
+	TEST_ASSERT_THROW(transformBuffer->getChangedID() != transformID);
+	TEST_ASSERT_THROW(lightingBuffer->getChangedID() == lightingID);
+
+	// change the lighting
+	lighting->Color.set(255, 255, 0, 0);
+	TEST_ASSERT_THROW(IShaderInstancing::updateTransformAndLighting(transformBuffer, lightingBuffer, entities.pointer(), 3) == 1);
+	TEST_ASSERT_THROW(lightingBuffer->getChangedID() != lightingID);
+
+	// hide the last instance, the count changed
+	transformID = transformBuffer->getChangedID();
+	TEST_ASSERT_THROW(IShaderInstancing::updateTransformAndLighting(transformBuffer, lightingBuffer, entities.pointer(), 2) == 0);
+	TEST_ASSERT_THROW(transformBuffer->getChangedID() != transformID);
+	TEST_ASSERT_THROW(transformBuffer->getVertexCount() == 2);
+
+	transformBuffer->drop();
+	lightingBuffer->drop();
+	delete entityMgr;
+}
+
+void testAutoInstancingRelease()
+{
+	TEST_CASE("Auto instancing release");
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+
+	CCamera* camera = zone->createEmptyObject()->addComponent<CCamera>();
+	CForwardRP* rp = new CForwardRP();
+
+	CEntityManager* entityMgr = scene->getEntityManager();
+	entityMgr->setCamera(camera);
+	entityMgr->setRenderPipeline(rp);
+
+	CMeshRenderer* meshRenderer = entityMgr->getSystem<CMeshRenderer>();
+	TEST_ASSERT_THROW(!meshRenderer->isAutoInstancing());
+	meshRenderer->setAutoInstancing(true);
+
+	CMeshManager* meshManager = CMeshManager::getInstance();
+	u32 numAutoInstancing = meshManager->getNumAutoInstancingMesh();
+
+	CMesh* mesh = new CMesh();
+
+	core::array<CEntity*> entities;
+	entityMgr->createEntity(4, entities);
+	for (u32 i = 0; i < 4; i++)
+	{
+		entities[i]->addData<CWorldTransformData>();
+		entities[i]->addData<CRenderMeshData>()->setShareMesh(mesh);
+	}
+	mesh->drop();
+
+	// the rendered mesh is kept by the mesh manager
+	entityMgr->update();
+	entityMgr->cullingAndRender();
+	TEST_ASSERT_THROW(meshManager->getNumAutoInstancingMesh() == numAutoInstancing + 1);
+	TEST_ASSERT_THROW(mesh->getReferenceCount() == 5);
+
+	// the mesh is released when no entity renders it
+	for (u32 i = 0; i < 4; i++)
+		entityMgr->removeEntity(entities[i]);
+
+	entityMgr->update();
+	entityMgr->cullingAndRender();
+	TEST_ASSERT_THROW(meshManager->getNumAutoInstancingMesh() == numAutoInstancing);
+
+	// the scene is unloaded, the meshes of the renderer are released
+	mesh = new CMesh();
+	CEntity* entity = entityMgr->createEntity();
+	entity->addData<CWorldTransformData>();
+	entity->addData<CRenderMeshData>()->setShareMesh(mesh);
+	entityMgr->update();
+	entityMgr->cullingAndRender();
+	TEST_ASSERT_THROW(meshManager->getNumAutoInstancingMesh() == numAutoInstancing + 1);
+
+	delete scene;
+	TEST_ASSERT_THROW(meshManager->getNumAutoInstancingMesh() == numAutoInstancing);
+	TEST_ASSERT_THROW(mesh->getReferenceCount() == 1);
+	mesh->drop();
+
+	delete rp;
+}
+
+void testEntityManager()
+{
+	testEntityDataStorage();
+
+	testMultiThreadUpdate();
+
+	testIncrementalSort();
+
+	testTransformDirtyUpdate();
+
+	testGroupSignature();
+
+	testCullingSystemBVH();
+
+	testLightCullingSystemBVH();
+
+	testAnimationSystem();
+
+	testInstancingDeltaUpdate();
+
+	testAutoInstancingRelease();
+}
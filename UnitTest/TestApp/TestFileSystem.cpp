@@ -0,0 +1,50 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestFileSystem.h"
+
+using namespace Skylicht;
+
+void testFileSystemPathCache()
+{
+	TEST_CASE("CFileSystem path cache");
+
+	io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+	const char* fileName = "TestPathCache.bin";
+	remove(fileName);
+
+	// the missing file is cached
+	u32 miss = fs->getPathCacheMiss();
+	u32 hit = fs->getPathCacheHit();
+	TEST_ASSERT_THROW(!fs->existFile(fileName));
+	TEST_ASSERT_THROW(fs->getPathCacheMiss() == miss + 1);
+	TEST_ASSERT_THROW(!fs->existFile(fileName));
+	TEST_ASSERT_THROW(fs->createAndOpenFile(fileName) == NULL);
+	TEST_ASSERT_THROW(fs->getPathCacheHit() == hit + 2);
+	TEST_ASSERT_THROW(fs->getPathCacheMiss() == miss + 1);
+
+	// write the file, the cache is invalidated
+	io::IWriteFile* writeFile = fs->createAndWriteFile(fileName);
+	TEST_ASSERT_THROW(writeFile != NULL);
+	u32 data = 0x12345678;
+	writeFile->write(&data, sizeof(u32));
+	writeFile->drop();
+
+	TEST_ASSERT_THROW(fs->existFile(fileName));
+	TEST_ASSERT_THROW(fs->getPathCacheMiss() == miss + 2);
+
+	io::IReadFile* readFile = fs->createAndOpenFile(fileName);
+	TEST_ASSERT_THROW(readFile != NULL);
+	TEST_ASSERT_THROW(readFile->getSize() == sizeof(u32));
+	readFile->drop();
+	TEST_ASSERT_THROW(fs->getPathCacheHit() == hit + 3);
+
+	// delete outside the file system, the failed open drops the entry
+	remove(fileName);
+	TEST_ASSERT_THROW(fs->createAndOpenFile(fileName) == NULL);
+	TEST_ASSERT_THROW(!fs->existFile(fileName));
+	TEST_ASSERT_THROW(fs->getPathCacheMiss() == miss + 3);
+
+	fs->clearPathCache();
+	TEST_ASSERT_THROW(!fs->existFile(fileName));
+	TEST_ASSERT_THROW(fs->getPathCacheMiss() == miss + 4);
+}
@@ -0,0 +1,77 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestLighting.h"
+
+#include "Lighting/CLightCluster.h"
+
+using namespace Skylicht;
+
+void testLightCluster()
+{
+	TEST_CASE("CLightCluster");
+
+	core::matrix4 proj, view;
+	proj.buildProjectionMatrixPerspectiveFovLH(core::PI / 3.0f, 16.0f / 9.0f, 0.1f, 500.0f);
+	view.buildCameraLookAtMatrixLH(core::vector3df(0.0f, 5.0f, 0.0f), core::vector3df(0.0f, 5.0f, 1.0f), core::vector3df(0.0f, 1.0f, 0.0f));
+
+	core::array<core::vector3df> position;
+	core::array<f32> radius;
+
+	srand(0);
+	for (int i = 0; i < 1000; i++)
+	{
+		position.push_back(core::vector3df((f32)(rand() % 400) - 200.0f, (f32)(rand() % 20), (f32)(rand() % 500) - 50.0f));
+		radius.push_back(1.0f + (f32)(rand() % 10));
+	}
+
+	CLightCluster cluster;
+	cluster.build(view, proj, 0.1f, 500.0f, position.pointer(), radius.pointer(), 1000, true);
+
+	// the serial build has the same result
+	CLightCluster serialCluster;
+	serialCluster.build(view, proj, 0.1f, 500.0f, position.pointer(), radius.pointer(), 1000, false);
+	TEST_ASSERT_THROW(serialCluster.getLightIndex().size() == cluster.getLightIndex().size());
+	TEST_ASSERT_THROW(memcmp(serialCluster.getLightIndex().const_pointer(), cluster.getLightIndex().const_pointer(), cluster.getLightIndex().size() * sizeof(u32)) == 0);
+
+	// the cluster of light center must contain the light
+	bool pass = true;
+	int numTest = 0;
+	for (u32 i = 0; i < 1000; i++)
+	{
+		int id = cluster.getClusterID(position[i]);
+		if (id < 0)
+			continue;
+
+		if (!cluster.getLightBound(i).Visible)
+		{
+			pass = false;
+			continue;
+		}
+
+		u32 count = 0;
+		const u32* lights = cluster.getClusterLights((u32)id, count);
+
+		bool found = false;
+		for (u32 j = 0; j < count; j++)
+		{
+			if (lights[j] == i)
+				found = true;
+		}
+
+		if (!found)
+			pass = false;
+		numTest++;
+	}
+	TEST_ASSERT_THROW(pass);
+	TEST_ASSERT_THROW(numTest > 0);
+
+	// the light behind the camera is not in any cluster
+	core::vector3df behind(0.0f, 5.0f, -20.0f);
+	f32 behindRadius = 2.0f;
+	cluster.build(view, proj, 0.1f, 500.0f, &behind, &behindRadius, 1, true);
+	TEST_ASSERT_THROW(cluster.getLightBound(0).Visible == false);
+	TEST_ASSERT_THROW(cluster.getLightIndex().size() == 0);
+
+	core::rectf rect;
+	TEST_ASSERT_THROW(cluster.getLightScreenRect(0, rect) == false);
+}
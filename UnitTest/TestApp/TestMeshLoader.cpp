@@ -0,0 +1,285 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestMeshLoader.h"
+
+#include "Utils/CMappedFile.h"
+#include "Entity/CEntityPrefab.h"
+#include "Transform/CWorldTransformData.h"
+#include "RenderMesh/CRenderMeshData.h"
+#include "Importer/Skylicht/CSkylichtMeshLoader.h"
+#include "Exporter/Skylicht/CSkylichtMeshExporter.h"
+
+using namespace Skylicht;
+
+CMesh* createGridMesh(int gridSize, float offset)
+{
+	IVideoDriver* driver = getVideoDriver();
+
+	CMeshBuffer<S3DVertex>* mb = new CMeshBuffer<S3DVertex>(driver->getVertexDescriptor(EVT_STANDARD), EIT_16BIT);
+	IVertexBuffer* vb = mb->getVertexBuffer();
+	IIndexBuffer* ib = mb->getIndexBuffer();
+
+	for (int y = 0; y <= gridSize; y++)
+	{
+		for (int x = 0; x <= gridSize; x++)
+		{
+			S3DVertex v;
+			v.Pos.set((f32)x, offset, (f32)y);
+			v.Normal.set(0.0f, 1.0f, 0.0f);
+			v.TCoords.set((f32)x / gridSize, (f32)y / gridSize);
+			v.Color.set(255, 255, 255, 255);
+			vb->addVertex(&v);
+		}
+	}
+
+	for (int y = 0; y < gridSize; y++)
+	{
+		for (int x = 0; x < gridSize; x++)
+		{
+			u32 i = y * (gridSize + 1) + x;
+			ib->addIndex(i);
+			ib->addIndex(i + gridSize + 1);
+			ib->addIndex(i + 1);
+			ib->addIndex(i + 1);
+			ib->addIndex(i + gridSize + 1);
+			ib->addIndex(i + gridSize + 2);
+		}
+	}
+
+	mb->recalculateBoundingBox();
+
+	CMesh* mesh = new CMesh();
+	mesh->addMeshBuffer(mb, "grid");
+	mb->drop();
+	return mesh;
+}
+
+bool writeModelVersion1(CEntityPrefab* prefab, const char* output)
+{
+	io::IWriteFile* writeFile = getIrrlichtDevice()->getFileSystem()->createAndWriteFile(output);
+	if (writeFile == NULL)
+		return false;
+
+	SAssetHeader assetHeader;
+	strcpy(assetHeader.Sign, "SLT");
+	assetHeader.AssetType = (u32)AssetModel;
+	assetHeader.AssetVersion = 1;
+	writeFile->write(&assetHeader, sizeof(SAssetHeader));
+
+	u32 count = prefab->getNumEntities();
+	writeFile->write(&count, sizeof(u32));
+
+	CMemoryStream memoryEntity(512);
+	CMemoryStream memoryData(512);
+
+	for (u32 i = 0; i < count; i++)
+	{
+		CEntity* entity = prefab->getEntity(i);
+
+		memoryEntity.resetWrite();
+		memoryEntity.writeInt(entity->getIndex());
+		memoryEntity.writeChar(entity->isVisible() ? 1 : 0);
+
+		for (int j = 0, n = entity->getDataCount(); j < n; j++)
+		{
+			IEntityData* data = entity->getDataByIndex(j);
+			memoryData.resetWrite();
+
+			if (data != NULL && data->serializable(&memoryData))
+			{
+				memoryEntity.writeInt(memoryData.getSize());
+				memoryEntity.writeString(data->getTypeName());
+				memoryEntity.writeStream(&memoryData);
+			}
+		}
+
+		memoryEntity.writeInt(-1);
+		writeFile->write(memoryEntity.getData(), memoryEntity.getSize());
+	}
+
+	writeFile->drop();
+	return true;
+}
+
+bool isSameModel(CEntityPrefab* a, CEntityPrefab* b)
+{
+	if (a->getNumEntities() != b->getNumEntities())
+		return false;
+
+	for (u32 i = 0, n = a->getNumEntities(); i < n; i++)
+	{
+		CWorldTransformData* ta = GET_ENTITY_DATA(a->getEntity(i), CWorldTransformData);
+		CWorldTransformData* tb = GET_ENTITY_DATA(b->getEntity(i), CWorldTransformData);
+
+		if (ta == NULL || tb == NULL ||
+			ta->ParentIndex != tb->ParentIndex ||
+			ta->Depth != tb->Depth ||
+			ta->Name != tb->Name ||
+			!ta->Relative.equals(tb->Relative))
+			return false;
+
+		CRenderMeshData* ra = GET_ENTITY_DATA(a->getEntity(i), CRenderMeshData);
+		CRenderMeshData* rb = GET_ENTITY_DATA(b->getEntity(i), CRenderMeshData);
+
+		if ((ra == NULL) != (rb == NULL))
+			return false;
+
+		if (ra == NULL)
+			continue;
+
+		CMesh* ma = ra->getMesh();
+		CMesh* mb = rb->getMesh();
+		if (ma->getMeshBufferCount() != mb->getMeshBufferCount())
+			return false;
+
+		for (u32 j = 0, m = ma->getMeshBufferCount(); j < m; j++)
+		{
+			IVertexBuffer* va = ma->getMeshBuffer(j)->getVertexBuffer();
+			IVertexBuffer* vb = mb->getMeshBuffer(j)->getVertexBuffer();
+			IIndexBuffer* ia = ma->getMeshBuffer(j)->getIndexBuffer();
+			IIndexBuffer* ib = mb->getMeshBuffer(j)->getIndexBuffer();
+
+			if (va->getVertexCount() != vb->getVertexCount() ||
+				ia->getIndexCount() != ib->getIndexCount() ||
+				memcmp(va->getVertices(), vb->getVertices(), va->getVertexCount() * va->getVertexSize()) != 0 ||
+				memcmp(ia->getIndices(), ib->getIndices(), ia->getIndexCount() * ia->getIndexSize()) != 0)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool writeStoredZip(const char* zipFile, const char* name, const void* data, u32 size)
+{
+	io::IWriteFile* writeFile = getIrrlichtDevice()->getFileSystem()->createAndWriteFile(zipFile);
+	if (writeFile == NULL)
+		return false;
+
+	u16 nameLength = (u16)strlen(name);
+
+	unsigned char header[30];
+	memset(header, 0, sizeof(header));
+
+	u32 sig = 0x04034b50;
+	u16 version = 10;
+	memcpy(header, &sig, 4);
+	memcpy(header + 4, &version, 2);
+	memcpy(header + 18, &size, 4);
+	memcpy(header + 22, &size, 4);
+	memcpy(header + 26, &nameLength, 2);
+
+	writeFile->write(header, sizeof(header));
+	writeFile->write(name, nameLength);
+	writeFile->write(data, size);
+	writeFile->drop();
+	return true;
+}
+
+void testMeshPack()
+{
+	TEST_CASE("CSkylichtMeshLoader pack");
+
+	const char* fileV1 = "TestMeshV1.smesh";
+	const char* fileConvert = "TestMeshConvert.smesh";
+	const char* fileExport = "TestMeshExport.smesh";
+
+	// model: root with the child grid meshes
+	CEntityPrefab model;
+	CEntity* root = model.createEntity();
+	model.addTransformData(root, NULL, core::IdentityMatrix, "root");
+
+	for (int i = 0; i < 200; i++)
+	{
+		CEntity* entity = model.createEntity();
+
+		core::matrix4 transform;
+		transform.setTranslation(core::vector3df((f32)i, 0.0f, 0.0f));
+
+		char name[32];
+		sprintf(name, "grid_%d", i);
+		model.addTransformData(entity, root, transform, name);
+
+		CMesh* mesh = createGridMesh(32, (f32)i);
+		CRenderMeshData* renderMesh = entity->addData<CRenderMeshData>();
+		renderMesh->setMesh(mesh);
+		mesh->drop();
+	}
+
+	TEST_ASSERT_THROW(writeModelVersion1(&model, fileV1));
+
+	CSkylichtMeshExporter exporter;
+	TEST_ASSERT_THROW(exporter.convertModel(fileV1, fileConvert));
+	TEST_ASSERT_THROW(exporter.exportModel(model.getEntities(), model.getNumEntities(), fileExport));
+
+	CEntityPrefab loadV1, loadConvert, loadExport;
+	CSkylichtMeshLoader loader;
+	TEST_ASSERT_THROW(loader.loadModel(fileV1, &loadV1, false, false, false, false));
+	TEST_ASSERT_THROW(loader.loadModel(fileConvert, &loadConvert, false, false, false, false));
+	TEST_ASSERT_THROW(loader.loadModel(fileExport, &loadExport, false, false, false, false));
+
+	TEST_ASSERT_THROW(isSameModel(&model, &loadV1));
+	TEST_ASSERT_THROW(isSameModel(&model, &loadConvert));
+	TEST_ASSERT_THROW(isSameModel(&model, &loadExport));
+
+	// the packed file is not version 1, so it can not be converted
+	TEST_ASSERT_THROW(exporter.convertModel(fileExport, fileConvert) == false);
+
+	// the crafted count that wraps the section size in u32 must be rejected
+	io::IReadFile* readFile = getIrrlichtDevice()->getFileSystem()->createAndOpenFile(fileExport);
+	TEST_ASSERT_THROW(readFile != NULL);
+
+	core::array<unsigned char> data;
+	data.set_used((u32)readFile->getSize());
+	readFile->read(data.pointer(), data.size());
+	readFile->drop();
+
+	SMeshPackHeader* header = (SMeshPackHeader*)(data.pointer() + sizeof(SAssetHeader));
+	header->NumType = 0x40000000;
+
+	io::IWriteFile* writeFile = getIrrlichtDevice()->getFileSystem()->createAndWriteFile(fileConvert);
+	TEST_ASSERT_THROW(writeFile != NULL);
+	writeFile->write(data.pointer(), data.size());
+	writeFile->drop();
+
+	CEntityPrefab loadCrafted;
+	TEST_ASSERT_THROW(loader.loadModel(fileConvert, &loadCrafted, false, false, false, false) == false);
+
+	remove(fileV1);
+	remove(fileConvert);
+	remove(fileExport);
+
+	TEST_CASE("CMappedFile");
+
+	// the loose file on the disk has the same name and size with the file in the archive
+	const char* fileZip = "TestMappedFile.zip";
+	const char* fileName = "TestMappedFile.bin";
+	const char archiveData[] = "archive";
+	const char diskData[] = "disk!!!";
+
+	TEST_ASSERT_THROW(writeStoredZip(fileZip, fileName, archiveData, sizeof(archiveData)));
+
+	writeFile = getIrrlichtDevice()->getFileSystem()->createAndWriteFile(fileName);
+	TEST_ASSERT_THROW(writeFile != NULL);
+	writeFile->write(diskData, sizeof(diskData));
+	writeFile->drop();
+
+	CMappedFile mappedFile;
+	TEST_ASSERT_THROW(mappedFile.open(fileName));
+	TEST_ASSERT_THROW(mappedFile.isMapped());
+	TEST_ASSERT_THROW(memcmp(mappedFile.getData(), diskData, sizeof(diskData)) == 0);
+	mappedFile.close();
+
+	// the archive is opened first, so the disk file must not shadow it
+	io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+	TEST_ASSERT_THROW(fs->addFileArchive(fileZip, false, false));
+	TEST_ASSERT_THROW(mappedFile.open(fileName));
+	TEST_ASSERT_THROW(!mappedFile.isMapped());
+	TEST_ASSERT_EQUAL(mappedFile.getSize(), sizeof(archiveData));
+	TEST_ASSERT_THROW(memcmp(mappedFile.getData(), archiveData, sizeof(archiveData)) == 0);
+	mappedFile.close();
+
+	fs->removeFileArchive(fs->getFileArchiveCount() - 1);
+	remove(fileZip);
+	remove(fileName);
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+void testMeshPack();
+
+bool writeStoredZip(const char* zipFile, const char* name, const void* data, u32 size);
@@ -0,0 +1,89 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestMeshRenderer.h"
+
+#include "RenderMesh/CMeshRenderer.h"
+#include "Entity/CEntityManager.h"
+#include "Transform/CWorldTransformData.h"
+
+using namespace Skylicht;
+
+void testDrawCommandSort()
+{
+	TEST_CASE("CMeshRenderer::sortDrawCommand");
+
+	core::array<SMeshDrawCommand> commands;
+	core::array<SMeshDrawCommand> temp;
+	core::array<u64> keys;
+
+	u64 seed = 1;
+	for (u32 i = 0; i < 1000; i++)
+	{
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+		SMeshDrawCommand cmd;
+		cmd.Key = (i % 3 == 0) ? (seed & 0xffff) : seed;
+		cmd.MeshData = NULL;
+		cmd.Mesh = NULL;
+		cmd.BufferID = i;
+		commands.push_back(cmd);
+		keys.push_back(cmd.Key);
+	}
+
+	temp.set_used(commands.size());
+	CMeshRenderer::sortDrawCommand(commands.pointer(), temp.pointer(), commands.size());
+
+	bool pass = true;
+	for (u32 i = 0; i < commands.size(); i++)
+	{
+		if (i > 0 && commands[i - 1].Key > commands[i].Key)
+			pass = false;
+
+		// the command keeps its key
+		if (keys[commands[i].BufferID] != commands[i].Key)
+			pass = false;
+	}
+	TEST_ASSERT_THROW(pass);
+}
+
+class CTestMeshRenderer : public CMeshRenderer
+{
+public:
+	bool canBatch(CEntity* entity)
+	{
+		return canAutoInstancing(entity);
+	}
+};
+
+void testAutoInstancingLighting()
+{
+	TEST_CASE("Auto instancing lighting");
+
+	CEntityManager* entityMgr = new CEntityManager();
+
+	CMeshRenderer* meshRenderer = entityMgr->getSystem<CMeshRenderer>();
+	TEST_ASSERT_THROW(!meshRenderer->isAutoInstancing());
+
+	CTestMeshRenderer renderer;
+
+	CEntity* entity = entityMgr->createEntity();
+	entity->addData<CWorldTransformData>();
+	TEST_ASSERT_THROW(renderer.canBatch(entity));
+
+	// the instancing shader only has the SH and ambient color of each instance
+	CIndirectLightingData* lightingData = entity->addData<CIndirectLightingData>();
+
+	lightingData->Type = CIndirectLightingData::SH9;
+	TEST_ASSERT_THROW(renderer.canBatch(entity));
+
+	lightingData->Type = CIndirectLightingData::AmbientColor;
+	TEST_ASSERT_THROW(renderer.canBatch(entity));
+
+	lightingData->Type = CIndirectLightingData::LightmapArray;
+	TEST_ASSERT_THROW(!renderer.canBatch(entity));
+
+	lightingData->Type = CIndirectLightingData::VertexColor;
+	TEST_ASSERT_THROW(!renderer.canBatch(entity));
+
+	delete entityMgr;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+void testDrawCommandSort();
+
+void testAutoInstancingLighting();
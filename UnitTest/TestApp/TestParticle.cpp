@@ -0,0 +1,258 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestParticle.h"
+
+#include "ParticleSystem/Particles/CFactory.h"
+#include "ParticleSystem/Particles/CGroup.h"
+#include "ParticleSystem/Particles/CSubGroup.h"
+#include "ParticleSystem/CParticleRenderer.h"
+#include "ParticleSystem/CParticleBufferData.h"
+#include "Entity/CEntityManager.h"
+#include "Culling/CVisibleData.h"
+#include "Culling/CCullingData.h"
+#include "Transform/CWorldTransformData.h"
+
+using namespace Skylicht;
+
+class CTestParticleCallback : public Particle::IParticleCallback
+{
+public:
+	core::array<f32> Tags;
+	int NumBatch;
+	bool Pass;
+
+	CTestParticleCallback() :
+		NumBatch(0),
+		Pass(true)
+	{
+	}
+
+	virtual void OnParticleBorn(Particle::CParticle& p)
+	{
+		p.Params[Particle::FrameIndex] = (f32)Tags.size();
+		Tags.push_back(p.Params[Particle::FrameIndex]);
+	}
+
+	virtual void OnParticleDead(Particle::CParticle& p)
+	{
+		// the data of the last particle is released
+		if (p.Index != Tags.size() - 1)
+			Pass = false;
+		Tags.set_used(Tags.size() - 1);
+	}
+
+	virtual void OnSwapParticleData(Particle::CParticle& p1, Particle::CParticle& p2)
+	{
+		core::swap(Tags[p1.Index], Tags[p2.Index]);
+	}
+
+	virtual void OnSwapParticleDataBatch(Particle::CParticle* particles, const Particle::SParticleSwap* swaps, int num)
+	{
+		NumBatch++;
+		Particle::IParticleCallback::OnSwapParticleDataBatch(particles, swaps, num);
+	}
+};
+
+void testParticleGroup()
+{
+	TEST_CASE("Particle group capacity");
+
+	Particle::CFactory factory;
+	Particle::CGroup* group = new Particle::CGroup();
+	group->setCapacity(100);
+
+	CTestParticleCallback callback;
+	group->addCallback(&callback);
+
+	Particle::CEmitter* emitter = factory.createRandomEmitter();
+	emitter->setZone(factory.createPointZone());
+	emitter->setTank(500);
+	group->addEmitter(emitter);
+
+	group->update(true);
+	TEST_ASSERT_THROW(group->getNumParticles() == 100);
+	TEST_ASSERT_THROW(callback.Tags.size() == 100);
+
+
+	TEST_CASE("Particle group compaction");
+	Particle::CParticle* particles = group->getParticlePointer();
+	for (u32 i = 0; i < 100; i++)
+	{
+		if (i % 3 == 0)
+			particles[i].Life = -1.0f;
+	}
+
+	group->update(true);
+	TEST_ASSERT_THROW(group->getNumParticles() == 66);
+	TEST_ASSERT_THROW(callback.NumBatch == 1);
+	TEST_ASSERT_THROW(callback.Pass);
+
+	// the data of callback follows the particles
+	particles = group->getParticlePointer();
+	bool pass = true;
+	for (u32 i = 0; i < 66; i++)
+	{
+		if (particles[i].Life < 0 || callback.Tags[i] != particles[i].Params[Particle::FrameIndex])
+			pass = false;
+	}
+	TEST_ASSERT_THROW(pass);
+
+	group->removeCallback(&callback);
+	delete group;
+
+
+	TEST_CASE("Particle sub group parent");
+
+	Particle::CGroup* parentGroup = new Particle::CGroup();
+	Particle::CSubGroup* subGroup = new Particle::CSubGroup(parentGroup);
+	Particle::CEmitter* parentEmitter = factory.createRandomEmitter();
+	parentEmitter->setZone(factory.createPointZone());
+
+	// the sub particle i follows the parent particle i, the position X is the tag
+	for (u32 i = 0; i < 30; i++)
+	{
+		core::vector3df position((f32)i, 0.0f, 0.0f);
+		parentGroup->addParticleByEmitter(parentEmitter, position, Transform::Oy);
+
+		int id = subGroup->addParticleByEmitter(parentEmitter, position, Transform::Oy);
+		subGroup->getParticlePointer()[id].ParentIndex = (s32)i;
+	}
+
+	particles = parentGroup->getParticlePointer();
+	for (u32 i = 0; i < 30; i++)
+	{
+		particles[i].Life = i % 3 == 0 ? -1.0f : 100.0f;
+		particles[i].Position.X = (f32)i;
+	}
+
+	parentGroup->update(true);
+	TEST_ASSERT_THROW(parentGroup->getNumParticles() == 20);
+
+	// the particles of the dead parent are detached, the others follow the swapped parent
+	particles = parentGroup->getParticlePointer();
+	Particle::CParticle* subParticles = subGroup->getParticlePointer();
+	pass = true;
+	for (u32 i = 0; i < 30; i++)
+	{
+		s32 parentIndex = subParticles[i].ParentIndex;
+		u32 tag = (u32)subParticles[i].Position.X;
+
+		if (tag % 3 == 0)
+		{
+			if (parentIndex != -1)
+				pass = false;
+		}
+		else if (parentIndex < 0 || parentIndex >= 20 || particles[parentIndex].Position.X != (f32)tag)
+		{
+			pass = false;
+		}
+	}
+	TEST_ASSERT_THROW(pass);
+
+	delete subGroup;
+	delete parentGroup;
+
+
+	TEST_CASE("Particle group random sequence");
+
+	// the result does not depend on the update order of the groups
+	Particle::CGroup* groups[4];
+	for (int i = 0; i < 4; i++)
+	{
+		groups[i] = new Particle::CGroup();
+		groups[i]->setRandomSeed(100 + (i % 2) * 100);
+		groups[i]->createModel(Particle::ColorR)->setStart(0.0f, 1.0f);
+
+		Particle::CEmitter* e = factory.createRandomEmitter();
+		e->setZone(factory.createSphereZone(core::vector3df(), 1.0f));
+		e->setTank(50);
+		groups[i]->addEmitter(e);
+	}
+
+	groups[0]->update(true);
+	groups[1]->update(true);
+
+	groups[3]->update(true);
+	groups[2]->update(true);
+
+	pass = true;
+	for (int i = 0; i < 2; i++)
+	{
+		Particle::CParticle* p1 = groups[i]->getParticlePointer();
+		Particle::CParticle* p2 = groups[i + 2]->getParticlePointer();
+
+		for (u32 j = 0; j < 50; j++)
+		{
+			if (p1[j].Position != p2[j].Position || p1[j].Life != p2[j].Life)
+				pass = false;
+		}
+	}
+	TEST_ASSERT_THROW(pass);
+
+	for (int i = 0; i < 4; i++)
+		delete groups[i];
+}
+
+class CTestParticleRenderer : public Particle::CParticleRenderer
+{
+public:
+	void updateGroups(CEntityManager* entityManager)
+	{
+		updateParticleGroups(entityManager);
+	}
+};
+
+void testParticleRendererUpdate()
+{
+	TEST_CASE("Particle renderer update tasks");
+
+	CEntityManager* entityMgr = new CEntityManager();
+	entityMgr->enableMultiThreadUpdate(true);
+
+	CTestParticleRenderer* renderer = entityMgr->addRenderSystem<CTestParticleRenderer>();
+
+	Particle::CFactory factory;
+	core::array<Particle::CGroup*> groups;
+
+	core::array<CEntity*> entities;
+	entityMgr->createEntity(40, entities);
+
+	for (u32 i = 0, n = entities.size(); i < n; i++)
+	{
+		entities[i]->addData<CVisibleData>();
+		entities[i]->addData<CWorldTransformData>();
+		entities[i]->addData<CCullingData>()->Visible = true;
+
+		Particle::CParticleBufferData* data = entities[i]->addData<Particle::CParticleBufferData>();
+
+		Particle::CGroup* group = data->createGroup();
+		group->setCapacity(10);
+
+		Particle::CEmitter* emitter = factory.createRandomEmitter();
+		emitter->setZone(factory.createPointZone());
+		emitter->setTank(10);
+		group->addEmitter(emitter);
+		groups.push_back(group);
+
+		// the sub group is updated in the task of its parent
+		if (i % 4 == 0)
+			data->createSubGroup(group);
+	}
+
+	renderer->beginQuery(entityMgr);
+	entityMgr->update();
+
+	// the table of root groups is reused at the second update
+	for (int step = 0; step < 2; step++)
+		renderer->updateGroups(entityMgr);
+
+	bool pass = true;
+	for (u32 i = 0, n = groups.size(); i < n; i++)
+	{
+		if (groups[i]->getNumParticles() != 10)
+			pass = false;
+	}
+	TEST_ASSERT_THROW(pass);
+
+	delete entityMgr;
+}
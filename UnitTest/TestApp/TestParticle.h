@@ -0,0 +1,5 @@
+#pragma once
+
+void testParticleGroup();
+
+void testParticleRendererUpdate();
@@ -0,0 +1,93 @@
+#include "Base.hh"
+#include "TestPhysics.h"
+
+#if defined(BUILD_SKYLICHT_PHYSIC) && defined(USE_BULLET_PHYSIC_ENGINE)
+
+#include "Scene/CScene.h"
+#include "PhysicsEngine/CPhysicsEngine.h"
+#include "RigidBody/CRigidbody.h"
+#include "Collider/CBoxCollider.h"
+
+using namespace Physics;
+
+static CRigidbody* createStaticBox(CZone* zone, const core::vector3df& position)
+{
+	CGameObject* obj = zone->createEmptyObject();
+	obj->addComponent<CBoxCollider>();
+
+	CRigidbody* body = obj->addComponent<CRigidbody>();
+	body->setDynamic(false);
+	TEST_ASSERT_THROW(body->initRigidbody());
+
+	body->setPosition(position);
+	return body;
+}
+
+#endif
+
+void testPhysics()
+{
+#if defined(BUILD_SKYLICHT_PHYSIC) && defined(USE_BULLET_PHYSIC_ENGINE)
+	TEST_CASE("Physics batch query");
+
+	CPhysicsEngine* engine = CPhysicsEngine::createGetInstance();
+	engine->initPhysics();
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+
+	// 2 unit boxes at the origin and at x = 10
+	CRigidbody* boxA = createStaticBox(zone, core::vector3df(0.0f, 0.0f, 0.0f));
+	CRigidbody* boxB = createStaticBox(zone, core::vector3df(10.0f, 0.0f, 0.0f));
+	engine->updateAABBs();
+
+	CPhysicsBatchQuery* batch = engine->getBatchQuery();
+	u32 rayHit = batch->addRayTest(core::vector3df(-10.0f, 0.0f, 0.0f), core::vector3df(20.0f, 0.0f, 0.0f));
+	u32 rayMiss = batch->addRayTest(core::vector3df(-10.0f, 5.0f, 0.0f), core::vector3df(20.0f, 5.0f, 0.0f));
+	u32 sweepHit = batch->addSweepTest(core::vector3df(5.0f, 0.0f, 0.0f), core::vector3df(20.0f, 0.0f, 0.0f), 0.25f);
+	u32 overlapB = batch->addOverlapTest(core::vector3df(10.0f, 0.0f, 0.0f), 1.0f);
+	u32 overlapEmpty = batch->addOverlapTest(core::vector3df(5.0f, 0.0f, 0.0f), 1.0f);
+
+	// the static bodies are in StaticFilter, so these queries must skip them
+	int noStatic = btBroadphaseProxy::AllFilter ^ btBroadphaseProxy::StaticFilter;
+	u32 rayFiltered = batch->addRayTest(core::vector3df(-10.0f, 0.0f, 0.0f), core::vector3df(20.0f, 0.0f, 0.0f), btBroadphaseProxy::DefaultFilter, noStatic);
+	u32 overlapFiltered = batch->addOverlapTest(core::vector3df(10.0f, 0.0f, 0.0f), 1.0f, btBroadphaseProxy::DefaultFilter, noStatic);
+
+	TEST_ASSERT_EQUAL(batch->getQueryCount(), 7);
+
+	engine->updatePhysics(1.0f / 60.0f);
+
+	TEST_ASSERT_EQUAL(batch->getQueryCount(), 0);
+	TEST_ASSERT_EQUAL(batch->getResultCount(), 7);
+
+	const SPhysicsQueryResult* results = batch->getResults();
+	const SPhysicsOverlap* overlaps = batch->getOverlaps();
+
+	TEST_CASE("Physics batch ray");
+	TEST_ASSERT_THROW(results[rayHit].Hit);
+	TEST_ASSERT_THROW(results[rayHit].Body == boxA);
+	TEST_ASSERT_THROW(fabsf(results[rayHit].HitPointWorld.X + 0.5f) < 0.01f);
+	TEST_ASSERT_THROW(!results[rayMiss].Hit);
+
+	TEST_CASE("Physics batch sweep");
+	TEST_ASSERT_THROW(results[sweepHit].Hit);
+	TEST_ASSERT_THROW(results[sweepHit].Body == boxB);
+
+	TEST_CASE("Physics batch overlap");
+	TEST_ASSERT_THROW(results[overlapB].Hit);
+	TEST_ASSERT_EQUAL(results[overlapB].OverlapCount, 1);
+	TEST_ASSERT_THROW(overlaps[results[overlapB].OverlapOffset].Body == boxB);
+	TEST_ASSERT_THROW(!results[overlapEmpty].Hit);
+	TEST_ASSERT_EQUAL(results[overlapEmpty].OverlapCount, 0);
+
+	TEST_CASE("Physics batch collision filter");
+	TEST_ASSERT_THROW(!results[rayFiltered].Hit);
+	TEST_ASSERT_THROW(!results[overlapFiltered].Hit);
+	TEST_ASSERT_EQUAL(results[overlapFiltered].OverlapCount, 0);
+
+	// release the bodies before the physics world
+	delete scene;
+
+	CPhysicsEngine::releaseInstance();
+#endif
+}
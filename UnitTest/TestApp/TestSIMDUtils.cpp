@@ -0,0 +1,227 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestSIMDUtils.h"
+
+#include "Utils/CSIMDUtils.h"
+#include "ParticleSystem/Particles/CInterpolator.h"
+
+using namespace Skylicht;
+
+void testSIMDUtils()
+{
+	TEST_CASE("CSIMDUtils::mulMatrix");
+	core::matrix4 a, b, r1, r2;
+	a.setRotationDegrees(core::vector3df(30.0f, 45.0f, 60.0f));
+	a.setTranslation(core::vector3df(1.0f, 2.0f, 3.0f));
+	b.setRotationDegrees(core::vector3df(-10.0f, 20.0f, 90.0f));
+	b.setTranslation(core::vector3df(-5.0f, 10.0f, 0.5f));
+	b.setScale(core::vector3df(2.0f, 0.5f, 1.0f));
+
+	r1.setbyproduct_nocheck(a, b);
+	CSIMDUtils::mulMatrix(r2, a, b);
+	for (int i = 0; i < 16; i++)
+		TEST_ASSERT_FLOAT_EQUAL(r1[i], r2[i]);
+
+
+	TEST_CASE("CSIMDUtils::transformBox");
+	core::aabbox3df box1(core::vector3df(-1.0f, -2.0f, -3.0f), core::vector3df(4.0f, 5.0f, 6.0f));
+	core::aabbox3df box2 = box1;
+	r1.transformBoxEx(box1);
+	CSIMDUtils::transformBox(r1, box2);
+	TEST_ASSERT_FLOAT_EQUAL(box1.MinEdge.X, box2.MinEdge.X);
+	TEST_ASSERT_FLOAT_EQUAL(box1.MinEdge.Y, box2.MinEdge.Y);
+	TEST_ASSERT_FLOAT_EQUAL(box1.MinEdge.Z, box2.MinEdge.Z);
+	TEST_ASSERT_FLOAT_EQUAL(box1.MaxEdge.X, box2.MaxEdge.X);
+	TEST_ASSERT_FLOAT_EQUAL(box1.MaxEdge.Y, box2.MaxEdge.Y);
+	TEST_ASSERT_FLOAT_EQUAL(box1.MaxEdge.Z, box2.MaxEdge.Z);
+
+
+	TEST_CASE("CSIMDUtils::mulMatrices");
+	core::matrix4 matA[5], matB[5], matOut[5];
+	for (int i = 0; i < 5; i++)
+	{
+		matA[i].setRotationDegrees(core::vector3df(10.0f * i, 20.0f, -5.0f * i));
+		matA[i].setTranslation(core::vector3df((f32)i, 1.0f, -2.0f));
+		matB[i].setRotationDegrees(core::vector3df(-15.0f, 7.0f * i, 30.0f));
+		matB[i].setScale(core::vector3df(1.0f + i, 0.5f, 2.0f));
+	}
+
+	CSIMDUtils::mulMatrices(matOut, matA, matB, 5);
+	for (int i = 0; i < 5; i++)
+	{
+		r1.setbyproduct_nocheck(matA[i], matB[i]);
+		for (int j = 0; j < 16; j++)
+			TEST_ASSERT_FLOAT_EQUAL(r1[j], matOut[i][j]);
+	}
+
+
+	TEST_CASE("CSIMDUtils::transformBoxes");
+	core::aabbox3df boxes1[5], boxes2[5];
+	for (int i = 0; i < 5; i++)
+	{
+		boxes1[i] = core::aabbox3df(core::vector3df(-1.0f * i, -2.0f, -3.0f), core::vector3df(4.0f, 5.0f + i, 6.0f));
+		boxes2[i] = boxes1[i];
+	}
+
+	// transform in place
+	CSIMDUtils::transformBoxes(matOut, boxes2, boxes2, 5);
+	for (int i = 0; i < 5; i++)
+	{
+		matOut[i].transformBoxEx(boxes1[i]);
+		TEST_ASSERT_FLOAT_EQUAL(boxes1[i].MinEdge.X, boxes2[i].MinEdge.X);
+		TEST_ASSERT_FLOAT_EQUAL(boxes1[i].MinEdge.Y, boxes2[i].MinEdge.Y);
+		TEST_ASSERT_FLOAT_EQUAL(boxes1[i].MinEdge.Z, boxes2[i].MinEdge.Z);
+		TEST_ASSERT_FLOAT_EQUAL(boxes1[i].MaxEdge.X, boxes2[i].MaxEdge.X);
+		TEST_ASSERT_FLOAT_EQUAL(boxes1[i].MaxEdge.Y, boxes2[i].MaxEdge.Y);
+		TEST_ASSERT_FLOAT_EQUAL(boxes1[i].MaxEdge.Z, boxes2[i].MaxEdge.Z);
+	}
+
+
+	TEST_CASE("CSIMDUtils::isBoxOutsideFrustum");
+	core::matrix4 proj, view;
+	proj.buildProjectionMatrixPerspectiveFovLH(core::PI / 3.0f, 1.0f, 1.0f, 100.0f);
+	view.buildCameraLookAtMatrixLH(core::vector3df(0.0f, 0.0f, 0.0f), core::vector3df(0.0f, 0.0f, 1.0f), core::vector3df(0.0f, 1.0f, 0.0f));
+
+	scene::SViewFrustum frustum;
+	frustum.setFrom(proj * view);
+
+	core::aabbox3df boxes[6];
+	boxes[0] = core::aabbox3df(core::vector3df(-1.0f, -1.0f, 10.0f), core::vector3df(1.0f, 1.0f, 12.0f));
+	boxes[1] = core::aabbox3df(core::vector3df(-1.0f, -1.0f, -12.0f), core::vector3df(1.0f, 1.0f, -10.0f));
+	boxes[2] = core::aabbox3df(core::vector3df(50.0f, -1.0f, 10.0f), core::vector3df(52.0f, 1.0f, 12.0f));
+	boxes[3] = core::aabbox3df(core::vector3df(-1.0f, -1.0f, 99.0f), core::vector3df(1.0f, 1.0f, 120.0f));
+	boxes[4] = core::aabbox3df(core::vector3df(-1.0f, -1.0f, 200.0f), core::vector3df(1.0f, 1.0f, 210.0f));
+	boxes[5] = core::aabbox3df(core::vector3df(-100.0f, -100.0f, 5.0f), core::vector3df(100.0f, 100.0f, 6.0f));
+
+	bool outside[6];
+	for (int i = 0; i < 6; i++)
+		outside[i] = CSIMDUtils::isBoxOutsideFrustum(frustum, boxes[i]);
+
+	TEST_ASSERT_THROW(outside[0] == false);
+	TEST_ASSERT_THROW(outside[1] == true);
+	TEST_ASSERT_THROW(outside[2] == true);
+	TEST_ASSERT_THROW(outside[3] == false);
+	TEST_ASSERT_THROW(outside[4] == true);
+	TEST_ASSERT_THROW(outside[5] == false);
+
+
+	TEST_CASE("CSIMDUtils::cullOrientedBoxes");
+	f32 centerData[3][6];
+	f32 axisData[9][6];
+	f32* center[3] = { centerData[0], centerData[1], centerData[2] };
+	f32* halfAxis[9];
+	for (int i = 0; i < 9; i++)
+		halfAxis[i] = axisData[i];
+
+	// the local box is moved, rotated in world
+	core::matrix4 world;
+	world.setRotationDegrees(core::vector3df(0.0f, 45.0f, 0.0f));
+
+	for (int i = 0; i < 6; i++)
+	{
+		world.setTranslation(core::vector3df(0.0f, 0.0f, 10.0f * i));
+
+		core::vector3df c = boxes[i].getCenter() - core::vector3df(0.0f, 0.0f, 10.0f);
+		core::vector3df e = boxes[i].MaxEdge - boxes[i].getCenter();
+		world.transformVect(c);
+
+		center[0][i] = c.X;
+		center[1][i] = c.Y;
+		center[2][i] = c.Z;
+
+		const f32* m = world.pointer();
+		const f32* extent = &e.X;
+		for (int j = 0; j < 3; j++)
+		{
+			halfAxis[j * 3][i] = m[j * 4] * extent[j];
+			halfAxis[j * 3 + 1][i] = m[j * 4 + 1] * extent[j];
+			halfAxis[j * 3 + 2][i] = m[j * 4 + 2] * extent[j];
+		}
+	}
+
+	CSIMDUtils::cullOrientedBoxes(frustum, center, halfAxis, 6, outside);
+
+	for (int i = 0; i < 6; i++)
+	{
+		// compare with the test of local box in the local frustum
+		world.setTranslation(core::vector3df(0.0f, 0.0f, 10.0f * i));
+
+		core::matrix4 invWorld;
+		world.getInverse(invWorld);
+
+		scene::SViewFrustum localFrustum = frustum;
+		localFrustum.transform(invWorld);
+
+		core::aabbox3df localBox = boxes[i];
+		localBox.MinEdge.Z -= 10.0f;
+		localBox.MaxEdge.Z -= 10.0f;
+
+		TEST_ASSERT_THROW(outside[i] == CSIMDUtils::isBoxOutsideFrustum(localFrustum, localBox));
+	}
+
+
+	TEST_CASE("CSIMDUtils::skinVertex");
+	const float* matrix[2] = { a.pointer(), b.pointer() };
+	const float weight[2] = { 0.25f, 0.75f };
+	core::vector3df srcPos(1.0f, 2.0f, 3.0f), srcNormal(0.0f, 1.0f, 0.0f);
+	core::vector3df pos, normal;
+	CSIMDUtils::skinVertex(matrix, weight, 2, srcPos, srcNormal, pos, normal);
+
+	core::vector3df p1 = srcPos, p2 = srcPos;
+	a.transformVect(p1);
+	b.transformVect(p2);
+	core::vector3df expected = p1 * 0.25f + p2 * 0.75f;
+	TEST_ASSERT_FLOAT_EQUAL(pos.X, expected.X);
+	TEST_ASSERT_FLOAT_EQUAL(pos.Y, expected.Y);
+	TEST_ASSERT_FLOAT_EQUAL(pos.Z, expected.Z);
+
+	core::vector3df n1 = srcNormal, n2 = srcNormal;
+	a.rotateVect(n1);
+	b.rotateVect(n2);
+	expected = n1 * 0.25f + n2 * 0.75f;
+	TEST_ASSERT_FLOAT_EQUAL(normal.X, expected.X);
+	TEST_ASSERT_FLOAT_EQUAL(normal.Y, expected.Y);
+	TEST_ASSERT_FLOAT_EQUAL(normal.Z, expected.Z);
+
+
+	TEST_CASE("CSIMDUtils::lerpArray");
+	f32 start[7], end[7], t[7], out[7];
+	for (int i = 0; i < 7; i++)
+	{
+		start[i] = (f32)i;
+		end[i] = (f32)i * 3.0f;
+		t[i] = i / 6.0f;
+	}
+	CSIMDUtils::lerpArray(start, end, t, out, 7);
+
+	bool pass = true;
+	for (int i = 0; i < 7; i++)
+	{
+		if (fabsf(out[i] - (start[i] + (end[i] - start[i]) * t[i])) > 0.0001f)
+			pass = false;
+	}
+	TEST_ASSERT_THROW(pass);
+
+
+	TEST_CASE("CInterpolator batch");
+	Particle::CInterpolator interpolator;
+	interpolator.addEntry(0.2f, 1.0f);
+	interpolator.addEntry(0.5f, 3.0f);
+	interpolator.addEntry(0.6f, 0.5f);
+	interpolator.addEntry(0.9f, 2.0f);
+
+	f32 x[23], y[23];
+	for (int i = 0; i < 23; i++)
+		x[i] = i / 20.0f - 0.05f;
+	x[22] = 0.5f;
+
+	interpolator.interpolate(x, y, 23);
+
+	pass = true;
+	for (int i = 0; i < 23; i++)
+	{
+		if (fabsf(y[i] - interpolator.interpolate(x[i])) > 0.0001f)
+			pass = false;
+	}
+	TEST_ASSERT_THROW(pass);
+}
@@ -5,6 +5,9 @@
 #include "TestTransform.h"
 
 #include "Scene/CScene.h"
+#include "Scene/CSceneExporter.h"
+#include "Scene/CSceneImporter.h"
+#include "Utils/CMappedFile.h"
 
 TestScene::TestScene() : m_testStep(0)
 {
@@ -121,8 +124,241 @@ void TestScene::render()
 
 TestScene* g_testScene = NULL;
 
+void testSceneSearchIndex()
+{
+	TEST_CASE("CScene search index");
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+
+	CContainerObject* containerA = zone->createContainerObject();
+	CContainerObject* containerB = zone->createContainerObject();
+	CContainerObject* containerC = containerB->createContainerObject();
+
+	CGameObject* objectA = containerA->createEmptyObject();
+	CGameObject* objectC = containerC->createEmptyObject();
+
+	objectA->setName("Player");
+	objectC->setName(L"Enemy");
+	objectC->setID("enemy-id");
+
+	// objects in the add list are searchable
+	TEST_ASSERT_THROW(scene->searchObjectInChild(L"Player") == objectA);
+	TEST_ASSERT_THROW(scene->searchObjectInChildByID("enemy-id") == objectC);
+	TEST_ASSERT_THROW(zone->searchObjectInChild(L"Enemy") == objectC);
+	TEST_ASSERT_THROW(containerB->searchObjectInChild(L"Enemy") == objectC);
+	TEST_ASSERT_THROW(containerA->searchObjectInChild(L"Enemy") == NULL);
+	TEST_ASSERT_THROW(containerB->searchObject(L"Enemy") == NULL);
+	TEST_ASSERT_THROW(containerC->searchObject(L"Enemy") == objectC);
+	TEST_ASSERT_THROW(containerC->searchObjectByID("enemy-id") == objectC);
+	TEST_ASSERT_THROW(containerA->searchObjectInChildByID("enemy-id") == NULL);
+
+	scene->updateAddRemoveObject();
+
+	// rename and change id
+	objectC->setName("Boss");
+	objectC->setID("boss-id");
+	TEST_ASSERT_THROW(scene->searchObjectInChild(L"Enemy") == NULL);
+	TEST_ASSERT_THROW(scene->searchObjectInChildByID("enemy-id") == NULL);
+	TEST_ASSERT_THROW(zone->searchObjectInChild(L"Boss") == objectC);
+	TEST_ASSERT_THROW(zone->searchObjectInChildByID("boss-id") == objectC);
+
+	// same name in other container
+	CGameObject* objectB = containerB->createEmptyObject();
+	objectB->setName("Boss");
+	TEST_ASSERT_THROW(containerB->searchObject(L"Boss") == objectB);
+	TEST_ASSERT_THROW(containerC->searchObject(L"Boss") == objectC);
+
+	// move object to other container
+	containerA->bringToChild(objectC);
+	TEST_ASSERT_THROW(containerA->searchObject(L"Boss") == objectC);
+	TEST_ASSERT_THROW(containerC->searchObject(L"Boss") == NULL);
+
+	// the entity id
+	CEntityManager* entityManager = scene->getEntityManager();
+	CEntity* entity = objectA->getEntity();
+	entity->setID(objectA->getID().c_str());
+	TEST_ASSERT_THROW(entityManager->getEntityByID(objectA->getID().c_str()) == entity);
+
+	// remove object
+	std::string idA = objectA->getID();
+	objectA->remove();
+	scene->updateAddRemoveObject();
+	TEST_ASSERT_THROW(scene->searchObjectInChild(L"Player") == NULL);
+	TEST_ASSERT_THROW(scene->searchObjectInChildByID(idA.c_str()) == NULL);
+	TEST_ASSERT_THROW(entityManager->getEntityByID(idA.c_str()) == NULL);
+
+	// remove container
+	containerA->remove();
+	scene->updateAddRemoveObject();
+	TEST_ASSERT_THROW(scene->searchObjectInChild(L"Boss") == objectB);
+
+	// same name, the search returns the first added object
+	CGameObject* copy[3];
+	for (int i = 0; i < 3; i++)
+	{
+		copy[i] = containerB->createEmptyObject();
+		copy[i]->setName("Copy");
+	}
+	TEST_ASSERT_THROW(scene->getObjectsByName(L"Copy")->size() == 3);
+	TEST_ASSERT_THROW(containerB->searchObject(L"Copy") == copy[0]);
+
+	copy[0]->remove();
+	scene->updateAddRemoveObject();
+	TEST_ASSERT_THROW(scene->getObjectsByName(L"Copy")->size() == 2);
+	TEST_ASSERT_THROW(scene->searchObjectInChild(L"Copy") == copy[1]);
+	TEST_ASSERT_THROW(containerB->searchObjectInChild(L"Copy") == copy[1]);
+
+	copy[1]->setName("Other");
+	TEST_ASSERT_THROW(scene->getObjectsByName(L"Copy")->size() == 1);
+	TEST_ASSERT_THROW(containerB->searchObject(L"Copy") == copy[2]);
+
+	delete scene;
+}
+
+void getSceneObjects(CContainerObject* container, std::vector<CGameObject*>& objects)
+{
+	ArrayGameObject* childs = container->getChilds();
+	for (size_t i = 0, n = childs->size(); i < n; i++)
+	{
+		CGameObject* object = childs->at(i);
+		objects.push_back(object);
+
+		CContainerObject* childContainer = dynamic_cast<CContainerObject*>(object);
+		if (childContainer != NULL)
+			getSceneObjects(childContainer, objects);
+	}
+}
+
+bool isSameScene(CScene* a, CScene* b)
+{
+	if (a->getAllZone()->size() != b->getAllZone()->size())
+		return false;
+
+	std::vector<CGameObject*> objectsA, objectsB;
+	for (size_t i = 0, n = a->getAllZone()->size(); i < n; i++)
+	{
+		CZone* zoneA = a->getAllZone()->at(i);
+		CZone* zoneB = b->getAllZone()->at(i);
+		objectsA.push_back(zoneA);
+		objectsB.push_back(zoneB);
+		getSceneObjects(zoneA, objectsA);
+		getSceneObjects(zoneB, objectsB);
+	}
+
+	// zone, 10 containers, 1000 objects
+	if (objectsA.size() != 1011 || objectsA.size() != objectsB.size())
+		return false;
+
+	for (size_t i = 0, n = objectsA.size(); i < n; i++)
+	{
+		CGameObject* objA = objectsA[i];
+		CGameObject* objB = objectsB[i];
+
+		if (objA->getID() != objB->getID() ||
+			strcmp(objA->getNameA(), objB->getNameA()) != 0 ||
+			objA->isVisible() != objB->isVisible() ||
+			(dynamic_cast<CContainerObject*>(objA) == NULL) != (dynamic_cast<CContainerObject*>(objB) == NULL))
+			return false;
+
+		CTransformEuler* transformA = objA->getTransformEuler();
+		CTransformEuler* transformB = objB->getTransformEuler();
+		if ((transformA == NULL) != (transformB == NULL))
+			return false;
+
+		if (transformA != NULL &&
+			(!transformA->getPosition().equals(transformB->getPosition()) ||
+				!transformA->getScale().equals(transformB->getScale())))
+			return false;
+	}
+
+	return true;
+}
+
+bool importScene(CScene* scene, const char* path)
+{
+	if (!CSceneImporter::beginImportScene(scene, path))
+		return false;
+
+	bool progress = true;
+	float percent = 0.0f;
+	while (!CSceneImporter::updateLoadScene())
+	{
+		float p = CSceneImporter::getLoadingPercent();
+		if (p < percent || p > 1.0f)
+			progress = false;
+		percent = p;
+	}
+
+	return progress && CSceneImporter::getLoadingPercent() == 1.0f;
+}
+
+void testSceneBinary()
+{
+	TEST_CASE("CSceneImporter binary");
+
+	const char* fileXML = "TestSceneXML.scene";
+	const char* fileBinary = "TestSceneBinary.scene";
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+	zone->setName("Zone");
+
+	for (int i = 0; i < 10; i++)
+	{
+		CContainerObject* container = zone->createContainerObject();
+		container->getTransformEuler()->setPosition(core::vector3df((f32)i, 0.0f, 0.0f));
+
+		for (int j = 0; j < 100; j++)
+		{
+			CGameObject* object = container->createEmptyObject();
+			object->getTransformEuler()->setPosition(core::vector3df((f32)i, (f32)j, 0.5f));
+			object->getTransformEuler()->setScale(core::vector3df(1.0f, 2.0f, (f32)j));
+			object->setVisible(j % 3 != 0);
+		}
+	}
+
+	scene->updateAddRemoveObject();
+
+	CSceneExporter::exportScene(scene, fileXML);
+	TEST_ASSERT_THROW(CSceneExporter::exportSceneBinary(scene, fileBinary));
+
+	CScene* sceneXML = new CScene();
+	CScene* sceneBinary = new CScene();
+
+	TEST_ASSERT_THROW(importScene(sceneXML, fileXML));
+	TEST_ASSERT_THROW(importScene(sceneBinary, fileBinary));
+
+	sceneXML->updateAddRemoveObject();
+	sceneBinary->updateAddRemoveObject();
+
+	TEST_ASSERT_THROW(isSameScene(scene, sceneXML));
+	TEST_ASSERT_THROW(isSameScene(scene, sceneBinary));
+
+	// the tables are read in place, so the sections must be aligned
+	CMappedFile binaryFile;
+	TEST_ASSERT_THROW(binaryFile.open(fileBinary));
+
+	SSceneBinaryHeader header;
+	memcpy(&header, binaryFile.getData() + sizeof(SAssetHeader), sizeof(SSceneBinaryHeader));
+	TEST_ASSERT_EQUAL(header.ObjectOffset % SCENE_BINARY_ALIGN, 0);
+	TEST_ASSERT_EQUAL(header.ComponentOffset % SCENE_BINARY_ALIGN, 0);
+	binaryFile.close();
+
+	delete sceneXML;
+	delete sceneBinary;
+	delete scene;
+
+	remove(fileXML);
+	remove(fileBinary);
+}
+
 void testScene()
 {
+	testSceneSearchIndex();
+
+	testSceneBinary();
+
 	TEST_CASE("Test scene start");
 	g_testScene = new TestScene();
 }
@@ -44,6 +44,37 @@ void testSystemThread()
 	getIrrlichtDevice()->sleep(100);
 }
 
+void testJobSystem()
+{
+	TEST_CASE("Job system parallel for");
+	System::CJobSystem* jobSystem = new System::CJobSystem(3);
+
+	std::vector<int> values;
+	values.resize(10000, 0);
+
+	jobSystem->parallelFor((int)values.size(), 64, [&values](int begin, int end)
+		{
+			for (int i = begin; i < end; i++)
+				values[i] = i * 2;
+		});
+
+	for (int i = 0, n = (int)values.size(); i < n; i++)
+		TEST_ASSERT_THROW(values[i] == i * 2);
+
+	TEST_CASE("Job system group");
+	System::CJobGroup group;
+	std::atomic<int> count(0);
+
+	for (int i = 0; i < 100; i++)
+		jobSystem->run([&count]() { count++; }, &group);
+
+	jobSystem->wait(&group);
+	TEST_ASSERT_THROW(group.isDone());
+	TEST_ASSERT_THROW(count.load() == 100);
+
+	delete jobSystem;
+}
+
 bool isSystemThreadPass()
 {
 	TEST_CASE("System thread end");
@@ -3,6 +3,7 @@
 #include "Base.hh"
 #include "Thread/IThread.h"
 #include "Thread/IMutex.h"
+#include "Thread/CJobSystem.h"
 
 using namespace Skylicht;
 
@@ -24,4 +25,6 @@ public:
 
 void testSystemThread();
 
+void testJobSystem();
+
 bool isSystemThreadPass();
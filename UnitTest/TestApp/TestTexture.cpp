@@ -0,0 +1,158 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestTexture.h"
+#include "TestMeshLoader.h"
+
+#include "TextureManager/CTextureManager.h"
+
+using namespace Skylicht;
+
+void testTextureStreaming()
+{
+	TEST_CASE("CTextureManager streaming");
+
+	IVideoDriver* driver = getVideoDriver();
+	CTextureManager* textureManager = CTextureManager::getInstance();
+
+	IImage* image = driver->createImage(video::ECF_A8R8G8B8, core::dimension2du(256, 256));
+	image->fill(SColor(255, 255, 128, 0));
+	TEST_ASSERT_THROW(driver->writeImageToFile(image, "TestStreamA.png"));
+	TEST_ASSERT_THROW(driver->writeImageToFile(image, "TestStreamB.png"));
+	image->drop();
+
+	// 256x256 RGBA and 1/3 for mipmaps
+	u32 fullMemory = 256 * 256 * 4;
+	fullMemory += fullMemory / 3;
+
+	u32 budget = textureManager->getStreamingBudget();
+	textureManager->setStreamingMipDistance(50.0f);
+
+	int numLoadA = 0;
+	int numLoadB = 0;
+	ITexture* textureA = NULL;
+	ITexture* textureB = NULL;
+	u32 callbackA = 0;
+	u32 callbackB = 0;
+
+	// return the placeholder, the texture is uploaded later
+	ITexture* t = textureManager->getTextureAsync("TestStreamA.png", 0.0f, [&](ITexture* texture)
+		{
+			textureA = texture;
+			numLoadA++;
+		}, &callbackA);
+	TEST_ASSERT_THROW(t == textureManager->getNullTexture());
+	TEST_ASSERT_THROW(callbackA != 0);
+	TEST_ASSERT_THROW(numLoadA == 0);
+	TEST_ASSERT_THROW(textureManager->isStreaming());
+
+	textureManager->finishStreaming();
+	TEST_ASSERT_THROW(numLoadA == 1);
+	TEST_ASSERT_THROW(textureA != NULL);
+	TEST_ASSERT_THROW(textureManager->getTexture("TestStreamA.png") == textureA);
+	TEST_ASSERT_THROW(textureManager->getTextureAsync("TestStreamA.png") == textureA);
+	TEST_ASSERT_THROW(textureManager->getStreamingMemory() == fullMemory);
+
+	// the far texture skips 2 mip levels (64x64)
+	textureManager->getTextureAsync("TestStreamB.png", 120.0f, [&](ITexture* texture)
+		{
+			textureB = texture;
+			numLoadB++;
+		}, &callbackB);
+	textureManager->finishStreaming();
+	TEST_ASSERT_THROW(numLoadB == 1);
+	TEST_ASSERT_THROW(strstr(textureB->getName().getPath().c_str(), "@mip2") != NULL);
+	TEST_ASSERT_THROW(textureManager->getStreamingMemory() == fullMemory + fullMemory / 16);
+
+	// come near, the full texture is loaded and the old texture that only the callback uses is released
+	io::path mip2Name = textureB->getName().getPath();
+	textureManager->setStreamingDistance("TestStreamB.png", 10.0f);
+	textureManager->finishStreaming();
+	TEST_ASSERT_THROW(numLoadB == 2);
+	TEST_ASSERT_THROW(strstr(textureB->getName().getPath().c_str(), "@mip") == NULL);
+	TEST_ASSERT_THROW(driver->findTexture(mip2Name) == NULL);
+	TEST_ASSERT_THROW(textureManager->getStreamingMemory() == 2 * fullMemory);
+
+	// the caller of getTexture keeps the full texture
+	ITexture* keepB = textureManager->getTexture("TestStreamB.png");
+	TEST_ASSERT_THROW(keepB == textureB);
+	io::path keepName = keepB->getName().getPath();
+
+	// over budget, the far texture drops the top mip level
+	textureManager->setStreamingDistance("TestStreamB.png", 30.0f);
+	textureManager->setStreamingBudget(fullMemory + fullMemory / 4);
+	textureManager->updateStreaming();
+	textureManager->finishStreaming();
+	TEST_ASSERT_THROW(numLoadA == 1);
+	TEST_ASSERT_THROW(numLoadB == 3);
+	TEST_ASSERT_THROW(strstr(textureB->getName().getPath().c_str(), "@mip1") != NULL);
+	TEST_ASSERT_THROW(textureManager->getStreamingMemory() <= textureManager->getStreamingBudget());
+	TEST_ASSERT_THROW(driver->findTexture(keepName) == keepB);
+
+	// the removed callback is not called, the callback without id is called once
+	textureManager->removeTextureCallback(callbackB);
+	textureManager->setStreamingBudget(budget);
+	textureManager->setStreamingDistance("TestStreamB.png", 10.0f);
+
+	int numLoadOnce = 0;
+	ITexture* mip1Texture = textureB;
+	io::path mip1Name = mip1Texture->getName().getPath();
+	textureManager->getTextureAsync("TestStreamB.png", 10.0f, [&](ITexture* texture)
+		{
+			numLoadOnce++;
+		});
+	TEST_ASSERT_THROW(numLoadOnce == 1);
+
+	textureManager->finishStreaming();
+	TEST_ASSERT_THROW(numLoadB == 3);
+	TEST_ASSERT_THROW(numLoadOnce == 1);
+
+	// the kept full texture is used again, the mip 1 texture is kept for the caller
+	TEST_ASSERT_THROW(textureManager->getTextureAsync("TestStreamB.png") == keepB);
+	TEST_ASSERT_THROW(driver->findTexture(mip1Name) == mip1Texture);
+	TEST_ASSERT_THROW(textureManager->getStreamingMemory() == 2 * fullMemory);
+
+	TEST_CASE("CTextureManager streaming archive");
+
+	// the stored file in zip is read from the shared archive file, the memory shows it is decoded to 256x256
+	io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+	io::IReadFile* readFile = fs->createAndOpenFile("TestStreamA.png");
+	TEST_ASSERT_THROW(readFile != NULL);
+
+	core::array<unsigned char> data;
+	data.set_used((u32)readFile->getSize());
+	readFile->read(data.pointer(), data.size());
+	readFile->drop();
+
+	TEST_ASSERT_THROW(writeStoredZip("TestStream.zip", "TestStreamZip.png", data.pointer(), data.size()));
+	TEST_ASSERT_THROW(fs->addFileArchive("TestStream.zip", false, false));
+
+	ITexture* textureZip = NULL;
+	u32 callbackZip = 0;
+	textureManager->getTextureAsync("TestStreamZip.png", 0.0f, [&](ITexture* texture)
+		{
+			textureZip = texture;
+		}, &callbackZip);
+	textureManager->finishStreaming();
+	TEST_ASSERT_THROW(textureZip != NULL);
+	TEST_ASSERT_THROW(textureManager->getStreamingMemory() == 3 * fullMemory);
+
+	// remove the streaming texture
+	textureManager->removeTexture(textureZip);
+	TEST_ASSERT_THROW(textureManager->getStreamingMemory() == 2 * fullMemory);
+
+	textureManager->removeTexture(keepB);
+	textureManager->removeTexture(mip1Texture);
+	TEST_ASSERT_THROW(driver->findTexture(keepName) == NULL);
+	TEST_ASSERT_THROW(driver->findTexture(mip1Name) == NULL);
+	TEST_ASSERT_THROW(textureManager->getStreamingMemory() == fullMemory);
+
+	textureManager->removeTexture(textureA);
+	TEST_ASSERT_THROW(textureManager->getStreamingMemory() == 0);
+	TEST_ASSERT_THROW(!textureManager->isStreaming());
+
+	fs->removeFileArchive(fs->getFileArchiveCount() - 1);
+
+	remove("TestStream.zip");
+	remove("TestStreamA.png");
+	remove("TestStreamB.png");
+}